@@ -993,6 +993,76 @@ void opcodeinin (lyricalinstruction*(* opcode)(lyricalreg*, lyricalreg*)) {
 	if (funcarg) freefuncarg();
 }
 
+// Process opcodes where the arguments
+// in order are: input, input, input.
+void opcodeininin (lyricalinstruction*(* opcode)(lyricalreg*, lyricalreg*, lyricalreg*)) {
+	
+	readoperands(3, SEMICOLONENDING);
+	
+	if (!compilepass) {
+		// Instructions are not generated in the firstpass.
+		
+		if (funcarg) freefuncarg();
+		
+		return;
+	}
+	
+	// I process the input operands.
+	
+	if (operand[2].arg) {
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[2].reg = getregforvar(operand[2].arg->v, 0, operand[2].arg->typepushed, operand[2].arg->bitselect, FORINPUT);
+		
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[2].reg->lock = 1;
+	}
+	
+	if (operand[1].arg) {
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[1].reg = getregforvar(operand[1].arg->v, 0, operand[1].arg->typepushed, operand[1].arg->bitselect, FORINPUT);
+		
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[1].reg->lock = 1;
+	}
+	
+	if (operand[0].arg) {
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[0].reg = getregforvar(operand[0].arg->v, 0, operand[0].arg->typepushed, operand[0].arg->bitselect, FORINPUT);
+		
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[0].reg->lock = 1;
+	}
+	
+	opcode(operand[0].reg, operand[1].reg, operand[2].reg);
+	
+	// I unlock the registers that were allocated
+	// and locked for the operands.
+	// Locked registers must be unlocked only after
+	// the instructions using them have been generated;
+	// otherwise they could be lost when insureenoughunusedregisters()
+	// is called while creating a new lyricalinstruction.
+	operand[0].reg->lock = 0;
+	operand[1].reg->lock = 0;
+	operand[2].reg->lock = 0;
+	
+	if (funcarg) freefuncarg();
+}
+
 // Process opcodes where the arguments
 // in order are: output, input.
 void opcodeoutin (lyricalinstruction*(* opcode)(lyricalreg*, lyricalreg*)) {
@@ -1430,105 +1500,398 @@ void opcodeinoutin (lyricalinstruction*(* opcode)(lyricalreg*, lyricalreg*)) {
 	if (funcarg) freefuncarg();
 }
 
-// Process opcodes for conditional
-// branching where the arguments
-// in order are: input, label.
-void opcodejcondinlabel (lyricalinstruction*(* opcode)(lyricalreg*, string)) {
-	
-	readoperands(1, COMMAENDING);
-	
-	u8* savedcurpos = curpos;
+// Process opcodes where the arguments
+// in order are: input-output, input, input.
+void opcodeinoutinin (lyricalinstruction*(* opcode)(lyricalreg*, lyricalreg*, lyricalreg*)) {
 	
-	// I read the label name to which
-	// I am supposed to jump to.
-	string label = readsymbol(LOWERCASESYMBOL);
+	readoperands(3, SEMICOLONENDING);
 	
-	if (!label.ptr) {
-		reverseskipspace();
-		throwerror("expecting a label name");
+	if (operand[0].arg) {
+		
+		lyricalvariable* v = operand[0].arg->varpushed;
+		
+		// If the output operand of the instruction
+		// is a readonly variable, I load its value
+		// in a lyricalreg and dis-associate the lyricalreg
+		// from its lyricalvariable since the value
+		// of a readonly variable cannot be changed,
+		// in other words a dirty lyricalreg cannot
+		// be flushed to a readonly variable.
+		// Note that the field v of the lyricalargument
+		// is not used to determine whether it is
+		// a readonly variable, because the field
+		// flag->istobeoutput is not set, since it is
+		// an input-output argument, and pushargument()
+		// can duplicate the variable which it would set
+		// in the field v of the lyricalargument, and which
+		// would prevent me from correctly determining
+		// whether I have a readonly variable.
+		// Note also that this argument cannot be passed
+		// by reference, which would have caused
+		// the lyricalvariable in the field v to be
+		// the address of the lyricalvariable
+		// in the field varpushed.
+		if (isvarreadonly(v)) {
+			// lyricalreg are usable only in the secondpass.
+			if (compilepass) {
+				// I use the type and bitselect with
+				// which the variable was pushed.
+				operand[0].reg = getregforvar(operand[0].arg->v, 0, operand[0].arg->typepushed, operand[0].arg->bitselect, FORINPUT);
+				
+				// I dis-associate the lyricalreg from
+				// the lyricalvariable since the value
+				// of a readonly variable cannot be changed,
+				// in other words a dirty lyricalreg cannot
+				// be flushed to a readonly variable.
+				operand[0].reg->v = 0;
+				
+				// I lock the allocated register to prevent
+				// another call to allocreg() from using it.
+				// I also lock it, otherwise it could be lost
+				// when insureenoughunusedregisters() is called
+				// while creating a new lyricalinstruction.
+				// I also lock it so that it is not seen
+				// as an unused register when generating
+				// lyricalinstruction, since the register
+				// is not assigned to anything.
+				operand[0].reg->lock = 1;
+				
+				operand[0].arg = 0;
+			}
+			
+		} else if (v->name.ptr[1] != '*') {
+			// Only lyricalvariable for variables explicitly
+			// declared by the programmer should be used
+			// with propagatevarchange; hence it should never be
+			// a tempvar, a readonly variable or a dereference variable;
+			// the lyricalvariable must have been used
+			// with processvaroffsetifany() to insure that
+			// there is no offset suffixed to its name;
+			// the field id of a lyricalvariable is non-null
+			// only for such lyricalvariable.
+			
+			// I call processvaroffsetifany() to check
+			// if the variable pointed by v had an offset
+			// suffixed to its name. If yes, it will find
+			// the main variable and set it in v.
+			uint offset = processvaroffsetifany(&v);
+			
+			if (v->id) {
+				
+				uint size = sizeoftype(operand[0].arg->typepushed.ptr, stringmmsz(operand[0].arg->typepushed));
+				
+				// There is no need to check whether the offset is outside
+				// of the boundary of the variable in memory; because
+				// evaluateexpression(), when parsing the postfix operator '.',
+				// prevent the use of an offset that can result in an illegal
+				// access beyond the size of the variable.
+				
+				// If the portion to modify on the variable
+				// is greater than the size of the variable,
+				// the size of the portion to modify is recomputed
+				// to the maximum allowable size so that the portion
+				// of the variable to modify is within its boundaries.
+				// Keep in mind that getregforvar() do a similar
+				// work to prevent access beyond the size of a variable.
+				if (size > (v->size - offset))
+					size = v->size - offset;
+					
+				propagatevarchange(v, offset, size);
+			}
+		}
 	}
 	
 	if (!compilepass) {
 		// Instructions are not generated in the firstpass.
 		
-		mmrefdown(label.ptr);
-		
 		if (funcarg) freefuncarg();
 		
 		return;
 	}
 	
-	// I process the input operand.
+	// I process the input operands first because
+	// for the output operand, I will discard any
+	// overlapping register in order to follow
+	// the rule about the loading of registers; so
+	// I make use of any loaded register before
+	// they get discarded if they were overlapping
+	// the output operand.
 	
-	if (operand[0].arg) {
+	if (operand[1].arg) {
 		// I use the type and bitselect with
 		// which the variable was pushed.
-		operand[0].reg = getregforvar(operand[0].arg->v, 0, operand[0].arg->typepushed, operand[0].arg->bitselect, FORINPUT);
+		operand[1].reg = getregforvar(operand[1].arg->v, 0, operand[1].arg->typepushed, operand[1].arg->bitselect, FORINPUT);
 		
 		// I lock the register to prevent
 		// a call of allocreg() from using it.
 		// I also lock it, otherwise it could be lost
 		// when insureenoughunusedregisters() is called
 		// while creating a new lyricalinstruction.
-		operand[0].reg->lock = 1;
+		operand[1].reg->lock = 1;
 	}
 	
-	// I flush all registers without discarding them
-	// since I am doing a conditional branching.
-	flushanddiscardallreg(DONOTDISCARD);
-	
-	// I set curpos to savedcurpos so that
-	// resolvelabellater(), used by opcode(),
-	// correctly set the field pos of the newly
-	// created lyricallabeledinstructiontoresolve.
-	swapvalues(&curpos, &savedcurpos);
-	
-	opcode(operand[0].reg, label);
-	
-	// Here I restore curpos.
-	swapvalues(&curpos, &savedcurpos);
-	
-	// The string label is duplicated by opcode()
-	// So here I free the string in label
-	// since I will no longer need it.
-	mmrefdown(label.ptr);
-	
-	// I unlock the registers that were allocated
-	// and locked for the operands.
-	// Locked registers must be unlocked only after
-	// the instructions using them have been generated;
-	// otherwise they could be lost when insureenoughunusedregisters()
-	// is called while creating a new lyricalinstruction.
-	operand[0].reg->lock = 0;
-	
-	if (funcarg) freefuncarg();
-}
-
-// Process opcodes for conditional
-// branching where the arguments
-// in order are: input, immediate.
-void opcodejcondinimm (lyricalinstruction*(* opcode)(lyricalreg*, u64)) {
-	
-	readoperands(2, SEMICOLONENDING);
-	
-	if (operand[1].arg) {
-		
-		if (!operand[1].arg->v->isnumber) {
-			
-			curpos = savedcurpos;
-			throwerror("incorrect immediate operand");
-		}
-		
-	} else {
+	if (operand[2].arg) {
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[2].reg = getregforvar(operand[2].arg->v, 0, operand[2].arg->typepushed, operand[2].arg->bitselect, FORINPUT);
 		
-		curpos = savedcurpos;
-		throwerror("immediate operand expected");
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[2].reg->lock = 1;
 	}
 	
-	if (!compilepass) {
-		// Instructions are not generated in the firstpass.
-		
-		// There is no need to check whether
+	// I process the input-output operand.
+	if (operand[0].arg) {
+		// Note that the input-output operand
+		// cannot be a readonly variable.
+		
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[0].reg = getregforvar(operand[0].arg->v, 0, operand[0].arg->typepushed, operand[0].arg->bitselect, FORINPUT);
+		
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[0].reg->lock = 1;
+		
+		if (operand[0].arg->v->name.ptr[0] == '$') {
+			// This function is used to determine whether
+			// the tempvar pointed by operand[0].arg->v
+			// is shared with another lyricalargument.
+			uint issharedtempvar4 () {
+				// I first check whether the tempvar
+				// is shared with the second or third argument.
+				// Note that if operand[1].arg->v == operand[0].arg->v
+				// or operand[2].arg->v == operand[0].arg->v,
+				// the lyricalvariable pointed by operand[1].arg->v
+				// or operand[2].arg->v is always a tempvar that
+				// was created by propagatevarchange().
+				if (operand[1].arg && operand[1].arg->v == operand[0].arg->v)
+					return 1;
+					
+				if (operand[2].arg && operand[2].arg->v == operand[0].arg->v)
+					return 1;
+					
+				// If I get here, I search among
+				// registered arguments.
+				
+				lyricalargument* arg = registeredargs;
+				
+				while (arg) {
+					// Note that if arg->v == operand[0].arg->v,
+					// the lyricalvariable pointed by arg->v
+					// is always a tempvar that was created
+					// by propagatevarchange().
+					if (arg->v == operand[0].arg->v) return 1;
+					
+					arg = arg->nextregisteredarg;
+				}
+				
+				return 0;
+			}
+			
+			// If the tempvar from which the register
+			// pointed by operand[0].reg was loaded is shared
+			// with another lyricalargument, its value
+			// should be flushed if it is dirty before
+			// the register reassignment; otherwise the value
+			// of the tempvar will be lost whereas it is
+			// still needed by another argument.
+			if (issharedtempvar4() && operand[0].reg->dirty)
+				flushreg(operand[0].reg);
+				
+			// I get here if getregforvar() was used
+			// with the duplicate of the variable pushed;
+			// nothing was done to flush(If dirty) and discard
+			// any register overlapping the memory region of
+			// the variable operand[0].arg->varpushed that
+			// I am going to modify; so I should discard
+			// those overlapping registers in order to follow
+			// the rule about the use of registers.
+			// Before reassignment, I also discard any register
+			// associated with the memory region for which
+			// I am trying to discard overlaps, otherwise
+			// after the register reassignment made below,
+			// I can have 2 registers associated with
+			// the same memory location, violating the rule
+			// about the use of registers; hence I call
+			// discardoverlappingreg(), setting its argument
+			// flag to DISCARDALLOVERLAP.
+			discardoverlappingreg(
+				operand[0].arg->varpushed,
+				sizeoftype(operand[0].arg->typepushed.ptr, stringmmsz(operand[0].arg->typepushed)),
+				operand[0].arg->bitselect,
+				DISCARDALLOVERLAP);
+				
+			// I manually reassign the register
+			// to operand[0].arg->varpushed since the variable
+			// pointed by operand[0].arg->varpushed is the one
+			// getting modified through the register and
+			// the dirty value of the register should
+			// be flushed to operand[0].arg->varpushed; I have
+			// to do this because the field v of the register
+			// is set to the duplicate of operand[0].arg->varpushed.
+			// Reassigning the register instead of creating
+			// a new register and copying its value is faster.
+			operand[0].reg->v = operand[0].arg->varpushed;
+			operand[0].reg->offset = processvaroffsetifany(&operand[0].reg->v);
+			
+			// Note that the value set in the fields offset
+			// and size of the register could be wrong to where
+			// the register represent a location beyond the boundary
+			// of the variable; and that can only occur if
+			// the programmer confused the compiler by using
+			// incorrect casting type.
+			
+		} else {
+			// I get here if getregforvar() was not used
+			// with the duplicate of the variable pushed.
+			// Since operand[0].arg->v which was used with
+			// getregforvar() was certainly not a volatile
+			// variable(Pushed volatile variables get duplicated),
+			// the registers overlapping the memory region of
+			// the variable associated with the register that
+			// I am going to dirty were only flushed without
+			// getting discarded; so I should discard
+			// those overlapping registers in order to follow
+			// the rule about the use of registers.
+			discardoverlappingreg(
+				operand[0].arg->v,
+				sizeoftype(operand[0].arg->typepushed.ptr, stringmmsz(operand[0].arg->typepushed)),
+				operand[0].arg->bitselect,
+				DISCARDALLOVERLAPEXCEPTREGFORVAR);
+		}
+		
+		// Since I am going to modify the value
+		// of the register operand[0].reg,
+		// I need to set it dirty.
+		operand[0].reg->dirty = 1;
+	}
+	
+	opcode(operand[0].reg, operand[1].reg, operand[2].reg);
+	
+	// If the input-output operand was
+	// a variable(meaning its field arg was set)
+	// and was volatile, I should flush it.
+	if (operand[0].arg && *operand[0].arg->varpushed->alwaysvolatile) flushreg(operand[0].reg);
+	
+	// I unlock the registers that were allocated
+	// and locked for the operands.
+	// Locked registers must be unlocked only after
+	// the instructions using them have been generated;
+	// otherwise they could be lost when insureenoughunusedregisters()
+	// is called while creating a new lyricalinstruction.
+	operand[0].reg->lock = 0;
+	operand[1].reg->lock = 0;
+	operand[2].reg->lock = 0;
+	
+	if (funcarg) freefuncarg();
+}
+
+// Process opcodes for conditional
+// branching where the arguments
+// in order are: input, label.
+void opcodejcondinlabel (lyricalinstruction*(* opcode)(lyricalreg*, string)) {
+	
+	readoperands(1, COMMAENDING);
+	
+	u8* savedcurpos = curpos;
+	
+	// I read the label name to which
+	// I am supposed to jump to.
+	string label = readsymbol(LOWERCASESYMBOL);
+	
+	if (!label.ptr) {
+		reverseskipspace();
+		throwerror("expecting a label name");
+	}
+	
+	if (!compilepass) {
+		// Instructions are not generated in the firstpass.
+		
+		mmrefdown(label.ptr);
+		
+		if (funcarg) freefuncarg();
+		
+		return;
+	}
+	
+	// I process the input operand.
+	
+	if (operand[0].arg) {
+		// I use the type and bitselect with
+		// which the variable was pushed.
+		operand[0].reg = getregforvar(operand[0].arg->v, 0, operand[0].arg->typepushed, operand[0].arg->bitselect, FORINPUT);
+		
+		// I lock the register to prevent
+		// a call of allocreg() from using it.
+		// I also lock it, otherwise it could be lost
+		// when insureenoughunusedregisters() is called
+		// while creating a new lyricalinstruction.
+		operand[0].reg->lock = 1;
+	}
+	
+	// I flush all registers without discarding them
+	// since I am doing a conditional branching.
+	flushanddiscardallreg(DONOTDISCARD);
+	
+	// I set curpos to savedcurpos so that
+	// resolvelabellater(), used by opcode(),
+	// correctly set the field pos of the newly
+	// created lyricallabeledinstructiontoresolve.
+	swapvalues(&curpos, &savedcurpos);
+	
+	opcode(operand[0].reg, label);
+	
+	// Here I restore curpos.
+	swapvalues(&curpos, &savedcurpos);
+	
+	// The string label is duplicated by opcode()
+	// So here I free the string in label
+	// since I will no longer need it.
+	mmrefdown(label.ptr);
+	
+	// I unlock the registers that were allocated
+	// and locked for the operands.
+	// Locked registers must be unlocked only after
+	// the instructions using them have been generated;
+	// otherwise they could be lost when insureenoughunusedregisters()
+	// is called while creating a new lyricalinstruction.
+	operand[0].reg->lock = 0;
+	
+	if (funcarg) freefuncarg();
+}
+
+// Process opcodes for conditional
+// branching where the arguments
+// in order are: input, immediate.
+void opcodejcondinimm (lyricalinstruction*(* opcode)(lyricalreg*, u64)) {
+	
+	readoperands(2, SEMICOLONENDING);
+	
+	if (operand[1].arg) {
+		
+		if (!operand[1].arg->v->isnumber) {
+			
+			curpos = savedcurpos;
+			throwerror("incorrect immediate operand");
+		}
+		
+	} else {
+		
+		curpos = savedcurpos;
+		throwerror("immediate operand expected");
+	}
+	
+	if (!compilepass) {
+		// Instructions are not generated in the firstpass.
+		
+		// There is no need to check whether
 		// there was any pushed argument by checking
 		// if funcarg is null, because funcarg will
 		// always be non-null since I am required
@@ -3363,26 +3726,74 @@ if (stringiseq2(s, "srai2")) {
 	return 0;
 }
 
-if (stringiseq2(s, "zxt")) {
+if (stringiseq2(s, "rol")) {
 	mmrefdown(s.ptr);
-	opcodeoutinimm(zxt);
+	opcodeoutinin(rol);
 	return 0;
 }
 
-if (stringiseq2(s, "sxt")) {
+if (stringiseq2(s, "roli")) {
 	mmrefdown(s.ptr);
-	opcodeoutinimm(sxt);
+	opcodeoutinimm(roli);
 	return 0;
 }
 
-#if 0
-// ###: The following function
-// is no longer needed, but it is
-// kept for documentation reasons.
-// It was used when I considered
-// implementing an instruction that
-// swap the value of two registers.
-if (stringiseq2(s, "swap")) {
+if (stringiseq2(s, "ror")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(ror);
+	return 0;
+}
+
+if (stringiseq2(s, "rori")) {
+	mmrefdown(s.ptr);
+	opcodeoutinimm(rori);
+	return 0;
+}
+
+if (stringiseq2(s, "bswap")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(bswap);
+	return 0;
+}
+
+if (stringiseq2(s, "popcnt")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(popcnt);
+	return 0;
+}
+
+if (stringiseq2(s, "clz")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(clz);
+	return 0;
+}
+
+if (stringiseq2(s, "ctz")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(ctz);
+	return 0;
+}
+
+if (stringiseq2(s, "zxt")) {
+	mmrefdown(s.ptr);
+	opcodeoutinimm(zxt);
+	return 0;
+}
+
+if (stringiseq2(s, "sxt")) {
+	mmrefdown(s.ptr);
+	opcodeoutinimm(sxt);
+	return 0;
+}
+
+#if 0
+// ###: The following function
+// is no longer needed, but it is
+// kept for documentation reasons.
+// It was used when I considered
+// implementing an instruction that
+// swap the value of two registers.
+if (stringiseq2(s, "swap")) {
 	
 	mmrefdown(s.ptr);
 	
@@ -4780,6 +5191,413 @@ if (stringiseq2(s, "ldsti")) {
 	return 0;
 }
 
+if (stringiseq2(s, "cas8")) {
+	mmrefdown(s.ptr);
+	opcodeinoutinin(cas8);
+	return 0;
+}
+
+if (stringiseq2(s, "cas16")) {
+	mmrefdown(s.ptr);
+	opcodeinoutinin(cas16);
+	return 0;
+}
+
+if (stringiseq2(s, "cas32")) {
+	mmrefdown(s.ptr);
+	opcodeinoutinin(cas32);
+	return 0;
+}
+
+if (stringiseq2(s, "cas64")) {
+	mmrefdown(s.ptr);
+	opcodeinoutinin(cas64);
+	return 0;
+}
+
+if (stringiseq2(s, "cas")) {
+	mmrefdown(s.ptr);
+	opcodeinoutinin(cas);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchadd8")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchadd8);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchadd16")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchadd16);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchadd32")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchadd32);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchadd64")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchadd64);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchadd")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchadd);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchsub8")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchsub8);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchsub16")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchsub16);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchsub32")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchsub32);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchsub64")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchsub64);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchsub")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchsub);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchand8")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchand8);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchand16")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchand16);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchand32")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchand32);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchand64")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchand64);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchand")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchand);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchor8")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchor8);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchor16")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchor16);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchor32")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchor32);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchor64")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchor64);
+	return 0;
+}
+
+if (stringiseq2(s, "fetchor")) {
+	mmrefdown(s.ptr);
+	opcodeinoutin(fetchor);
+	return 0;
+}
+
+if (stringiseq2(s, "fence")) {
+	
+	mmrefdown(s.ptr);
+	
+	// Instructions are not generated in the firstpass.
+	if (!compilepass) return 0;
+	
+	// I flush and discard all registers
+	// so that the memory accesses for
+	// variables are ordered by the fence.
+	flushanddiscardallreg(FLUSHANDDISCARDALL);
+	
+	fence();
+	
+	return 0;
+}
+
+if (stringiseq2(s, "vcpy")) {
+	mmrefdown(s.ptr);
+	opcodeinin(vcpy);
+	return 0;
+}
+
+if (stringiseq2(s, "vadd8")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vadd8);
+	return 0;
+}
+
+if (stringiseq2(s, "vadd16")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vadd16);
+	return 0;
+}
+
+if (stringiseq2(s, "vadd32")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vadd32);
+	return 0;
+}
+
+if (stringiseq2(s, "vadd64")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vadd64);
+	return 0;
+}
+
+if (stringiseq2(s, "vsub8")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vsub8);
+	return 0;
+}
+
+if (stringiseq2(s, "vsub16")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vsub16);
+	return 0;
+}
+
+if (stringiseq2(s, "vsub32")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vsub32);
+	return 0;
+}
+
+if (stringiseq2(s, "vsub64")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vsub64);
+	return 0;
+}
+
+if (stringiseq2(s, "vand")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vand);
+	return 0;
+}
+
+if (stringiseq2(s, "vor")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vor);
+	return 0;
+}
+
+if (stringiseq2(s, "vxor")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vxor);
+	return 0;
+}
+
+if (stringiseq2(s, "vcmpeq8")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vcmpeq8);
+	return 0;
+}
+
+if (stringiseq2(s, "vcmpeq16")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vcmpeq16);
+	return 0;
+}
+
+if (stringiseq2(s, "vcmpeq32")) {
+	mmrefdown(s.ptr);
+	opcodeininin(vcmpeq32);
+	return 0;
+}
+
+if (stringiseq2(s, "vmovmsk8")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(vmovmsk8);
+	return 0;
+}
+
+if (stringiseq2(s, "vbcast8")) {
+	mmrefdown(s.ptr);
+	opcodeinin(vbcast8);
+	return 0;
+}
+
+if (stringiseq2(s, "vbcast16")) {
+	mmrefdown(s.ptr);
+	opcodeinin(vbcast16);
+	return 0;
+}
+
+if (stringiseq2(s, "vbcast32")) {
+	mmrefdown(s.ptr);
+	opcodeinin(vbcast32);
+	return 0;
+}
+
+if (stringiseq2(s, "vbcast64")) {
+	mmrefdown(s.ptr);
+	opcodeinin(vbcast64);
+	return 0;
+}
+
+if (stringiseq2(s, "fadd32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fadd32);
+	return 0;
+}
+
+if (stringiseq2(s, "fadd64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fadd64);
+	return 0;
+}
+
+if (stringiseq2(s, "fsub32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fsub32);
+	return 0;
+}
+
+if (stringiseq2(s, "fsub64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fsub64);
+	return 0;
+}
+
+if (stringiseq2(s, "fmul32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fmul32);
+	return 0;
+}
+
+if (stringiseq2(s, "fmul64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fmul64);
+	return 0;
+}
+
+if (stringiseq2(s, "fdiv32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fdiv32);
+	return 0;
+}
+
+if (stringiseq2(s, "fdiv64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(fdiv64);
+	return 0;
+}
+
+if (stringiseq2(s, "feq32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(feq32);
+	return 0;
+}
+
+if (stringiseq2(s, "feq64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(feq64);
+	return 0;
+}
+
+if (stringiseq2(s, "flt32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(flt32);
+	return 0;
+}
+
+if (stringiseq2(s, "flt64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(flt64);
+	return 0;
+}
+
+if (stringiseq2(s, "flte32")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(flte32);
+	return 0;
+}
+
+if (stringiseq2(s, "flte64")) {
+	mmrefdown(s.ptr);
+	opcodeoutinin(flte64);
+	return 0;
+}
+
+if (stringiseq2(s, "itof32")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(itof32);
+	return 0;
+}
+
+if (stringiseq2(s, "itof64")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(itof64);
+	return 0;
+}
+
+if (stringiseq2(s, "f32toi")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(f32toi);
+	return 0;
+}
+
+if (stringiseq2(s, "f64toi")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(f64toi);
+	return 0;
+}
+
+if (stringiseq2(s, "f32tof64")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(f32tof64);
+	return 0;
+}
+
+if (stringiseq2(s, "f64tof32")) {
+	mmrefdown(s.ptr);
+	opcodeoutin(f64tof32);
+	return 0;
+}
+
 #if 0
 // ### Old implementations that did not update
 // operands values unless they were registers.
@@ -119,7 +119,7 @@ enum {POSTFIXOPDOT = 0};
 // of the pattern used to match a type, ei: pointer to function type.
 // Note also that in all pattern string the escaping metachar '\'
 // is itself escaped because the compiler uses it as well for escaping.
-pamsyntokenized nativefcall[14];
+pamsyntokenized nativefcall[20];
 
 // Increment and decrement operators for native types and pointers.
 nativefcall[0] = pamsyntokenize(
@@ -785,6 +785,181 @@ nativefcall[13] = pamsyntokenize(
 	""
 );
 
+// Bit-manipulation builtin functions for native types;
+// they are called using the function call syntax.
+nativefcall[14] = pamsyntokenize(
+	(sizeofgpr == 1) ?
+		"<"
+		"{popcnt,clz,ctz,bswap}"
+		"|"
+			"{s8,u8}"
+		"|"
+		">" :
+	(sizeofgpr == 2) ?
+		"<"
+		"{popcnt,clz,ctz,bswap}"
+		"|"
+			"{s8,s16,u8,u16}"
+		"|"
+		">" :
+	(sizeofgpr == 4) ?
+		"<"
+		"{popcnt,clz,ctz,bswap}"
+		"|"
+			"{s8,s16,s32,u8,u16,u32}"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"{popcnt,clz,ctz,bswap}"
+		"|"
+			"{s8,s16,s32,s64,u8,u16,u32,u64}"
+		"|"
+		">" :
+	""
+);
+
+// Rotation builtin functions for native types;
+// they are called using the function call syntax.
+nativefcall[15] = pamsyntokenize(
+	(sizeofgpr == 1) ?
+		"<"
+		"{rotl,rotr}"
+		"|"
+			"{s8,u8}"
+			"|"
+			"{s8,u8}"
+		"|"
+		">" :
+	(sizeofgpr == 2) ?
+		"<"
+		"{rotl,rotr}"
+		"|"
+			"{s8,s16,u8,u16}"
+			"|"
+			"{s8,s16,u8,u16}"
+		"|"
+		">" :
+	(sizeofgpr == 4) ?
+		"<"
+		"{rotl,rotr}"
+		"|"
+			"{s8,s16,s32,u8,u16,u32}"
+			"|"
+			"{s8,s16,s32,u8,u16,u32}"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"{rotl,rotr}"
+		"|"
+			"{s8,s16,s32,s64,u8,u16,u32,u64}"
+			"|"
+			"{s8,s16,s32,s64,u8,u16,u32,u64}"
+		"|"
+		">" :
+	""
+);
+
+// Arithmetic and comparison operators for
+// floating point types; both arguments must
+// have the same floating point type.
+// The type f64 is only available when
+// a gpr is large enough to hold it.
+nativefcall[16] = pamsyntokenize(
+	(sizeofgpr == 4) ?
+		"<"
+		"{\\+,\\-,\\*,/,\\<,\\<=,\\>,\\>=,==,\\!=}"
+		"|"
+			"f32"
+			"|"
+			"f32"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"{\\+,\\-,\\*,/,\\<,\\<=,\\>,\\>=,==,\\!=}"
+		"|{"
+			"f32"
+			"|"
+			"f32"
+		","
+			"f64"
+			"|"
+			"f64"
+		"}|"
+		">" :
+	""
+);
+
+// Self arithmetic operators for floating point types;
+// both arguments must have the same floating point type.
+nativefcall[17] = pamsyntokenize(
+	(sizeofgpr == 4) ?
+		"<"
+		"{\\+=,\\-=,\\*=,/=}"
+		"|"
+			"f32"
+			"|"
+			"f32"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"{\\+=,\\-=,\\*=,/=}"
+		"|{"
+			"f32"
+			"|"
+			"f32"
+		","
+			"f64"
+			"|"
+			"f64"
+		"}|"
+		">" :
+	""
+);
+
+// Negate operator for floating point types.
+nativefcall[18] = pamsyntokenize(
+	(sizeofgpr == 4) ?
+		"<"
+		"\\-"
+		"|"
+			"f32"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"\\-"
+		"|"
+			"{f32,f64}"
+		"|"
+		">" :
+	""
+);
+
+// Conversion builtin functions between native
+// integer types and floating point types;
+// they are called using the function call syntax.
+nativefcall[19] = pamsyntokenize(
+	(sizeofgpr == 4) ?
+		"<"
+		"{tof32,tosint}"
+		"|"
+			"{s8,s16,s32,u8,u16,u32,f32}"
+		"|"
+		">" :
+	(sizeofgpr == 8) ?
+		"<"
+		"{tof32,tof64,tosint}"
+		"|"
+			"{s8,s16,s32,s64,u8,u16,u32,u64,f32,f64}"
+		"|"
+		">" :
+	""
+);
+
 
 // Pattern used to determine if the declaration of an operator function was correct; The pattern,
 // depending on the operator determine whether the right number of arguments was given.
@@ -887,7 +1062,7 @@ pamsyntokenized isnativetype = pamsyntokenize(
 );
 
 // Pattern used to check if a symbol is a keyword.
-pamsyntokenized iskeyword = pamsyntokenize("<{this,retvar,return,catch,throw,sizeof,offsetof,typeof,switch,case,default,break,continue,while,do,if,else,goto,operator,struct,pstruct,union,enum,static,asm,export,void,{s,u}{8,16,32,64}}>");
+pamsyntokenized iskeyword = pamsyntokenize("<{this,retvar,return,catch,throw,sizeof,offsetof,typeof,switch,case,default,break,continue,while,do,if,else,goto,operator,struct,pstruct,union,enum,static,asm,export,void,{s,u}{8,16,32,64},f{32,64}}>");
 
 // This pattern is used to extract the field offset suffixed to a variable if any.
 pamsyntokenized matchoffsetifvarfield = pamsyntokenize("#{\\.}+[0-9]>");
@@ -919,7 +1094,9 @@ lyricaltype nativetype[] = {
 	{.name = stringduplicate2("u8"), .size = 1, .v = 0, .scopedepth = 0, .scope = 0},
 	{.name = stringduplicate2("u16"), .size = 2, .v = 0, .scopedepth = 0, .scope = 0},
 	{.name = stringduplicate2("u32"), .size = 4, .v = 0, .scopedepth = 0, .scope = 0},
-	{.name = stringduplicate2("u64"), .size = 8, .v = 0, .scopedepth = 0, .scope = 0}
+	{.name = stringduplicate2("u64"), .size = 8, .v = 0, .scopedepth = 0, .scope = 0},
+	{.name = stringduplicate2("f32"), .size = 4, .v = 0, .scopedepth = 0, .scope = 0},
+	{.name = stringduplicate2("f64"), .size = 8, .v = 0, .scopedepth = 0, .scope = 0}
 };
 
 // Enum for which the value is used
@@ -933,7 +1110,9 @@ enum {
 	NATIVETYPEU8,
 	NATIVETYPEU16,
 	NATIVETYPEU32,
-	NATIVETYPEU64
+	NATIVETYPEU64,
+	NATIVETYPEF32,
+	NATIVETYPEF64
 };
 
 string u8ptrstr = stringduplicate2("u8*");
@@ -21,6 +21,10 @@ while (stringiseq4(curpos, "#+e", 3) || stringiseq4(curpos, "#-e", 3)) {
 	isexportinferred = (curpos[1] == '+');
 	curpos += 3;
 	skipspace();
+	// The source end with the character
+	// sequence stopping export inference
+	// when it only include modules.
+	if (!*curpos) goto startofprocessing;
 }
 
 if (*curpos == '{') {
@@ -222,8 +226,88 @@ if (checkforkeyword("return")) {
 			
 			savedcurpos = curpos;
 			
+			// Tail calls are generated only in the secondpass.
+			if (compilepass &&
+				!(compileargcompileflag&LYRICALCOMPILENOTAILCALL) &&
+				currentfunc->tailcallentry &&
+				!currentfunc->firstpass->localaddrisobtained) {
+				// I check whether the expression is only made
+				// of a call to currentfunc, in which case
+				// tailcallpos is set to the location of
+				// the opening paranthesis of the call.
+				// generatefunctioncall() will then re-use
+				// the stackframe of currentfunc if the call
+				// is found to be a call to currentfunc.
+				
+				string s = readsymbol(LOWERCASESYMBOL);
+				
+				if (s.ptr) {
+					
+					if (*curpos == '(' && stringiseq1(s, currentfunc->name)) {
+						
+						u8* c = curpos;
+						
+						uint paranthesiscount = 0;
+						
+						// I search the closing paranthesis
+						// of the call, skipping constant
+						// strings and characters.
+						while (1) {
+							
+							u8 cc = *c;
+							
+							if (cc == '(') ++paranthesiscount;
+							else if (cc == ')') {
+								if (!--paranthesiscount) break;
+							} else if (cc == '"' || cc == '\'') {
+								
+								while (*++c != cc) {
+									if (!*c) break;
+									else if (*c == '\\' && c[1]) ++c;
+								}
+								
+								if (!*c) break;
+								
+							} else if (!cc || cc == ';' || cc == '{' || cc == '}') break;
+							
+							++c;
+						}
+						
+						if (*c == ')') {
+							
+							u8* savedcurpos2 = curpos;
+							
+							curpos = c+1;
+							skipspace();
+							
+							if (*curpos == ';' || *curpos == '}') tailcallpos = savedcurpos2;
+						}
+					}
+					
+					mmrefdown(s.ptr);
+				}
+				
+				curpos = savedcurpos;
+			}
+			
+			u8* savedtailcallpos = tailcallpos;
+			
 			v = evaluateexpression(LOWESTPRECEDENCE);
 			
+			// If tailcallpos was set and it has been reset
+			// to null by generatefunctioncall(), a call to
+			// currentfunc re-using its stackframe was generated;
+			// the instructions returning from currentfunc are not
+			// needed since the call will never return here.
+			if (savedtailcallpos && !tailcallpos) {
+				
+				varfreetempvarrelated(v);
+				
+				goto returnstatementdone;
+			}
+			
+			tailcallpos = 0;
+			
 			if (*curpos == ',') {
 				
 				if (v && v != EXPRWITHNORETVAL) {
@@ -379,6 +463,8 @@ if (checkforkeyword("return")) {
 		}
 	}
 	
+	returnstatementdone:
+	
 	// Note that because flushanddiscardallreg() was called with
 	// its argument flag set to DONOTFLUSHREGFORLOCALSKEEPREGFORRETURNADDR,
 	// any following expression that use the variables or stackframes
@@ -2025,55 +2111,165 @@ if (checkforkeyword("switch")) {
 			// when generating lyricalinstruction.
 			r1->lock = 1;
 			
-			uint currentswitchblocklowestcasevalue;
-			// Retrieve lowest switch() case value.
-			uint bintreescanupcallback (uint value, void** data) {
-				currentswitchblocklowestcasevalue = value;
-				return 0;
-			}
-			bintreescanup(currentswitchblock->btree, bintreescanupcallback);
-			
-			if (currentswitchblocklowestcasevalue) {
-				li(r1, currentswitchblocklowestcasevalue);
-				sub(r, r, r1); // Substract lowest case value to ease comparison.
+			// Retrieve the number of switch() cases.
+			uint casecount = 0;
+			uint bintreescanupcountcallback (uint value, void** data) {
+				++casecount;
+				return 1;
 			}
+			bintreescanup(currentswitchblock->btree, bintreescanupcountcallback);
 			
-			uint currentswitchblockhighestcasevalue;
-			// Retrieve highest switch() case value.
-			uint bintreescandowncallback (uint value, void** data) {
-				currentswitchblockhighestcasevalue = value;
-				return 0;
+			// Retrieve the switch() case values and labels
+			// sorted from the lowest to the highest value.
+			uint* casevalues = mmalloc(casecount*sizeof(uint));
+			u8** caselabels = mmalloc(casecount*sizeof(u8*));
+			uint n = 0;
+			uint bintreescanupcallback (uint value, void** data) {
+				casevalues[n] = value;
+				caselabels[n] = *data;
+				++n;
+				return 1;
 			}
-			bintreescandown(currentswitchblock->btree, bintreescandowncallback);
+			bintreescanup(currentswitchblock->btree, bintreescanupcallback);
 			
-			li(r1, currentswitchblockhighestcasevalue-currentswitchblocklowestcasevalue);
+			// Group the sorted switch() cases in clusters.
+			// Consecutive switch() cases are added to
+			// a cluster for as long as the range of values
+			// that it cover remain dense enough; a cluster
+			// is kept only if it is large enough to be worth
+			// a jumptable, otherwise its first switch() case
+			// become a cluster of its own.
+			// Since cases are sorted, the substraction
+			// of case values cannot wrap around.
+			switchcluster* clusters = mmalloc(casecount*sizeof(switchcluster));
+			uint clustercount = 0;
+			n = 0;
+			do {
+				uint last = n;
+				
+				while ((last+1) < casecount &&
+					(casevalues[last+1] - casevalues[n]) <
+						((last+2-n)*SWITCHJUMPTABLEMAXSPARSENESS))
+					++last;
+				
+				if ((last-n+1) < SWITCHJUMPTABLEMINCASECOUNT) last = n;
+				
+				clusters[clustercount].first = n;
+				clusters[clustercount].last = last;
+				++clustercount;
+				
+				n = last+1;
+				
+			} while (n < casecount);
 			
 			// Jump to the switch() default if it exist,
 			// otherwise jump to the end of the switch().
-			if (defaultsc.ptr) jltu(r1, r, defaultsc);
-			else jltu(r1, r, labelnameforendofloop);
-			
-			string labelnameforjumpcasearray = stringfmt("%d", newgenericlabelid());
-			
-			afip(r1, labelnameforjumpcasearray); // Get the address of the jumpcase array.
-			
-			uint jumpcaseclog2sz = compilearg->jumpcaseclog2sz;
+			string labelnamefornocase = defaultsc.ptr ? defaultsc : labelnameforendofloop;
+			
+			// This function generate the jumptable for
+			// the cluster given as argument.
+			// The value of the register pointed by r
+			// get modified, hence the jumptable must
+			// be the last test in its execution path,
+			// which is always the case since it
+			// end with an indirect jump.
+			void generatejumptable (switchcluster* c) {
+				
+				uint lowestcasevalue = casevalues[c->first];
+				
+				if (lowestcasevalue) {
+					li(r1, lowestcasevalue);
+					sub(r, r, r1); // Substract lowest case value to ease comparison.
+				}
+				
+				li(r1, casevalues[c->last]-lowestcasevalue);
+				
+				jltu(r1, r, labelnamefornocase);
+				
+				string labelnameforjumpcasearray = stringfmt("%d", newgenericlabelid());
+				
+				afip(r1, labelnameforjumpcasearray); // Get the address of the jumpcase array.
+				
+				uint jumpcaseclog2sz = compilearg->jumpcaseclog2sz;
+				
+				slli(r, r, jumpcaseclog2sz); // Compute offset within the jumpcase array.
+				add(r1, r1, r); // Compute the address to jump to within the jumpcase array.
+				jr(r1);
+				
+				// Create the label which mark
+				// the start of the jumpcase array.
+				newlabel(labelnameforjumpcasearray);
+				
+				// Generate the jumpcase array.
+				uint jumpcasebinsz = (1<<jumpcaseclog2sz);
+				uint m = c->first;
+				uint casevalue = lowestcasevalue;
+				do {
+					if (casevalues[m] == casevalue) {
+						j((string){.ptr = caselabels[m]})->binsz = jumpcasebinsz;
+						++m;
+					} else j(labelnamefornocase)->binsz = jumpcasebinsz;
+					
+					++casevalue;
+					
+				} while (m <= c->last);
+			}
 			
-			slli(r, r, jumpcaseclog2sz); // Compute offset within the jumpcase array.
-			add(r1, r1, r); // Compute the address to jump to within the jumpcase array.
-			jr(r1);
+			// This function generate the tests
+			// for the clusters from the index first
+			// to the index last; the clusters are
+			// tested one after the other when there
+			// are few of them and they are all single
+			// switch() cases, otherwise a binary search
+			// is generated on their lowest case value.
+			void generatesearch (uint first, uint last) {
+				
+				if (first == last && clusters[first].first != clusters[first].last) {
+					generatejumptable(&clusters[first]);
+					return;
+				}
+				
+				if ((last-first+1) <= SWITCHLINEARSEARCHMAXCASECOUNT) {
+					
+					uint m = first;
+					
+					while (m <= last && clusters[m].first == clusters[m].last) ++m;
+					
+					if (m > last) {
+						
+						m = first;
+						
+						do {
+							uint c = clusters[m].first;
+							li(r1, casevalues[c]);
+							jeq(r, r1, (string){.ptr = caselabels[c]});
+						} while (++m <= last);
+						
+						j(labelnamefornocase);
+						
+						return;
+					}
+				}
+				
+				uint middle = first + ((last-first+1)/2);
+				
+				string labelnameforlowerhalf = stringfmt("%d", newgenericlabelid());
+				
+				li(r1, casevalues[clusters[middle].first]);
+				jltu(r, r1, labelnameforlowerhalf);
+				
+				generatesearch(middle, last);
+				
+				newlabel(labelnameforlowerhalf);
+				
+				generatesearch(first, middle-1);
+			}
 			
-			// Create the label which mark
-			// the start of the jumpcase array.
-			newlabel(labelnameforjumpcasearray);
+			generatesearch(0, clustercount-1);
 			
-			// Generate the jumpcase array.
-			uint jumpcasebinsz = (1<<jumpcaseclog2sz);
-			uint n = currentswitchblocklowestcasevalue;
-			do {
-				string sc = {.ptr = bintreefind(currentswitchblock->btree, n)};
-				j(sc.ptr ? sc : labelnameforendofloop)->binsz = jumpcasebinsz;
-			} while (++n <= currentswitchblockhighestcasevalue);
+			mmfree(clusters);
+			mmfree(caselabels);
+			mmfree(casevalues);
 			
 			// Destroy currentswitchblock->btree .
 			bintreeempty(&currentswitchblock->btree);
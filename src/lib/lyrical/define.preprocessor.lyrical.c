@@ -67,6 +67,11 @@ m = mmalloc(sizeof(macro));
 // within the current file and its includes.
 m->islocal = (*savedcurpos2 == 'l');
 
+// A macro locally defined is freed
+// at the end of the file in which
+// it was defined.
+if (!m->islocal) ++preprocessorsideeffectcount;
+
 m->chunklocationtsetwhenused = 0;
 
 m->name = s;
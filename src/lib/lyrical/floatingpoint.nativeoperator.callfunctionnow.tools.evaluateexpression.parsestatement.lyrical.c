@@ -0,0 +1,230 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+// The operators + - * / on floating point
+// types produce a result variable having the
+// type of their first argument, while the
+// operators < <= > >= == != produce a result
+// variable having the type uint, and are false
+// when any of their arguments is a NaN, except
+// for != which is then true.
+// The bits of a floating point value are held
+// in the least significant bits of a gpr.
+
+// I set the bitsize of the floating
+// point type of the arguments.
+argbitsize = 8*sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+
+// I set the type of the result variable.
+builtinresulttype = (*name == '+' || *name == '-' || *name == '*' || *name == '/') ?
+	funcarg->typepushed : largeenoughunsignednativetype(sizeofgpr);
+	
+	
+// If the first and second arguments are numbers,
+// the return variable should be a number, which
+// I compute using the floating point
+// arithmetic of the host.
+if (funcarg->v->isnumber && funcarg->next->v->isnumber) {
+	
+	imm1 = funcarg->v->numbervalue;
+	imm2 = funcarg->next->v->numbervalue;
+	
+	if (argbitsize == 64) {
+		
+		double d1 = bitstof64(imm1);
+		double d2 = bitstof64(imm2);
+		
+		switch (*name) {
+			case '+': immresult = f64tobits(d1 + d2); break;
+			case '-': immresult = f64tobits(d1 - d2); break;
+			case '*': immresult = f64tobits(d1 * d2); break;
+			case '/': immresult = f64tobits(d1 / d2); break;
+			case '=': immresult = (d1 == d2); break;
+			case '!': immresult = (d1 != d2); break;
+			case '<': immresult = (name[1] == '=') ? (d1 <= d2) : (d1 < d2); break;
+			default: immresult = (name[1] == '=') ? (d1 >= d2) : (d1 > d2); break;
+		}
+		
+	} else {
+		
+		float f1 = bitstof32(imm1);
+		float f2 = bitstof32(imm2);
+		
+		switch (*name) {
+			case '+': immresult = f32tobits(f1 + f2); break;
+			case '-': immresult = f32tobits(f1 - f2); break;
+			case '*': immresult = f32tobits(f1 * f2); break;
+			case '/': immresult = f32tobits(f1 / f2); break;
+			case '=': immresult = (f1 == f2); break;
+			case '!': immresult = (f1 != f2); break;
+			case '<': immresult = (name[1] == '=') ? (f1 <= f2) : (f1 < f2); break;
+			default: immresult = (name[1] == '=') ? (f1 >= f2) : (f1 > f2); break;
+		}
+	}
+	
+	// Note that getvarnumber() will duplicate
+	// the string pointed by builtinresulttype.ptr
+	// before using it, so I don't need to
+	// give it a duplicated string.
+	resultvar = getvarnumber(immresult, builtinresulttype);
+	
+	break;
+}
+
+
+// Instructions are not generated in the firstpass.
+// So here, only the result variable is created.
+if (!compilepass) {
+	// I create the result variable.
+	resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+	
+	resultvar->name = generatetempvarname(resultvar);
+	
+	// Set the type of the result variable.
+	resultvar->type = stringduplicate1(builtinresulttype);
+	
+	break;
+}
+
+
+// There is no floating point immediate
+// value in the target instructions, so
+// an argument which is a number is
+// loaded in a register as well.
+
+// I use the type and bitselect with
+// which the variable was pushed.
+r1 = getregforvar(funcarg->v, 0, funcarg->typepushed, funcarg->bitselect, FORINPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+r1->lock = 1;
+
+// I use the type and bitselect with
+// which the variable was pushed.
+r2 = getregforvar(funcarg->next->v, 0, funcarg->next->typepushed, funcarg->next->bitselect, FORINPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+r2->lock = 1;
+
+
+// I compute the result value.
+
+// I create the result variable.
+resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+
+resultvar->name = generatetempvarname(resultvar);
+
+// Set the type of the result variable.
+resultvar->type = stringduplicate1(builtinresulttype);
+
+// The register obtained will be appropriately
+// set dirty and setregtothebottom() will
+// be called on it before getregforvar() return.
+rresult = getregforvar(resultvar, 0, resultvar->type, 0, FOROUTPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+rresult->lock = 1;
+
+// The operators > and >= are generated
+// as the operators < and <= with
+// their arguments swapped, and the operator !=
+// is generated as the negation of the operator ==.
+switch (*name) {
+	
+	case '+':
+		
+		if (argbitsize == 64) fadd64(rresult, r1, r2);
+		else fadd32(rresult, r1, r2);
+		
+		break;
+		
+	case '-':
+		
+		if (argbitsize == 64) fsub64(rresult, r1, r2);
+		else fsub32(rresult, r1, r2);
+		
+		break;
+		
+	case '*':
+		
+		if (argbitsize == 64) fmul64(rresult, r1, r2);
+		else fmul32(rresult, r1, r2);
+		
+		break;
+		
+	case '/':
+		
+		if (argbitsize == 64) fdiv64(rresult, r1, r2);
+		else fdiv32(rresult, r1, r2);
+		
+		break;
+		
+	case '=':
+	case '!':
+		
+		if (argbitsize == 64) feq64(rresult, r1, r2);
+		else feq32(rresult, r1, r2);
+		
+		if (*name == '!') xori(rresult, rresult, 1);
+		
+		break;
+		
+	case '<':
+		
+		if (name[1] == '=') {
+			
+			if (argbitsize == 64) flte64(rresult, r1, r2);
+			else flte32(rresult, r1, r2);
+			
+		} else {
+			
+			if (argbitsize == 64) flt64(rresult, r1, r2);
+			else flt32(rresult, r1, r2);
+		}
+		
+		break;
+		
+	default:
+		
+		if (name[1] == '=') {
+			
+			if (argbitsize == 64) flte64(rresult, r2, r1);
+			else flte32(rresult, r2, r1);
+			
+		} else {
+			
+			if (argbitsize == 64) flt64(rresult, r2, r1);
+			else flt32(rresult, r2, r1);
+		}
+		
+		break;
+}
+
+
+// I unlock the registers that were allocated
+// and locked for the operands.
+// Locked registers must be unlocked only after
+// the instructions using them have been generated;
+// otherwise they could be lost when insureenoughunusedregisters()
+// is called while creating a new lyricalinstruction.
+r1->lock = 0;
+r2->lock = 0;
+rresult->lock = 0;
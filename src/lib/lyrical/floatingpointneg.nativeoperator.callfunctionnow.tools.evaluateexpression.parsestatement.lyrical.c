@@ -0,0 +1,98 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+// The operator - on a floating point type
+// flip the sign bit of its argument; its
+// result variable has the same type
+// as its argument.
+
+// I set the bitsize of the floating
+// point type of the argument.
+argbitsize = 8*sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+
+
+// If the only argument is a number,
+// the return variable should be a number.
+if (funcarg->v->isnumber) {
+	
+	immresult = (funcarg->v->numbervalue ^ ((u64)1<<(argbitsize-1)));
+	
+	// Note that getvarnumber() will duplicate
+	// the string pointed by funcarg->typepushed.ptr
+	// before using it, so I don't need to
+	// give it a duplicated string.
+	resultvar = getvarnumber(immresult, funcarg->typepushed);
+	
+	break;
+}
+
+
+// Instructions are not generated in the firstpass.
+// So here, only the result variable is created.
+if (!compilepass) {
+	// I create the result variable.
+	resultvar = varalloc(sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed)), LOOKFORAHOLE);
+	
+	resultvar->name = generatetempvarname(resultvar);
+	
+	// Set the type of the result variable.
+	resultvar->type = stringduplicate1(funcarg->typepushed);
+	
+	break;
+}
+
+
+// I use the type and bitselect with
+// which the variable was pushed.
+r1 = getregforvar(funcarg->v, 0, funcarg->typepushed, funcarg->bitselect, FORINPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+r1->lock = 1;
+
+
+// I compute the result value.
+
+// I create the result variable.
+resultvar = varalloc(sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed)), LOOKFORAHOLE);
+
+resultvar->name = generatetempvarname(resultvar);
+
+// Set the type of the result variable.
+resultvar->type = stringduplicate1(funcarg->typepushed);
+
+// The register obtained will be appropriately
+// set dirty and setregtothebottom() will
+// be called on it before getregforvar() return.
+rresult = getregforvar(resultvar, 0, resultvar->type, 0, FOROUTPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+rresult->lock = 1;
+
+xori(rresult, r1, ((u64)1<<(argbitsize-1)));
+
+
+// I unlock the registers that were allocated
+// and locked for the operands.
+// Locked registers must be unlocked only after
+// the instructions using them have been generated;
+// otherwise they could be lost when insureenoughunusedregisters()
+// is called while creating a new lyricalinstruction.
+r1->lock = 0;
+rresult->lock = 0;
@@ -137,6 +137,8 @@ uint loopparameterssz = arrayuintsz(loopparameters);
 
 uint i = 0;
 
+++foreachblockdepth;
+
 while (1) {
 	
 	m->chunks->content.ptr = (u8*)loopparameters.ptr[i];
@@ -162,6 +164,8 @@ while (1) {
 	else break;
 }
 
+--foreachblockdepth;
+
 // I throw an error,
 // if the for-loop macro
 // did not get used.
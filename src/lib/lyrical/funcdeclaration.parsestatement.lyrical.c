@@ -922,6 +922,27 @@ void funcdeclaration (string type, string name, funcdeclarationflag flag) {
 			// defined, since its declaration is outside
 			// the scope where it is being defined.
 			
+			// A function defined within the scope
+			// nesting the content of a module .lyc file,
+			// and declared within the root function
+			// outside of any scope, is a function
+			// declared by the module .lyh file; it is
+			// exported, unless runtime exporting
+			// is disabled, so that the module
+			// can be used as a library.
+			if (isexportinferred && currentfunc == rootfunc && !f->scopedepth &&
+				!(compileargcompileflag&LYRICALCOMPILENOFUNCTIONEXPORT)) {
+				
+				if (compilepass) f->toexport = 1;
+				else {
+					// Functions to export must be treated as
+					// function for which the address is obtained.
+					f->itspointerisobtained = 1;
+					
+					++f->wasused;
+				}
+			}
+			
 			savedfscopedepth = f->scopedepth;
 			savedfscope = f->scope;
 			
@@ -1051,6 +1072,15 @@ void funcdeclaration (string type, string name, funcdeclarationflag flag) {
 			lyricalinstruction* i = newinstruction(f, LYRICALOPCOMMENT);
 			i->comment = stringduplicate2("end: done");
 		}
+		
+		// Only a recursive function can call itself
+		// from a return statement; the LYRICALOPNOP
+		// generated here is where such call re-using
+		// the stackframe of the function jump-to.
+		// It is generated before the caching of
+		// stackframe pointers, since the registers
+		// holding them would be discarded by the call.
+		if (f->firstpass->isrecursive) f->tailcallentry = newinstruction(f, LYRICALOPNOP);
 	}
 	
 	++curpos; // Set curpos after '{' .
@@ -0,0 +1,280 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+
+// This file is included within lyricalcompile()
+// once immediate values have been reviewed, hence
+// immediate values of type LYRICALIMMOFFSETTOINSTRUCTION
+// point to the first lyricalinstruction of a block.
+
+// A condition is evaluated into a register
+// which is then tested by a LYRICALOPJZ or
+// LYRICALOPJNZ; when the condition is
+// a comparison, the backend would generate
+// an instruction setting the register to 0 or 1,
+// followed by an instruction testing the register,
+// followed by the branching instruction.
+// When the register set by a LYRICALOPSEQ,
+// LYRICALOPSNE, LYRICALOPSLT, LYRICALOPSLTE,
+// LYRICALOPSLTU, LYRICALOPSLTEU, LYRICALOPSZ
+// or LYRICALOPSNZ is only used by the LYRICALOPJZ
+// or LYRICALOPJNZ that follow it, the comparison
+// is removed and the branching instruction
+// is replaced by the branching instruction
+// which compare the same registers, so that
+// a backend can generate a single compare
+// followed by a conditional branch.
+// Only stores to memory, which do not modify
+// any register, are allowed between the comparison
+// and the branching instruction, as it is the case
+// when registers are flushed before a branch.
+
+// This function return 1 if the value
+// of the register id is not used from
+// the lyricalinstruction pointed by i,
+// otherwise 0; it is the case when the register
+// is in the array of unused registers of that
+// lyricalinstruction, or when that lyricalinstruction
+// set the register without reading it.
+uint isregdead (lyricalinstruction* i, uint id) {
+	
+	while (i->op == LYRICALOPCOMMENT) {
+		
+		if ((i = i->next) == f->i) return 0;
+	}
+	
+	uint* u = i->unusedregs;
+	
+	if (u) {
+		while (*u) {
+			
+			if (*u == id) return 1;
+			
+			++u;
+		}
+	}
+	
+	lyricalop op = i->op;
+	
+	// The lyricalop from LYRICALOPADD to LYRICALOPSNZ,
+	// from LYRICALOPAFIP to LYRICALOPLD64I,
+	// and from LYRICALOPFADD32 to LYRICALOPF64TOF32,
+	// only set r1.
+	if (((op >= LYRICALOPADD && op <= LYRICALOPSNZ) ||
+		(op >= LYRICALOPAFIP && op <= LYRICALOPLD64I) ||
+		(op >= LYRICALOPFADD32 && op <= LYRICALOPF64TOF32)) &&
+		i->r1 == id && i->r2 != id && i->r3 != id)
+		return 1;
+		
+	return 0;
+}
+
+// This function remove the register id from
+// the array of unused registers of the
+// lyricalinstruction pointed by i.
+void removeregfromunused (lyricalinstruction* i, uint id) {
+	
+	uint* u = i->unusedregs;
+	
+	if (!u) return;
+	
+	while (*u && *u != id) ++u;
+	
+	if (!*u) return;
+	
+	do u[0] = u[1]; while (*++u);
+}
+
+do {
+	// Note that f->i is always non-null,
+	// so there is no need to check it.
+	
+	lyricalinstruction* i = f->i;
+	
+	do {
+		lyricalop op = i->op;
+		
+		if (!(op == LYRICALOPSEQ || op == LYRICALOPSNE ||
+			op == LYRICALOPSLT || op == LYRICALOPSLTE ||
+			op == LYRICALOPSLTU || op == LYRICALOPSLTEU ||
+			op == LYRICALOPSZ || op == LYRICALOPSNZ))
+			continue;
+			
+		// The comparison must not be the first
+		// lyricalinstruction of a block, otherwise
+		// it could be the target of a branching
+		// instruction and could not be removed.
+		lyricalinstruction* ii = i->prev;
+		
+		while (ii->op == LYRICALOPCOMMENT && ii != f->i) ii = ii->prev;
+		
+		if (i == f->i || ii->op == LYRICALOPNOP) continue;
+		
+		uint r = i->r1;
+		
+		// I look for the branching instruction
+		// testing the register set by the comparison.
+		lyricalinstruction* j = i->next;
+		
+		while (j != f->i) {
+			
+			if (j->op == LYRICALOPCOMMENT) {
+				
+				j = j->next;
+				
+				continue;
+			}
+			
+			if (j->op >= LYRICALOPST8 && j->op <= LYRICALOPST64I &&
+				j->r1 != r && j->r2 != r && j->r3 != r) {
+				
+				j = j->next;
+				
+				continue;
+			}
+			
+			break;
+		}
+		
+		if (j == f->i || (j->op != LYRICALOPJZ && j->op != LYRICALOPJNZ) || j->r1 != r ||
+			j->imm->type != LYRICALIMMOFFSETTOINSTRUCTION || j->imm->next)
+			continue;
+			
+		// The register set by the comparison must
+		// be unused after the branching instruction,
+		// whether or not the branch is taken.
+		if (j->next == f->i || !isregdead(j->next, r) || !isregdead(j->imm->i, r)) continue;
+		
+		uint branchifzero = (j->op == LYRICALOPJZ);
+		
+		uint r2 = i->r2;
+		uint r3 = i->r3;
+		
+		switch (op) {
+			
+			case LYRICALOPSEQ:
+				
+				j->op = branchifzero ? LYRICALOPJNE : LYRICALOPJEQ;
+				
+				j->r1 = r2; j->r2 = r3;
+				
+				break;
+				
+			case LYRICALOPSNE:
+				
+				j->op = branchifzero ? LYRICALOPJEQ : LYRICALOPJNE;
+				
+				j->r1 = r2; j->r2 = r3;
+				
+				break;
+				
+			case LYRICALOPSLT:
+				
+				// !(r2 < r3) is (r3 <= r2).
+				if (branchifzero) {
+					j->op = LYRICALOPJLTE;
+					j->r1 = r3; j->r2 = r2;
+				} else {
+					j->op = LYRICALOPJLT;
+					j->r1 = r2; j->r2 = r3;
+				}
+				
+				break;
+				
+			case LYRICALOPSLTE:
+				
+				// !(r2 <= r3) is (r3 < r2).
+				if (branchifzero) {
+					j->op = LYRICALOPJLT;
+					j->r1 = r3; j->r2 = r2;
+				} else {
+					j->op = LYRICALOPJLTE;
+					j->r1 = r2; j->r2 = r3;
+				}
+				
+				break;
+				
+			case LYRICALOPSLTU:
+				
+				if (branchifzero) {
+					j->op = LYRICALOPJLTEU;
+					j->r1 = r3; j->r2 = r2;
+				} else {
+					j->op = LYRICALOPJLTU;
+					j->r1 = r2; j->r2 = r3;
+				}
+				
+				break;
+				
+			case LYRICALOPSLTEU:
+				
+				if (branchifzero) {
+					j->op = LYRICALOPJLTU;
+					j->r1 = r3; j->r2 = r2;
+				} else {
+					j->op = LYRICALOPJLTEU;
+					j->r1 = r2; j->r2 = r3;
+				}
+				
+				break;
+				
+			case LYRICALOPSZ:
+				
+				j->op = branchifzero ? LYRICALOPJNZ : LYRICALOPJZ;
+				
+				j->r1 = r2;
+				
+				break;
+				
+			case LYRICALOPSNZ:
+				
+				j->r1 = r2;
+				
+				break;
+				
+			default: break;
+		}
+		
+		// The registers read by the comparison
+		// are now read by the branching instruction,
+		// so they must not be in its array of unused
+		// registers, otherwise the backend could use
+		// them as scratch before they are read.
+		removeregfromunused(j, r2);
+		
+		if (op != LYRICALOPSZ && op != LYRICALOPSNZ) removeregfromunused(j, r3);
+		
+		// I detach the comparison from
+		// its linkedlist and free it;
+		// it is sure not to be f->i .
+		
+		ii = i;
+		
+		i = i->prev;
+		
+		LINKEDLISTCIRCULARREMOVE_(prev, next, ii);
+		
+		if (ii->unusedregs) mmrefdown(ii->unusedregs);
+		
+		if (ii->dbginfo.filepath.ptr) mmrefdown(ii->dbginfo.filepath.ptr);
+		
+		mmrefdown(ii);
+		
+	} while ((i = i->next) != f->i);
+	
+} while ((f = f->next) != rootfunc);
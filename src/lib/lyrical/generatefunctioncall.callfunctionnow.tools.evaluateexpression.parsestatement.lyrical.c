@@ -234,9 +234,91 @@ void generatefunctioncall () {
 	
 	uint stackframeoffset;
 	
+	// This variable is set to 1 when the call is made from
+	// a return statement within currentfunc and is a call
+	// to currentfunc; the stackframe of currentfunc is then
+	// re-used instead of creating a new stackframe, and
+	// the call become a jump to the instruction pointed
+	// by currentfunc->tailcallentry.
+	// Variadic functions, functions that use the keyword "this",
+	// or calls having byref arguments, pending postfix
+	// operations or reserved registers to restore
+	// after the call, still create a new stackframe.
+	uint istailcall = (tailcallpos == curpos && !varptrtofunc &&
+		sfr.f == currentfunc && !sfr.f->isvariadic &&
+		!sfr.f->firstpass->usethisvar &&
+		!linkedlistofpostfixoperatorcall && !arrayofreservedgpr.ptr);
+		
+	// Tempvar to which the arguments of the call
+	// are written when re-using the stackframe
+	// of currentfunc; the arguments are then copied
+	// over the arguments of currentfunc, since computing
+	// an argument may require the value of an argument
+	// of currentfunc that would have been overwritten.
+	lyricalvariable* tailcallargs = 0;
+	
+	if (istailcall && funcarg) {
+		// Size of the arguments to write.
+		uint tailcallargssize = 0;
+		
+		lyricalargument* arg = funcarg;
+		
+		do {
+			if (arg->flag->istobepassedbyref) {
+				istailcall = 0;
+				break;
+			}
+			
+			// The size of each argument is computed
+			// the same way it is done when writting
+			// the arguments in the stack below.
+			
+			uint argvarsize = sizeoftype(arg->typepushed.ptr, stringmmsz(arg->typepushed));
+			
+			if (arg->v->type.ptr && arg->v->size < argvarsize) argvarsize = arg->v->size;
+			
+			tailcallargssize = ROUNDUPTOPOWEROFTWO(tailcallargssize + argvarsize, sizeofgpr);
+			
+		} while ((arg = arg->next) != funcarg);
+		
+		if (istailcall) {
+			
+			tailcallargs = varalloc(tailcallargssize, LOOKFORAHOLE);
+			tailcallargs->name = generatetempvarname(tailcallargs);
+		}
+	}
+	
+	if (istailcall) {
+		
+		if (compileargcompileflag&LYRICALCOMPILECOMMENT) {
+			comment(stringduplicate2("begin: re-using the stackframe of the function"));
+		}
+		
+		if (tailcallargs) {
+			// I allocate and lock a register that will
+			// be used to hold the address where arguments
+			// will be written; its value is set so that
+			// the arguments are written to the tempvar
+			// pointed by tailcallargs when using
+			// the offsets of a regular stackframe.
+			(r1 = allocreg(CRITICALREG))->lock = 1;
+			
+			r1->size = sizeofgpr;
+			
+			// Note that generateloadinstr() only work with variables
+			// which reside in the stack or global variable region.
+			// Since the tempvar pointed by tailcallargs reside there,
+			// I am perfectly fine to use generateloadinstr().
+			generateloadinstr(r1, tailcallargs, 0, 0, LOADADDR);
+			
+			addi(r1, r1, -(5*sizeofgpr));
+		}
+		
+		stackframeoffset = 5*sizeofgpr;
+		
 	// I check whether I am calling a function
 	// which use a stackframe holder.
-	if (varptrtofunc || !sfr.f->firstpass->stackframeholder) {
+	} else if (varptrtofunc || !sfr.f->firstpass->stackframeholder) {
 		// I allocate and lock a register that will
 		// be used to hold the address where the stackframe
 		// of the function to call is located and where
@@ -1056,6 +1138,111 @@ void generatefunctioncall () {
 		}
 	}
 	
+	if (istailcall) {
+		// Since I am going to do a branching,
+		// I flush and discard all registers.
+		flushanddiscardallreg(FLUSHANDDISCARDALL);
+		
+		if (tailcallargs) {
+			// I copy the arguments written to
+			// the tempvar pointed by tailcallargs
+			// over the arguments of currentfunc.
+			
+			// Since the register is not assigned
+			// to anything, I lock it, otherwise
+			// it will be seen as an unused register
+			// when generating the lyricalinstruction
+			// for memcpy.
+			(r2 = allocreg(CRITICALREG))->lock = 1;
+			
+			// I create the instruction:
+			// addi r2, %0, sizeofgpr + stackframepointerscachesize + sharedregionsize + vlocalmaxsize + 6*sizeofgpr;
+			// It will set r2 to the location within the stackframe
+			// of currentfunc where its first argument is located;
+			// 6*sizeofgpr account for the return address,
+			// the address of the previous function stackframe,
+			// the address of the parent function stackframe,
+			// the stackframe-id, the "this" pointer
+			// and the address of the return variable.
+			
+			lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPADDI);
+			i->r1 = r2->id;
+			i->r2 = 0;
+			
+			lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
+			imm->type = LYRICALIMMVALUE;
+			imm->n = 7*sizeofgpr;
+			
+			i->imm = imm;
+			
+			imm = mmallocz(sizeof(lyricalimmval));
+			imm->type = LYRICALIMMSTACKFRAMEPOINTERSCACHESIZE;
+			imm->f = currentfunc;
+			
+			i->imm->next = imm;
+			
+			imm = mmallocz(sizeof(lyricalimmval));
+			imm->type = LYRICALIMMSHAREDREGIONSIZE;
+			imm->f = currentfunc;
+			
+			i->imm->next->next = imm;
+			
+			imm = mmallocz(sizeof(lyricalimmval));
+			imm->type = LYRICALIMMLOCALVARSSIZE;
+			imm->f = currentfunc;
+			
+			i->imm->next->next->next = imm;
+			
+			addi(r1, r1, 5*sizeofgpr);
+			
+			// Note that the source and destination memory region
+			// of the copy will never overlap, since the tempvar
+			// pointed by tailcallargs is a local variable.
+			memcpyi(r2, r1, (stackframeoffset - (5*sizeofgpr))/sizeofgpr);
+			
+			// Unlock the lyricalreg.
+			// Locked registers must be unlocked only after
+			// the instructions using them have been generated;
+			// otherwise they could be lost when insureenoughunusedregisters()
+			// is called while creating a new lyricalinstruction.
+			r1->lock = 0;
+			r2->lock = 0;
+			
+			if (compileargcompileflag&LYRICALCOMPILECOMMENT) {
+				// The lyricalreg pointed by r1 and r2 were not allocated
+				// to a lyricalvariable but since I am done using them,
+				// I should also produce a comment about them having been
+				// discarded to complement the allocation comment that
+				// were generated when they were allocated.
+				comment(stringfmt("reg %%%d discarded", r1->id));
+				comment(stringfmt("reg %%%d discarded", r2->id));
+			}
+			
+			setregtothetop(r2);
+			setregtothetop(r1);
+			
+			varfree(tailcallargs);
+		}
+		
+		// I generate the instruction jumping
+		// to the instruction which follow
+		// the setup of the stackframe of currentfunc.
+		lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPJ);
+		i->imm = mmallocz(sizeof(lyricalimmval));
+		i->imm->type = LYRICALIMMOFFSETTOINSTRUCTION;
+		i->imm->i = currentfunc->tailcallentry;
+		
+		// I notify the return statement
+		// that the call will never return.
+		tailcallpos = 0;
+		
+		if (compileargcompileflag&LYRICALCOMPILECOMMENT) {
+			comment(stringduplicate2("end: done"));
+		}
+		
+		return;
+	}
+	
 	// I use the value of stackframeoffset to insure that
 	// the call arguments usage did not exceed its limit.
 	// If I am calling a function which use a stackframe holder
@@ -51,6 +51,10 @@ u8* savedsource = compileargsource;
 uint trytoincludemodulelyc = 0;
 uint ismodule = 0;
 
+// Variable which get set to 1 if the functions
+// of the module .lyc file are to be imported.
+uint isimportedmodulelyc = 0;
+
 // Variable which get set to 1 if
 // the file to include is an .lyx file.
 uint islyx = 0;
@@ -122,7 +126,12 @@ if (filepath.ptr[0] == '/') {
 		}
 	}
 	
-	compileargsource = fileread1(filepath.ptr).ptr;
+	// Only the preprocessor directives of the module
+	// .lyc file are kept if its functions are to be imported.
+	if (trytoincludemodulelyc && compileargimportmodule)
+		isimportedmodulelyc = compileargimportmodule(filepath.ptr);
+		
+	compileargsource = readincludedfile(filepath.ptr);
 	
 	if (compileargsource) {
 		// 4 stand for the length of ".lyx" .
@@ -187,7 +196,12 @@ if (filepath.ptr[0] == '/') {
 		}
 	}
 	
-	compileargsource = fileread1(filepath.ptr).ptr;
+	// Only the preprocessor directives of the module
+	// .lyc file are kept if its functions are to be imported.
+	if (trytoincludemodulelyc && compileargimportmodule)
+		isimportedmodulelyc = compileargimportmodule(filepath.ptr);
+		
+	compileargsource = readincludedfile(filepath.ptr);
 	
 	if (compileargsource) {
 		// 4 stand for the length of ".lyx" .
@@ -265,7 +279,12 @@ if (filepath.ptr[0] == '/') {
 			}
 		}
 		
-		compileargsource = fileread1(s.ptr).ptr;
+		// Only the preprocessor directives of the module
+		// .lyc file are kept if its functions are to be imported.
+		if (trytoincludemodulelyc && compileargimportmodule)
+			isimportedmodulelyc = compileargimportmodule(s.ptr);
+			
+		compileargsource = readincludedfile(s.ptr);
 		
 		if (compileargsource) {
 			// 4 stand for the length of ".lyx" .
@@ -336,28 +355,6 @@ mmrefdown(savedfilepath.ptr);
 stringappend1(&compileresult.srcfilepaths, filepath);
 stringappend4(&compileresult.srcfilepaths, '\n');
 
-// This structure represent an included file.
-typedef struct includedfile {
-	// This field is set to a string that
-	// is the filepath and linenumber where
-	// the include directive was used. ei:
-	// filepath.lyc:123.
-	string origin;
-	
-	// This field is set to the filepath.
-	string filepath;
-	
-	// The field prev of the first element
-	// of the linkedlist is null.
-	struct includedfile* prev;
-	
-} includedfile;
-
-// This variable keep in a linkedlist,
-// includedfile that represent files currently
-// being included and still being preprocessed.
-static includedfile* includedfiles = 0;
-
 if (includedfiles) {
 	// If I get here, I make sure that the file
 	// inclusion is not a recursive inclusion.
@@ -431,9 +428,96 @@ currentfilepath = filepath;
 
 macro* savedmacros = macros;
 
-chunk* c;
+uint savedisinimportedmodulelyc = isinimportedmodulelyc;
 
-if (c = preprocessor(islyx ? PREPROCESSINCLUDELYX : PREPROCESSINCLUDE)) {
+// A file that is not a module is part of
+// the module .lyc file which included it.
+if (ismodule || trytoincludemodulelyc)
+	isinimportedmodulelyc = isimportedmodulelyc;
+	
+if (isinimportedmodulelyc) {
+	// The functions of the module .lyc file
+	// are to be imported, but the modules that
+	// it includes remain needed by the modules
+	// including it; hence I blank every line
+	// that is not an `include directive or
+	// a conditional directive around it.
+	// Newlines are kept so that error
+	// locations remain correct.
+	// The content is duplicated, since
+	// the content returned by the callback
+	// compilearg->readfile can be shared.
+	
+	u8* ptr = stringduplicate2(compileargsource).ptr;
+	
+	mmrefdown(compileargsource);
+	
+	curpos = compileargsource = ptr;
+	
+	while (*ptr) {
+		
+		u8* lineptr = ptr;
+		
+		while (*lineptr == ' ' || *lineptr == '\t') ++lineptr;
+		
+		uint iskept = (*lineptr == '`' && (
+			stringiseq4(lineptr+1, "include", 7) ||
+			stringiseq4(lineptr+1, "ifdef", 5) ||
+			stringiseq4(lineptr+1, "ifndef", 6) ||
+			stringiseq4(lineptr+1, "elifdef", 7) ||
+			stringiseq4(lineptr+1, "elifndef", 8) ||
+			stringiseq4(lineptr+1, "else", 4) ||
+			stringiseq4(lineptr+1, "endif", 5)));
+			
+		while (*ptr && *ptr != '\n') {
+			if (!iskept) *ptr = ' ';
+			++ptr;
+		}
+		
+		if (*ptr) ++ptr;
+	}
+}
+
+chunk* c = 0;
+
+// Key with which the result of preprocessing
+// the file is loaded and saved; it remain null
+// when that result is not to be persisted.
+// .lyx files, and files included within
+// a `foreach block, are always preprocessed.
+u64 key = 0;
+
+u64 contenthash;
+
+if (compileargloadpreprocessed && compileargsavepreprocessed && !islyx && !foreachblockdepth) {
+	
+	key = preprocessedkey();
+	
+	contenthash = preprocessedhash(PREPROCESSEDHASHBASIS, compileargsource, stringsz(compileargsource));
+	
+	u8* data = compileargloadpreprocessed(key);
+	
+	if (data) {
+		c = loadpreprocessedchunks(data, contenthash);
+		mmrefdown(data);
+	}
+}
+
+if (!c) {
+	
+	uint savedpreprocessorsideeffectcount = preprocessorsideeffectcount;
+	
+	c = preprocessor(islyx ? PREPROCESSINCLUDELYX : PREPROCESSINCLUDE);
+	
+	// The result of preprocessing the file
+	// is saved only if it did not include files,
+	// nor define or undefine macros, since those
+	// effects would be missing when it is loaded.
+	if (c && key && preprocessorsideeffectcount == savedpreprocessorsideeffectcount)
+		savepreprocessedchunks(key, contenthash, c);
+}
+
+if (c) {
 	#if 0
 	// ### Not sure whether this code is still necessary.
 	// To the last chunk of the preprocessing result,
@@ -511,6 +595,8 @@ if (c = preprocessor(islyx ? PREPROCESSINCLUDELYX : PREPROCESSINCLUDE)) {
 
 mmrefdown(compileargsource);
 
+isinimportedmodulelyc = savedisinimportedmodulelyc;
+
 currentfilepath = savedcurrentfilepath;
 
 curpos = savedcurpos2;
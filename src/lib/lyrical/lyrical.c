@@ -290,6 +290,18 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 	uint (*compilearginstallmissingmodule)(u8* modulename) =
 		compilearg->installmissingmodule;
 	
+	u8* (*compileargreadfile)(u8* filepath) =
+		compilearg->readfile;
+		
+	uint (*compileargimportmodule)(u8* modulelycpath) =
+		compilearg->importmodule;
+		
+	u8* (*compileargloadpreprocessed)(u64 key) =
+		compilearg->loadpreprocessed;
+		
+	void (*compileargsavepreprocessed)(u64 key, u8* data, uint sz) =
+		compilearg->savepreprocessed;
+		
 	u8* compilearglyxappend =
 		compilearg->lyxappend;
 	
@@ -517,6 +529,28 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 	if (compileargcompileflag&LYRICALCOMPILEALLVARVOLATILE) *returnvar.alwaysvolatile = 1;
 	else *returnvar.alwaysvolatile = 0;
 	
+	// Variable set depending on whether
+	// function export was inferred
+	// through characters' sequence that
+	// were injected by the preprocessor.
+	// It and the variables below are used
+	// across recursive calls of parsestatement();
+	// they are declared here instead of as
+	// static variables within parsestatement()
+	// so that each call of lyricalcompile()
+	// use its own.
+	uint isexportinferred = 0;
+	
+	// Variable used to remember what is
+	// the owner of an anonymous struct/pstruct/union
+	// when recursively calling parsestatement()
+	// to parse nested anonymous struct/pstruct/union.
+	lyricaltype* ownerofanonymoustype = 0;
+	
+	// Variable used by newgenericlabelid()
+	// to generate unique label names.
+	uint endofblockid = 0;
+	
 	#include "parsestatement.lyrical.c"
 	
 	curpos = compileargsource;
@@ -585,6 +619,13 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 			// this function is being done.
 			void resolvepropagations (lyricalfunction* f, lyricalfunction* initialfunc) {
 				
+				// A function which directly or indirectly
+				// call itself would otherwise be recursed
+				// into endlessly.
+				if (f->propagationsresolvedfor == initialfunc) return;
+				
+				f->propagationsresolvedfor = initialfunc;
+				
 				lyricalpropagation* p = f->p;
 				
 				while (p) {
@@ -909,7 +950,12 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 		// it cannot use another function stackframe
 		// to hold its arguments and local variables.
 		uint isstackframeholder (lyricalfunction* f) {
-			return (f == rootfunc) || f->isrecursive || f->itspointerisobtained || f->couldnotgetastackframeholder;
+			return (f == rootfunc) || f->isrecursive || f->itspointerisobtained || f->couldnotgetastackframeholder ||
+				// When functions can be exported, the children
+				// of rootfunc do not use its stackframe, since
+				// rootfunc has returned by the time exported
+				// functions get called from another binary.
+				(f->parent == rootfunc && !(compileargcompileflag&LYRICALCOMPILENOFUNCTIONEXPORT));
 		}
 		
 		// When I get here, f == rootfunc;
@@ -1075,6 +1121,15 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 							do {
 								lyricalfunction* ff;
 								
+								// This array is used to prevent recursively
+								// checking the same lyricalcalledfunction,
+								// otherwise infinite recursive calls
+								// of recursivelycheck() will occur.
+								// recursivelycheck() free it and
+								// set it back to null before returning
+								// from its outermost call.
+								arrayuint beingchecked = arrayuintnull;
+								
 								// This function check whether
 								// a lyricalcalledfunction called
 								// the lyricalfunction pointed by ff.
@@ -1083,12 +1138,6 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 								void recursivelycheck (lyricalcalledfunction* calledfunction) {
 									
 									if (calledfunction) {
-										// This array is used to prevent recursively
-										// checking the same lyricalcalledfunction,
-										// otherwise infinite recursive calls
-										// of recursivelycheck() will occur.
-										static arrayuint beingchecked = arrayuintnull;
-										
 										if (beingchecked.ptr) {
 											
 											uint i = 0;
@@ -1846,6 +1895,21 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 		
 		// When I get here, f == rootfunc;
 		
+		if (!(compileargcompileflag&(LYRICALCOMPILENOLOOPOPTIMIZATION|LYRICALCOMPILEALLVARVOLATILE))) {
+			#include "optimizeloops.lyrical.c"
+		}
+		
+		// When I get here, f == rootfunc;
+		
+		// Comparisons only used by the branching
+		// instruction that follow them are fused
+		// with that branching instruction.
+		{
+			#include "fusecompareandbranch.lyrical.c"
+		}
+		
+		// When I get here, f == rootfunc;
+		
 		// This optimization is commented out
 		// because a backend should be able
 		// to handle more than one LYRICALOPNOP,
@@ -2123,7 +2187,10 @@ lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg) {
 	
 	if (stringconstants) generatestringregion();
 	
-	compileresult.globalregionsz = rootfunc->vlocalmaxsize;
+	// The stack page pool is at the end of
+	// the global variable region; it is made
+	// of 4 gpr (see LYRICALOPSTACKPAGEALLOC).
+	compileresult.globalregionsz = rootfunc->vlocalmaxsize + (4*sizeofgpr);
 	
 	// I cancel the session that I created for regaining
 	// any allocated memory in the event of a thrown error.
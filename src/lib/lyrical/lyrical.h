@@ -145,6 +145,14 @@ typedef enum {
 	LYRICALOPSRA,	// r1 = r2 >> r3;	#Arithmetic shift.
 	LYRICALOPSRAI,	// r1 = r2 >> imm;	#Arithmetic shift.
 	LYRICALOPSRAI2,	// r1 = imm >> r2;	#Arithmetic shift.
+	LYRICALOPROL,	// r1 = r2 rotated left by r3;	#Rotation of all the bits of a gpr.
+	LYRICALOPROLI,	// r1 = r2 rotated left by imm;	#Rotation of all the bits of a gpr.
+	LYRICALOPROR,	// r1 = r2 rotated right by r3;	#Rotation of all the bits of a gpr.
+	LYRICALOPRORI,	// r1 = r2 rotated right by imm;	#Rotation of all the bits of a gpr.
+	LYRICALOPBSWAP,	// r1 = r2 with the order of its bytes reversed;	#All the bytes of a gpr.
+	LYRICALOPPOPCNT,	// r1 = count of bits set in r2;
+	LYRICALOPCLZ,	// r1 = count of leading null bits in r2;	#r1 is set to the bitsize of a gpr if r2 is null.
+	LYRICALOPCTZ,	// r1 = count of trailing null bits in r2;	#r1 is set to the bitsize of a gpr if r2 is null.
 	LYRICALOPZXT,	// Zero extended the value in r2 and store it r1; imm hold the count of least significant bits to zero extend; no operation if imm is 0.
 	LYRICALOPSXT,	// Sign extended the value in r2 and store it r1; imm hold the count of least significant bits to sign extend; no operation if imm is 0.
 	// For LYRICALOPZXT and LYRICALOPSXT,
@@ -262,6 +270,89 @@ typedef enum {
 	LYRICALOPLDST64R,// Atomically swap the value of the 64 bits of r1 and the 64bits value at the address r2;
 	LYRICALOPLDST64I,// Atomically swap the value of the 64 bits of r1 and the 64bits value at the address imm;
 	
+	// Memory access atomic read-modify-write.
+	// These instructions do not use
+	// an immediate value, and r1 is
+	// set to the value that was at
+	// the address r2, zero extended.
+	LYRICALOPCAS8,	// Atomically: if the 8bits value at the address r2 is equal to the 8 least significant bits of r1, store the 8 least significant bits of r3 at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPCAS16,	// Atomically: if the 16bits value at the address r2 is equal to the 16 least significant bits of r1, store the 16 least significant bits of r3 at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPCAS32,	// Atomically: if the 32bits value at the address r2 is equal to the 32 bits of r1, store the 32 bits of r3 at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPCAS64,	// Atomically: if the 64bits value at the address r2 is equal to the 64 bits of r1, store the 64 bits of r3 at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHADD8,	// Atomically add the 8 least significant bits of r1 to the 8bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHADD16,	// Atomically add the 16 least significant bits of r1 to the 16bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHADD32,	// Atomically add the 32 bits of r1 to the 32bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHADD64,	// Atomically add the 64 bits of r1 to the 64bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHSUB8,	// Atomically substract the 8 least significant bits of r1 from the 8bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHSUB16,	// Atomically substract the 16 least significant bits of r1 from the 16bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHSUB32,	// Atomically substract the 32 bits of r1 from the 32bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHSUB64,	// Atomically substract the 64 bits of r1 from the 64bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHAND8,	// Atomically and the 8 least significant bits of r1 with the 8bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHAND16,	// Atomically and the 16 least significant bits of r1 with the 16bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHAND32,	// Atomically and the 32 bits of r1 with the 32bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHAND64,	// Atomically and the 64 bits of r1 with the 64bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHOR8,	// Atomically or the 8 least significant bits of r1 with the 8bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHOR16,	// Atomically or the 16 least significant bits of r1 with the 16bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHOR32,	// Atomically or the 32 bits of r1 with the 32bits value at the address r2; r1 is set to the value that was at the address r2.
+	LYRICALOPFETCHOR64,	// Atomically or the 64 bits of r1 with the 64bits value at the address r2; r1 is set to the value that was at the address r2.
+	
+	// Memory fence.
+	LYRICALOPFENCE,	// Complete all memory loads and stores issued before this instruction, before any memory load or store issued after it.
+	
+	// Vector.
+	// These instructions do not use
+	// an immediate value, and operate on
+	// 128bits vectors in memory at the
+	// addresses in registers, since
+	// there is no vector register; their
+	// lanes are 8, 16, 32 or 64 bits.
+	LYRICALOPVCPY,	// Copy the 128bits vector at the address r2 to the address r1.
+	LYRICALOPVADD8,	// Store at the address r1 the lane-wise addition of the 128bits vectors at the addresses r2 and r3, using 8bits lanes.
+	LYRICALOPVADD16,	// Store at the address r1 the lane-wise addition of the 128bits vectors at the addresses r2 and r3, using 16bits lanes.
+	LYRICALOPVADD32,	// Store at the address r1 the lane-wise addition of the 128bits vectors at the addresses r2 and r3, using 32bits lanes.
+	LYRICALOPVADD64,	// Store at the address r1 the lane-wise addition of the 128bits vectors at the addresses r2 and r3, using 64bits lanes.
+	LYRICALOPVSUB8,	// Store at the address r1 the lane-wise substraction of the 128bits vector at the address r3 from the one at the address r2, using 8bits lanes.
+	LYRICALOPVSUB16,	// Store at the address r1 the lane-wise substraction of the 128bits vector at the address r3 from the one at the address r2, using 16bits lanes.
+	LYRICALOPVSUB32,	// Store at the address r1 the lane-wise substraction of the 128bits vector at the address r3 from the one at the address r2, using 32bits lanes.
+	LYRICALOPVSUB64,	// Store at the address r1 the lane-wise substraction of the 128bits vector at the address r3 from the one at the address r2, using 64bits lanes.
+	LYRICALOPVAND,	// Store at the address r1 the bitwise and of the 128bits vectors at the addresses r2 and r3.
+	LYRICALOPVOR,	// Store at the address r1 the bitwise or of the 128bits vectors at the addresses r2 and r3.
+	LYRICALOPVXOR,	// Store at the address r1 the bitwise xor of the 128bits vectors at the addresses r2 and r3.
+	LYRICALOPVCMPEQ8,	// Store at the address r1 the lane-wise comparison of the 128bits vectors at the addresses r2 and r3, using 8bits lanes; each lane is set to all ones if equal, otherwise to zero.
+	LYRICALOPVCMPEQ16,	// Store at the address r1 the lane-wise comparison of the 128bits vectors at the addresses r2 and r3, using 16bits lanes; each lane is set to all ones if equal, otherwise to zero.
+	LYRICALOPVCMPEQ32,	// Store at the address r1 the lane-wise comparison of the 128bits vectors at the addresses r2 and r3, using 32bits lanes; each lane is set to all ones if equal, otherwise to zero.
+	LYRICALOPVMOVMSK8,	// Set r1 to the 16bits mask made of the most significant bit of each 8bits lane of the 128bits vector at the address r2, zero extended; the bit 0 of the mask is from the lane at the lowest address.
+	LYRICALOPVBCAST8,	// Store at the address r1 the 128bits vector made of the 8 least significant bits of r2 in each 8bits lane.
+	LYRICALOPVBCAST16,	// Store at the address r1 the 128bits vector made of the 16 least significant bits of r2 in each 16bits lane.
+	LYRICALOPVBCAST32,	// Store at the address r1 the 128bits vector made of the 32 least significant bits of r2 in each 32bits lane.
+	LYRICALOPVBCAST64,	// Store at the address r1 the 128bits vector made of the 64 least significant bits of r2 in each 64bits lane.
+	
+	// Floating point.
+	// These instructions do not use
+	// an immediate value; a 32bits or 64bits
+	// floating point number is held in
+	// the least significant bits of a register.
+	LYRICALOPFADD32,	// r1 = r2 + r3; using 32bits floating point numbers.
+	LYRICALOPFADD64,	// r1 = r2 + r3; using 64bits floating point numbers.
+	LYRICALOPFSUB32,	// r1 = r2 - r3; using 32bits floating point numbers.
+	LYRICALOPFSUB64,	// r1 = r2 - r3; using 64bits floating point numbers.
+	LYRICALOPFMUL32,	// r1 = r2 * r3; using 32bits floating point numbers.
+	LYRICALOPFMUL64,	// r1 = r2 * r3; using 64bits floating point numbers.
+	LYRICALOPFDIV32,	// r1 = r2 / r3; using 32bits floating point numbers.
+	LYRICALOPFDIV64,	// r1 = r2 / r3; using 64bits floating point numbers.
+	LYRICALOPFEQ32,	// r1 = (r2 == r3); using 32bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPFEQ64,	// r1 = (r2 == r3); using 64bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPFLT32,	// r1 = (r2 < r3); using 32bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPFLT64,	// r1 = (r2 < r3); using 64bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPFLTE32,	// r1 = (r2 <= r3); using 32bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPFLTE64,	// r1 = (r2 <= r3); using 64bits floating point numbers; r1 is set to 0 if r2 or r3 is a NaN.
+	LYRICALOPITOF32,	// r1 = the 32bits floating point number nearest to the signed value of r2.
+	LYRICALOPITOF64,	// r1 = the 64bits floating point number nearest to the signed value of r2.
+	LYRICALOPF32TOI,	// r1 = the signed value of the 32bits floating point number r2 rounded toward zero; r1 is set to the most negative signed value if the result is not representable.
+	LYRICALOPF64TOI,	// r1 = the signed value of the 64bits floating point number r2 rounded toward zero; r1 is set to the most negative signed value if the result is not representable.
+	LYRICALOPF32TOF64,	// r1 = the 64bits floating point number equal to the 32bits floating point number r2.
+	LYRICALOPF64TOF32,	// r1 = the 32bits floating point number nearest to the 64bits floating point number r2.
+	
 	// Memory copy.
 	// These instructions copy data
 	// from the memory location in r2
@@ -313,8 +404,24 @@ typedef enum {
 	// by the compiler to dynamically allocate
 	// stack memory when needed and free it
 	// when no longer needed.
+	// imm is the address of the stack page pool,
+	// made of 4 gpr at the end of the global variable region:
+	// the address of the first page in the pool or null,
+	// the count of pages in the pool,
+	// the count of pages allocated from the pool,
+	// and the count of pages allocated otherwise.
+	// A page in the pool hold in its first gpr
+	// the address of the next page in the pool or null.
+	// Backends can use the stack page pool
+	// to avoid a syscall when allocating and
+	// freeing pages, or ignore it.
 	LYRICALOPSTACKPAGEALLOC,	// r1 get set to the start address of the page allocated. r1 get set to -1 on failure.
 	LYRICALOPSTACKPAGEFREE,		// r1 hold an address anywhere within the page to free.
+	// For LYRICALOPSTACKPAGE*, the backends
+	// can assume that a single lyricalimmval
+	// of type LYRICALIMMOFFSETTOGLOBALREGION
+	// followed by a lyricalimmval of type
+	// LYRICALIMMVALUE have been used.
 	
 	// This lyricalinstruction is
 	// generated by the compiler
@@ -566,6 +673,20 @@ typedef enum {
 	// effectively disabling runtime exporting.
 	LYRICALCOMPILENOFUNCTIONEXPORT = 1<<5,
 	
+	// When used, a function calling itself from
+	// a return statement create a new stackframe
+	// instead of re-using its own stackframe;
+	// this is useful when debugging since
+	// every call remain visible in the stack.
+	LYRICALCOMPILENOTAILCALL = 1<<6,
+	
+	// When used, loops are left as generated;
+	// otherwise computations involving variables
+	// not modified within a loop, or modified only
+	// by adding a constant on every iteration, are
+	// done using registers dedicated to the loop.
+	LYRICALCOMPILENOLOOPOPTIMIZATION = 1<<7,
+	
 } lyricalcompileflag;
 
 // Structure used to specify predeclared
@@ -671,7 +792,10 @@ typedef struct {
 	
 	// Memory size that must be
 	// available for the global
-	// variable region.
+	// variable region; it include
+	// the stack page pool which is
+	// at the end of the region
+	// (see LYRICALOPSTACKPAGEALLOC).
 	uint globalregionsz;
 	
 	// String that contain the list
@@ -783,6 +907,64 @@ typedef struct {
 	// and non-null otherwise.
 	uint (*installmissingmodule)(u8* modulename);
 	
+	// When non-null, this field is to be set
+	// to a callback function which is called
+	// to get the content of a file to include,
+	// instead of reading it from the filesystem.
+	// It must return null on failure, otherwise
+	// a null terminated string allocated using
+	// mmalloc(), which lyricalcompile() will
+	// never modify and will release using
+	// mmrefdown(); hence a callback function
+	// caching the content of files can return
+	// the same memory block after having used
+	// mmrefup() on it.
+	u8* (*readfile)(u8* filepath);
+	
+	// When non-null, this field is to be set
+	// to a callback function which is called
+	// with the path of a module .lyc file
+	// before including it; when it return
+	// non-null, only the preprocessor directives
+	// of the .lyc file are included, so that the
+	// modules it include still get included,
+	// and the functions declared by the module
+	// .lyh file are left undefined so as to be
+	// imported; for it to work, the flag
+	// LYRICALCOMPILENOFUNCTIONIMPORT must
+	// not be used.
+	// Functions defined by the module .lyc file
+	// which is compiled, and declared outside
+	// of it within the root function, are exported
+	// if the flag LYRICALCOMPILENOFUNCTIONEXPORT
+	// is not used.
+	uint (*importmodule)(u8* modulelycpath);
+	
+	// When non-null, these fields are to be set
+	// to callback functions used to persist the result
+	// of preprocessing included files, so that repeated
+	// compilations do not preprocess them again.
+	// The callback function savepreprocessed is called
+	// with a key, and the data of size sz to associate
+	// with it; the key is computed from the path
+	// of the included file and all the macros defined
+	// where it is included.
+	// The callback function loadpreprocessed must return
+	// null if no data is associated with the key given
+	// as argument, otherwise a memory block allocated
+	// using mmalloc() and containing the data, which
+	// lyricalcompile() will release using mmrefdown().
+	// The data contain the hash of the content
+	// of the file from which it was generated,
+	// so that it is not used once the file
+	// has been modified.
+	// The result of preprocessing a file is saved
+	// only if it did not include files, nor define
+	// macros that remain defined after it, nor
+	// undefine macros.
+	u8* (*loadpreprocessed)(u64 key);
+	void (*savepreprocessed)(u64 key, u8* data, uint sz);
+	
 	// When parsing an .lyx file, the null terminated
 	// string pointed by this field get appended
 	// to every double quoted string generated
@@ -809,6 +991,13 @@ typedef struct {
 // and return a lyricalcompileresult;
 // if an error occur, the field rootfunc
 // of the lyricalcompileresult returned is null.
+// All the compilation state is kept within
+// the stackframe of lyricalcompile(), hence
+// it can be called concurrently from multiple
+// threads when the memory manager has been
+// built with MMTHREADSAFE defined; the callbacks
+// set in the lyricalcompilearg must then be
+// threadsafe as well.
 lyricalcompileresult lyricalcompile (lyricalcompilearg* compilearg);
 
 
@@ -1028,7 +1217,21 @@ typedef enum {
 	// arg0: fd.
 	// arg1: length.
 	// Return a value.
-	LYRICALSYSCALLFTRUNCATE
+	LYRICALSYSCALLFTRUNCATE,
+	
+	// Save the global variable region
+	// of the executable in its cache entry,
+	// so that subsequent runs using
+	// the runner option "snapshot"
+	// start with it restored.
+	// Return a value.
+	LYRICALSYSCALLSNAPSHOT,
+	
+	// Return non-null if the global
+	// variable region was restored
+	// from a snapshot.
+	// Return a value.
+	LYRICALSYSCALLSNAPSHOTRESTORED
 	
 } lyricalsyscall;
 
@@ -185,14 +185,14 @@ if (r1) {
 		if (*funcarg->typepushed.ptr == 'u') {
 			
 			if (*name == '*') muli(rresult, r1, imm2);
-			else if (*name == '/') divui(rresult, r1, imm2);
-			else modui(rresult, r1, imm2);
+			else if (*name == '/') divbyimm(rresult, r1, imm2, 0, 0);
+			else divbyimm(rresult, r1, imm2, 0, 1);
 			
 		} else {
 			
 			if (*name == '*') muli(rresult, r1, imm2);
-			else if (*name == '/') divi(rresult, r1, imm2);
-			else modi(rresult, r1, imm2);
+			else if (*name == '/') divbyimm(rresult, r1, imm2, 1, 0);
+			else divbyimm(rresult, r1, imm2, 1, 1);
 		}
 	}
 	
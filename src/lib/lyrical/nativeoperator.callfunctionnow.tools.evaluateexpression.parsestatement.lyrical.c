@@ -32,6 +32,13 @@ lyricalreg* rresult; lyricalreg* r1; lyricalreg* r2;
 // are immediate values.
 u64 immresult, imm1, imm2;
 
+// argbitsize is set by builtin functions
+// to the bitsize of the type with which
+// their first argument was pushed, and
+// builtinresulttype is set to the type
+// of their result variable.
+uint argbitsize; string builtinresulttype;
+
 // This function return the stride of a pointer.
 // The argument type must be a valid string
 // and must be a pointer type.
@@ -49,6 +56,23 @@ uint stride (string type) {
 	return sizeoftype(type.ptr, i);
 }
 
+// This function return the value which,
+// when used as a multiplier, replicate
+// throughout a gpr a value which has
+// the bitsize n; n must be a powerof2
+// less than or equal to the bitsize of a gpr.
+u64 replicatemultiplier (uint n) {
+	
+	u64 m = 0;
+	
+	uint i;
+	
+	for (i = 0; i < bitsizeofgpr; i += n)
+		m |= ((u64)1<<i);
+		
+	return m;
+}
+
 // This function is used to determine whether
 // the tempvar pointed by funcarg->v is
 // shared with another lyricalargument.
@@ -92,6 +116,296 @@ uint issharedtempvar1 () {
 	return 0;
 }
 
+// This function generate in the register rresult
+// the quotient, or the remainder if ismodulo is true,
+// of the division of the register r by the immediate
+// value n; issigned determine whether the division
+// is signed or unsigned.
+// The division is done using a multiplication
+// by the reciprocal of n, followed by shifts,
+// which is much faster than the division
+// instruction; the reciprocal is computed using
+// the algorithm from the book "Hacker's Delight".
+// When n is a powerof2, shifts and masks are used.
+// The division instructions are still used for
+// the divisors for which there is no faster
+// instruction sequence, or which would require
+// a divide by zero.
+// The registers rresult and r must be locked
+// and they can be the same register, since
+// rresult is only written by the last
+// instruction generated.
+void divbyimm (lyricalreg* rresult, lyricalreg* r, u64 n, uint issigned, uint ismodulo) {
+	
+	u64 mask = ((bitsizeofgpr < (8*sizeof(u64))) ? (((u64)1<<bitsizeofgpr)-1) : (u64)-1);
+	
+	u64 signbit = ((u64)1<<(bitsizeofgpr-1));
+	
+	// I only keep the bits of the divisor
+	// that the instruction would have used.
+	n &= mask;
+	
+	// Absolute value of the divisor.
+	u64 d = ((issigned && (n&signbit)) ? ((-n)&mask) : n);
+	
+	// A signed division by minus one
+	// is a negation, and its remainder is null.
+	if (issigned && n == mask) {
+		
+		if (ismodulo) li(rresult, 0);
+		else neg(rresult, r);
+		
+		return;
+	}
+	
+	// I use the division instructions when the
+	// divisor is null or one, or is the most
+	// negative signed number, or is an unsigned
+	// powerof2 for which divui() and modui()
+	// already generate a shift or a mask.
+	if (d < 2 || (issigned ? (d == signbit) : ispowerof2(d))) goto usedivisioninstruction;
+	
+	// Multiplier and shift amount
+	// computed for the divisor.
+	u64 m; uint s;
+	
+	// Set to 1 when the multiplier do not fit
+	// in a gpr, in which case an add and a shift
+	// is needed to fixup the unsigned quotient.
+	uint a = 0;
+	
+	// Will be set to the powerof2 amount
+	// when d is a powerof2.
+	uint k = 0;
+	
+	if (issigned) {
+		
+		if (!(k = ispowerof2(d))) {
+			
+			u64 t = (signbit + (n>>(bitsizeofgpr-1)));
+			
+			// Absolute value of the largest
+			// dividend for which the remainder
+			// of its division by d is d-1.
+			u64 anc = ((t - 1 - (t%d))&mask);
+			
+			uint p = (bitsizeofgpr-1);
+			
+			u64 q1 = (signbit/anc);
+			u64 rem1 = ((signbit - (q1*anc))&mask);
+			u64 q2 = (signbit/d);
+			u64 rem2 = ((signbit - (q2*d))&mask);
+			
+			u64 delta;
+			
+			do {
+				++p;
+				
+				q1 = ((2*q1)&mask); rem1 = ((2*rem1)&mask);
+				
+				if (rem1 >= anc) {
+					q1 = ((q1+1)&mask);
+					rem1 = ((rem1-anc)&mask);
+				}
+				
+				q2 = ((2*q2)&mask); rem2 = ((2*rem2)&mask);
+				
+				if (rem2 >= d) {
+					q2 = ((q2+1)&mask);
+					rem2 = ((rem2-d)&mask);
+				}
+				
+				delta = ((d - rem2)&mask);
+				
+			} while (q1 < delta || (q1 == delta && !rem1));
+			
+			m = ((q2+1)&mask);
+			
+			if (n&signbit) m = ((-m)&mask);
+			
+			s = (p - bitsizeofgpr);
+		}
+		
+	} else {
+		
+		u64 nc = ((mask - ((-n)&mask)%n)&mask);
+		
+		uint p = (bitsizeofgpr-1);
+		
+		u64 q1 = (signbit/nc);
+		u64 rem1 = ((signbit - (q1*nc))&mask);
+		u64 q2 = ((signbit-1)/n);
+		u64 rem2 = (((signbit-1) - (q2*n))&mask);
+		
+		u64 delta;
+		
+		do {
+			++p;
+			
+			if (rem1 >= ((nc - rem1)&mask)) {
+				q1 = ((2*q1 + 1)&mask);
+				rem1 = ((2*rem1 - nc)&mask);
+			} else {
+				q1 = ((2*q1)&mask);
+				rem1 = ((2*rem1)&mask);
+			}
+			
+			if (((rem2 + 1)&mask) >= ((n - rem2)&mask)) {
+				if (q2 >= (signbit-1)) a = 1;
+				q2 = ((2*q2 + 1)&mask);
+				rem2 = ((2*rem2 + 1 - n)&mask);
+			} else {
+				if (q2 >= signbit) a = 1;
+				q2 = ((2*q2)&mask);
+				rem2 = ((2*rem2 + 1)&mask);
+			}
+			
+			delta = ((n - 1 - rem2)&mask);
+			
+		} while (p < (2*bitsizeofgpr) && (q1 < delta || (q1 == delta && !rem1)));
+		
+		m = ((q2+1)&mask);
+		
+		s = (p - bitsizeofgpr);
+	}
+	
+	// A multiplier which is null, one or a powerof2
+	// cannot be used because mulhi() and mulhui()
+	// would generate a copy or a left shift;
+	// it should not happen, but I use
+	// the division instruction in that case.
+	if (!k && (m < 2 || ispowerof2(m))) goto usedivisioninstruction;
+	
+	// I allocate the registers that will hold
+	// intermediate results; since they are
+	// not assigned to anything, I lock them,
+	// otherwise they will be seen as unused
+	// registers when generating lyricalinstruction.
+	// I also lock them to prevent a call
+	// of allocreg() from using them.
+	lyricalreg* t1 = allocreg(CRITICALREG);
+	t1->lock = 1;
+	t1->size = sizeofgpr;
+	
+	lyricalreg* t2 = allocreg(CRITICALREG);
+	t2->lock = 1;
+	t2->size = sizeofgpr;
+	
+	if (k) {
+		// I get here for a signed division
+		// by a powerof2; since a shift right
+		// round toward negative infinity, 2^k-1
+		// is added to the dividend when it is
+		// negative so that the quotient
+		// get rounded toward zero.
+		
+		srai(t1, r, bitsizeofgpr-1);
+		srli(t1, t1, bitsizeofgpr-k);
+		add(t1, t1, r);
+		
+		if (ismodulo) {
+			// The remainder is the dividend
+			// minus the dividend rounded toward
+			// zero to a multiple of 2^k.
+			// The sign of the divisor do not
+			// affect the remainder.
+			andi(t1, t1, -((u64)1<<k));
+			sub(rresult, r, t1);
+			
+		} else if (n&signbit) {
+			
+			srai(t1, t1, k);
+			neg(rresult, t1);
+			
+		} else srai(rresult, t1, k);
+		
+	} else if (issigned) {
+		// The multiplier is sign extended
+		// the same way an immediate value is.
+		if (m&signbit) m |= ~mask;
+		
+		mulhi(t1, r, m);
+		
+		// When the sign of the multiplier do
+		// not match the sign of the divisor,
+		// the dividend was substracted or added
+		// by the multiplication and must be
+		// added or substracted back.
+		if (!(n&signbit) && (m&signbit)) add(t1, t1, r);
+		else if ((n&signbit) && !(m&signbit)) sub(t1, t1, r);
+		
+		srai(t1, t1, s);
+		
+		// One is added to a negative
+		// quotient to round it toward zero.
+		srli(t2, t1, bitsizeofgpr-1);
+		
+		if (ismodulo) {
+			
+			add(t1, t1, t2);
+			
+			if (n&signbit) n |= ~mask;
+			
+			muli(t1, t1, n);
+			sub(rresult, r, t1);
+			
+		} else add(rresult, t1, t2);
+		
+	} else {
+		
+		mulhui(t1, r, m);
+		
+		lyricalreg* q = t1;
+		
+		if (a) {
+			// The multiplier needed one more bit
+			// than the size of a gpr; the quotient
+			// is computed as ((((r - t1) >> 1) + t1) >> (s-1))
+			// which cannot overflow.
+			sub(t2, r, t1);
+			srli(t2, t2, 1);
+			add(t1, t1, t2);
+			
+			--s;
+		}
+		
+		if (ismodulo) {
+			
+			srli(q, q, s);
+			muli(q, q, n);
+			sub(rresult, r, q);
+			
+		} else srli(rresult, q, s);
+	}
+	
+	// Unlock the lyricalreg.
+	// Locked registers must be unlocked only after
+	// the instructions using them have been generated;
+	// otherwise they could be lost when insureenoughunusedregisters()
+	// is called while creating a new lyricalinstruction.
+	t1->lock = 0;
+	t2->lock = 0;
+	
+	return;
+	
+	usedivisioninstruction:
+	
+	if (issigned) {
+		// The divisor get sign extended
+		// the same way it would have been
+		// by ifnativetypedosignorzeroextend().
+		if (n&signbit) n |= ~mask;
+		
+		if (ismodulo) modi(rresult, r, n);
+		else divi(rresult, r, n);
+		
+	} else {
+		
+		if (ismodulo) modui(rresult, r, n);
+		else divui(rresult, r, n);
+	}
+}
+
 // There can never be an argument
 // with its field byref set when
 // used with a native operator.
@@ -182,6 +496,30 @@ switch(sfr.nativeop) {
 	case 14: // I get here for the operators &= ^= |=
 		#include "selfbitwiseandxoror.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
 		break;
+		
+	case 15: // I get here for the builtin functions popcnt() clz() ctz() bswap()
+		#include "popcntclzctzbswap.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
+		
+	case 16: // I get here for the builtin functions rotl() rotr()
+		#include "rotlrotr.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
+		
+	case 17: // I get here for the operators + - * / < <= > >= == != on floating point types
+		#include "floatingpoint.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
+		
+	case 18: // I get here for the operators += -= *= /= on floating point types
+		#include "selffloatingpoint.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
+		
+	case 19: // I get here for the operator - on floating point types
+		#include "floatingpointneg.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
+		
+	case 20: // I get here for the builtin functions tof32() tof64() tosint()
+		#include "tof32tof64tosint.nativeoperator.callfunctionnow.tools.evaluateexpression.parsestatement.lyrical.c"
+		break;
 }
 
 if (compilepass) {
@@ -152,6 +152,14 @@ lyricalinstruction* newinstruction (lyricalfunction* f, lyricalop op) {
 				case LYRICALOPSRA: return "SRA";
 				case LYRICALOPSRAI: return "SRAI";
 				case LYRICALOPSRAI2: return "SRAI2";
+				case LYRICALOPROL: return "ROL";
+				case LYRICALOPROLI: return "ROLI";
+				case LYRICALOPROR: return "ROR";
+				case LYRICALOPRORI: return "RORI";
+				case LYRICALOPBSWAP: return "BSWAP";
+				case LYRICALOPPOPCNT: return "POPCNT";
+				case LYRICALOPCLZ: return "CLZ";
+				case LYRICALOPCTZ: return "CTZ";
 				case LYRICALOPZXT: return "ZXT";
 				case LYRICALOPSXT: return "SXT";
 				
@@ -252,6 +260,70 @@ lyricalinstruction* newinstruction (lyricalfunction* f, lyricalop op) {
 				case LYRICALOPLDST64R: return "LDST64R";
 				case LYRICALOPLDST64I: return "LDST64I";
 				
+				case LYRICALOPCAS8: return "CAS8";
+				case LYRICALOPCAS16: return "CAS16";
+				case LYRICALOPCAS32: return "CAS32";
+				case LYRICALOPCAS64: return "CAS64";
+				case LYRICALOPFETCHADD8: return "FETCHADD8";
+				case LYRICALOPFETCHADD16: return "FETCHADD16";
+				case LYRICALOPFETCHADD32: return "FETCHADD32";
+				case LYRICALOPFETCHADD64: return "FETCHADD64";
+				case LYRICALOPFETCHSUB8: return "FETCHSUB8";
+				case LYRICALOPFETCHSUB16: return "FETCHSUB16";
+				case LYRICALOPFETCHSUB32: return "FETCHSUB32";
+				case LYRICALOPFETCHSUB64: return "FETCHSUB64";
+				case LYRICALOPFETCHAND8: return "FETCHAND8";
+				case LYRICALOPFETCHAND16: return "FETCHAND16";
+				case LYRICALOPFETCHAND32: return "FETCHAND32";
+				case LYRICALOPFETCHAND64: return "FETCHAND64";
+				case LYRICALOPFETCHOR8: return "FETCHOR8";
+				case LYRICALOPFETCHOR16: return "FETCHOR16";
+				case LYRICALOPFETCHOR32: return "FETCHOR32";
+				case LYRICALOPFETCHOR64: return "FETCHOR64";
+				
+				case LYRICALOPFENCE: return "FENCE";
+				case LYRICALOPVCPY: return "VCPY";
+				case LYRICALOPVADD8: return "VADD8";
+				case LYRICALOPVADD16: return "VADD16";
+				case LYRICALOPVADD32: return "VADD32";
+				case LYRICALOPVADD64: return "VADD64";
+				case LYRICALOPVSUB8: return "VSUB8";
+				case LYRICALOPVSUB16: return "VSUB16";
+				case LYRICALOPVSUB32: return "VSUB32";
+				case LYRICALOPVSUB64: return "VSUB64";
+				case LYRICALOPVAND: return "VAND";
+				case LYRICALOPVOR: return "VOR";
+				case LYRICALOPVXOR: return "VXOR";
+				case LYRICALOPVCMPEQ8: return "VCMPEQ8";
+				case LYRICALOPVCMPEQ16: return "VCMPEQ16";
+				case LYRICALOPVCMPEQ32: return "VCMPEQ32";
+				case LYRICALOPVMOVMSK8: return "VMOVMSK8";
+				case LYRICALOPVBCAST8: return "VBCAST8";
+				case LYRICALOPVBCAST16: return "VBCAST16";
+				case LYRICALOPVBCAST32: return "VBCAST32";
+				case LYRICALOPVBCAST64: return "VBCAST64";
+				
+				case LYRICALOPFADD32: return "FADD32";
+				case LYRICALOPFADD64: return "FADD64";
+				case LYRICALOPFSUB32: return "FSUB32";
+				case LYRICALOPFSUB64: return "FSUB64";
+				case LYRICALOPFMUL32: return "FMUL32";
+				case LYRICALOPFMUL64: return "FMUL64";
+				case LYRICALOPFDIV32: return "FDIV32";
+				case LYRICALOPFDIV64: return "FDIV64";
+				case LYRICALOPFEQ32: return "FEQ32";
+				case LYRICALOPFEQ64: return "FEQ64";
+				case LYRICALOPFLT32: return "FLT32";
+				case LYRICALOPFLT64: return "FLT64";
+				case LYRICALOPFLTE32: return "FLTE32";
+				case LYRICALOPFLTE64: return "FLTE64";
+				case LYRICALOPITOF32: return "ITOF32";
+				case LYRICALOPITOF64: return "ITOF64";
+				case LYRICALOPF32TOI: return "F32TOI";
+				case LYRICALOPF64TOI: return "F64TOI";
+				case LYRICALOPF32TOF64: return "F32TOF64";
+				case LYRICALOPF64TOF32: return "F64TOF32";
+				
 				case LYRICALOPMEM8CPY: return "MEM8CPY";
 				case LYRICALOPMEM8CPYI: return "MEM8CPYI";
 				case LYRICALOPMEM8CPY2: return "MEM8CPY2";
@@ -2289,6 +2361,163 @@ lyricalinstruction* srai2 (lyricalreg* r1, lyricalreg* r2, u64 n) {
 	return i;
 }
 
+lyricalinstruction* rol (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPROL);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The sign and zero extension
+	// of the result register
+	// cannot be predicted.
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* roli (lyricalreg* r1, lyricalreg* r2, u64 n) {
+	
+	n &= targetshiftamountmask;
+	
+	if (!n) return cpy(r1, r2);
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPROLI);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	i->imm = mmallocz(sizeof(lyricalimmval));
+	i->imm->type = LYRICALIMMVALUE;
+	i->imm->n = n;
+	
+	// The sign and zero extension
+	// of the result register
+	// cannot be predicted.
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* ror (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPROR);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The sign and zero extension
+	// of the result register
+	// cannot be predicted.
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* rori (lyricalreg* r1, lyricalreg* r2, u64 n) {
+	
+	n &= targetshiftamountmask;
+	
+	if (!n) return cpy(r1, r2);
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPRORI);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	i->imm = mmallocz(sizeof(lyricalimmval));
+	i->imm->type = LYRICALIMMVALUE;
+	i->imm->n = n;
+	
+	// The sign and zero extension
+	// of the result register
+	// cannot be predicted.
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* bswap (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPBSWAP);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The sign and zero extension
+	// of the result register
+	// cannot be predicted.
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* popcnt (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPPOPCNT);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The result is never greater
+	// than the bitsize of a gpr,
+	// hence it fits in a byte and
+	// is both sign and zero extended.
+	
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* clz (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCLZ);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The result is never greater
+	// than the bitsize of a gpr,
+	// hence it fits in a byte and
+	// is both sign and zero extended.
+	
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* ctz (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCTZ);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The result is never greater
+	// than the bitsize of a gpr,
+	// hence it fits in a byte and
+	// is both sign and zero extended.
+	
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
 lyricalinstruction* zxt (lyricalreg* r1, lyricalreg* r2, u64 n) {
 	
 	if (!(n%(sizeofgpr*8))) return 0;
@@ -4088,139 +4317,1019 @@ lyricalinstruction* ldsti (lyricalreg* r1, u64 n) {
 	else if (sizeofgpr == 8) return ldst64i(r1, n);
 }
 
-lyricalinstruction* mem8cpy (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
-	// All operands are input-output.
-	
-	if (r1->id == r3->id) throwerror("the first and third operands cannot be the same");
-	else if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
-	else if (r2->id == r3->id) throwerror("the second and third operands cannot be the same");
+lyricalinstruction* cas8 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
 	
-	// I first generate a check
-	// to insure that the value
-	// of r3 will never be null.
-	// The check simplify the
-	// lyricalinstruction conversion
-	// by the backend.
-	
-	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPJZ);
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCAS8);
 	
-	i->r1 = r3->id;
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
 	
-	lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
-	imm->type = LYRICALIMMOFFSETTOINSTRUCTION;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	i->imm = imm;
+	r1->waszeroextended = (r1->size >= 1);
+	r1->wassignextended = (r1->size > 1);
 	
-	// I now generate the mem8cpy instruction.
+	return i;
+}
+
+lyricalinstruction* cas16 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
 	
-	i = newinstruction(currentfunc, LYRICALOPMEM8CPY);
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCAS16);
 	
 	i->r1 = r1->id;
 	i->r2 = r2->id;
 	i->r3 = r3->id;
 	
-	// I set the destination
-	// of the LYRICALOPJZ.
-	
-	i = newinstruction(currentfunc, LYRICALOPNOP);
-	
-	imm->i = i;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	// r1 is set sign extended if r3 is sign extended,
-	// and if r1->size >= r3->size.
-	// r2 is set sign extended if r3 is sign extended,
-	// and if r2->size >= r3->size.
-	// The value of r3 become zero, hence
-	// it is set both zero and sign extended.
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
 	
-	if (r1->wassignextended && r3->wassignextended && r1->size >= r3->size)
-		r1->wassignextended = 1;
-	else r1->wassignextended = 0;
+	return i;
+}
+
+lyricalinstruction* cas32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
 	
-	r1->waszeroextended = 0;
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCAS32);
 	
-	if (r2->wassignextended && r3->wassignextended && r2->size >= r3->size)
-		r2->wassignextended = 1;
-	else r2->wassignextended = 0;
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
 	
-	r2->waszeroextended = 0;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	r3->waszeroextended = 1;
-	r3->wassignextended = 1;
+	r1->waszeroextended = (r1->size >= 4);
+	r1->wassignextended = (r1->size > 4);
 	
 	return i;
 }
 
-lyricalinstruction* mem8cpy2 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
-	// All operands are input-output.
+lyricalinstruction* cas64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
 	
-	if (r1->id == r3->id) throwerror("the first and third operands cannot be the same");
-	else if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
-	else if (r2->id == r3->id) throwerror("the second and third operands cannot be the same");
-	
-	// I first generate a check
-	// to insure that the value
-	// of r3 will never be null.
-	// The check simplify the
-	// lyricalinstruction conversion
-	// by the backend.
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPCAS64);
 	
-	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPJZ);
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
 	
-	i->r1 = r3->id;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
-	imm->type = LYRICALIMMOFFSETTOINSTRUCTION;
+	r1->waszeroextended = (r1->size >= 8);
+	r1->wassignextended = (r1->size > 8);
 	
-	i->imm = imm;
+	return i;
+}
+
+lyricalinstruction* cas (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
 	
-	// I now generate the mem8cpy2 instruction.
+	if (sizeofgpr == 1) return cas8(r1, r2, r3);
+	else if (sizeofgpr == 2) return cas16(r1, r2, r3);
+	else if (sizeofgpr == 4) return cas32(r1, r2, r3);
+	else if (sizeofgpr == 8) return cas64(r1, r2, r3);
+}
+
+lyricalinstruction* fetchadd8 (lyricalreg* r1, lyricalreg* r2) {
 	
-	i = newinstruction(currentfunc, LYRICALOPMEM8CPY2);
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHADD8);
 	
 	i->r1 = r1->id;
 	i->r2 = r2->id;
-	i->r3 = r3->id;
-	
-	// I set the destination
-	// of the LYRICALOPJZ.
-	
-	i = newinstruction(currentfunc, LYRICALOPNOP);
 	
-	imm->i = i;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	// r1 is set sign extended if r3 is sign extended,
-	// and if r1->size >= r3->size.
-	// r2 is set sign extended if r3 is sign extended,
-	// and if r2->size >= r3->size.
-	// The value of r3 become zero, hence
-	// it is set both zero and sign extended.
+	r1->waszeroextended = (r1->size >= 1);
+	r1->wassignextended = (r1->size > 1);
 	
-	if (r1->wassignextended && r3->wassignextended && r1->size >= r3->size)
-		r1->wassignextended = 1;
-	else r1->wassignextended = 0;
+	return i;
+}
+
+lyricalinstruction* fetchadd16 (lyricalreg* r1, lyricalreg* r2) {
 	
-	r1->waszeroextended = 0;
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHADD16);
 	
-	if (r2->wassignextended && r3->wassignextended && r2->size >= r3->size)
-		r2->wassignextended = 1;
-	else r2->wassignextended = 0;
+	i->r1 = r1->id;
+	i->r2 = r2->id;
 	
-	r2->waszeroextended = 0;
+	// The value that was in memory
+	// is zero extended in r1.
 	
-	r3->waszeroextended = 1;
-	r3->wassignextended = 1;
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
 	
 	return i;
 }
 
-lyricalinstruction* mem8cpyi (lyricalreg* r1, lyricalreg* r2, u64 n) {
-	// All operands are input-output,
-	// except the immediate value.
+lyricalinstruction* fetchadd32 (lyricalreg* r1, lyricalreg* r2) {
 	
-	if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHADD32);
 	
-	if (!n) return 0;
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 4);
+	r1->wassignextended = (r1->size > 4);
+	
+	return i;
+}
+
+lyricalinstruction* fetchadd64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHADD64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 8);
+	r1->wassignextended = (r1->size > 8);
+	
+	return i;
+}
+
+lyricalinstruction* fetchadd (lyricalreg* r1, lyricalreg* r2) {
+	
+	if (sizeofgpr == 1) return fetchadd8(r1, r2);
+	else if (sizeofgpr == 2) return fetchadd16(r1, r2);
+	else if (sizeofgpr == 4) return fetchadd32(r1, r2);
+	else if (sizeofgpr == 8) return fetchadd64(r1, r2);
+}
+
+lyricalinstruction* fetchsub8 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHSUB8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 1);
+	r1->wassignextended = (r1->size > 1);
+	
+	return i;
+}
+
+lyricalinstruction* fetchsub16 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHSUB16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
+	
+	return i;
+}
+
+lyricalinstruction* fetchsub32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHSUB32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 4);
+	r1->wassignextended = (r1->size > 4);
+	
+	return i;
+}
+
+lyricalinstruction* fetchsub64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHSUB64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 8);
+	r1->wassignextended = (r1->size > 8);
+	
+	return i;
+}
+
+lyricalinstruction* fetchsub (lyricalreg* r1, lyricalreg* r2) {
+	
+	if (sizeofgpr == 1) return fetchsub8(r1, r2);
+	else if (sizeofgpr == 2) return fetchsub16(r1, r2);
+	else if (sizeofgpr == 4) return fetchsub32(r1, r2);
+	else if (sizeofgpr == 8) return fetchsub64(r1, r2);
+}
+
+lyricalinstruction* fetchand8 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHAND8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 1);
+	r1->wassignextended = (r1->size > 1);
+	
+	return i;
+}
+
+lyricalinstruction* fetchand16 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHAND16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
+	
+	return i;
+}
+
+lyricalinstruction* fetchand32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHAND32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 4);
+	r1->wassignextended = (r1->size > 4);
+	
+	return i;
+}
+
+lyricalinstruction* fetchand64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHAND64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 8);
+	r1->wassignextended = (r1->size > 8);
+	
+	return i;
+}
+
+lyricalinstruction* fetchand (lyricalreg* r1, lyricalreg* r2) {
+	
+	if (sizeofgpr == 1) return fetchand8(r1, r2);
+	else if (sizeofgpr == 2) return fetchand16(r1, r2);
+	else if (sizeofgpr == 4) return fetchand32(r1, r2);
+	else if (sizeofgpr == 8) return fetchand64(r1, r2);
+}
+
+lyricalinstruction* fetchor8 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHOR8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 1);
+	r1->wassignextended = (r1->size > 1);
+	
+	return i;
+}
+
+lyricalinstruction* fetchor16 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHOR16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
+	
+	return i;
+}
+
+lyricalinstruction* fetchor32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHOR32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 4);
+	r1->wassignextended = (r1->size > 4);
+	
+	return i;
+}
+
+lyricalinstruction* fetchor64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFETCHOR64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The value that was in memory
+	// is zero extended in r1.
+	
+	r1->waszeroextended = (r1->size >= 8);
+	r1->wassignextended = (r1->size > 8);
+	
+	return i;
+}
+
+lyricalinstruction* fetchor (lyricalreg* r1, lyricalreg* r2) {
+	
+	if (sizeofgpr == 1) return fetchor8(r1, r2);
+	else if (sizeofgpr == 2) return fetchor16(r1, r2);
+	else if (sizeofgpr == 4) return fetchor32(r1, r2);
+	else if (sizeofgpr == 8) return fetchor64(r1, r2);
+}
+
+lyricalinstruction* fence () {
+	return newinstruction(currentfunc, LYRICALOPFENCE);
+}
+
+lyricalinstruction* vcpy (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVCPY);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	return i;
+}
+
+lyricalinstruction* vadd8 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVADD8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vadd16 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVADD16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vadd32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVADD32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vadd64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVADD64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vsub8 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVSUB8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vsub16 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVSUB16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vsub32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVSUB32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vsub64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVSUB64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vand (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVAND);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vor (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVOR);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vxor (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVXOR);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vcmpeq8 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVCMPEQ8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vcmpeq16 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVCMPEQ16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vcmpeq32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVCMPEQ32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	return i;
+}
+
+lyricalinstruction* vmovmsk8 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVMOVMSK8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	// The mask is 16bits
+	// and zero extended.
+	
+	r1->waszeroextended = (r1->size >= 2);
+	r1->wassignextended = (r1->size > 2);
+	
+	return i;
+}
+
+lyricalinstruction* vbcast8 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVBCAST8);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	return i;
+}
+
+lyricalinstruction* vbcast16 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVBCAST16);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	return i;
+}
+
+lyricalinstruction* vbcast32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVBCAST32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	return i;
+}
+
+lyricalinstruction* vbcast64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPVBCAST64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	return i;
+}
+
+lyricalinstruction* fadd32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFADD32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fadd64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFADD64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fsub32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFSUB32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fsub64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFSUB64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fmul32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFMUL32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fmul64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFMUL64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fdiv32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFDIV32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* fdiv64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFDIV64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* feq32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFEQ32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* feq64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFEQ64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* flt32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFLT32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* flt64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFLT64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* flte32 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFLTE32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* flte64 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPFLTE64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// The result is both sign and
+	// zero extended because only
+	// the lsb is set.
+	r1->waszeroextended = 1;
+	r1->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* itof32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPITOF32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* itof64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPITOF64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* f32toi (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPF32TOI);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* f64toi (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPF64TOI);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* f32tof64 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPF32TOF64);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* f64tof32 (lyricalreg* r1, lyricalreg* r2) {
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPF64TOF32);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	
+	r1->waszeroextended = 0;
+	r1->wassignextended = 0;
+	
+	return i;
+}
+
+lyricalinstruction* mem8cpy (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	// All operands are input-output.
+	
+	if (r1->id == r3->id) throwerror("the first and third operands cannot be the same");
+	else if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
+	else if (r2->id == r3->id) throwerror("the second and third operands cannot be the same");
+	
+	// I first generate a check
+	// to insure that the value
+	// of r3 will never be null.
+	// The check simplify the
+	// lyricalinstruction conversion
+	// by the backend.
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPJZ);
+	
+	i->r1 = r3->id;
+	
+	lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
+	imm->type = LYRICALIMMOFFSETTOINSTRUCTION;
+	
+	i->imm = imm;
+	
+	// I now generate the mem8cpy instruction.
+	
+	i = newinstruction(currentfunc, LYRICALOPMEM8CPY);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// I set the destination
+	// of the LYRICALOPJZ.
+	
+	i = newinstruction(currentfunc, LYRICALOPNOP);
+	
+	imm->i = i;
+	
+	// r1 is set sign extended if r3 is sign extended,
+	// and if r1->size >= r3->size.
+	// r2 is set sign extended if r3 is sign extended,
+	// and if r2->size >= r3->size.
+	// The value of r3 become zero, hence
+	// it is set both zero and sign extended.
+	
+	if (r1->wassignextended && r3->wassignextended && r1->size >= r3->size)
+		r1->wassignextended = 1;
+	else r1->wassignextended = 0;
+	
+	r1->waszeroextended = 0;
+	
+	if (r2->wassignextended && r3->wassignextended && r2->size >= r3->size)
+		r2->wassignextended = 1;
+	else r2->wassignextended = 0;
+	
+	r2->waszeroextended = 0;
+	
+	r3->waszeroextended = 1;
+	r3->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* mem8cpy2 (lyricalreg* r1, lyricalreg* r2, lyricalreg* r3) {
+	// All operands are input-output.
+	
+	if (r1->id == r3->id) throwerror("the first and third operands cannot be the same");
+	else if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
+	else if (r2->id == r3->id) throwerror("the second and third operands cannot be the same");
+	
+	// I first generate a check
+	// to insure that the value
+	// of r3 will never be null.
+	// The check simplify the
+	// lyricalinstruction conversion
+	// by the backend.
+	
+	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPJZ);
+	
+	i->r1 = r3->id;
+	
+	lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
+	imm->type = LYRICALIMMOFFSETTOINSTRUCTION;
+	
+	i->imm = imm;
+	
+	// I now generate the mem8cpy2 instruction.
+	
+	i = newinstruction(currentfunc, LYRICALOPMEM8CPY2);
+	
+	i->r1 = r1->id;
+	i->r2 = r2->id;
+	i->r3 = r3->id;
+	
+	// I set the destination
+	// of the LYRICALOPJZ.
+	
+	i = newinstruction(currentfunc, LYRICALOPNOP);
+	
+	imm->i = i;
+	
+	// r1 is set sign extended if r3 is sign extended,
+	// and if r1->size >= r3->size.
+	// r2 is set sign extended if r3 is sign extended,
+	// and if r2->size >= r3->size.
+	// The value of r3 become zero, hence
+	// it is set both zero and sign extended.
+	
+	if (r1->wassignextended && r3->wassignextended && r1->size >= r3->size)
+		r1->wassignextended = 1;
+	else r1->wassignextended = 0;
+	
+	r1->waszeroextended = 0;
+	
+	if (r2->wassignextended && r3->wassignextended && r2->size >= r3->size)
+		r2->wassignextended = 1;
+	else r2->wassignextended = 0;
+	
+	r2->waszeroextended = 0;
+	
+	r3->waszeroextended = 1;
+	r3->wassignextended = 1;
+	
+	return i;
+}
+
+lyricalinstruction* mem8cpyi (lyricalreg* r1, lyricalreg* r2, u64 n) {
+	// All operands are input-output,
+	// except the immediate value.
+	
+	if (r1->id == r2->id) throwerror("the first and second operands cannot be the same");
+	
+	if (!n) return 0;
 	
 	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPMEM8CPYI);
 	
@@ -4949,12 +6058,31 @@ lyricalinstruction* pagealloci (lyricalreg* r1, u64 n) {
 	return i;
 }
 
+// This function attach to the lyricalinstruction
+// pointed by i the immediate values for the address
+// of the stack page pool which is at the end of
+// the global variable region, after the variables
+// of the root function.
+void stackpagepoolimm (lyricalinstruction* i) {
+	
+	i->imm = mmallocz(sizeof(lyricalimmval));
+	i->imm->type = LYRICALIMMOFFSETTOGLOBALREGION;
+	
+	lyricalimmval* imm = mmallocz(sizeof(lyricalimmval));
+	imm->type = LYRICALIMMLOCALVARSSIZE;
+	imm->f = rootfunc;
+	
+	i->imm->next = imm;
+}
+
 lyricalinstruction* stackpagealloc (lyricalreg* r1) {
 	
 	lyricalinstruction* i = newinstruction(currentfunc, LYRICALOPSTACKPAGEALLOC);
 	
 	i->r1 = r1->id;
 	
+	stackpagepoolimm(i);
+	
 	// The sign and zero extension
 	// of the result register
 	// cannot be predicted.
@@ -4994,5 +6122,7 @@ lyricalinstruction* stackpagefree (lyricalreg* r1) {
 	
 	i->r1 = r1->id;
 	
+	stackpagepoolimm(i);
+	
 	return i;
 }
@@ -0,0 +1,875 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+
+// This file is included within lyricalcompile()
+// once immediate values have been reviewed, hence
+// immediate values of type LYRICALIMMOFFSETTOINSTRUCTION
+// point to the first lyricalinstruction of a block and
+// the offsets used with the stack pointer register
+// are immediate values of type LYRICALIMMVALUE.
+
+// Since all registers are flushed and discarded
+// at the start of a block (see LYRICALOPNOP),
+// a variable used within a loop get loaded
+// from the stackframe on every iteration.
+// A loop made of a single block is optimized
+// by dedicating to the loop registers which
+// are unused throughout the loop, so as to keep
+// results from one iteration to the next:
+// - A LYRICALOPMULI of a variable which is modified
+// within the loop only by adding a constant on every
+// iteration (induction variable) is replaced by
+// a LYRICALOPADDI of a register initialized before
+// the loop and incremented at the end of every iteration.
+// - A LYRICALOPMULI, LYRICALOPMULHI, LYRICALOPMULHUI,
+// LYRICALOPDIVI, LYRICALOPDIVUI, LYRICALOPMODI or
+// LYRICALOPMODUI of a variable which is not modified
+// within the loop is computed once before the loop.
+
+// Enum used with the field kind of loopvalue.
+typedef enum {
+	// The value is unknown.
+	LOOPVALUEUNKNOWN,
+	
+	// The value is the value that the stackframe
+	// location in the field offset had when the
+	// iteration started, added to the field n.
+	LOOPVALUEOFFSETTOSTACKFRAMEVALUE,
+	
+} loopvaluekind;
+
+// Structure describing the value of
+// a register or a stackframe location
+// within an iteration of a loop.
+typedef struct {
+	
+	loopvaluekind kind;
+	
+	u64 offset;
+	
+	u64 n;
+	
+} loopvalue;
+
+// Structure describing a store done
+// within an iteration of a loop.
+typedef struct {
+	// Offset from the stack pointer register
+	// of the stackframe location written.
+	u64 offset;
+	
+	// Byte size of the store;
+	// when null, the store could have
+	// been done anywhere in the stackframe.
+	uint size;
+	
+	loopvalue v;
+	
+} loopstore;
+
+// Structure describing
+// a lyricalinstruction
+// that can be optimized.
+typedef struct {
+	
+	lyricalinstruction* i;
+	
+	// Value of the register
+	// which is the input of
+	// the lyricalinstruction.
+	loopvalue v;
+	
+	// Register dedicated to the loop
+	// and which hold the result of
+	// the lyricalinstruction, or 0
+	// if the lyricalinstruction
+	// is not to be optimized.
+	uint r;
+	
+	// Value added to the dedicated register
+	// at the end of every iteration.
+	u64 step;
+	
+} loopcandidate;
+
+// This function return the sum
+// of the immediate values of
+// the lyricalinstruction pointed by i;
+// it return 0 if one of the immediate
+// values is not of type LYRICALIMMVALUE.
+uint loopimmvalue (lyricalinstruction* i, u64* n) {
+	
+	lyricalimmval* imm = i->imm;
+	
+	if (!imm) return 0;
+	
+	*n = 0;
+	
+	do {
+		if (imm->type != LYRICALIMMVALUE) return 0;
+		
+		*n += imm->n;
+		
+	} while (imm = imm->next);
+	
+	return 1;
+}
+
+// This function remove the register id from
+// the array of unused registers of the
+// lyricalinstruction pointed by i.
+void removeunusedreg (lyricalinstruction* i, uint id) {
+	
+	uint* u = i->unusedregs;
+	
+	if (!u) return;
+	
+	while (*u && *u != id) ++u;
+	
+	if (!*u) return;
+	
+	do u[0] = u[1]; while (*++u);
+}
+
+// This function create a lyricalinstruction
+// before the lyricalinstruction pointed by before.
+// The array of unused registers is duplicated
+// from the lyricalinstruction pointed by unusedregsfrom.
+lyricalinstruction* newloopinstruction (lyricalop op, uint r1, uint r2, lyricalinstruction* before, lyricalinstruction* unusedregsfrom) {
+	
+	lyricalinstruction* i = mmallocz(sizeof(lyricalinstruction));
+	
+	i->op = op;
+	i->r1 = r1;
+	i->r2 = r2;
+	
+	if (unusedregsfrom->unusedregs) {
+		
+		uint unusedregssz = mmsz(unusedregsfrom->unusedregs);
+		
+		i->unusedregs = mmalloc(unusedregssz);
+		
+		bytcpy(i->unusedregs, unusedregsfrom->unusedregs, unusedregssz);
+	}
+	
+	// Note that "prev" is used with
+	// the argument FIELDPREV of the macro
+	// LINKEDLISTCIRCULARADDTOBOTTOM()
+	// so that the lyricalinstruction
+	// get inserted before the one
+	// pointed by before.
+	LINKEDLISTCIRCULARADDTOBOTTOM(prev, next, i, before);
+	
+	return i;
+}
+
+// This function attach to the lyricalinstruction
+// pointed by i, an immediate value of type
+// LYRICALIMMVALUE set to n sign-extended.
+void setloopimmvalue (lyricalinstruction* i, s64 n) {
+	
+	n <<= ((8*sizeof(u64))-bitsizeofgpr);
+	n >>= ((8*sizeof(u64))-bitsizeofgpr);
+	
+	if (!i->imm) i->imm = mmallocz(sizeof(lyricalimmval));
+	
+	i->imm->type = LYRICALIMMVALUE;
+	i->imm->n = n;
+}
+
+// Load of a value which
+// has the size of a GPR.
+lyricalop ldgpr;
+
+switch (sizeofgpr) {
+	case 1: ldgpr = LYRICALOPLD8; break;
+	case 2: ldgpr = LYRICALOPLD16; break;
+	case 4: ldgpr = LYRICALOPLD32; break;
+	default: ldgpr = LYRICALOPLD64; break;
+}
+
+// This function optimize the loop starting
+// at the lyricalinstruction pointed by h and
+// ending with the branching lyricalinstruction
+// pointed by b, within the lyricalfunction f.
+// The array pointed by references contain
+// the lyricalinstruction of the function f
+// using an immediate value of type
+// LYRICALIMMOFFSETTOINSTRUCTION, and the
+// bintree order associate each lyricalinstruction
+// of the function f with its position.
+void optimizeloop (lyricalfunction* f, lyricalinstruction* h, lyricalinstruction* b, lyricalinstruction** references, uint referencescount, bintree order) {
+	
+	uint hpos = (uint)bintreefind(order, (uint)h);
+	uint bpos = (uint)bintreefind(order, (uint)b);
+	
+	// The only lyricalinstruction
+	// refering to the start of the loop
+	// must be the one ending the loop,
+	// and no lyricalinstruction can refer
+	// to a lyricalinstruction within
+	// the loop, otherwise the loop would
+	// not be made of a single block.
+	uint n = 0;
+	
+	while (n < referencescount) {
+		
+		lyricalinstruction* r = references[n];
+		
+		lyricalimmval* imm = r->imm;
+		
+		do {
+			if (imm->type == LYRICALIMMOFFSETTOINSTRUCTION) {
+				
+				if (imm->i == h) {
+					if (r != b) return;
+				} else {
+					
+					uint pos = (uint)bintreefind(order, (uint)imm->i);
+					
+					if (pos > hpos && pos <= bpos) return;
+				}
+			}
+			
+		} while (imm = imm->next);
+		
+		++n;
+	}
+	
+	// Find the LYRICALOPNOP preceding
+	// the start of the loop; instructions
+	// to execute before the loop are
+	// to be inserted before it.
+	lyricalinstruction* l = 0;
+	
+	lyricalinstruction* i = h;
+	
+	while (i != f->i->next) {
+		
+		i = i->prev;
+		
+		if (i->op == LYRICALOPNOP) l = i;
+		else if (i->op != LYRICALOPCOMMENT) break;
+	}
+	
+	if (!l || l == f->i->next) return;
+	
+	// Variable set to 1 if the stack pointer
+	// register is used within the loop for
+	// something else than the base address
+	// of a load or store; in which case
+	// stores through other registers
+	// could modify the stackframe.
+	uint stackaddrisused = 0;
+	
+	// Check that the loop only use
+	// lyricalinstruction that are understood.
+	i = h;
+	
+	while (1) {
+		
+		lyricalop op = i->op;
+		
+		if (op <= LYRICALOPSNZ) {
+			
+			if (!i->r1) return;
+			
+			if (!i->r2 || (!i->r3 && (
+				op == LYRICALOPADD || op == LYRICALOPSUB ||
+				op == LYRICALOPMUL || op == LYRICALOPMULH ||
+				op == LYRICALOPDIV || op == LYRICALOPMOD ||
+				op == LYRICALOPMULHU || op == LYRICALOPDIVU ||
+				op == LYRICALOPMODU || op == LYRICALOPAND ||
+				op == LYRICALOPOR || op == LYRICALOPXOR ||
+				op == LYRICALOPSLL || op == LYRICALOPSRL ||
+				op == LYRICALOPSRA || op == LYRICALOPROL ||
+				op == LYRICALOPROR || op == LYRICALOPSEQ ||
+				op == LYRICALOPSNE || op == LYRICALOPSLT ||
+				op == LYRICALOPSLTE || op == LYRICALOPSLTU ||
+				op == LYRICALOPSLTEU))) stackaddrisused = 1;
+				
+		} else if (op == LYRICALOPLI || op == LYRICALOPAFIP) {
+			
+			if (!i->r1) return;
+			
+		} else if (op >= LYRICALOPLD8 && op <= LYRICALOPLDST64I) {
+			
+			if (!i->r1) {
+				// A load cannot be done
+				// in the stack pointer register.
+				if (op <= LYRICALOPLD64I || op >= LYRICALOPLDST8) return;
+				else stackaddrisused = 1;
+			}
+			
+			// Only the forms (r2 + imm) use
+			// the stack pointer register as
+			// the base address of a load or store.
+			if (((op - LYRICALOPLD8) % 3) == 1 && !i->r2) stackaddrisused = 1;
+			
+		} else if (op >= LYRICALOPMEM8CPY && op <= LYRICALOPMEM64CPYI2) {
+			
+			if (!i->r1 || !i->r2) return;
+			
+			if ((op - LYRICALOPMEM8CPY) % 2 == 0 && !i->r3) return;
+			
+		} else if (op >= LYRICALOPVCPY && op <= LYRICALOPVBCAST64) {
+			
+			if (op == LYRICALOPVMOVMSK8) {
+				// The mask cannot be set
+				// in the stack pointer register.
+				if (!i->r1) return;
+				
+				if (!i->r2) stackaddrisused = 1;
+				
+			} else if (!i->r1 || !i->r2 || (!i->r3 &&
+				op >= LYRICALOPVADD8 && op <= LYRICALOPVCMPEQ32)) stackaddrisused = 1;
+				
+		} else if (op >= LYRICALOPFADD32 && op <= LYRICALOPF64TOF32) {
+			
+			if (!i->r1) return;
+			
+			if (!i->r2 || (!i->r3 && op <= LYRICALOPFLTE64)) stackaddrisused = 1;
+			
+		} else if (op == LYRICALOPJEQ || op == LYRICALOPJNE ||
+			op == LYRICALOPJLT || op == LYRICALOPJLTE ||
+			op == LYRICALOPJLTU || op == LYRICALOPJLTEU ||
+			op == LYRICALOPJZ || op == LYRICALOPJNZ || op == LYRICALOPJ) {
+			// Branching lyricalinstruction
+			// within the loop can only be
+			// leaving the loop, which has
+			// already been checked.
+			
+		} else if (op != LYRICALOPNOP && op != LYRICALOPCOMMENT) return;
+		
+		if (i == b) break;
+		
+		i = i->next;
+	}
+	
+	// Value of each register.
+	loopvalue* regs = mmallocz(nbrofgpr*sizeof(loopvalue));
+	
+	loopstore* stores = 0;
+	uint storescount = 0;
+	
+	loopcandidate* candidates = 0;
+	uint candidatescount = 0;
+	
+	// This function record a store
+	// done within the loop.
+	void newstore (u64 offset, uint size, loopvalue v) {
+		
+		stores = mmrealloc(stores, (storescount+1)*sizeof(loopstore));
+		
+		stores[storescount].offset = offset;
+		stores[storescount].size = size;
+		stores[storescount].v = v;
+		
+		++storescount;
+	}
+	
+	// This function return 1 if the store pointed by s
+	// overlap the stackframe location which has the size
+	// of a GPR and is at the offset given by the argument offset.
+	uint isstoreoverlapping (loopstore* s, u64 offset) {
+		return (!s->size || ((s64)(s->offset - offset) < (s64)sizeofgpr && (s64)(offset - s->offset) < (s64)s->size));
+	}
+	
+	// Evaluate the value of each register
+	// within an iteration of the loop.
+	i = h;
+	
+	while (1) {
+		
+		lyricalop op = i->op;
+		
+		u64 imm;
+		
+		if (op == LYRICALOPCPY) regs[i->r1] = regs[i->r2];
+		else if (op == LYRICALOPADDI) {
+			
+			if (regs[i->r2].kind == LOOPVALUEOFFSETTOSTACKFRAMEVALUE && loopimmvalue(i, &imm)) {
+				
+				regs[i->r1] = regs[i->r2];
+				regs[i->r1].n += imm;
+				
+			} else regs[i->r1].kind = LOOPVALUEUNKNOWN;
+			
+		} else if (op <= LYRICALOPSNZ ||
+			op == LYRICALOPLI || op == LYRICALOPAFIP) {
+			
+			if ((op == LYRICALOPMULI || op == LYRICALOPMULHI || op == LYRICALOPMULHUI ||
+				op == LYRICALOPDIVI || op == LYRICALOPDIVUI ||
+				op == LYRICALOPMODI || op == LYRICALOPMODUI) &&
+				regs[i->r2].kind == LOOPVALUEOFFSETTOSTACKFRAMEVALUE &&
+				i->imm->type == LYRICALIMMVALUE && !i->imm->next) {
+				
+				s64 divisor = i->imm->n;
+				
+				// A division which could trap
+				// must not be moved before the loop.
+				if (op == LYRICALOPMULI || op == LYRICALOPMULHI || op == LYRICALOPMULHUI ||
+					(divisor && (divisor != -1 || op == LYRICALOPDIVUI || op == LYRICALOPMODUI))) {
+					
+					candidates = mmrealloc(candidates, (candidatescount+1)*sizeof(loopcandidate));
+					
+					candidates[candidatescount].i = i;
+					candidates[candidatescount].v = regs[i->r2];
+					candidates[candidatescount].r = 0;
+					
+					++candidatescount;
+				}
+			}
+			
+			regs[i->r1].kind = LOOPVALUEUNKNOWN;
+			
+		} else if (op >= LYRICALOPLD8 && op <= LYRICALOPLDST64I) {
+			
+			uint isstore = (op >= LYRICALOPST8);
+			
+			// Byte size of the memory access.
+			uint size = 1<<(((op - LYRICALOPLD8) % 12) / 3);
+			
+			if (((op - LYRICALOPLD8) % 3) == 0 && !i->r2 && loopimmvalue(i, &imm)) {
+				// I get here for a load or
+				// store within the stackframe.
+				
+				if (isstore) newstore(imm, size, regs[i->r1]);
+				
+				if (!isstore || op >= LYRICALOPLDST8) {
+					
+					regs[i->r1].kind = LOOPVALUEUNKNOWN;
+					
+					if (op == ldgpr) {
+						// The value loaded is the value
+						// of the last store that was done
+						// at the same stackframe location,
+						// or the value at the start
+						// of the iteration if there
+						// was no such store.
+						
+						n = storescount;
+						
+						while (1) {
+							
+							if (!n) {
+								
+								regs[i->r1].kind = LOOPVALUEOFFSETTOSTACKFRAMEVALUE;
+								regs[i->r1].offset = imm;
+								regs[i->r1].n = 0;
+								
+								break;
+							}
+							
+							loopstore* s = &stores[--n];
+							
+							if (isstoreoverlapping(s, imm)) {
+								
+								if (s->size == sizeofgpr && s->offset == imm)
+									regs[i->r1] = s->v;
+									
+								break;
+							}
+						}
+					}
+				}
+				
+			} else {
+				
+				if (isstore && stackaddrisused)
+					newstore(0, 0, (loopvalue){.kind = LOOPVALUEUNKNOWN});
+					
+				if (!isstore || op >= LYRICALOPLDST8) regs[i->r1].kind = LOOPVALUEUNKNOWN;
+			}
+			
+		} else if (op >= LYRICALOPMEM8CPY && op <= LYRICALOPMEM64CPYI2) {
+			
+			if (stackaddrisused) newstore(0, 0, (loopvalue){.kind = LOOPVALUEUNKNOWN});
+			
+			regs[i->r1].kind = LOOPVALUEUNKNOWN;
+			regs[i->r2].kind = LOOPVALUEUNKNOWN;
+			
+			if ((op - LYRICALOPMEM8CPY) % 2 == 0) regs[i->r3].kind = LOOPVALUEUNKNOWN;
+			
+		} else if (op == LYRICALOPVMOVMSK8) regs[i->r1].kind = LOOPVALUEUNKNOWN;
+		else if (op >= LYRICALOPVCPY && op <= LYRICALOPVBCAST64) {
+			// The 128bits vector is stored
+			// at the address in r1.
+			if (stackaddrisused) newstore(0, 0, (loopvalue){.kind = LOOPVALUEUNKNOWN});
+			
+		} else if (op >= LYRICALOPFADD32 && op <= LYRICALOPF64TOF32)
+			regs[i->r1].kind = LOOPVALUEUNKNOWN;
+		
+		if (i == b) break;
+		
+		i = i->next;
+	}
+	
+	// Array of registers which are
+	// unused throughout the loop.
+	uint* unusedregs = 0;
+	uint unusedregscount = 0;
+	
+	if (l->unusedregs) {
+		
+		uint* u = l->unusedregs;
+		
+		while (*u) {
+			
+			unusedregs = mmrealloc(unusedregs, (unusedregscount+1)*sizeof(uint));
+			
+			unusedregs[unusedregscount++] = *u++;
+		}
+	}
+	
+	i = l;
+	
+	while (unusedregscount) {
+		
+		if (i->op != LYRICALOPCOMMENT) {
+			
+			n = 0;
+			
+			while (n < unusedregscount) {
+				
+				uint* u = i->unusedregs;
+				
+				if (u) while (*u && *u != unusedregs[n]) ++u;
+				
+				if (!u || !*u) unusedregs[n] = unusedregs[--unusedregscount];
+				else ++n;
+			}
+		}
+		
+		if (i == b) break;
+		
+		i = i->next;
+	}
+	
+	// The count of registers dedicated to the loop
+	// must leave to every lyricalinstruction of the loop,
+	// and to every lyricalinstruction inserted before
+	// the loop, the minimum count of unused registers
+	// that the backend require for its lyricalop.
+	uint maxdedicatedregs = unusedregscount;
+	
+	uint minunusedregcount (lyricalinstruction* i, lyricalop op) {
+		
+		uint count = 0;
+		
+		if (i->unusedregs) while (i->unusedregs[count]) ++count;
+		
+		uint min = compilearg->minunusedregcountforop[op];
+		
+		return ((count > min) ? (count - min) : 0);
+	}
+	
+	lyricalop ops[] = {
+		ldgpr, LYRICALOPADDI, LYRICALOPMULI,
+		LYRICALOPMULHI, LYRICALOPMULHUI,
+		LYRICALOPDIVI, LYRICALOPDIVUI,
+		LYRICALOPMODI, LYRICALOPMODUI};
+	
+	n = 0;
+	
+	do {
+		uint count = minunusedregcount(l, ops[n]);
+		
+		if (maxdedicatedregs > count) maxdedicatedregs = count;
+		
+	} while (++n < (sizeof(ops)/sizeof(lyricalop)));
+	
+	i = l;
+	
+	while (maxdedicatedregs) {
+		
+		if (i->op < LYRICALOPNOP) {
+			
+			uint count = minunusedregcount(i, i->op);
+			
+			if (maxdedicatedregs > count) maxdedicatedregs = count;
+		}
+		
+		if (i == b) break;
+		
+		i = i->next;
+	}
+	
+	// Registers dedicated to the loop.
+	uint* dedicatedregs = 0;
+	uint dedicatedregscount = 0;
+	
+	// First lyricalinstruction
+	// inserted before the loop.
+	lyricalinstruction* preheader = 0;
+	
+	// Decide which lyricalinstruction
+	// get optimized, using a single
+	// dedicated register for similar
+	// lyricalinstruction.
+	// When the lyricalinstruction is
+	// a LYRICALOPMULI, the dedicated register
+	// hold the product of the value that
+	// its input had at the start of
+	// the iteration; otherwise the dedicated
+	// register hold its result.
+	n = 0;
+	
+	while (n < candidatescount) {
+		
+		loopcandidate* c = &candidates[n];
+		
+		lyricalop op = c->i->op;
+		
+		s64 step = 0;
+		
+		// The value at the stackframe location
+		// at the end of an iteration is the value
+		// of the last store done at that location.
+		uint m = storescount;
+		
+		while (m) {
+			
+			loopstore* s = &stores[--m];
+			
+			if (isstoreoverlapping(s, c->v.offset)) {
+				
+				if (s->size != sizeofgpr || s->offset != c->v.offset ||
+					s->v.kind != LOOPVALUEOFFSETTOSTACKFRAMEVALUE ||
+					s->v.offset != c->v.offset) goto skipcandidate;
+					
+				step = s->v.n;
+				
+				break;
+			}
+		}
+		
+		// There must be no other store
+		// overlapping the stackframe location
+		// without exactly matching it.
+		while (m) {
+			
+			loopstore* s = &stores[--m];
+			
+			if (isstoreoverlapping(s, c->v.offset) &&
+				(s->size != sizeofgpr || s->offset != c->v.offset))
+				goto skipcandidate;
+		}
+		
+		// A value which is modified on every
+		// iteration can only be used with
+		// a multiplication, since the result
+		// can then be computed with an addition.
+		if (step && op != LYRICALOPMULI) goto skipcandidate;
+		
+		// Re-use the register of a similar
+		// lyricalinstruction, if any.
+		m = 0;
+		
+		while (m < n) {
+			
+			loopcandidate* cc = &candidates[m];
+			
+			if (cc->r && cc->i->op == op &&
+				cc->v.offset == c->v.offset &&
+				cc->i->imm->n == c->i->imm->n &&
+				(op == LYRICALOPMULI || cc->v.n == c->v.n)) {
+				
+				c->r = cc->r;
+				
+				goto skipcandidate;
+			}
+			
+			++m;
+		}
+		
+		if (dedicatedregscount == maxdedicatedregs) goto skipcandidate;
+		
+		c->r = unusedregs[--unusedregscount];
+		
+		dedicatedregs = mmrealloc(dedicatedregs, (dedicatedregscount+1)*sizeof(uint));
+		
+		dedicatedregs[dedicatedregscount++] = c->r;
+		
+		c->step = step*(s64)c->i->imm->n;
+		
+		// Instructions computing the value
+		// of the dedicated register before the loop.
+		
+		i = newloopinstruction(ldgpr, c->r, 0, l, l);
+		setloopimmvalue(i, c->v.offset);
+		
+		if (!preheader) preheader = i;
+		
+		if (c->v.n && op != LYRICALOPMULI)
+			setloopimmvalue(newloopinstruction(LYRICALOPADDI, c->r, c->r, l, l), c->v.n);
+			
+		setloopimmvalue(newloopinstruction(op, c->r, c->r, l, l), c->i->imm->n);
+		
+		if (c->step) setloopimmvalue(newloopinstruction(LYRICALOPADDI, c->r, c->r, b, b), c->step);
+		
+		skipcandidate:
+		
+		++n;
+	}
+	
+	// Replace optimized lyricalinstruction.
+	n = 0;
+	
+	while (n < candidatescount) {
+		
+		loopcandidate* c = &candidates[n];
+		
+		if (c->r) {
+			
+			i = c->i;
+			
+			s64 offset = (s64)c->v.n * (s64)i->imm->n;
+			
+			i->r2 = c->r;
+			
+			if (i->op == LYRICALOPMULI && offset) {
+				
+				i->op = LYRICALOPADDI;
+				
+				setloopimmvalue(i, offset);
+				
+			} else {
+				
+				i->op = LYRICALOPCPY;
+				
+				mmrefdown(i->imm);
+				i->imm = 0;
+			}
+		}
+		
+		++n;
+	}
+	
+	if (preheader) {
+		// The registers dedicated to the loop
+		// must not be seen as unused from the
+		// first lyricalinstruction inserted
+		// before the loop to the end of the loop.
+		i = preheader;
+		
+		do {
+			n = 0;
+			
+			while (n < dedicatedregscount) removeunusedreg(i, dedicatedregs[n++]);
+			
+		} while ((i = i->next) != b->next);
+		
+		mmrefdown(dedicatedregs);
+	}
+	
+	mmrefdown(regs);
+	
+	if (stores) mmrefdown(stores);
+	
+	if (candidates) mmrefdown(candidates);
+	
+	if (unusedregs) mmrefdown(unusedregs);
+}
+
+// When I get here, f == rootfunc;
+
+do {
+	// Only functions in which the address of
+	// a variable residing in the stackframe is never
+	// obtained are optimized, so that the stackframe
+	// can only be modified through loads and stores
+	// using the stack pointer register.
+	if (!f->i || f->firstpass->localaddrisobtained) continue;
+	
+	bintree order = bintreenull;
+	
+	lyricalinstruction** references = 0;
+	uint referencescount = 0;
+	
+	lyricalinstruction** loopends = 0;
+	uint loopendscount = 0;
+	
+	lyricalinstruction* i = f->i->next;
+	
+	uint pos = 0;
+	
+	do {
+		bintreeadd(&order, (uint)i, (void*)++pos);
+		
+		lyricalimmval* imm = i->imm;
+		
+		if (i->op != LYRICALOPCOMMENT && i->op != LYRICALOPMACHINECODE) while (imm) {
+			
+			if (imm->type == LYRICALIMMOFFSETTOINSTRUCTION) {
+				
+				references = mmrealloc(references, (referencescount+1)*sizeof(lyricalinstruction*));
+				
+				references[referencescount++] = i;
+				
+				break;
+			}
+			
+			imm = imm->next;
+		}
+		
+	} while ((i = i->next) != f->i->next);
+	
+	// A loop end with a branching lyricalinstruction
+	// to a lyricalinstruction which precede it.
+	uint n = 0;
+	
+	while (n < referencescount) {
+		
+		i = references[n];
+		
+		lyricalop op = i->op;
+		
+		if ((op == LYRICALOPJ || op == LYRICALOPJNZ || op == LYRICALOPJZ ||
+			op == LYRICALOPJEQ || op == LYRICALOPJNE ||
+			op == LYRICALOPJLT || op == LYRICALOPJLTE ||
+			op == LYRICALOPJLTU || op == LYRICALOPJLTEU) &&
+			(uint)bintreefind(order, (uint)i->imm->i) <= (uint)bintreefind(order, (uint)i)) {
+			
+			loopends = mmrealloc(loopends, (loopendscount+1)*sizeof(lyricalinstruction*));
+			
+			loopends[loopendscount++] = i;
+		}
+		
+		++n;
+	}
+	
+	n = 0;
+	
+	while (n < loopendscount) {
+		
+		i = loopends[n];
+		
+		optimizeloop(f, i->imm->i, i, references, referencescount, order);
+		
+		++n;
+	}
+	
+	if (references) mmrefdown(references);
+	
+	if (loopends) mmrefdown(loopends);
+	
+	bintreeempty(&order);
+	
+} while ((f = f->next) != rootfunc);
@@ -43,6 +43,17 @@ lyricallabeledinstructiontoresolve* linkedlistoflabeledinstructiontoresolve = 0;
 string labelnameforendofloop = stringnull;
 string labelnameforcontinuestatement = stringnull;
 
+// When a return statement is made only of a call
+// to the function being defined, this variable is
+// set to the location of the opening paranthesis
+// of that call, which is where curpos is set when
+// callfunctionnow() is used for that call; and
+// it is set back to null by generatefunctioncall()
+// once it has generated the instructions re-using
+// the stackframe of the function being defined.
+// This variable is used only in the secondpass.
+u8* tailcallpos = 0;
+
 // This variable point to a linkedlist of arguments
 // linked through their fields prevregisteredarg
 // and nextregisteredarg. The linkedlist is used by
@@ -120,6 +131,42 @@ typedef struct {
 // restored to its initilial state when done with the firstpass.
 switchblock* currentswitchblock = 0;
 
+// Constants used when lowering a switch() block.
+enum {
+	// Minimum number of switch() cases
+	// needed to create a jumptable;
+	// a group of fewer switch() cases
+	// is tested using comparisons.
+	SWITCHJUMPTABLEMINCASECOUNT = 4,
+	
+	// A jumptable is created for a group of
+	// switch() cases only if the range of
+	// values that it cover is less than
+	// or equal to SWITCHJUMPTABLEMAXSPARSENESS
+	// times its number of switch() cases.
+	SWITCHJUMPTABLEMAXSPARSENESS = 3,
+	
+	// Maximum number of switch() cases
+	// tested one after the other before
+	// splitting the tests in a binary search.
+	SWITCHLINEARSEARCHMAXCASECOUNT = 4,
+};
+
+// Structure representing a group of
+// switch() cases used when lowering
+// a switch() block; the fields first
+// and last are indexes of the first and
+// last switch() case value of the group.
+// When the group has more than one
+// switch() case, a jumptable is used.
+typedef struct {
+	
+	uint first;
+	
+	uint last;
+	
+} switchcluster;
+
 // This string is used when statementparsingflag
 // is set to PARSEPOINTERTOFUNCTIONTYPE or PARSEFUNCTIONSIGNATURE;
 // I call parsestatement() that way when respectively parsing
@@ -405,18 +452,15 @@ void parsestatement (parsestatementflag statementparsingflag) {
 	// it can be used within funcdeclaration().
 	u8* startofdeclaration;
 	
-	// Variable set depending on whether
-	// function export was inferred
-	// through characters' sequence that
-	// were injected by the preprocessor.
-	static uint isexportinferred = 0;
-	
 	#include "funcdeclaration.parsestatement.lyrical.c"
 	
 	if (statementparsingflag == PARSEFUNCTIONBODY) {
 		// I get here when starting the parsing of a function.
 		
 		if (currentfunc == rootfunc) {
+			// The variable may have been
+			// left set by the first pass.
+			isexportinferred = 0;
 			
 			if (rootfunc->vlocal) {
 				// The global variable region
@@ -1484,12 +1528,6 @@ void parsestatement (parsestatementflag statementparsingflag) {
 			// If I get here, I parse the definition
 			// of a struct/pstruct/union.
 			
-			// This static variable is used to remember
-			// what is the owner of an anonymous struct/pstruct/union
-			// when recursively calling parsestatement()
-			// to parse nested anonymous struct/pstruct/union.
-			static lyricaltype* ownerofanonymoustype;
-			
 			// Here I save the current value of curpos and
 			// skip till after the closing brace of
 			// the definition of the struct/pstruct/union in order
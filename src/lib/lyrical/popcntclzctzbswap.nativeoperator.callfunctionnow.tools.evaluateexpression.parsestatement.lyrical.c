@@ -0,0 +1,199 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+// The builtin functions popcnt(), clz()
+// and ctz() compute their result using
+// only the bits of the type with which
+// their argument was pushed; their result
+// variable has the type uint.
+// The builtin function bswap() reverse
+// the order of the bytes of the type with
+// which its argument was pushed; its result
+// variable has the same type as its argument.
+
+// I set the bitsize of the type
+// with which the argument was pushed.
+argbitsize = 8*sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+
+// I set the type of the result variable.
+builtinresulttype = (*name == 'b') ? funcarg->typepushed : largeenoughunsignednativetype(sizeofgpr);
+
+
+if (funcarg->v->isnumber) {
+	// If I get here, the argument is a number
+	// which should translate to an immediate value
+	// when generating the instruction.
+	// Note that constant variables cannot be bitselected
+	// because they do not reside in memory.
+	
+	imm1 = ifnativetypedosignorzeroextend(funcarg->v->numbervalue, funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+	
+	r1 = 0;
+	
+} else r1 = (lyricalreg*)-1;
+
+
+// If the only argument is a number,
+// the return variable should be a number.
+if (!r1) {
+	
+	// I only keep the bits of the type
+	// with which the argument was pushed.
+	if (argbitsize < 64) imm1 &= (((u64)1<<argbitsize)-1);
+	
+	immresult = 0;
+	
+	uint i;
+	
+	if (*name == 'p') {
+		
+		for (i = 0; i < argbitsize; ++i)
+			immresult += ((imm1>>i)&1);
+			
+	} else if (*name == 'b') {
+		
+		for (i = 0; i < argbitsize; i += 8)
+			immresult |= (((imm1>>i)&0xff)<<(argbitsize-8-i));
+			
+	} else if (name[1] == 'l') {
+		
+		for (i = argbitsize; i && !((imm1>>(i-1))&1); --i)
+			++immresult;
+			
+	} else {
+		
+		for (i = 0; i < argbitsize && !((imm1>>i)&1); ++i)
+			++immresult;
+	}
+	
+	// Note that getvarnumber() will duplicate
+	// the string pointed by builtinresulttype.ptr
+	// before using it, so I don't need to
+	// give it a duplicated string.
+	resultvar = getvarnumber(immresult, builtinresulttype);
+	
+	break;
+}
+
+
+// Instructions are not generated in the firstpass.
+// So here, only the result variable is created.
+if (!compilepass) {
+	// I create the result variable.
+	resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+	
+	resultvar->name = generatetempvarname(resultvar);
+	
+	// Set the type of the result variable.
+	resultvar->type = stringduplicate1(builtinresulttype);
+	
+	break;
+}
+
+
+// I use the type and bitselect with
+// which the variable was pushed.
+r1 = getregforvar(funcarg->v, 0, funcarg->typepushed, funcarg->bitselect, FORINPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+r1->lock = 1;
+
+
+// I compute the result value.
+
+// I create the result variable.
+resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+
+resultvar->name = generatetempvarname(resultvar);
+
+// Set the type of the result variable.
+resultvar->type = stringduplicate1(builtinresulttype);
+
+// The register obtained will be appropriately
+// set dirty and setregtothebottom() will
+// be called on it before getregforvar() return.
+rresult = getregforvar(resultvar, 0, resultvar->type, 0, FOROUTPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+rresult->lock = 1;
+
+if (*name == 'p') {
+	// The bits above the type of
+	// the argument must not be counted.
+	if (zxt(rresult, r1, argbitsize)) popcnt(rresult, rresult);
+	else popcnt(rresult, r1);
+	
+} else if (*name == 'b') {
+	// The reversed bytes of the type
+	// of the argument end up in the most
+	// significant bytes of the register,
+	// from where they are shifted down.
+	if (argbitsize == 8) cpy(rresult, r1);
+	else {
+		bswap(rresult, r1);
+		
+		if (argbitsize < bitsizeofgpr) srli(rresult, rresult, bitsizeofgpr - argbitsize);
+	}
+	
+} else if (name[1] == 'l') {
+	// The leading null bits above the type
+	// of the argument are counted by clz()
+	// and must be substracted from its result.
+	if (zxt(rresult, r1, argbitsize)) {
+		
+		clz(rresult, rresult);
+		
+		addi(rresult, rresult, -(u64)(bitsizeofgpr - argbitsize));
+		
+	} else clz(rresult, r1);
+	
+} else {
+	// The argument is shifted to the most
+	// significant bits of the register, which
+	// drop the bits above its type; the trailing
+	// null bits added by the shift are then
+	// substracted from the result of ctz(), which
+	// is the bitsize of a gpr when the argument
+	// is null, hence the result is limited
+	// to the bitsize of the type of the argument.
+	// Setting the bit right above the type of
+	// the argument with an ori would need
+	// an immediate value of 32bits or more
+	// for an argument of type u32 on a 64bits gpr.
+	if (argbitsize < bitsizeofgpr) {
+		
+		slli(rresult, r1, bitsizeofgpr - argbitsize);
+		
+		ctz(rresult, rresult);
+		
+		addi(rresult, rresult, -(u64)(bitsizeofgpr - argbitsize));
+		
+	} else ctz(rresult, r1);
+}
+
+
+// I unlock the registers that were allocated
+// and locked for the operands.
+// Locked registers must be unlocked only after
+// the instructions using them have been generated;
+// otherwise they could be lost when insureenoughunusedregisters()
+// is called while creating a new lyricalinstruction.
+r1->lock = 0;
+rresult->lock = 0;
@@ -40,8 +40,12 @@ chunk* moduleschunks = 0;
 // This function attach the linkedlist
 // of chunk given as argument to
 // the linkedlist pointed by moduleschunks.
+// The linkedlist given as argument is null
+// when the source only include modules.
 void attachmodulechunks (chunk* linkedlist) {
 	
+	if (!linkedlist) return;
+	
 	if (moduleschunks) {
 		
 		chunk* savedchunkprev = moduleschunks->prev;
@@ -58,6 +62,136 @@ void attachmodulechunks (chunk* linkedlist) {
 
 curpos = compileargsource;
 
+// This structure represent a macro.
+typedef struct macro {
+	// This field is set for a macro created from
+	// a lyricalpredeclaredmacro or for a macro
+	// created when the directive `foreach is used.
+	// When set, it mean that the fields chunks->origin,
+	// chunks->path, chunks->offset and chunks->linenumber
+	// are determined when the name of this macro
+	// is parsed and its single chunk duplicated.
+	uint chunklocationtsetwhenused;
+	
+	// This field is set to 1 while the macro is
+	// being defined otherwise it is set to null.
+	uint isbeingdefined;
+	
+	// This field is set to 1 for a macro
+	// that was defined using the preprocessor
+	// directive `locdef instead of `define .
+	uint islocal;
+	
+	// Set to 1 if the macro was used
+	// at least once, otherwise it is null.
+	// This field is used only with macro that
+	// are arguments of a function-like macro,
+	// and with for-loop macro.
+	uint wasused;
+	
+	// This field is used so as to be able
+	// to include in an error message the location
+	// where the macro was defined.
+	// For a macro that was not created from
+	// a lyricalpredeclaredmacro, this field
+	// is set to a string that is the filepath
+	// and linenumber where the macro was defined. ei:
+	// filepath.lyc:123.
+	// For a macro that was created from an
+	// lyricalpredeclaredmacro, this field is set
+	// to the string: "creation of predeclared macros".
+	string origin;
+	
+	// Name of the macro.
+	string name;
+	
+	// When set, the macro cannot be undefined
+	// by the preprocessor directive `undef.
+	uint cannotbeundefined;
+	
+	// Content of the macro which is
+	// a circular linkedlist of chunk.
+	chunk* chunks;
+	
+	// Pointer to an array of macro
+	// that are the arguments of this macro.
+	// This field is only set for
+	// function-like macro.
+	struct macro** args;
+	
+	// Number of arguments used
+	// by this macro.
+	// This field is only set for
+	// function-like macro.
+	uint nbrofargs;
+	
+	// The field prev of the first element of
+	// the linkedlist point to the last element
+	// of the linkedlist while the field next
+	// of the last element of the linkedlist
+	// point to the first element of
+	// the linkedlist.
+	struct macro* prev;
+	struct macro* next;
+	
+} macro;
+
+// This variable point to the circular
+// linkedlist of macro.
+// It and the variables below are shared by
+// the recursive calls of preprocessor(); they are
+// declared here instead of as static variables
+// within preprocessor() so that each call
+// of lyricalcompile() use its own.
+macro* macros = 0;
+
+// This structure represent an included file.
+typedef struct includedfile {
+	// This field is set to a string that
+	// is the filepath and linenumber where
+	// the include directive was used. ei:
+	// filepath.lyc:123.
+	string origin;
+	
+	// This field is set to the filepath.
+	string filepath;
+	
+	// The field prev of the first element
+	// of the linkedlist is null.
+	struct includedfile* prev;
+	
+} includedfile;
+
+// This variable keep in a linkedlist,
+// includedfile that represent files currently
+// being included and still being preprocessed.
+includedfile* includedfiles = 0;
+
+// This variable is set to 1 while preprocessing
+// a module .lyc file whose functions are to be
+// imported, or a file that it includes.
+uint isinimportedmodulelyc = 0;
+
+// This variable save the string that is used
+// by createchunk() to set the field origin
+// of the struct chunk.
+string chunkorigin = stringnull;
+
+// This variable is incremented by
+// the preprocessor directives which effect
+// outlive the file in which they are used;
+// it is used to determine whether the result
+// of preprocessing an included file can be
+// saved using compilearg->savepreprocessed .
+uint preprocessorsideeffectcount = 0;
+
+// This variable is non-null while
+// preprocessing the body of a `foreach block,
+// since whether its loop macro get used
+// is not part of the result of
+// preprocessing an included file.
+uint foreachblockdepth = 0;
+
 // Enum used by preprocessor().
 typedef enum {
 	// Used with the first call of preprocessor()
@@ -99,83 +233,6 @@ typedef enum {
 // This function recursively preprocess
 // the source code using the variable curpos.
 chunk* preprocessor (preprocessoraction action) {
-	// This structure represent a macro.
-	typedef struct macro {
-		// This field is set for a macro created from
-		// a lyricalpredeclaredmacro or for a macro
-		// created when the directive `foreach is used.
-		// When set, it mean that the fields chunks->origin,
-		// chunks->path, chunks->offset and chunks->linenumber
-		// are determined when the name of this macro
-		// is parsed and its single chunk duplicated.
-		uint chunklocationtsetwhenused;
-		
-		// This field is set to 1 while the macro is
-		// being defined otherwise it is set to null.
-		uint isbeingdefined;
-		
-		// This field is set to 1 for a macro
-		// that was defined using the preprocessor
-		// directive `locdef instead of `define .
-		uint islocal;
-		
-		// Set to 1 if the macro was used
-		// at least once, otherwise it is null.
-		// This field is used only with macro that
-		// are arguments of a function-like macro,
-		// and with for-loop macro.
-		uint wasused;
-		
-		// This field is used so as to be able
-		// to include in an error message the location
-		// where the macro was defined.
-		// For a macro that was not created from
-		// a lyricalpredeclaredmacro, this field
-		// is set to a string that is the filepath
-		// and linenumber where the macro was defined. ei:
-		// filepath.lyc:123.
-		// For a macro that was created from an
-		// lyricalpredeclaredmacro, this field is set
-		// to the string: "creation of predeclared macros".
-		string origin;
-		
-		// Name of the macro.
-		string name;
-		
-		// When set, the macro cannot be undefined
-		// by the preprocessor directive `undef.
-		uint cannotbeundefined;
-		
-		// Content of the macro which is
-		// a circular linkedlist of chunk.
-		chunk* chunks;
-		
-		// Pointer to an array of macro
-		// that are the arguments of this macro.
-		// This field is only set for
-		// function-like macro.
-		struct macro** args;
-		
-		// Number of arguments used
-		// by this macro.
-		// This field is only set for
-		// function-like macro.
-		uint nbrofargs;
-		
-		// The field prev of the first element of
-		// the linkedlist point to the last element
-		// of the linkedlist while the field next
-		// of the last element of the linkedlist
-		// point to the first element of
-		// the linkedlist.
-		struct macro* prev;
-		struct macro* next;
-		
-	} macro;
-	
-	// This variable point to the circular
-	// linkedlist of macro.
-	static macro* macros = 0;
 	
 	if (action == PREPROCESSBEGIN && compilearg->predeclaredmacros) {
 		// If I get here, I create the predeclared macros.
@@ -228,11 +285,6 @@ chunk* preprocessor (preprocessoraction action) {
 	// within the instance of this function.
 	chunk* chunks = 0;
 	
-	// This variable save the string that is used
-	// by createchunk() to set the field origin
-	// of the struct chunk.
-	static string chunkorigin = stringnull;
-	
 	// Variables used to save the location where
 	// a chunk to create start and end in the file
 	// being preprocessed.
@@ -875,6 +927,8 @@ chunk* preprocessor (preprocessoraction action) {
 					throwerror("invalid use of preprocessor directive");
 				}
 				
+				++preprocessorsideeffectcount;
+				
 				#include "include.preprocessor.lyrical.c"
 				
 			} else if (checkfordirective("define") || checkfordirective("locdef")) {
@@ -909,6 +963,8 @@ chunk* preprocessor (preprocessoraction action) {
 					throwerror("invalid use of preprocessor directive");
 				}
 				
+				++preprocessorsideeffectcount;
+				
 				#include "undef.preprocessor.lyrical.c"
 				
 			} else if (checkfordirective("ifdef")) {
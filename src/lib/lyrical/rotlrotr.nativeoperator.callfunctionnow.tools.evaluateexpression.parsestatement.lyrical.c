@@ -0,0 +1,182 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+// The builtin functions rotl() and rotr()
+// rotate the bits of the type with which
+// their first argument was pushed, by the
+// count of bits given by their second argument
+// modulo the bitsize of that type; their result
+// variable has the same type as their first argument.
+// When that type is smaller than a gpr, its value
+// is replicated throughout the gpr, so that
+// rotating the entire gpr leave in its least
+// significant bits the result of rotating
+// only the bits of that type.
+
+// I set the bitsize of the type with
+// which the first argument was pushed.
+argbitsize = 8*sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+
+
+if (funcarg->v->isnumber) {
+	// If I get here, the argument is a number
+	// which should translate to an immediate value
+	// when generating the instruction.
+	// Note that constant variables cannot be bitselected
+	// because they do not reside in memory.
+	
+	imm1 = ifnativetypedosignorzeroextend(funcarg->v->numbervalue, funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+	
+	// I only keep the bits of the type
+	// with which the argument was pushed.
+	if (argbitsize < 64) imm1 &= (((u64)1<<argbitsize)-1);
+	
+	r1 = 0;
+	
+} else r1 = (lyricalreg*)-1;
+
+
+if (funcarg->next->v->isnumber) {
+	// If I get here, the argument is a number
+	// which should translate to an immediate value
+	// when generating the instruction.
+	// Note that constant variables cannot be bitselected
+	// because they do not reside in memory.
+	
+	imm2 = ifnativetypedosignorzeroextend(funcarg->next->v->numbervalue, funcarg->next->typepushed.ptr, stringmmsz(funcarg->next->typepushed));
+	
+	// The rotation is done modulo
+	// the bitsize of the type of
+	// the first argument; and a
+	// rotate right is converted
+	// to a rotate left.
+	imm2 &= (argbitsize-1);
+	
+	if (name[3] == 'r') imm2 = ((argbitsize - imm2)&(argbitsize-1));
+	
+	r2 = 0;
+	
+} else r2 = (lyricalreg*)-1;
+
+
+// If the first and second arguments are numbers,
+// the return variable should be a number.
+if (!(r1 || r2)) {
+	
+	if (imm2) {
+		
+		immresult = ((imm1 << imm2) | (imm1 >> (argbitsize - imm2)));
+		
+		if (argbitsize < 64) immresult &= (((u64)1<<argbitsize)-1);
+		
+	} else immresult = imm1;
+	
+	// Note that getvarnumber() will duplicate
+	// the string pointed by funcarg->typepushed.ptr
+	// before using it, so I don't need to
+	// give it a duplicated string.
+	resultvar = getvarnumber(immresult, funcarg->typepushed);
+	
+	break;
+}
+
+
+// Instructions are not generated in the firstpass.
+// So here, only the result variable is created.
+if (!compilepass) {
+	// I create the result variable.
+	resultvar = varalloc(sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed)), LOOKFORAHOLE);
+	
+	resultvar->name = generatetempvarname(resultvar);
+	
+	// Set the type of the result variable.
+	resultvar->type = stringduplicate1(funcarg->typepushed);
+	
+	break;
+}
+
+
+if (r1) {
+	// I use the type and bitselect with
+	// which the variable was pushed.
+	r1 = getregforvar(funcarg->v, 0, funcarg->typepushed, funcarg->bitselect, FORINPUT);
+	
+	// I lock the register to prevent
+	// a call of allocreg() from using it.
+	r1->lock = 1;
+}
+
+
+if (r2) {
+	// I use the type and bitselect with
+	// which the variable was pushed.
+	r2 = getregforvar(funcarg->next->v, 0, funcarg->next->typepushed, funcarg->next->bitselect, FORINPUT);
+	
+	// I lock the register to prevent
+	// a call of allocreg() from using it.
+	r2->lock = 1;
+}
+
+
+// I compute the result value.
+
+// I create the result variable.
+resultvar = varalloc(sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed)), LOOKFORAHOLE);
+
+resultvar->name = generatetempvarname(resultvar);
+
+// Set the type of the result variable.
+resultvar->type = stringduplicate1(funcarg->typepushed);
+
+// The register obtained will be appropriately
+// set dirty and setregtothebottom() will
+// be called on it before getregforvar() return.
+rresult = getregforvar(resultvar, 0, resultvar->type, 0, FOROUTPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+rresult->lock = 1;
+
+// I load in rresult the value to rotate,
+// replicated throughout the gpr when
+// its type is smaller than a gpr.
+if (r1) {
+	
+	if (zxt(rresult, r1, argbitsize)) muli(rresult, rresult, replicatemultiplier(argbitsize));
+	else cpy(rresult, r1);
+	
+} else li(rresult, imm1*replicatemultiplier(argbitsize));
+
+if (r2) {
+	// I get here if the second
+	// argument is not an immediate value.
+	if (name[3] == 'l') rol(rresult, rresult, r2);
+	else ror(rresult, rresult, r2);
+	
+} else roli(rresult, rresult, imm2);
+
+
+// I unlock the registers that were allocated
+// and locked for the operands.
+// Locked registers must be unlocked only after
+// the instructions using them have been generated;
+// otherwise they could be lost when insureenoughunusedregisters()
+// is called while creating a new lyricalinstruction.
+if (r1) r1->lock = 0;
+if (r2) r2->lock = 0;
+rresult->lock = 0;
@@ -282,14 +282,14 @@ if (r2) {
 	if (*funcarg->typepushed.ptr == 'u') {
 		
 		if (*name == '*') muli(r1, r1, imm2);
-		else if (*name == '/') divui(r1, r1, imm2);
-		else modui(r1, r1, imm2);
+		else if (*name == '/') divbyimm(r1, r1, imm2, 0, 0);
+		else divbyimm(r1, r1, imm2, 0, 1);
 		
 	} else {
 		
 		if (*name == '*') muli(r1, r1, imm2);
-		else if (*name == '/') divi(r1, r1, imm2);
-		else modi(r1, r1, imm2);
+		else if (*name == '/') divbyimm(r1, r1, imm2, 1, 0);
+		else divbyimm(r1, r1, imm2, 1, 1);
 	}
 }
 
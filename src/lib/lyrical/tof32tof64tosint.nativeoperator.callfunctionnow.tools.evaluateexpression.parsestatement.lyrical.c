@@ -0,0 +1,177 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+// The builtin functions tof32() and tof64()
+// convert their argument, which is either
+// a native integer type or a floating point type,
+// to the floating point type of their name.
+// The builtin function tosint() convert its
+// argument, rounding toward zero, to the signed
+// native type as large as a gpr; a value that
+// cannot be represented is converted to the most
+// negative value of that type.
+// An integer argument is converted using its
+// value sign or zero extended to a gpr and
+// seen as signed; so an unsigned value
+// with its most significant bit set
+// and as large as a gpr is converted
+// as a negative value.
+
+// I set the bitsize of the type with
+// which the argument was pushed.
+argbitsize = 8*sizeoftype(funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+
+// I set the type of the result variable.
+builtinresulttype = (name[2] == 's') ? largeenoughsignednativetype(sizeofgpr) :
+	nativetype[(name[3] == '3') ? NATIVETYPEF32 : NATIVETYPEF64].name;
+	
+// I determine whether the argument has a floating
+// point type, in which case argbitsize is also
+// the bitsize of that floating point type;
+// the fcall pattern insure that a type
+// starting with 'f' is a floating point type.
+uint isfloatarg = (*funcarg->typepushed.ptr == 'f');
+
+
+// If the only argument is a number,
+// the return variable should be a number, which
+// I compute using the floating point
+// arithmetic of the host.
+if (funcarg->v->isnumber) {
+	
+	imm1 = ifnativetypedosignorzeroextend(funcarg->v->numbervalue, funcarg->typepushed.ptr, stringmmsz(funcarg->typepushed));
+	
+	// I compute in d the value
+	// of the argument.
+	double d;
+	
+	if (isfloatarg) d = (argbitsize == 64) ? bitstof64(imm1) : bitstof32(imm1);
+	else {
+		// The value sign or zero extended
+		// to a gpr is seen as signed.
+		if (bitsizeofgpr < 64 && (imm1 & ((u64)1<<(bitsizeofgpr-1))))
+			imm1 |= ~maxtargetuintvalue;
+			
+		d = (s64)imm1;
+	}
+	
+	if (name[2] == 's') {
+		
+		double m = (double)((u64)1<<(bitsizeofgpr-1));
+		
+		// A value that cannot be represented,
+		// including a NaN, is converted to
+		// the most negative value.
+		if (d >= -m && d < m) immresult = (s64)d;
+		else immresult = ((u64)1<<(bitsizeofgpr-1));
+		
+		immresult &= maxtargetuintvalue;
+		
+	} else if (name[3] == '3') {
+		// An integer value is converted
+		// directly to a float, instead of through
+		// the double d, so as to round it once.
+		if (isfloatarg) immresult = f32tobits(d);
+		else immresult = f32tobits((s64)imm1);
+		
+	} else immresult = f64tobits(d);
+	
+	// Note that getvarnumber() will duplicate
+	// the string pointed by builtinresulttype.ptr
+	// before using it, so I don't need to
+	// give it a duplicated string.
+	resultvar = getvarnumber(immresult, builtinresulttype);
+	
+	break;
+}
+
+
+// Instructions are not generated in the firstpass.
+// So here, only the result variable is created.
+if (!compilepass) {
+	// I create the result variable.
+	resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+	
+	resultvar->name = generatetempvarname(resultvar);
+	
+	// Set the type of the result variable.
+	resultvar->type = stringduplicate1(builtinresulttype);
+	
+	break;
+}
+
+
+// I use the type and bitselect with
+// which the variable was pushed.
+r1 = getregforvar(funcarg->v, 0, funcarg->typepushed, funcarg->bitselect, FORINPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+r1->lock = 1;
+
+
+// I compute the result value.
+
+// I create the result variable.
+resultvar = varalloc(sizeoftype(builtinresulttype.ptr, stringmmsz(builtinresulttype)), LOOKFORAHOLE);
+
+resultvar->name = generatetempvarname(resultvar);
+
+// Set the type of the result variable.
+resultvar->type = stringduplicate1(builtinresulttype);
+
+// The register obtained will be appropriately
+// set dirty and setregtothebottom() will
+// be called on it before getregforvar() return.
+rresult = getregforvar(resultvar, 0, resultvar->type, 0, FOROUTPUT);
+
+// I lock the register to prevent
+// a call of allocreg() from using it.
+rresult->lock = 1;
+
+if (name[2] == 's') {
+	// I get here for tosint().
+	
+	if (!isfloatarg) cpy(rresult, r1);
+	else if (argbitsize == 64) f64toi(rresult, r1);
+	else f32toi(rresult, r1);
+	
+} else if (name[3] == '3') {
+	// I get here for tof32().
+	
+	if (!isfloatarg) itof32(rresult, r1);
+	else if (argbitsize == 64) f64tof32(rresult, r1);
+	else cpy(rresult, r1);
+	
+} else {
+	// I get here for tof64().
+	
+	if (!isfloatarg) itof64(rresult, r1);
+	else if (argbitsize == 64) cpy(rresult, r1);
+	else f32tof64(rresult, r1);
+}
+
+
+// I unlock the registers that were allocated
+// and locked for the operands.
+// Locked registers must be unlocked only after
+// the instructions using them have been generated;
+// otherwise they could be lost when insureenoughunusedregisters()
+// is called while creating a new lyricalinstruction.
+r1->lock = 0;
+rresult->lock = 0;
@@ -694,7 +694,13 @@ lyricalvariable* readvarorfunc () {
 		// because I certainly read a number
 		// since I get here only if I have
 		// at least a single digit of a number.
-		return getvarnumber(readnumber().n, largeenoughunsignednativetype(sizeofgpr));
+		readnumberresult r = readnumber();
+		
+		// A floating point number is casted
+		// to the floating point type of its size.
+		if (r.floatsize) return getvarnumber(r.n, nativetype[(r.floatsize == 4) ? NATIVETYPEF32 : NATIVETYPEF64].name);
+		
+		return getvarnumber(r.n, largeenoughunsignednativetype(sizeofgpr));
 		
 	} else if ((s = readsymbol(UPPERCASESYMBOL)).ptr) {
 		// If I get here, I readed an enum element
@@ -1383,6 +1389,34 @@ lyricalvariable* readvarorfunc () {
 			
 		default:
 			
+			if (dofunctioncall && (
+				stringiseq2(s, "popcnt") || stringiseq2(s, "clz") ||
+				stringiseq2(s, "ctz") || stringiseq2(s, "bswap") ||
+				stringiseq2(s, "rotl") || stringiseq2(s, "rotr") ||
+				stringiseq2(s, "tof32") || stringiseq2(s, "tof64") ||
+				stringiseq2(s, "tosint"))) {
+				// If I get here, I am calling a builtin
+				// function, which is a native operation
+				// that is not a declared symbol; its
+				// patterns are in nativefcall.
+				
+				// I set curpos to savedcurpos2 so that
+				// if an error is thrown by callfunctionnow(),
+				// curpos is correctly set to the location
+				// of the error.
+				swapvalues(&curpos, &savedcurpos2);
+				
+				// callfunctionnow() never return
+				// a null pointer and return EXPRWITHNORETVAL
+				// if there was no resulting variable.
+				v = callfunctionnow((lyricalvariable*)0, s.ptr, CALLDEFAULT);
+				
+				// Here I restore curpos.
+				swapvalues(&curpos, &savedcurpos2);
+				
+				break;
+			}
+			
 			curpos = savedcurpos;
 			
 			// The string pointed by s.ptr will be freed by
@@ -201,8 +201,6 @@ uint isvarreadonly (lyricalvariable* v) {
 // This function is used to generate a unique label name.
 uint newgenericlabelid () {
 	
-	static uint endofblockid = 0;
-	
 	// There is no need to check
 	// whether (endofblockid == -1),
 	// because it would never happen,
@@ -398,14 +396,42 @@ typedef struct {
 	// otherwise it is set to 0.
 	uint wasread;
 	
+	// This field is set to the bytesize
+	// of the floating point number read,
+	// in which case the field n hold
+	// the bits representing that number;
+	// otherwise it is set to 0.
+	uint floatsize;
+	
 } readnumberresult;
 
+// Functions used to convert between
+// a floating point value of the host
+// and the bits representing it.
+u64 f64tobits (double d) {
+	union {double d; u64 n;} u = {.d = d};
+	return u.n;
+}
+double bitstof64 (u64 n) {
+	union {double d; u64 n;} u = {.n = n};
+	return u.d;
+}
+u64 f32tobits (float f) {
+	union {float f; u32 n;} u = {.f = f};
+	return u.n;
+}
+float bitstof32 (u64 n) {
+	union {float f; u32 n;} u = {.n = n};
+	return u.f;
+}
+
 // This function parse a number.
 readnumberresult readnumber () {
 	
 	readnumberresult r = {
 		.n = 0,
-		.wasread = 0
+		.wasread = 0,
+		.floatsize = 0
 	};
 	
 	u64 n;
@@ -416,8 +442,140 @@ readnumberresult readnumber () {
 		return (n > maxtargetuintvalue || n < r.n);
 	}
 	
+	uint isdigit (u8 c) {
+		return (c >= '0' && c <= '9');
+	}
+	
 	u8* savedcurpos = curpos;
 	
+	// I check whether I have a floating point
+	// number, which is a decimal number followed
+	// by a fractional part and/or an exponent;
+	// ei: 1.5 or 15e-1 or 1.5f
+	u8* c = curpos;
+	
+	while (isdigit(*c)) ++c;
+	
+	if (c != curpos && (
+		(*c == '.' && isdigit(c[1])) ||
+		(*c == 'e' && (isdigit(c[1]) || ((c[1] == '+' || c[1] == '-') && isdigit(c[2])))))) {
+		// The digits of the number are accumulated
+		// in mantissa, and its value is
+		// mantissa*(10**exponent); digits which
+		// do not fit in mantissa are not
+		// significant and only adjust exponent.
+		u64 mantissa = 0;
+		
+		sint exponent = 0;
+		
+		while (isdigit(*curpos)) {
+			
+			if (mantissa < ((u64)-1/10)) mantissa = (mantissa*10) + (*curpos - '0');
+			else ++exponent;
+			
+			++curpos;
+		}
+		
+		if (*curpos == '.') {
+			
+			++curpos;
+			
+			while (isdigit(*curpos)) {
+				
+				if (mantissa < ((u64)-1/10)) {
+					mantissa = (mantissa*10) + (*curpos - '0');
+					--exponent;
+				}
+				
+				++curpos;
+			}
+		}
+		
+		if (*curpos == 'e') {
+			
+			++curpos;
+			
+			uint isnegative = (*curpos == '-');
+			
+			if (*curpos == '+' || *curpos == '-') ++curpos;
+			
+			sint e = 0;
+			
+			while (isdigit(*curpos)) {
+				
+				if (e < 100000) e = (e*10) + (*curpos - '0');
+				
+				++curpos;
+			}
+			
+			if (isnegative) exponent -= e;
+			else exponent += e;
+		}
+		
+		// The computation is done using long double
+		// so that mantissa and powers of 10 up to 10**27
+		// are represented exactly, and only the last
+		// operation round the result.
+		long double d = mantissa;
+		
+		long double p = 1;
+		long double b = 10;
+		
+		uint e = (exponent < 0) ? -exponent : exponent;
+		
+		while (e) {
+			
+			if (e&1) p *= b;
+			
+			b *= b;
+			
+			e >>= 1;
+		}
+		
+		if (exponent < 0) d /= p;
+		else d *= p;
+		
+		// The suffix 'f' specify
+		// a 32bits floating point number.
+		if (*curpos == 'f') {
+			
+			++curpos;
+			
+			float f = d;
+			
+			if (f > 3.40282346638528859812e+38f) {
+				curpos = savedcurpos;
+				throwerror("overflowing floating point number");
+			}
+			
+			r.n = f32tobits(f);
+			r.floatsize = 4;
+			
+		} else {
+			
+			if (sizeofgpr < 8) {
+				curpos = savedcurpos;
+				throwerror("64bits floating point numbers are not supported by the target; use the suffix 'f'");
+			}
+			
+			double f = d;
+			
+			if (f > 1.79769313486231570815e+308) {
+				curpos = savedcurpos;
+				throwerror("overflowing floating point number");
+			}
+			
+			r.n = f64tobits(f);
+			r.floatsize = 8;
+		}
+		
+		r.wasread = 1;
+		
+		skipspace();
+		
+		return r;
+	}
+	
 	if (*curpos == '0') {
 		
 		r.wasread = 1;
@@ -3896,6 +4054,15 @@ lyricalvariable* getvaraddr (lyricalvariable* v, getvaraddrflag flag) {
 			
 			propagatevarchange(vv, 0, vv->size);
 			
+			// The address of a variable residing in
+			// the stackframe of the function owning it
+			// is being obtained; that stackframe could
+			// then be modified or used through a pointer.
+			// retvar has no funcowner, as it
+			// resides outside of the stackframe.
+			if (vv->funcowner && vv->funcowner != rootfunc)
+				vv->funcowner->localaddrisobtained = 1;
+				
 			// GPRs are made available only
 			// in the secondpass and instructions
 			// are generated only in the secondpass.
@@ -371,3 +371,252 @@ void freemacros () {
 		
 	} while (m != macros);
 }
+
+// This function return the content of
+// the file to include which path is given
+// as argument, using compilearg->readfile
+// when it was set; null is returned
+// if the file could not be read.
+u8* readincludedfile (u8* filepath) {
+	
+	if (compileargreadfile) return compileargreadfile(filepath);
+	
+	return fileread1(filepath).ptr;
+}
+
+
+// Initial value of an FNV-1a hash.
+#define PREPROCESSEDHASHBASIS 0xcbf29ce484222325
+
+// This function return the FNV-1a hash
+// given as argument updated with
+// the data of size sz pointed by ptr.
+u64 preprocessedhash (u64 hash, u8* ptr, uint sz) {
+	
+	while (sz) {
+		hash ^= *ptr++;
+		hash *= 0x100000001b3;
+		--sz;
+	}
+	
+	return hash;
+}
+
+// This function return the FNV-1a hash
+// given as argument updated with the string
+// given as argument; its size is hashed
+// as well so that consecutive strings
+// cannot be confused with each other.
+u64 preprocessedhashstring (u64 hash, string s) {
+	
+	uint sz = s.ptr ? stringmmsz(s)+1 : 0;
+	
+	hash = preprocessedhash(hash, (u8*)&sz, sizeof(sz));
+	
+	if (sz) hash = preprocessedhash(hash, s.ptr, sz-1);
+	
+	return hash;
+}
+
+// This function return the FNV-1a hash
+// given as argument updated with
+// the linkedlist of chunk given as argument.
+u64 preprocessedhashchunks (u64 hash, chunk* linkedlist) {
+	
+	if (!linkedlist) return hash;
+	
+	chunk* c = linkedlist;
+	
+	do {
+		hash = preprocessedhashstring(hash, c->origin);
+		hash = preprocessedhashstring(hash, c->path);
+		hash = preprocessedhash(hash, (u8*)&c->offset, sizeof(c->offset));
+		hash = preprocessedhash(hash, (u8*)&c->linenumber, sizeof(c->linenumber));
+		hash = preprocessedhashstring(hash, c->content);
+		
+	} while ((c = c->next) != linkedlist);
+	
+	return hash;
+}
+
+// This function return the key used with
+// compilearg->loadpreprocessed and
+// compilearg->savepreprocessed for the file
+// about to be preprocessed; since the result
+// of preprocessing a file depend on the macros
+// defined where it is included, all of them
+// are hashed with the path of the file.
+u64 preprocessedkey () {
+	
+	u64 hash = preprocessedhashstring(PREPROCESSEDHASHBASIS, currentfilepath);
+	
+	hash = preprocessedhashstring(hash, chunkorigin);
+	
+	hash = preprocessedhash(hash, (u8*)&isinimportedmodulelyc, sizeof(isinimportedmodulelyc));
+	
+	if (macros) {
+		
+		macro* m = macros;
+		
+		do {
+			hash = preprocessedhashstring(hash, m->name);
+			hash = preprocessedhash(hash, (u8*)&m->chunklocationtsetwhenused, sizeof(m->chunklocationtsetwhenused));
+			hash = preprocessedhash(hash, (u8*)&m->isbeingdefined, sizeof(m->isbeingdefined));
+			hash = preprocessedhash(hash, (u8*)&m->nbrofargs, sizeof(m->nbrofargs));
+			
+			for (uint i = 0; i < m->nbrofargs; ++i)
+				hash = preprocessedhashstring(hash, m->args[i]->name);
+				
+			hash = preprocessedhashchunks(hash, m->chunks);
+			
+		} while ((m = m->next) != macros);
+	}
+	
+	return hash;
+}
+
+// This function save, using
+// compilearg->savepreprocessed, the linkedlist
+// of chunk given as argument which is the result
+// of preprocessing the file which content has
+// the hash given as argument.
+// The data saved is made of the hash, followed
+// by the number of chunk and, for each chunk,
+// its fields offset and linenumber, followed by
+// the size+1 of the strings of its fields origin,
+// path and content, or null for a null string,
+// followed by the characters of those strings.
+void savepreprocessedchunks (u64 key, u64 contenthash, chunk* linkedlist) {
+	
+	string data = stringduplicate3((u8*)&contenthash, sizeof(contenthash));
+	
+	uint count = 0;
+	
+	chunk* c = linkedlist;
+	
+	do ++count; while ((c = c->next) != linkedlist);
+	
+	stringappend3(&data, (u8*)&count, sizeof(count));
+	
+	do {
+		uint n[5] = {
+			c->offset,
+			c->linenumber,
+			c->origin.ptr ? stringmmsz(c->origin)+1 : 0,
+			c->path.ptr ? stringmmsz(c->path)+1 : 0,
+			c->content.ptr ? stringmmsz(c->content)+1 : 0};
+			
+		stringappend3(&data, (u8*)n, sizeof(n));
+		
+		if (n[2] > 1) stringappend1(&data, c->origin);
+		if (n[3] > 1) stringappend1(&data, c->path);
+		if (n[4] > 1) stringappend1(&data, c->content);
+		
+	} while ((c = c->next) != linkedlist);
+	
+	compileargsavepreprocessed(key, data.ptr, stringmmsz(data));
+	
+	mmrefdown(data.ptr);
+}
+
+// This function return the linkedlist
+// of chunk recreated from the data given
+// as argument which was saved by
+// savepreprocessedchunks(); null is returned
+// if the data was not generated from a file
+// which content has the hash given as argument,
+// or if the data is not valid.
+chunk* loadpreprocessedchunks (u8* data, u64 contenthash) {
+	
+	uint datasz = mmsz(data);
+	
+	if (datasz < sizeof(u64)+sizeof(uint)) return 0;
+	
+	u64 hash;
+	bytcpy((u8*)&hash, data, sizeof(hash));
+	
+	if (hash != contenthash) return 0;
+	
+	uint count;
+	bytcpy((u8*)&count, data+sizeof(hash), sizeof(count));
+	
+	if (!count) return 0;
+	
+	u8* ptr = data+sizeof(hash)+sizeof(count);
+	u8* limit = data+datasz;
+	
+	chunk* linkedlist = 0;
+	
+	// This function return a string
+	// which size+1 is given as argument,
+	// reading its characters from ptr.
+	string readstring (uint sz) {
+		
+		if (!sz) return stringnull;
+		
+		--sz;
+		
+		string s = stringduplicate3(ptr, sz);
+		
+		ptr += sz;
+		
+		return s;
+	}
+	
+	do {
+		uint n[5];
+		
+		if ((uint)(limit - ptr) < sizeof(n)) goto error;
+		
+		bytcpy((u8*)n, ptr, sizeof(n));
+		
+		ptr += sizeof(n);
+		
+		if ((uint)(limit - ptr) < (n[2] ? n[2]-1 : 0) + (n[3] ? n[3]-1 : 0) + (n[4] ? n[4]-1 : 0))
+			goto error;
+			
+		chunk* c = mmallocz(sizeof(chunk));
+		
+		c->offset = n[0];
+		
+		c->linenumber = n[1];
+		
+		c->origin = readstring(n[2]);
+		
+		// Most chunks are from the file
+		// being preprocessed, and share
+		// the string of its path.
+		if (n[3] && stringiseq5(ptr, n[3]-1, currentfilepath)) {
+			c->path = stringduplicate1(currentfilepath);
+			ptr += n[3]-1;
+		} else c->path = readstring(n[3]);
+		
+		c->content = readstring(n[4]);
+		
+		if (linkedlist) {
+			
+			c->next = linkedlist;
+			c->prev = linkedlist->prev;
+			linkedlist->prev->next = c;
+			linkedlist->prev = c;
+			
+		} else {
+			
+			c->next = c;
+			c->prev = c;
+			linkedlist = c;
+		}
+		
+	} while (--count);
+	
+	// The memory block can be larger
+	// than the data, ei: when it was read
+	// from a file using fileread1().
+	return linkedlist;
+	
+	error:
+	
+	if (linkedlist) freemacrochunklinkedlist(linkedlist);
+	
+	return 0;
+}
@@ -515,6 +515,48 @@ string lyricalbackendtext (lyricalcompileresult compileresult) {
 					appendargimm(BEGINWITHCOMMA);
 					break;
 					
+				case LYRICALOPROL:
+					stringappend2(b, "rol");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPROLI:
+					stringappend2(b, "roli");
+					appendarg2reg();
+					appendargimm(BEGINWITHCOMMA);
+					break;
+					
+				case LYRICALOPROR:
+					stringappend2(b, "ror");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPRORI:
+					stringappend2(b, "rori");
+					appendarg2reg();
+					appendargimm(BEGINWITHCOMMA);
+					break;
+					
+				case LYRICALOPBSWAP:
+					stringappend2(b, "bswap");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPPOPCNT:
+					stringappend2(b, "popcnt");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPCLZ:
+					stringappend2(b, "clz");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPCTZ:
+					stringappend2(b, "ctz");
+					appendarg2reg();
+					break;
+					
 				case LYRICALOPZXT:
 					stringappend2(b, "zxt");
 					appendarg2reg();
@@ -1030,6 +1072,310 @@ string lyricalbackendtext (lyricalcompileresult compileresult) {
 					appendargimm(BEGINWITHCOMMA);
 					break;
 					
+				case LYRICALOPCAS8:
+					stringappend2(b, "cas8");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPCAS16:
+					stringappend2(b, "cas16");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPCAS32:
+					stringappend2(b, "cas32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPCAS64:
+					stringappend2(b, "cas64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFETCHADD8:
+					stringappend2(b, "fetchadd8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHADD16:
+					stringappend2(b, "fetchadd16");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHADD32:
+					stringappend2(b, "fetchadd32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHADD64:
+					stringappend2(b, "fetchadd64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHSUB8:
+					stringappend2(b, "fetchsub8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHSUB16:
+					stringappend2(b, "fetchsub16");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHSUB32:
+					stringappend2(b, "fetchsub32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHSUB64:
+					stringappend2(b, "fetchsub64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHAND8:
+					stringappend2(b, "fetchand8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHAND16:
+					stringappend2(b, "fetchand16");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHAND32:
+					stringappend2(b, "fetchand32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHAND64:
+					stringappend2(b, "fetchand64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHOR8:
+					stringappend2(b, "fetchor8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHOR16:
+					stringappend2(b, "fetchor16");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHOR32:
+					stringappend2(b, "fetchor32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFETCHOR64:
+					stringappend2(b, "fetchor64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFENCE:
+					stringappend2(b, "fence");
+					break;
+					
+				case LYRICALOPVCPY:
+					stringappend2(b, "vcpy");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPVADD8:
+					stringappend2(b, "vadd8");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVADD16:
+					stringappend2(b, "vadd16");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVADD32:
+					stringappend2(b, "vadd32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVADD64:
+					stringappend2(b, "vadd64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVSUB8:
+					stringappend2(b, "vsub8");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVSUB16:
+					stringappend2(b, "vsub16");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVSUB32:
+					stringappend2(b, "vsub32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVSUB64:
+					stringappend2(b, "vsub64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVAND:
+					stringappend2(b, "vand");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVOR:
+					stringappend2(b, "vor");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVXOR:
+					stringappend2(b, "vxor");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVCMPEQ8:
+					stringappend2(b, "vcmpeq8");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVCMPEQ16:
+					stringappend2(b, "vcmpeq16");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVCMPEQ32:
+					stringappend2(b, "vcmpeq32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPVMOVMSK8:
+					stringappend2(b, "vmovmsk8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPVBCAST8:
+					stringappend2(b, "vbcast8");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPVBCAST16:
+					stringappend2(b, "vbcast16");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPVBCAST32:
+					stringappend2(b, "vbcast32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPVBCAST64:
+					stringappend2(b, "vbcast64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPFADD32:
+					stringappend2(b, "fadd32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFADD64:
+					stringappend2(b, "fadd64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFSUB32:
+					stringappend2(b, "fsub32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFSUB64:
+					stringappend2(b, "fsub64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFMUL32:
+					stringappend2(b, "fmul32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFMUL64:
+					stringappend2(b, "fmul64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFDIV32:
+					stringappend2(b, "fdiv32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFDIV64:
+					stringappend2(b, "fdiv64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFEQ32:
+					stringappend2(b, "feq32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFEQ64:
+					stringappend2(b, "feq64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFLT32:
+					stringappend2(b, "flt32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFLT64:
+					stringappend2(b, "flt64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFLTE32:
+					stringappend2(b, "flte32");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPFLTE64:
+					stringappend2(b, "flte64");
+					appendarg3reg();
+					break;
+					
+				case LYRICALOPITOF32:
+					stringappend2(b, "itof32");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPITOF64:
+					stringappend2(b, "itof64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPF32TOI:
+					stringappend2(b, "f32toi");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPF64TOI:
+					stringappend2(b, "f64toi");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPF32TOF64:
+					stringappend2(b, "f32tof64");
+					appendarg2reg();
+					break;
+					
+				case LYRICALOPF64TOF32:
+					stringappend2(b, "f64tof32");
+					appendarg2reg();
+					break;
+					
 				case LYRICALOPMEM8CPY:
 					stringappend2(b, "mem8cpy");
 					appendarg3reg();
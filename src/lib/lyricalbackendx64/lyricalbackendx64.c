@@ -32,8 +32,10 @@
 #include <string.h>
 #include <arrayu8.h>
 #include <arrayu64.h>
-#include <bintree.h>
 #include <lyrical.h>
+#ifndef LYRICALBACKENDX64BASELINEISA
+#include <cpuid.h>
+#endif
 
 
 // # On Linux, to disassemble a raw binary file, use the following command:
@@ -46,6 +48,31 @@
 #error "little endian required"
 #endif
 
+// Macros setting the count of stack pages
+// allocated at once when the stack page pool
+// is empty, and the count of stack pages
+// that the stack page pool can hold.
+#ifndef LYRICALBACKENDX64STACKPAGEBATCH
+#define LYRICALBACKENDX64STACKPAGEBATCH 4
+#endif
+#ifndef LYRICALBACKENDX64STACKPAGEPOOLMAX
+#define LYRICALBACKENDX64STACKPAGEPOOLMAX 16
+#endif
+#if LYRICALBACKENDX64STACKPAGEBATCH < 1 || LYRICALBACKENDX64STACKPAGEBATCH > 8
+#error "LYRICALBACKENDX64STACKPAGEBATCH must be from 1 to 8"
+#endif
+#if LYRICALBACKENDX64STACKPAGEPOOLMAX > 127
+#error "LYRICALBACKENDX64STACKPAGEPOOLMAX must be less than 128"
+#endif
+
+// When the macro LYRICALBACKENDX64BASELINEISA
+// is defined, the instructions POPCNT, LZCNT
+// and TZCNT are never generated, even if
+// the CPU on which the compiler is running
+// support them; instruction sequences using
+// only the baseline x64 instruction set
+// are generated instead.
+
 
 // Structure used by
 // lyricalbackendx64()
@@ -163,6 +190,19 @@ typedef enum {
 	// aligned to a pagesize (4096 bytes).
 	LYRICALBACKENDX64PAGEALIGNED,
 	
+	// The following values can be
+	// or'ed with any of the above;
+	// when used, the first instruction
+	// of each function, and each loop head,
+	// which is the target of a branching
+	// instruction located after it within
+	// the same function, are aligned to
+	// the boundary selected, padding with
+	// no-operation instructions.
+	LYRICALBACKENDX64ALIGN16 = (1<<2),
+	LYRICALBACKENDX64ALIGN32 = (2<<2),
+	LYRICALBACKENDX64ALIGN64 = (3<<2),
+	
 } lyricalbackendx64flag;
 
 enum {
@@ -218,9 +258,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	// to convert to its binary
 	// executable equivalent.
 	typedef struct {
-		// Executable binary
-		// of the instruction.
-		arrayu8 binary;
+		// Byte offset, within codebuf, where
+		// the executable binary of the instruction
+		// was emitted, unless the instruction
+		// was redone, in which case its executable
+		// binary is in the field redobinary.
+		uint codeoffset;
+		
+		// Byte size of the executable
+		// binary of the instruction.
+		uint binarysz;
+		
+		// Executable binary of the
+		// instruction when it was redone.
+		arrayu8 redobinary;
 		
 		// This field hold the
 		// byte offset location,
@@ -271,8 +322,26 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		// but used for the secondary immediate.
 		u64 imm2miscvalue;
 		
+		// Index of the instruction
+		// within the layout arrays
+		// layoutinstr and layoutsz.
+		uint layoutidx;
+		
+		// This field is non-null
+		// if the executable binary
+		// of the instruction must
+		// start at an offset aligned
+		// to codealign.
+		uint isaligned;
+		
 	} backenddata;
 	
+	// Boundary to which the first
+	// instruction of each function
+	// and each loop head get aligned;
+	// null when no alignment is done.
+	uint codealign = ((flag>>2)&3) ? (8<<((flag>>2)&3)) : 0;
+	
 	lyricalfunction* f = compileresult.rootfunc;
 	
 	// I create a new session
@@ -289,6 +358,45 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	// instructions that manipulate the stack.
 	enum {PAGESIZE = 4096};
 	
+	// Count of stack pages allocated at once by
+	// LYRICALOPSTACKPAGEALLOC when the stack page pool
+	// is empty; the pages beside the one used are added
+	// to the stack page pool.
+	enum {STACKPAGEBATCH = LYRICALBACKENDX64STACKPAGEBATCH};
+	
+	// Count of stack pages that the stack page pool
+	// can hold; LYRICALOPSTACKPAGEFREE free the page
+	// instead of adding it to the stack page pool
+	// when the stack page pool is full.
+	enum {STACKPAGEPOOLMAX = LYRICALBACKENDX64STACKPAGEPOOLMAX};
+	
+	// Variables set to whether the CPU
+	// on which the compiler is running
+	// support the instructions POPCNT,
+	// LZCNT and TZCNT; when the CPU do not
+	// support them, instruction sequences
+	// using only the baseline x64 instruction
+	// set are generated instead.
+	uint haspopcnt = 0, haslzcnt = 0, hastzcnt = 0;
+	
+	#ifndef LYRICALBACKENDX64BASELINEISA
+	{
+		u32 eax, ebx, ecx, edx;
+		
+		// CPUID.01H:ECX.POPCNT[bit 23].
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			haspopcnt = ((ecx>>23)&1);
+			
+		// CPUID.80000001H:ECX.LZCNT[bit 5].
+		if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx))
+			haslzcnt = ((ecx>>5)&1);
+			
+		// CPUID.(EAX=07H, ECX=0H):EBX.BMI1[bit 3].
+		if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			hastzcnt = ((ebx>>3)&1);
+	}
+	#endif
+	
 	// Array that will be used to track
 	// which register was used to save
 	// the value of the register given
@@ -304,41 +412,26 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	// unused register used.
 	uint regsinusetmp[REGCOUNT] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 	
-	// Binary tree that will be used
-	// to store all lyricalinstruction*
-	// to redo.
-	bintree toredo = bintreenull;
-	
-	// Label I jump to in order to
-	// begin redoing lyricalinstruction.
-	redo:;
-	
-	// Array which will hold
-	// section1 debug information.
-	arrayu64 dbginfosection1;
-	
-	// Array which will hold
-	// pointers to strings for
-	// section2 debug information.
-	arrayu64 dbginfosection2;
-	// Variable which store the total length
-	// of all strings for which the pointers
-	// are stored in dbginfosection2.
-	uint dbginfosection2len = 0;
+	// Buffer in which the executable binary
+	// of every instruction get emitted, one after
+	// the other; it grows by doubling its size,
+	// and once every instruction has been laid
+	// out, it becomes the executable binary
+	// returned; hence its size is a capacity,
+	// and the count of bytes used is codebufsz.
+	arrayu8 codebuf = arrayu8null;
+	uint codebufsz = 0;
 	
-	dbginfosection1 = arrayu64null;
-	
-	// Reserve space at the top
-	// for storing the byte usage
-	// of section1 debug information.
-	*arrayu64append1(&dbginfosection1) = 0;
-	
-	dbginfosection2 = arrayu64null;
+	// Array that will be used to store
+	// pairs of lyricalfunction* and
+	// lyricalinstruction* to redo; the pairs
+	// are stored in the order in which
+	// their lyricalinstruction get laid out.
+	arrayu64 toredo = arrayu64null;
 	
-	// Variable used to keep track
-	// of the size of instructions
-	// to execute.
-	uint executableinstrsz = 0;
+	// Index within toredo of the pair
+	// being redone.
+	uint toredoidx = 0;
 	
 	lyricalinstruction* i;
 	
@@ -347,6 +440,54 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	// in i->backenddata.
 	backenddata* b;
 	
+	// Count of lyricalinstruction
+	// among all lyricalfunction.
+	uint layoutinstrsz = 0;
+	
+	do {
+		i = f->i->next;
+		
+		do ++layoutinstrsz; while ((i = i->next) != f->i->next);
+		
+	} while ((f = f->next) != compileresult.rootfunc);
+	
+	// When I get here f == compileresult.rootfunc;
+	
+	// The backenddata of all lyricalinstruction
+	// are allocated at once, in the order in
+	// which their lyricalinstruction get laid out.
+	backenddata* backenddatas = mmallocz(layoutinstrsz*sizeof(backenddata));
+	
+	// Arrays storing in the order in
+	// which they get laid out, all the
+	// lyricalinstruction* and the size
+	// of their binary executable equivalent.
+	// They are used to recompute the offset
+	// of each binary without walking through
+	// every lyricalfunction after some
+	// lyricalinstruction have been redone.
+	arrayu64 layoutinstr = (arrayu64){.ptr = mmalloc(layoutinstrsz*sizeof(u64))};
+	arrayu64 layoutsz = (arrayu64){.ptr = mmalloc(layoutinstrsz*sizeof(u64))};
+	
+	// Index within layoutinstr of
+	// the next lyricalinstruction
+	// to lay out.
+	uint layoutidx = 0;
+	
+	// Index within layoutinstr from where
+	// offsets must be recomputed.
+	uint layoutdirtyidx = 0;
+	
+	// Set to 1 when at least one
+	// lyricalinstruction was redone.
+	uint wasredone = 0;
+	
+	// Label I jump to in order to
+	// begin redoing lyricalinstruction.
+	redo:;
+	
+	if (toredo.ptr) f = (lyricalfunction*)toredo.ptr[0];
+	
 	do {
 		// Note that f->i is always non-null,
 		// so there is no need to check it.
@@ -355,7 +496,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		// intruction that was generated and
 		// f->i->next point to the first
 		// instruction generated.
-		i = f->i->next;
+		// When redoing lyricalinstruction,
+		// only the lyricalinstruction saved
+		// in toredo get walked through.
+		if (toredo.ptr) i = (lyricalinstruction*)toredo.ptr[toredoidx+1];
+		else i = f->i->next;
 		
 		// Enum used to map x64 register names
 		// to Lyrical register numbering.
@@ -426,6 +571,56 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		#define LOOKUPREGRSP 4
 		#define LOOKUPREGRBP 5
 		
+		// Function which append the count
+		// of bytes given as argument to the
+		// executable binary of the instruction
+		// pointed by i, and return the address
+		// of the first byte appended; that
+		// address is only valid until the next
+		// call to this function, since the buffer
+		// in which bytes get emitted can move.
+		u8* binaryappend2 (uint count) {
+			
+			b->binarysz += count;
+			
+			// An instruction being redone
+			// get emitted in its own buffer,
+			// since the bytes that follow it
+			// in codebuf are still in use.
+			if (toredo.ptr) return arrayu8append2(&b->redobinary, count);
+			
+			uint n = codebufsz;
+			
+			codebufsz += count;
+			
+			uint codebufcapacity = arrayu8sz(codebuf);
+			
+			if (codebufsz > codebufcapacity) {
+				
+				codebufcapacity = (codebufcapacity ? (codebufcapacity*2) : PAGESIZE);
+				
+				if (codebufcapacity < codebufsz) codebufcapacity = codebufsz;
+				
+				codebuf.ptr = mmrealloc(codebuf.ptr, codebufcapacity);
+			}
+			
+			return (codebuf.ptr + n);
+		}
+		
+		u8* binaryappend1 () {
+			return binaryappend2(1);
+		}
+		
+		// Function which return the address
+		// of the executable binary of the
+		// instruction pointed by i.
+		u8* binaryptr () {
+			
+			if (b->redobinary.ptr) return b->redobinary.ptr;
+			
+			return (codebuf.ptr + b->codeoffset);
+		}
+		
 		// This function set the fields
 		// isimmused, immfieldoffset and
 		// immmiscvalue (increment it).
@@ -438,13 +633,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate value.
 			b->isimmused = IMM8;
-			b->immfieldoffset = arrayu8sz(b->binary);
+			b->immfieldoffset = b->binarysz;
 			b->immmiscvalue += n;
 			
 			// Here I simply create space
 			// for a 8bits immediate value
 			// to be resolved later.
-			arrayu8append1(&b->binary);
+			binaryappend1();
 		}
 		
 		// This function set the fields
@@ -459,13 +654,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate2 value.
 			b->isimm2used = IMM8;
-			b->imm2fieldoffset = arrayu8sz(b->binary);
+			b->imm2fieldoffset = b->binarysz;
 			b->imm2miscvalue += n;
 			
 			// Here I simply create space
 			// for a 8bits immediate2 value
 			// to be resolved later.
-			arrayu8append1(&b->binary);
+			binaryappend1();
 		}
 		
 		// This function set the fields
@@ -480,13 +675,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate value.
 			b->isimmused = IMM32;
-			b->immfieldoffset = arrayu8sz(b->binary);
+			b->immfieldoffset = b->binarysz;
 			b->immmiscvalue += n;
 			
 			// Here I simply create space
 			// for a 32bits immediate value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u32));
+			binaryappend2(sizeof(u32));
 		}
 		
 		// This function set the fields
@@ -501,13 +696,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate2 value.
 			b->isimm2used = IMM32;
-			b->imm2fieldoffset = arrayu8sz(b->binary);
+			b->imm2fieldoffset = b->binarysz;
 			b->imm2miscvalue += n;
 			
 			// Here I simply create space
 			// for a 32bits immediate2 value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u32));
+			binaryappend2(sizeof(u32));
 		}
 		
 		// This function set the fields
@@ -522,13 +717,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate value.
 			b->isimmused = IMM64;
-			b->immfieldoffset = arrayu8sz(b->binary);
+			b->immfieldoffset = b->binarysz;
 			b->immmiscvalue += n;
 			
 			// Here I simply create space
 			// for a 64bits immediate value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u64));
+			binaryappend2(sizeof(u64));
 		}
 		
 		// This function set the fields
@@ -543,13 +738,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate2 value.
 			b->isimm2used = IMM64;
-			b->imm2fieldoffset = arrayu8sz(b->binary);
+			b->imm2fieldoffset = b->binarysz;
 			b->imm2miscvalue += n;
 			
 			// Here I simply create space
 			// for a 64bits immediate2 value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u64));
+			binaryappend2(sizeof(u64));
 		}
 		
 		void nop () {
@@ -557,7 +752,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// 90		NOP		#One byte no-operation instruction.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x90;
+			*binaryappend1() = 0x90;
 		}
 		
 		// Instruction size in bytes
@@ -584,11 +779,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x89;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void push (uint r) {
@@ -599,13 +794,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			if (lookupregr > 7) {
 				// REX-Prefix == 0100000B
-				*arrayu8append1(&b->binary) = 0x41;
+				*binaryappend1() = 0x41;
 				
 				lookupregr %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0x50+lookupregr);
+			*binaryappend1() = (0x50+lookupregr);
 		}
 		
 		void pop (uint r) {
@@ -624,13 +819,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			if (lookupregr > 7) {
 				// REX-Prefix == 0100000B
-				*arrayu8append1(&b->binary) = 0x41;
+				*binaryappend1() = 0x41;
 				
 				lookupregr %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0x58+lookupregr);
+			*binaryappend1() = (0x58+lookupregr);
 		}
 		
 		// This function return the id
@@ -834,11 +1029,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x01;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x01;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void xor (uint r1, uint r2) {
@@ -861,11 +1056,23 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x31;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x31;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
+		}
+		
+		// Function used to sign-extend
+		// RAX into RDX:RAX, which is
+		// the dividend of IDIV.
+		void cqo () {
+			// Specification from the Intel manual.
+			// REX.W 99	CQO	#RDX:RAX = sign-extend of RAX.
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x48;
+			*binaryappend1() = 0x99;
 		}
 		
 		// Function used to load the
@@ -885,7 +1092,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				if (imm->type != LYRICALIMMVALUE || *(u64*)&imm->n || n) {
 					// If b->isimmused is set, then
 					// I am redoing the lyricalinstruction.
-					if (((((sint)n < 0) ? -n : n) >= (1 << 31)) ||
+					if (((((sint)n < 0) ? -n : n) >= ((u64)1 << 31)) ||
 						b->isimmused == IMM64) { // I also get here, if n cannot fit in a 32bits immediate.
 						
 						// Specification from the Intel manual.
@@ -899,8 +1106,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						lookupregr %= 8;
 						
 						// Append the opcode byte.
-						*arrayu8append1(&b->binary) = rex;
-						*arrayu8append1(&b->binary) = (0xb8+lookupregr);
+						*binaryappend1() = rex;
+						*binaryappend1() = (0xb8+lookupregr);
 						
 						// Append the immediate value.
 						append64bitsimm(n);
@@ -923,11 +1130,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						u8 modrm = ((0b11<<6)|lookupregr);
 						
 						// Append the opcode byte.
-						*arrayu8append1(&b->binary) = rex;
-						*arrayu8append1(&b->binary) = 0xc7;
+						*binaryappend1() = rex;
+						*binaryappend1() = 0xc7;
 						
 						// Append the ModR/M byte.
-						*arrayu8append1(&b->binary) = modrm;
+						*binaryappend1() = modrm;
 						
 						// Append the immediate value.
 						append32bitsimm(n);
@@ -948,7 +1155,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		void ldi2 (uint r, u64 n) {
 			// If b->isimm2used is set, then
 			// I am redoing the lyricalinstruction.
-			if (((((sint)n < 0) ? -n : n) >= (1 << 31)) ||
+			if (((((sint)n < 0) ? -n : n) >= ((u64)1 << 31)) ||
 				b->isimm2used == IMM64) { // I also get here, if n cannot fit in a 32bits immediate2.
 				
 				// Specification from the Intel manual.
@@ -962,8 +1169,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				lookupregr %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = (0xb8+lookupregr);
+				*binaryappend1() = rex;
+				*binaryappend1() = (0xb8+lookupregr);
 				
 				// Append the immediate2 value.
 				append64bitsimm2(n);
@@ -986,17 +1193,109 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0xc7;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0xc7;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate2 value.
 				append32bitsimm2(n);
 			}
 		}
 		
+		// Function which compute
+		// r1 = r2 + (r3 << scale),
+		// where scale is 0, 1, 2 or 3,
+		// using a single LEA instruction;
+		// r3 cannot be RSP since it cannot
+		// be encoded as an index register.
+		void lea (uint r1, uint r2, uint r3, u8 scale) {
+			// Specification from the Intel manual.
+			// REX.W 8D /r	LEA r64,m	#Store effective address for m in register r64.
+			
+			if (r3 == RSP) throwerror();
+			
+			u8 lookupregreg = lookupreg(r1);
+			u8 lookupregbase = lookupreg(r2);
+			u8 lookupregindex = lookupreg(r3);
+			
+			// REX-Prefix == 0100WRXB
+			u8 rex = (0x48|((lookupregreg>7)<<2)|((lookupregindex>7)<<1)|(lookupregbase>7));
+			
+			lookupregreg %= 8;
+			lookupregbase %= 8;
+			lookupregindex %= 8;
+			
+			// When the base register is
+			// RBP or R13, MOD == 0b00 would mean
+			// that there is no base register,
+			// so a null 8bits displacement is used.
+			u8 mod = ((lookupregbase == LOOKUPREGRBP) ? 0b01 : 0b00);
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x8d;
+			
+			// Append the ModR/M byte.
+			// From the most significant bit to the least significant bit.
+			// MOD == mod;
+			// REG == reg[2:0]; #Only the 3 least significant bits matters.
+			// R/M == 0b100; #A SIB byte follows.
+			*binaryappend1() = ((mod<<6)|(lookupregreg<<3)|0b100);
+			
+			// Append the SIB byte.
+			// From the most significant bit to the least significant bit.
+			// SCALE == scale;
+			// INDEX == index[2:0]; #Only the 3 least significant bits matters.
+			// BASE == base[2:0]; #Only the 3 least significant bits matters.
+			*binaryappend1() = ((scale<<6)|(lookupregindex<<3)|lookupregbase);
+			
+			if (mod) *binaryappend1() = 0;
+		}
+		
+		// Function which compute
+		// r1 = r2 + immediate, using
+		// a single LEA instruction where
+		// the immediate is the displacement;
+		// it must not be used when
+		// b->isimmused == IMM64.
+		void leai (uint r1, uint r2) {
+			// Specification from the Intel manual.
+			// REX.W 8D /r	LEA r64,m	#Store effective address for m in register r64.
+			
+			u8 lookupregreg = lookupreg(r1);
+			u8 lookupregrm = lookupreg(r2);
+			
+			// REX-Prefix == 0100WR0B
+			u8 rex = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
+			
+			lookupregreg %= 8;
+			lookupregrm %= 8;
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x8d;
+			
+			// Append the ModR/M byte.
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b10 for a 32bits displacement, 0b01 for an 8bits displacement;
+			// REG == reg[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			*binaryappend1() = (((b->isimmused == IMM32) ? (0b10<<6) : (0b01<<6))|(lookupregreg<<3)|lookupregrm);
+			
+			// When R/M == 0b100, a SIB byte
+			// must follow; it is set such that
+			// RSP or R12 is the base register
+			// without any index register.
+			if (lookupregrm == LOOKUPREGRSP) *binaryappend1() = 0x24;
+			
+			// Append the displacement which
+			// is the immediate value.
+			if (b->isimmused == IMM32) append32bitsimm(0);
+			else append8bitsimm(0);
+		}
+		
 		void addi (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
@@ -1034,11 +1333,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -1061,11 +1360,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -1109,11 +1408,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate2 value.
 				append32bitsimm2(0);
@@ -1136,11 +1435,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate2 value.
 				append8bitsimm2(0);
@@ -1167,12 +1466,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xff;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xff;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
+		#endif
 		
 		// Increment register by 8bits immediate
 		// value given as argument.
@@ -1194,16 +1494,15 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x83;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x83;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			// Append 8bits immediate value.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
-		#endif
 		
 		void sub (uint r1, uint r2) {
 			// Specification from the Intel manual.
@@ -1225,11 +1524,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x29;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x29;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		// Not used; kept for reference.
@@ -1271,11 +1570,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(5<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -1298,11 +1597,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(5<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -1328,11 +1627,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(3<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		// Function used to atomically
@@ -1357,11 +1656,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x87;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void mul (uint r1, uint r2) {
@@ -1384,12 +1683,12 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xaf;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xaf;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void mulh (uint r1, uint r2) {
@@ -1468,11 +1767,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(5<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -1555,7 +1854,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				} else regsinusetmp[RDX] = 1; // Mark unused register as temporarily used.
 			}
 			
-			xor(RDX, RDX);
+			cqo();
 			
 			// Specification from the Intel manual.
 			// REX.W F7 /7	IDIV r/m64	#Signed divide RDX:RAX by r/m64,
@@ -1575,11 +1874,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -1662,7 +1961,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				} else regsinusetmp[RDX] = 1; // Mark unused register as temporarily used.
 			}
 			
-			xor(RDX, RDX);
+			cqo();
 			
 			// Specification from the Intel manual.
 			// REX.W F7 /7	IDIV r/m64	#Signed divide RDX:RAX by r/m64,
@@ -1682,11 +1981,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -1787,11 +2086,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(4<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -1894,11 +2193,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(6<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -2001,11 +2300,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(6<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r1 != RDX) {
 				
@@ -2030,7 +2329,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			if (r1r2wasxchged) xchg(r1, r2); // Restore registers value.
 		}
 		
-		void muli (uint r) {
+		void muli (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -2044,8 +2343,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
+				if (r1 != r2) cpy(r1, r2);
+				
 				ldi(unusedreg, 0);
-				mul(r, unusedreg);
+				mul(r1, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
@@ -2053,27 +2354,27 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// Specification from the Intel manual.
 				// REX.W 69 /r id	IMUL r64, r/m64, imm32		#reg = r/m64 * imm32.
 				
-				u8 lookupregr = lookupreg(r);
-				
-				u8 lookupregrgt7 = (lookupregr>7);
+				u8 lookupregreg = lookupreg(r1);
+				u8 lookupregrm = lookupreg(r2);
 				
 				// REX-Prefix == 0100WR0B
-				u8 rex = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
+				u8 rex = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
 				
-				lookupregr %= 8;
+				lookupregreg %= 8;
+				lookupregrm %= 8;
 				
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				u8 modrm = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+				u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x69;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x69;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -2082,27 +2383,27 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// Specification from the Intel manual.
 				// REX.W 6b /r ib	IMUL r64, r/m64, imm8		#reg = r/m64 * imm8.
 				
-				u8 lookupregr = lookupreg(r);
-				
-				u8 lookupregrgt7 = (lookupregr>7);
+				u8 lookupregreg = lookupreg(r1);
+				u8 lookupregrm = lookupreg(r2);
 				
 				// REX-Prefix == 0100WR0B
-				u8 rex = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
+				u8 rex = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
 				
-				lookupregr %= 8;
+				lookupregreg %= 8;
+				lookupregrm %= 8;
 				
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				u8 modrm = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+				u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x6b;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x6b;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -2113,7 +2414,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		void loadimm (uint r, u64 n) {
 			
 			if (!n) xor(r, r);
-			else if ((((sint)n < 0) ? -n : n) >= (1 << 31)) {
+			else if ((((sint)n < 0) ? -n : n) >= ((u64)1 << 31)) {
 				// Specification from the Intel manual.
 				// REX.W B8+rd io		MOV r64, imm64		#Move imm64 to r64.
 				
@@ -2125,11 +2426,35 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				lookupregr %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = (0xb8+lookupregr);
+				*binaryappend1() = rex;
+				*binaryappend1() = (0xb8+lookupregr);
 				
 				// Append 64bits immediate value.
-				*(u64*)arrayu8append2(&b->binary, sizeof(u64)) = n;
+				*(u64*)binaryappend2(sizeof(u64)) = n;
+				
+			} else if (n < ((u64)1 << 31)) {
+				// Specification from the Intel manual.
+				// B8+rd id		MOV r32, imm32		#Move imm32 to r32.
+				
+				// Writing a 32bits register zero
+				// extend the result to 64bits, hence
+				// for a positive value, this shorter
+				// encoding can be used.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				if (lookupregr > 7) {
+					// REX-Prefix == 0100000B
+					*binaryappend1() = 0x41;
+					
+					lookupregr %= 8;
+				}
+				
+				// Append the opcode byte.
+				*binaryappend1() = (0xb8+lookupregr);
+				
+				// Append 32bits immediate value.
+				*(u32*)binaryappend2(sizeof(u32)) = n;
 				
 			} else {
 				// Specification from the Intel manual.
@@ -2149,14 +2474,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0xc7;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0xc7;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append 32bits immediate value.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = n;
+				*(u32*)binaryappend2(sizeof(u32)) = n;
 			}
 		}
 		
@@ -2189,18 +2514,25 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// REX.W F7 /5	IMUL r/m64	#Signed multiply RDX:RAX = RAX * r/m64,
 			// with the low result stored in RAX and high result stored in RDX.
 			
+			u8 lookupregrm = lookupreg(RDX);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregrm>7));
+			
+			lookupregrm %= 8;
+			
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|(5<<3)|RDX);
+			u8 modrm = ((0b11<<6)|(5<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x48; // REX-Prefix == 0100W000
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r != RDX) {
 				
@@ -2256,7 +2588,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			ldi(x, 0);
 			
-			xor(RDX, RDX);
+			cqo();
 			
 			// Specification from the Intel manual.
 			// REX.W F7 /7	IDIV r/m64	#Signed divide RDX:RAX by r/m64,
@@ -2276,11 +2608,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			regsinusetmp[x] = 0; // Unmark register as temporarily used.
 			
@@ -2338,7 +2670,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			ldi(x, 0);
 			
-			xor(RDX, RDX);
+			cqo();
 			
 			// Specification from the Intel manual.
 			// REX.W F7 /7	IDIV r/m64	#Signed divide RDX:RAX by r/m64,
@@ -2358,11 +2690,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			regsinusetmp[x] = 0; // Unmark register as temporarily used.
 			
@@ -2428,11 +2760,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(4<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r != RDX) {
 				
@@ -2508,11 +2840,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(6<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			regsinusetmp[x] = 0; // Unmark register as temporarily used.
 			
@@ -2590,11 +2922,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(6<<3)|lookupregx);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			regsinusetmp[x] = 0; // Unmark register as temporarily used.
 			
@@ -2637,11 +2969,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x21;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x21;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void andi (uint r) {
@@ -2681,11 +3013,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -2708,11 +3040,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -2739,16 +3071,16 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
-				*arrayu8append1(&b->binary) = n;
+				*binaryappend1() = n;
 				
-			} else if ((((sint)n < 0) ? -n : n) < (1 << 31)) {
+			} else if ((((sint)n < 0) ? -n : n) < ((u64)1 << 31)) {
 				// Specification from the Intel manual.
 				// REX.W 81 /4 id	AND r/m64, imm32	#r/m64 AND imm32 (sign-extended to 64bits).
 				
@@ -2766,14 +3098,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append 32bits immediate value.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = n;
+				*(u32*)binaryappend2(sizeof(u32)) = n;
 				
 			} else {
 				// Look for an unused register.
@@ -2814,11 +3146,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x09;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x09;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void ori (uint r) {
@@ -2858,11 +3190,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(1<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -2885,11 +3217,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(1<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -2933,11 +3265,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(6<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -2960,11 +3292,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(6<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -2989,11 +3321,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(2<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void sll (uint r1, uint r2) {
@@ -3045,11 +3377,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(4<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r2 != RCX) {
 				
@@ -3080,11 +3412,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			// Append the immediate value.
 			append8bitsimm(0);
@@ -3102,18 +3434,18 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			lookupregr %= 8;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			*arrayu8append1(&b->binary) = ((0b11<<6)|(4<<3)|lookupregr);
+			*binaryappend1() = ((0b11<<6)|(4<<3)|lookupregr);
 			
 			// Append the 8bits immediate value.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
 		
 		void srl (uint r1, uint r2) {
@@ -3165,11 +3497,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(5<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r2 != RCX) {
 				
@@ -3200,16 +3532,42 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(5<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			// Append the immediate value.
 			append8bitsimm(0);
 		}
 		
+		void srlimm (uint r, u8 n) {
+			// Specification from the Intel manual.
+			// REX.W C1 /5 ib	SHR r/m64, imm8		#Shift logically r/m64 right imm8 times.
+			
+			u8 lookupregr = lookupreg(r);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregr>7));
+			
+			lookupregr %= 8;
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			*binaryappend1() = ((0b11<<6)|(5<<3)|lookupregr);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = n;
+		}
+		
 		void sra (uint r1, uint r2) {
 			
 			uint r1r2wasxchged = 0;
@@ -3259,11 +3617,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			if (r2 != RCX) {
 				
@@ -3294,11 +3652,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(7<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
 			// Append the immediate value.
 			append8bitsimm(0);
@@ -3316,96 +3674,243 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			lookupregr %= 8;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			*arrayu8append1(&b->binary) = ((0b11<<6)|(7<<3)|lookupregr);
+			*binaryappend1() = ((0b11<<6)|(7<<3)|lookupregr);
 			
 			// Append the 8bits immediate value.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
 		
 		// Function which zero extend
 		// the n least significant bits
 		// of the register r.
-		void zxt (uint r, u8 n) {
+		void rol (uint r1, uint r2) {
 			
-			if (n == 8) {
-				// r must be a register that
-				// can be encoded in the field reg
-				// of an instruction ModR/M when
-				// it is used as an 8bits operand;
-				// either RAX, RBX, RCX, RDX;
-				
-				// Variable to be set to the register
-				// which will be encoded in the field
-				// reg of the instruction ModR/M.
-				uint rvalid;
-				
-				// Variable set to 1 if
-				// the register rvalid
-				// was saved.
-				uint rvalidwassaved = 0;
+			uint r1r2wasxchged = 0;
+			
+			if (r2 != RCX && r1 == RCX) {
+				// If I get here, I xchg r1 and r2
+				// so as to generate the least
+				// amount of intructions while
+				// setting up the rotation amount
+				// in RCX.
 				
-				// I find a valid unused register
-				// to use if r is not either
-				// of RAX, RBX, RCX, RDX.
-				if (r < RAX || r > RDX) {
-					
-					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-						// I get here if r was not
-						// either of RAX, RBX, RCX, RDX
-						// and I could not find a valid
-						// unused register to use.
-						
-						rvalid = RAX;
-						
-						savereg(rvalid); rvalidwassaved = 1;
-						
-					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-					
-					cpy(rvalid, r);
-					
-				} else rvalid = r;
+				xchg(r1, r2);
 				
-				// Specification from the Intel manual.
-				// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
+				// Set r1 and r2 to the register id
+				// that contain their values.
+				r1 ^= r2; r2 ^= r1; r1 ^= r2;
 				
-				u8 lookupregrvalid = lookupreg(rvalid);
+				r1r2wasxchged = 1;
+			}
+			
+			uint rcxwassaved = 0;
+			
+			if (r2 != RCX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(RCX)) {
+					savereg(RCX); rcxwassaved = 1;
+				} else regsinusetmp[RCX] = 1; // Mark unused register as temporarily used.
 				
-				u8 lookupregrvalidgt7 = (lookupregrvalid > 7);
+				cpy(RCX, r2);
+			}
+			
+			// Specification from the Intel manual.
+			// REX.W D3 /0	ROL r/m64, CL		#Rotate 64 bits r/m64 left CL times.
+			
+			u8 lookupregrm = lookupreg(r1);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregrm>7));
+			
+			lookupregrm %= 8;
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|(0<<3)|lookupregrm);
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xd3;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+			
+			if (r2 != RCX) {
+				
+				if (rcxwassaved) {
+					// Restore register value.
+					restorereg(RCX);
+				} else regsinusetmp[RCX] = 0; // Unmark register as temporarily used.
+			}
+			
+			if (r1r2wasxchged) xchg(r1, r2); // Restore registers value.
+		}
+		
+		void roli (uint r) {
+			// Specification from the Intel manual.
+			// REX.W C1 /0 ib	ROL r/m64, imm8		#Rotate 64 bits r/m64 left imm8 times.
+			
+			u8 lookupregr = lookupreg(r);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregr>7));
+			
+			lookupregr %= 8;
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|(0<<3)|lookupregr);
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+			
+			// Append the immediate value.
+			append8bitsimm(0);
+		}
+		
+		void ror (uint r1, uint r2) {
+			
+			uint r1r2wasxchged = 0;
+			
+			if (r2 != RCX && r1 == RCX) {
+				// If I get here, I xchg r1 and r2
+				// so as to generate the least
+				// amount of intructions while
+				// setting up the rotation amount
+				// in RCX.
+				
+				xchg(r1, r2);
+				
+				// Set r1 and r2 to the register id
+				// that contain their values.
+				r1 ^= r2; r2 ^= r1; r1 ^= r2;
+				
+				r1r2wasxchged = 1;
+			}
+			
+			uint rcxwassaved = 0;
+			
+			if (r2 != RCX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(RCX)) {
+					savereg(RCX); rcxwassaved = 1;
+				} else regsinusetmp[RCX] = 1; // Mark unused register as temporarily used.
+				
+				cpy(RCX, r2);
+			}
+			
+			// Specification from the Intel manual.
+			// REX.W D3 /1	ROR r/m64, CL		#Rotate 64 bits r/m64 right CL times.
+			
+			u8 lookupregrm = lookupreg(r1);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregrm>7));
+			
+			lookupregrm %= 8;
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|(1<<3)|lookupregrm);
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xd3;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+			
+			if (r2 != RCX) {
+				
+				if (rcxwassaved) {
+					// Restore register value.
+					restorereg(RCX);
+				} else regsinusetmp[RCX] = 0; // Unmark register as temporarily used.
+			}
+			
+			if (r1r2wasxchged) xchg(r1, r2); // Restore registers value.
+		}
+		
+		void rori (uint r) {
+			// Specification from the Intel manual.
+			// REX.W C1 /1 ib	ROR r/m64, imm8		#Rotate 64 bits r/m64 right imm8 times.
+			
+			u8 lookupregr = lookupreg(r);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregr>7));
+			
+			lookupregr %= 8;
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|(1<<3)|lookupregr);
+			
+			// Append the opcode byte.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+			
+			// Append the immediate value.
+			append8bitsimm(0);
+		}
+		
+		void zxt (uint r, u8 n) {
+			
+			if (n == 8) {
+				// Specification from the Intel manual.
+				// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
-				if (lookupregrvalidgt7) {
+				// A REX prefix, even without any
+				// of its bits set, allow for any
+				// register to be used as an 8bits
+				// operand, since SPL, BPL, SIL and DIL
+				// get encoded instead of AH, CH, DH, BH.
+				if (lookupregr > 3) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrvalidgt7<<2)|lookupregrvalidgt7);
+					*binaryappend1() = (0x40|(lookupregrgt7<<2)|lookupregrgt7);
 					
-					lookupregrvalid %= 8;
+					lookupregr %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb6;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb6;
 				
 				// Append the ModR/M byte.
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				*arrayu8append1(&b->binary) = ((0b11<<6)|(lookupregrvalid<<3)|lookupregrvalid);
-				
-				if (rvalid != r) {
-					
-					cpy(r, rvalid);
-					
-					if (rvalidwassaved) restorereg(rvalid);
-					// Unmark register as temporarily used.
-					else regsinusetmp[rvalid] = 0;
-				}
+				*binaryappend1() = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 				
 			} else if (n == 16) {
 				// Specification from the Intel manual.
@@ -3417,21 +3922,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2)|lookupregrgt7);
+					*binaryappend1() = (0x40|(lookupregrgt7<<2)|lookupregrgt7);
 					
 					lookupregr %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb7;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb7;
 				
 				// Append the ModR/M byte.
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				*arrayu8append1(&b->binary) = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+				*binaryappend1() = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 				
 			} else if (n == 32) {
 				// Specification from the Intel manual.
@@ -3443,20 +3948,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2)|lookupregrgt7);
+					*binaryappend1() = (0x40|(lookupregrgt7<<2)|lookupregrgt7);
 					
 					lookupregr %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x8b;
+				*binaryappend1() = 0x8b;
 				
 				// Append the ModR/M byte.
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				*arrayu8append1(&b->binary) = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+				*binaryappend1() = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 				
 			} else {
 				// I get here if n is not 8, 16 or 32.
@@ -3486,16 +3991,16 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = rex;
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = rex;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
-					*arrayu8append1(&b->binary) = modrm;
+					*binaryappend1() = modrm;
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = bitselect;
+					*binaryappend1() = bitselect;
 					
-				} else if (bitselect < (1<<31)) {
+				} else if (bitselect < ((u64)1<<31)) {
 					// Specification from the Intel manual.
 					// REX.W 81 /4 id	AND r/m64, imm32		#r/m64 AND imm32 (sign-extended).
 					
@@ -3513,14 +4018,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = rex;
-					*arrayu8append1(&b->binary) = 0x81;
+					*binaryappend1() = rex;
+					*binaryappend1() = 0x81;
 					
 					// Append the ModR/M byte.
-					*arrayu8append1(&b->binary) = modrm;
+					*binaryappend1() = modrm;
 					
 					// Append the 32bits immediate value.
-					*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = bitselect;
+					*(u32*)binaryappend2(sizeof(u32)) = bitselect;
 					
 				} else {
 					// Look for an unused register
@@ -3548,75 +4053,33 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		void sxt (uint r, u8 n) {
 			
 			if (n == 8) {
-				// r must be a register that
-				// can be encoded in the field reg
-				// of an instruction ModR/M when
-				// it is used as an 8bits operand;
-				// either RAX, RBX, RCX, RDX;
-				
-				// Variable to be set to the register
-				// which will be encoded in the field
-				// reg of the instruction ModR/M.
-				uint rvalid;
-				
-				// Variable set to 1 if
-				// the register rvalid
-				// was saved.
-				uint rvalidwassaved = 0;
-				
-				// I find a valid unused register
-				// to use if r is not either
-				// of RAX, RBX, RCX, RDX.
-				if (r < RAX || r > RDX) {
-					
-					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-						// I get here if r was not
-						// either of RAX, RBX, RCX, RDX
-						// and I could not find a valid
-						// unused register to use.
-						
-						rvalid = RAX;
-						
-						savereg(rvalid); rvalidwassaved = 1;
-						
-					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-					
-					cpy(rvalid, r);
-					
-				} else rvalid = r;
-				
 				// Specification from the Intel manual.
 				// REX.W 0F BE /r	MOVSX r64, r/m8		#Move r/m8 to r64, sign-extension.
 				
-				u8 lookupregrvalid = lookupreg(rvalid);
+				// Since a REX prefix is always used,
+				// any register can be used as an 8bits
+				// operand, SPL, BPL, SIL and DIL getting
+				// encoded instead of AH, CH, DH, BH.
+				
+				u8 lookupregr = lookupreg(r);
 				
-				//u8 lookupregrvalidgt7 = (lookupregrvalid > 7);
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
 				// REX-Prefix == 0100WR0B
-				//u8 rex = (0x48|((lookupregrvalidgt7)<<2)|(lookupregrvalidgt7));
+				*binaryappend1() = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
 				
-				//lookupregrvalid %= 8; // rvalid is <= 7;
+				lookupregr %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x48; //rex;
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xbe;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xbe;
 				
 				// Append the ModR/M byte.
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				*arrayu8append1(&b->binary) = ((0b11<<6)|(lookupregrvalid<<3)|lookupregrvalid);
-				
-				if (rvalid != r) {
-					
-					cpy(r, rvalid);
-					
-					if (rvalidwassaved) restorereg(rvalid);
-					// Unmark register as temporarily used.
-					else regsinusetmp[rvalid] = 0;
-				}
+				*binaryappend1() = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 				
 			} else if (n == 16) {
 				// Specification from the Intel manual.
@@ -3627,20 +4090,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 lookupregrgt7 = (lookupregr > 7);
 				
 				// REX-Prefix == 0100WR0B
-				*arrayu8append1(&b->binary) = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
+				*binaryappend1() = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
 				
 				lookupregr %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xbf;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xbf;
 				
 				// Append the ModR/M byte.
 				// From the most significant bit to the least significant bit.
 				// MOD == 0b11;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-				*arrayu8append1(&b->binary) = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+				*binaryappend1() = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 				
 			} else {
 				// I get here if n is not 8 or 16.
@@ -3658,6 +4121,44 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
+		// Function which set the register
+		// given as argument to 1 or 0, using
+		// the SETcc instruction which second
+		// opcode byte is given as argument,
+		// and zero extend the 8bits result.
+		void setcc (uint r, u8 opcode) {
+			
+			u8 lookupregr = lookupreg(r);
+			
+			// A REX prefix, even without any
+			// of its bits set, allow for any
+			// register to be used as an 8bits
+			// operand, since SPL, BPL, SIL and DIL
+			// get encoded instead of AH, CH, DH, BH.
+			if (lookupregr > 3) {
+				// REX-Prefix == 0100000B
+				*binaryappend1() = (0x40|(lookupregr>7));
+				
+				lookupregr %= 8;
+			}
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|lookupregr);
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = opcode;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+			
+			// I zero extend the 8 bits result.
+			zxt(r, 8);
+		}
+		
 		void cmp (uint r1, uint r2) {
 			// Specification from the Intel manual.
 			// REX.W 39 /r	CMP r/m64, r64		#Compare r64 with r/m64.
@@ -3678,167 +4179,31 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x39;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x39;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 		}
 		
 		void seq (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmp(r1, r2);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
-			
-			cmp(rvalid, r2);
-			
-			// Specification from the Intel manual.
-			// REX.W 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
-			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
-			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r1, 0x94);
 		}
 		
 		void sne (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
-			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
 			
-			cmp(rvalid, r2);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
-			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
-			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
 			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r1, 0x95);
 		}
 		
 		void cmpi (uint r) {
@@ -3878,11 +4243,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(7<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -3905,11 +4270,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 modrm = ((0b11<<6)|(7<<3)|lookupregr);
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
+				*binaryappend1() = modrm;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -3917,1743 +4282,1446 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		}
 		
 		void seqi (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmpi(r);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			setcc(r, 0x94);
+		}
+		
+		void snei (uint r) {
 			
-			cmpi(rvalid);
+			cmpi(r);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
-			
-			u8 lookupregrm = lookupreg(rvalid);
+			// 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			setcc(r, 0x95);
+		}
+		
+		void slt (uint r1, uint r2) {
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			cmp(r1, r2);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Specification from the Intel manual.
+			// 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
+			setcc(r1, 0x9c);
+		}
+		
+		void slte (uint r1, uint r2) {
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			cmp(r1, r2);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Specification from the Intel manual.
+			// 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r1, 0x9e);
 		}
 		
-		void snei (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void sltu (uint r1, uint r2) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmp(r1, r2);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 92	SETB r/m8	#Set byte if below (CF=1).
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			setcc(r1, 0x92);
+		}
+		
+		void slteu (uint r1, uint r2) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
+			// 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
 			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			setcc(r1, 0x96);
+		}
+		
+		void sgt (uint r1, uint r2) {
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			cmp(r1, r2);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Specification from the Intel manual.
+			// 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
+			setcc(r1, 0x9f);
+		}
+		
+		void sgte (uint r1, uint r2) {
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			cmp(r1, r2);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Specification from the Intel manual.
+			// 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r1, 0x9d);
 		}
 		
-		void slt (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void sgtu (uint r1, uint r2) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmp(r1, r2);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+			setcc(r1, 0x97);
+		}
+		
+		void sgteu (uint r1, uint r2) {
 			
-			cmp(rvalid, r2);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
+			// 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			setcc(r1, 0x93);
+		}
+		
+		void slti (uint r) {
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			cmpi(r);
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Specification from the Intel manual.
+			// 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
-			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9c;
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r, 0x9c);
 		}
 		
-		void slte (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
-			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+		void sltei (uint r) {
 			
-			cmp(rvalid, r2);
+			cmpi(r);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
-			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9e;
+			setcc(r, 0x9e);
+		}
+		
+		void sltui (uint r) {
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			cmpi(r);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Specification from the Intel manual.
+			// 0F 92	SETB r/m8	#Set byte if below (CF=1).
 			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r, 0x92);
 		}
 		
-		void sltu (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void slteui (uint r) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmpi(r);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+			setcc(r, 0x96);
+		}
+		
+		void sgti (uint r) {
 			
-			cmp(rvalid, r2);
+			cmpi(r);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 92	SETB r/m8	#Set byte if below (CF=1).
+			// 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
 			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			setcc(r, 0x9f);
+		}
+		
+		void sgtei (uint r) {
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			cmpi(r);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Specification from the Intel manual.
+			// 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x92;
+			setcc(r, 0x9d);
+		}
+		
+		void sgtui (uint r) {
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			cmpi(r);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Specification from the Intel manual.
+			// 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
 			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			setcc(r, 0x97);
 		}
 		
-		void slteu (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+		void sgteui (uint r) {
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+			cmpi(r);
 			
-			cmp(rvalid, r2);
+			// Specification from the Intel manual.
+			// 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
 			
+			setcc(r, 0x93);
+		}
+		
+		// Function used to compare
+		// a register value against zero.
+		void cmptozero (uint r) {
 			// Specification from the Intel manual.
-			// REX.W 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
+			// REX.W 85 /r	TEST r/m64, r64		# AND r64 with r/m64; set SF, ZF, PF according to result.
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			u8 lookupregr = lookupreg(r);
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			u8 lookupregrgt7 = (lookupregr>7);
+			
+			// REX-Prefix == 0100WR0B
+			u8 rex = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			lookupregr %= 8;
 			
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// REG == reg[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
+			u8 modrm = ((0b11<<6)|(lookupregr<<3)|lookupregr);
 			
 			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x96;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x85;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			*binaryappend1() = modrm;
 		}
 		
-		void sgt (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void sz (uint r) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmptozero(r);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 0F 94	SETZ r/m8	#Set byte if zero (ZF=1).
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+			setcc(r, 0x94);
+		}
+		
+		void snz (uint r) {
 			
-			cmp(rvalid, r2);
+			cmptozero(r);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
-			
-			u8 lookupregrm = lookupreg(rvalid);
+			// 0F 95	SETNZ r/m8	#Set byte if not zero (ZF=0).
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
-			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
-			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9f;
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r1) {
+			setcc(r, 0x95);
+		}
+		
+		void afip (uint r) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			//if (b->isimmused == IMM64) { // ### Commented-out as RIP-relative addressing is failing.
+				// Specification from the Intel manual.
+				// E8 cd	CALL rel32	#Call relative.
+				// ### Using the rel16 variant
+				// ### (by prefixing 0x66) which
+				// ### is shorter, would segfault.
 				
-				cpy(r1, rvalid);
+				// Append the opcode byte.
+				*binaryappend1() = 0xe8;
 				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+				// Append a 32bits offset immediate value of zero.
+				*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
+				
+				uint bbinarysz = b->binarysz;
+				
+				// Pop in r the return address
+				// which is the address of
+				// the POP instruction itself.
+				pop(r);
+				
+				// Note that the immediate field for which
+				// the offset will be encoded in b->immfieldoffset
+				// is expected to be in the last bytes of afip.
+				addi(r);
+				
+				// Increment the immediate misc value
+				// to account for instructions from
+				// after the CALL instruction.
+				b->immmiscvalue += (b->binarysz - bbinarysz);
+				
+			/*} else { // ### Commented-out as RIP-relative addressing is failing.
+				// Specification from the Intel manual.
+				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+				// The ModR/M byte get set such that
+				// a 32bits displacement is expected.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				// REX-Prefix == 0100WR00
+				u8 rex = (0x48|((lookupregr>7)<<2));
+				
+				lookupregr %= 8;
+				
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b101
+				u8 modrm = ((lookupregr<<3)|0b101);
+				
+				// Append the opcode byte.
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x8b;
+				
+				// Append the ModR/M byte.
+				*binaryappend1() = modrm;
+				
+				// Append the immediate value.
+				// Note that the immediate field for which
+				// the offset will be encoded in b->immfieldoffset
+				// is expected to be in the last bytes of afip.
+				append32bitsimm(0);
+			}*/
 		}
 		
-		void sgte (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
-			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
+		void afip2 (uint r) {
+			// If b->isimm2used is set, then
+			// I am redoing the lyricalinstruction.
+			//if (b->isimm2used == IMM64) { // ### Commented-out as RIP-relative addressing is failing.
+				// Specification from the Intel manual.
+				// E8 cd	CALL rel32	#Call relative.
+				// ### Using the rel16 variant
+				// ### (by prefixing 0x66) which
+				// ### is shorter, would segfault.
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode byte.
+				*binaryappend1() = 0xe8;
 				
-				cpy(rvalid, r1);
+				// Append a 32bits offset immediate value of zero.
+				*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 				
-			} else rvalid = r1;
-			
-			cmp(rvalid, r2);
-			
+				uint bbinarysz = b->binarysz;
+				
+				// Pop in r the return address
+				// which is the address of
+				// the POP instruction itself.
+				pop(r);
+				
+				// Note that the immediate2 field for which
+				// the offset will be encoded in b->imm2fieldoffset
+				// is expected to be in the last bytes of afip2.
+				addi2(r);
+				
+				// Increment the immediate2 misc value
+				// to account for instructions from
+				// after the CALL instruction.
+				b->imm2miscvalue += (b->binarysz - bbinarysz);
+				
+			/*} else { // ### Commented-out as RIP-relative addressing is failing.
+				// Specification from the Intel manual.
+				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+				// The ModR/M byte get set such that
+				// a 32bits displacement is expected.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				// REX-Prefix == 0100WR00
+				u8 rex = (0x48|((lookupregr>7)<<2));
+				
+				lookupregr %= 8;
+				
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b101
+				u8 modrm = ((lookupregr<<3)|0b101);
+				
+				// Append the opcode byte.
+				*binaryappend1() = rex;
+				*binaryappend1() = 0x8b;
+				
+				// Append the ModR/M byte.
+				*binaryappend1() = modrm;
+				
+				// Append the immediate2 value.
+				// Note that the immediate2 field for which
+				// the offset will be encoded in b->imm2fieldoffset
+				// is expected to be in the last bytes of afip2.
+				append32bitsimm2(0);
+			}*/
+		}
+		
+		void jr (uint r) {
 			// Specification from the Intel manual.
-			// REX.W 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
+			// FF /4	JMP r/m64	#Jump absolute.
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			u8 lookupregr = lookupreg(r);
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			if (lookupregr > 7) {
+				// REX-Prefix == 0100000B
+				*binaryappend1() = 0x41;
+				
+				lookupregr %= 8;
+			}
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Append the opcode byte.
+			*binaryappend1() = 0xff;
 			
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
-			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9d;
+			u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r1) {
+			*binaryappend1() = modrm;
+		}
+		
+		void j () {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				cpy(r1, rvalid);
+				// There is always enough
+				// unused registers before
+				// a non-conditional branching,
+				// because all registers
+				// are flushed and discarded.
+				// This function is also
+				// used when generating
+				// conditional branching;
+				// for conditional branching,
+				// the compiler insured that
+				// there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				// Mark unused register as temporarily used.
+				regsinusetmp[unusedreg] = 1;
+				
+				afip(unusedreg);
+				jr(unusedreg);
 				
-				if (rvalidwassaved) restorereg(rvalid);
 				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
+				regsinusetmp[unusedreg] = 0;
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// E9 cd	JMP rel32	#Jump relative, RIP = RIP + 32-bit.
+				
+				// Append the opcode byte.
+				*binaryappend1() = 0xe9;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// EB cb	JMP rel8	#Jump relative, RIP = RIP + 8-bit.
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0xEB;
+				
+				// Append the immediate value.
+				append8bitsimm(0);
 			}
 		}
 		
-		void sgtu (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		void jeq (uint r1, uint r2) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			cmp(r1, r2);
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode bytes.
+				*binaryappend1() = 0x75;
 				
-				cpy(rvalid, r1);
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
 				
-			} else rvalid = r1;
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 84 cd	JE rel32	#Jump near if equal (ZF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x84;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 74 cb	JE rel8	#Jump short if equal (ZF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x74;
+				
+				// Append the immediate value.
+				append8bitsimm(0);
+			}
+		}
+		
+		void jeqr (uint r1, uint r2, uint r3) {
 			
-			cmp(rvalid, r2);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x75;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x97;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			uint opstart = b->binarysz;
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			jr(r3);
 			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sgteu (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void ji () {
+			// The x64 instruction set
+			// do not have a jump instruction
+			// to an immediate absolute address,
+			// so I use an unused register to hold
+			// the absolute address to jump to.
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			// Look for an unused register.
+			uint unusedreg = findunusedreg(0);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// There is always enough
+			// unused registers before
+			// a non-conditional branching,
+			// because all registers
+			// are flushed and discarded.
+			// This function is also
+			// used when generating
+			// conditional branching;
+			// for conditional branching,
+			// the compiler insured that
+			// there are enough unused
+			// registers available.
+			if (!unusedreg) throwerror();
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
-				
-			} else rvalid = r1;
+			// Mark unused register as temporarily used.
+			regsinusetmp[unusedreg] = 1;
 			
-			cmp(rvalid, r2);
+			ldi(unusedreg, 0);
 			
-			// Specification from the Intel manual.
-			// REX.W 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
+			jr(unusedreg);
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			// Unmark register as temporarily used.
+			regsinusetmp[unusedreg] = 0;
+		}
+		
+		void jeqi (uint r1, uint r2) {
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			cmp(r1, r2);
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Specification from the Intel manual.
+			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x75;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x93;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			uint opstart = b->binarysz;
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			ji();
 			
-			if (rvalid != r1) {
-				
-				cpy(r1, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void slti (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		void jne (uint r1, uint r2) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			cmp(r1, r2);
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 74 cb	JE rel8	#Jump short if equal (ZF=1).
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode bytes.
+				*binaryappend1() = 0x74;
+				
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 85 cd	JNE rel32	#Jump near if not equal (ZF=0).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x85;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 				
-				cpy(rvalid, r);
+				// Append the opcode bytes.
+				*binaryappend1() = 0x75;
 				
-			} else rvalid = r;
+				// Append the immediate value.
+				append8bitsimm(0);
+			}
+		}
+		
+		void jner (uint r1, uint r2, uint r3) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
+			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x74;
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			uint opstart = b->binarysz;
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			jr(r3);
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9c;
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jnei (uint r1, uint r2) {
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			cmp(r1, r2);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Specification from the Intel manual.
+			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			// Append the opcode bytes.
+			*binaryappend1() = 0x74;
+			
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
+			
+			uint opstart = b->binarysz;
+			
+			ji();
+			
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sltei (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		void jlt (uint r1, uint r2) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			cmp(r1, r2);
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode bytes.
+				*binaryappend1() = 0x7d;
+				
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 8C cd	JL rel32	#Jump near if less (SF≠OF).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x8c;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
 				
-				cpy(rvalid, r);
+			} else {
+				// Specification from the Intel manual.
+				// 7C cb	JL rel8	#Jump short if less (SF≠OF).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x7c;
 				
-			} else rvalid = r;
+				// Append the immediate value.
+				append8bitsimm(0);
+			}
+		}
+		
+		void jltr (uint r1, uint r2, uint r3) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x7d;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9e;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			uint opstart = b->binarysz;
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			jr(r3);
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sltui (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
-			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+		void jlti (uint r1, uint r2) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 92	SETB r/m8	#Set byte if below (CF=1).
-			
-			u8 lookupregrm = lookupreg(rvalid);
+			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// Append the opcode bytes.
+			*binaryappend1() = 0x7d;
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			uint opstart = b->binarysz;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x92;
+			ji();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jlte (uint r1, uint r2) {
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			cmp(r1, r2);
 			
-			if (rvalid != r) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x7f;
 				
-				cpy(r, rvalid);
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
 				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 8E cd	JLE rel32	#Jump near if less or equal (ZF=1 or SF≠OF).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x8e;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 7E cb	JLE rel8	#Jump short if less or equal (ZF=1 or SF≠OF).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x7e;
+				
+				// Append the immediate value.
+				append8bitsimm(0);
 			}
 		}
 		
-		void slteui (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void jlter (uint r1, uint r2, uint r3) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmp(r1, r2);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x7f;
 			
-			cmpi(rvalid);
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Specification from the Intel manual.
-			// REX.W 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
+			uint opstart = b->binarysz;
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			jr(r3);
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jltei (uint r1, uint r2) {
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			cmp(r1, r2);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Specification from the Intel manual.
+			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x96;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x7f;
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			uint opstart = b->binarysz;
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			ji();
+			
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sgti (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		void jltu (uint r1, uint r2) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			cmp(r1, r2);
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 73 cb	JNB rel8	#Jump short if not below (CF=0).
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode bytes.
+				*binaryappend1() = 0x73;
+				
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 82 cd	JB rel32	#Jump near if below (CF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x82;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 72 cb	JB rel8	#Jump short if below (CF=1).
 				
-				cpy(rvalid, r);
+				// Append the opcode bytes.
+				*binaryappend1() = 0x72;
 				
-			} else rvalid = r;
+				// Append the immediate value.
+				append8bitsimm(0);
+			}
+		}
+		
+		void jltur (uint r1, uint r2, uint r3) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
-			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x73;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9f;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			uint opstart = b->binarysz;
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			jr(r3);
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sgtei (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
-			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
-			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+		void jltui (uint r1, uint r2) {
 			
-			cmpi(rvalid);
+			cmp(r1, r2);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
-			
-			u8 lookupregrm = lookupreg(rvalid);
+			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// Append the opcode bytes.
+			*binaryappend1() = 0x73;
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			uint opstart = b->binarysz;
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9d;
+			ji();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jlteu (uint r1, uint r2) {
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			cmp(r1, r2);
 			
-			if (rvalid != r) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
 				
-				cpy(r, rvalid);
+				// Append the opcode bytes.
+				*binaryappend1() = 0x77;
 				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 86 cd	JBE rel32	#Jump near if below or equal (CF=1 or ZF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x86;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 76 cb	JBE rel8	#Jump short if below or equal (CF=1 or ZF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x76;
+				
+				// Append the immediate value.
+				append8bitsimm(0);
 			}
 		}
 		
-		void sgtui (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void jlteur (uint r1, uint r2, uint r3) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmp(r1, r2);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x77;
 			
-			cmpi(rvalid);
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Specification from the Intel manual.
-			// REX.W 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
+			uint opstart = b->binarysz;
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			jr(r3);
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jlteui (uint r1, uint r2) {
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			cmp(r1, r2);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Specification from the Intel manual.
+			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x97;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x77;
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			uint opstart = b->binarysz;
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			ji();
+			
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sgteui (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		void jz (uint r) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			cmptozero(r);
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
 				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				// Append the opcode bytes.
+				*binaryappend1() = 0x75;
+				
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 84 cd	JZ rel32	#Jump near if zero (ZF=1).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x84;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 74 cb	JZ rel8	#Jump short if zero (ZF=1).
 				
-				cpy(rvalid, r);
+				// Append the opcode bytes.
+				*binaryappend1() = 0x74;
 				
-			} else rvalid = r;
+				// Append the immediate value.
+				append8bitsimm(0);
+			}
+		}
+		
+		void jzr (uint r1, uint r2) {
 			
-			cmpi(rvalid);
+			cmptozero(r1);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
+			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x75;
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			uint opstart = b->binarysz;
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			jr(r2);
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jzi (uint r) {
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x93;
+			cmptozero(r);
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Specification from the Intel manual.
+			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x75;
+			
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
+			
+			uint opstart = b->binarysz;
+			
+			ji();
+			
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		void jnz (uint r) {
+			
+			cmptozero(r);
 			
-			if (rvalid != r) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Specification from the Intel manual.
+				// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 				
-				cpy(r, rvalid);
+				// Append the opcode bytes.
+				*binaryappend1() = 0x74;
 				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
+				// Append the 8bits immediate
+				// field which is the bytesize
+				// of the following branching
+				// instruction.
+				uint imm = b->binarysz;
+				binaryappend1();
+				
+				uint opstart = b->binarysz;
+				
+				j();
+				
+				// Set the 8bits immediate field appended above.
+				binaryptr()[imm] = (b->binarysz - opstart);
+				
+			} else if (b->isimmused == IMM32) {
+				// Specification from the Intel manual.
+				// 0F 85 cd	JNZ rel32	#Jump near if not zero (ZF=0).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x85;
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
+				
+				// Append the opcode bytes.
+				*binaryappend1() = 0x75;
+				
+				// Append the immediate value.
+				append8bitsimm(0);
 			}
 		}
 		
-		// Function used to compare
-		// a register value against zero.
-		void cmptozero (uint r) {
-			// Specification from the Intel manual.
-			// REX.W 85 /r	TEST r/m64, r64		# AND r64 with r/m64; set SF, ZF, PF according to result.
+		void jnzr (uint r1, uint r2) {
 			
-			u8 lookupregr = lookupreg(r);
+			cmptozero(r1);
 			
-			u8 lookupregrgt7 = (lookupregr>7);
+			// Specification from the Intel manual.
+			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 			
-			// REX-Prefix == 0100WR0B
-			u8 rex = (0x48|(lookupregrgt7<<2)|lookupregrgt7);
+			// Append the opcode bytes.
+			*binaryappend1() = 0x74;
 			
-			lookupregr %= 8;
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == reg[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-			u8 modrm = ((0b11<<6)|(lookupregr<<3)|lookupregr);
+			uint opstart = b->binarysz;
 			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x85;
+			jr(r2);
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
-		void sz (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void jnzi (uint r) {
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			cmptozero(r);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Specification from the Intel manual.
+			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x74;
+			
+			// Append the 8bits immediate
+			// field which is the bytesize
+			// of the following branching
+			// instruction.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			cmptozero(rvalid);
+			uint opstart = b->binarysz;
+			
+			ji();
 			
+			// Set the 8bits immediate field appended above.
+			binaryptr()[imm] = (b->binarysz - opstart);
+		}
+		
+		// Generate the instruction that compute
+		// in r, an RIP-relative address, and return
+		// the address of the 32bits immediate field
+		// which is set to the displacement from RIP.
+		/* // ### Commented-out as RIP-relative addressing is failing.
+		u32* gip32 (uint r) {
 			// Specification from the Intel manual.
-			// REX.W 0F 94	SETZ r/m8	#Set byte if zero (ZF=1).
+			// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+			// The ModR/M byte get set such that
+			// a 32bits displacement is expected.
 			
-			u8 lookupregrm = lookupreg(rvalid);
+			u8 lookupregr = lookupreg(r);
 			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// REX-Prefix == 0100WR00
+			u8 rex = (0x48|((lookupregr>7)<<2));
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			lookupregr %= 8;
 			
 			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			// MOD == 0b00;
+			// REG == reg[2:0]; #Only the 3 least significant bits matters.
+			// R/M == 0b101
+			u8 modrm = ((lookupregr<<3)|0b101);
 			
 			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x8b;
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = modrm;
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
-			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
-		}
+			// Append a 32bits offset immediate field,
+			// set it null and return its address.
+			u32* imm = (u32*)binaryappend2(sizeof(u32));
+			*imm = 0;
+			return imm;
+		}*/
 		
-		void snz (uint r) {
-			// r must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		// Generate the instruction that compute
+		// in r, an RIP-relative address, and return
+		// the offset, within the binary of the
+		// instruction, of the 8bits immediate field
+		// which is set to the displacement from RIP.
+		uint gip8 (uint r) {
+			// Specification from the Intel manual.
+			// E8 cd	CALL rel32	#Call relative.
+			// ### Using the rel16 variant
+			// ### (by prefixing 0x66) which
+			// ### is shorter, would segfault.
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			// Append the opcode byte.
+			*binaryappend1() = 0xe8;
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			// Append a 32bits offset immediate value of zero.
+			*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 			
-			// I find a valid unused register
-			// to use if r is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r < RAX || r > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					rvalid = RAX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r);
-				
-			} else rvalid = r;
+			uint opstart = b->binarysz;
 			
-			cmptozero(rvalid);
+			// Pop in r the return address
+			// which is the address of
+			// the POP instruction itself.
+			pop(r);
 			
 			// Specification from the Intel manual.
-			// REX.W 0F 95	SETNZ r/m8	#Set byte if not zero (ZF=0).
-			
-			u8 lookupregrm = lookupreg(rvalid);
-			
-			// REX-Prefix == 0100W00B
-			//u8 rex = (0x48|(lookupregrm>7));
+			// REX.W 83 /0 ib     ADD r/m64, imm8         #Add sign-extended imm8 to r/m64.
 			
-			//lookupregrm %= 8; // rvalid is <= 7;
+			// Append the opcode byte.
+			*binaryappend1() = 0x48;
+			*binaryappend1() = 0x83;
 			
+			// Append the ModR/M byte.
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|lookupregrm);
+			*binaryappend1() = ((0b11<<6)|lookupreg(r));
 			
-			// Append the opcode byte.
-			//*arrayu8append1(&b->binary) = 0x48; //rex; // Not needed.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
+			// Append the 8bits immediate field to be later set.
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			// Set the immediate value
+			// to account for instructions from
+			// after the CALL instruction.
+			binaryptr()[imm] = (b->binarysz - opstart);
 			
-			// I zero extend the 8 bits result.
-			zxt(rvalid, 8);
+			return imm;
+		}
+		
+		void jl (uint r) {
 			
-			if (rvalid != r) {
-				
-				cpy(r, rvalid);
-				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
-			}
+			uint imm = gip8(r);
+			
+			uint opstart = b->binarysz;
+			
+			j();
+			
+			// Increment the 8bits immediate field from gip8().
+			binaryptr()[imm] += (b->binarysz - opstart);
 		}
 		
-		void afip (uint r) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			//if (b->isimmused == IMM64) { // ### Commented-out as RIP-relative addressing is failing.
-				// Specification from the Intel manual.
-				// E8 cd	CALL rel32	#Call relative.
-				// ### Using the rel16 variant
-				// ### (by prefixing 0x66) which
-				// ### is shorter, would segfault.
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0xe8;
-				
-				// Append a 32bits offset immediate value of zero.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
-				
-				uint mmszbbinaryptr = mmsz(b->binary.ptr);
-				
-				// Pop in r the return address
-				// which is the address of
-				// the POP instruction itself.
-				pop(r);
-				
-				// Note that the immediate field for which
-				// the offset will be encoded in b->immfieldoffset
-				// is expected to be in the last bytes of afip.
-				addi(r);
-				
-				// Increment the immediate misc value
-				// to account for instructions from
-				// after the CALL instruction.
-				b->immmiscvalue += (mmsz(b->binary.ptr) - mmszbbinaryptr);
-				
-			/*} else { // ### Commented-out as RIP-relative addressing is failing.
-				// Specification from the Intel manual.
-				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
-				// The ModR/M byte get set such that
-				// a 32bits displacement is expected.
-				
-				u8 lookupregr = lookupreg(r);
-				
-				// REX-Prefix == 0100WR00
-				u8 rex = (0x48|((lookupregr>7)<<2));
-				
-				lookupregr %= 8;
-				
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b101
-				u8 modrm = ((lookupregr<<3)|0b101);
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x8b;
-				
-				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
-				
-				// Append the immediate value.
-				// Note that the immediate field for which
-				// the offset will be encoded in b->immfieldoffset
-				// is expected to be in the last bytes of afip.
-				append32bitsimm(0);
-			}*/
+		void jlr (uint r1, uint r2) {
+			
+			uint imm = gip8(r1);
+			
+			uint opstart = b->binarysz;
+			
+			jr(r2);
+			
+			// Increment the 8bits immediate field from gip8().
+			binaryptr()[imm] += (b->binarysz - opstart);
 		}
 		
-		void afip2 (uint r) {
-			// If b->isimm2used is set, then
-			// I am redoing the lyricalinstruction.
-			//if (b->isimm2used == IMM64) { // ### Commented-out as RIP-relative addressing is failing.
-				// Specification from the Intel manual.
-				// E8 cd	CALL rel32	#Call relative.
-				// ### Using the rel16 variant
-				// ### (by prefixing 0x66) which
-				// ### is shorter, would segfault.
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0xe8;
-				
-				// Append a 32bits offset immediate value of zero.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
-				
-				uint mmszbbinaryptr = mmsz(b->binary.ptr);
-				
-				// Pop in r the return address
-				// which is the address of
-				// the POP instruction itself.
-				pop(r);
-				
-				// Note that the immediate2 field for which
-				// the offset will be encoded in b->imm2fieldoffset
-				// is expected to be in the last bytes of afip2.
-				addi2(r);
-				
-				// Increment the immediate2 misc value
-				// to account for instructions from
-				// after the CALL instruction.
-				b->imm2miscvalue += (mmsz(b->binary.ptr) - mmszbbinaryptr);
-				
-			/*} else { // ### Commented-out as RIP-relative addressing is failing.
-				// Specification from the Intel manual.
-				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
-				// The ModR/M byte get set such that
-				// a 32bits displacement is expected.
-				
-				u8 lookupregr = lookupreg(r);
-				
-				// REX-Prefix == 0100WR00
-				u8 rex = (0x48|((lookupregr>7)<<2));
-				
-				lookupregr %= 8;
-				
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b101
-				u8 modrm = ((lookupregr<<3)|0b101);
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = rex;
-				*arrayu8append1(&b->binary) = 0x8b;
-				
-				// Append the ModR/M byte.
-				*arrayu8append1(&b->binary) = modrm;
-				
-				// Append the immediate2 value.
-				// Note that the immediate2 field for which
-				// the offset will be encoded in b->imm2fieldoffset
-				// is expected to be in the last bytes of afip2.
-				append32bitsimm2(0);
-			}*/
+		void jli (uint r) {
+			// The x64 instruction set
+			// do not have a jump instruction
+			// to an immediate absolute address,
+			// so I use an unused register to hold
+			// the absolute address to jump to.
+			
+			// Look for an unused register.
+			uint unusedreg = findunusedreg(0);
+			
+			// Since all registers are
+			// flushed before a branching,
+			// there should be unused
+			// registers available.
+			if (!unusedreg) throwerror();
+			
+			// Mark unused register as temporarily used.
+			regsinusetmp[unusedreg] = 1;
+			
+			ldi(unusedreg, 0);
+			
+			jlr(r, unusedreg);
+			
+			// Unmark register as temporarily used.
+			regsinusetmp[unusedreg] = 0;
 		}
 		
-		void jr (uint r) {
+		void jpushr (uint r) {
 			// Specification from the Intel manual.
-			// FF /4	JMP r/m64	#Jump absolute.
+			// FF /2	CALL r/m64	#Call absolute.
 			
 			u8 lookupregr = lookupreg(r);
 			
 			if (lookupregr > 7) {
 				// REX-Prefix == 0100000B
-				*arrayu8append1(&b->binary) = 0x41;
+				*binaryappend1() = 0x41;
 				
 				lookupregr %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xff;
+			*binaryappend1() = 0xff;
 			
+			// Append the ModR/M byte.
 			// From the most significant bit to the least significant bit.
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			u8 modrm = ((0b11<<6)|(4<<3)|lookupregr);
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
+			*binaryappend1() = ((0b11<<6)|(2<<3)|lookupregr);
 		}
 		
-		void j () {
+		void jpush () {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -5665,144 +5733,42 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// a non-conditional branching,
 				// because all registers
 				// are flushed and discarded.
-				// This function is also
-				// used when generating
-				// conditional branching;
-				// for conditional branching,
-				// the compiler insured that
-				// there are enough unused
-				// registers available.
 				if (!unusedreg) throwerror();
 				
 				// Mark unused register as temporarily used.
 				regsinusetmp[unusedreg] = 1;
 				
 				afip(unusedreg);
-				jr(unusedreg);
+				jpushr(unusedreg);
 				
 				// Unmark register as temporarily used.
 				regsinusetmp[unusedreg] = 0;
 				
-			} else if (b->isimmused == IMM32) {
+			} else {
 				// Specification from the Intel manual.
-				// E9 cd	JMP rel32	#Jump relative, RIP = RIP + 32-bit.
+				// E8 cd	CALL rel32	#Call relative.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0xe9;
+				*binaryappend1() = 0xe8;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
-				
-			} else {
-				// Specification from the Intel manual.
-				// EB cb	JMP rel8	#Jump relative, RIP = RIP + 8-bit.
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0xEB;
-				
-				// Append the immediate value.
-				append8bitsimm(0);
 			}
 		}
 		
-		void jeq (uint r1, uint r2) {
+		void jpushi () {
+			// The x64 instruction set
+			// do not have a jump instruction
+			// to an immediate absolute address,
+			// so I use an unused register to hold
+			// the absolute address to jump to.
 			
-			cmp(r1, r2);
+			// Look for an unused register.
+			uint unusedreg = findunusedreg(0);
 			
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
-				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
-				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-				
-				j();
-				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 84 cd	JE rel32	#Jump near if equal (ZF=1).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x84;
-				
-				// Append the immediate value.
-				append32bitsimm(0);
-				
-			} else {
-				// Specification from the Intel manual.
-				// 74 cb	JE rel8	#Jump short if equal (ZF=1).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
-				
-				// Append the immediate value.
-				append8bitsimm(0);
-			}
-		}
-		
-		void jeqr (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void ji () {
-			// The x64 instruction set
-			// do not have a jump instruction
-			// to an immediate absolute address,
-			// so I use an unused register to hold
-			// the absolute address to jump to.
-			
-			// Look for an unused register.
-			uint unusedreg = findunusedreg(0);
-			
-			// There is always enough
-			// unused registers before
-			// a non-conditional branching,
-			// because all registers
-			// are flushed and discarded.
-			// This function is also
-			// used when generating
-			// conditional branching;
-			// for conditional branching,
-			// the compiler insured that
-			// there are enough unused
+			// Since all registers are
+			// flushed before a branching,
+			// there should be unused
 			// registers available.
 			if (!unusedreg) throwerror();
 			
@@ -5811,1098 +5777,754 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			ldi(unusedreg, 0);
 			
-			jr(unusedreg);
+			jpushr(unusedreg);
 			
 			// Unmark register as temporarily used.
 			regsinusetmp[unusedreg] = 0;
 		}
 		
-		void jeqi (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void jpop () {
 			// Specification from the Intel manual.
-			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
+			// C3	RET	#return to calling procedure.
 			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			// Append the opcode byte.
+			*binaryappend1() = 0xc3;
 		}
 		
-		void jne (uint r1, uint r2) {
+		void ld8r (uint r1, uint r2) {
+			// Specification from the Intel manual.
+			// 0F B6 /r	MOVZX r32, r/m8	#Move r/m8 to r32, zero-extension.
 			
-			cmp(r1, r2);
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
 			
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 74 cb	JE rel8	#Jump short if equal (ZF=1).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
-				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
-				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-				
-				j();
-				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 85 cd	JNE rel32	#Jump near if not equal (ZF=0).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x85;
+			u8 lookupregrmgt7 = (lookupregrm > 7);
+			u8 lookupregreggt7 = (lookupregreg > 7);
+			
+			if (lookupregreggt7 || lookupregrmgt7) {
+				// REX-Prefix == 01000R0B
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
-				// Append the immediate value.
-				append32bitsimm(0);
+				lookupregrm %= 8;
+				lookupregreg %= 8;
+			}
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb6;
+			
+			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
-				// Specification from the Intel manual.
-				// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
+				// When I get here, I use a SIB byte.
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
-				// Append the immediate value.
-				append8bitsimm(0);
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void jner (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jnei (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlt (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void ld8 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7d;
 				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
+				if (r1 == r2) {
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(0);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+					
+					ldi(unusedreg, 0);
+					add(unusedreg, r2);
+					ld8r(r1, unusedreg);
+					
+					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					
+				} else {
+					
+					ldi(r1, 0);
+					add(r1, r2);
+					ld8r(r1, r1);
+				}
 				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			} else {
+				// Specification from the Intel manual.
+				// 0F B6 /r	MOVZX r32, r/m8	#Move r/m8 to r32, zero-extension.
 				
-				j();
+				u8 lookupregrm = lookupreg(r2);
+				u8 lookupregreg = lookupreg(r1);
 				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+				u8 lookupregrmgt7 = (lookupregrm > 7);
+				u8 lookupregreggt7 = (lookupregreg > 7);
 				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 8C cd	JL rel32	#Jump near if less (SF≠OF).
+				if (lookupregreggt7 || lookupregrmgt7) {
+					// REX-Prefix == 01000R0B
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					
+					lookupregrm %= 8;
+					lookupregreg %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x8c;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb6;
 				
-				// Append the immediate value.
-				append32bitsimm(0);
-				
-			} else {
-				// Specification from the Intel manual.
-				// 7C cb	JL rel8	#Jump short if less (SF≠OF).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7c;
-				
-				// Append the immediate value.
-				append8bitsimm(0);
+				if (b->isimmused == IMM32) {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append32bitsimm(0);
+					
+				} else {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append8bitsimm(0);
+				}
 			}
 		}
 		
-		void jltr (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7d;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlti (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7d;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlte (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void ld8i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7f;
-				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
+				ldi(r, 0);
+				ld8r(r, r);
 				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			} else {
+				// Specification from the Intel manual.
+				// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
 				
-				j();
+				u8 lookupregr = lookupreg(r);
 				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 8E cd	JLE rel32	#Jump near if less or equal (ZF=1 or SF≠OF).
+				if (lookupregrgt7) {
+					// REX-Prefix == 01000R00
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
+					
+					lookupregr %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x8e;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb6;
 				
-				// Append the immediate value.
-				append32bitsimm(0);
+				// Note that in x64, a ModR/M byte with
+				// MOD == 0b00 and R/M == 0b101 correspond
+				// to RIP-relative addressing; hence
+				// the reason an alternate encoding
+				// that use an extra SIB byte is used.
 				
-			} else {
-				// Specification from the Intel manual.
-				// 7E cb	JLE rel8	#Jump short if less or equal (ZF=1 or SF≠OF).
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7e;
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
-				append8bitsimm(0);
+				append32bitsimm(0);
 			}
 		}
 		
-		void jlter (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
+		void ld16r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7f;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
+			// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jltei (uint r1, uint r2) {
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
 			
-			cmp(r1, r2);
+			u8 lookupregrmgt7 = (lookupregrm > 7);
+			u8 lookupregreggt7 = (lookupregreg > 7);
 			
-			// Specification from the Intel manual.
-			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
+			if (lookupregreggt7 || lookupregrmgt7) {
+				// REX-Prefix == 01000R0B
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				
+				lookupregrm %= 8;
+				lookupregreg %= 8;
+			}
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7f;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb7;
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
+				
+			} else {
+				// When I get here, I use a SIB byte.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
 		}
 		
-		void jltu (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void ld16 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				
+				if (r1 == r2) {
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(0);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+					
+					ldi(unusedreg, 0);
+					add(unusedreg, r2);
+					ld16r(r1, unusedreg);
+					
+					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					
+				} else {
+					
+					ldi(r1, 0);
+					add(r1, r2);
+					ld16r(r1, r1);
+				}
+				
+			} else {
 				// Specification from the Intel manual.
-				// 73 cb	JNB rel8	#Jump short if not below (CF=0).
+				// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x73;
+				u8 lookupregrm = lookupreg(r2);
+				u8 lookupregreg = lookupreg(r1);
 				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
-				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-				
-				j();
-				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 82 cd	JB rel32	#Jump near if below (CF=1).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x82;
-				
-				// Append the immediate value.
-				append32bitsimm(0);
+				u8 lookupregrmgt7 = (lookupregrm > 7);
+				u8 lookupregreggt7 = (lookupregreg > 7);
 				
-			} else {
-				// Specification from the Intel manual.
-				// 72 cb	JB rel8	#Jump short if below (CF=1).
+				if (lookupregreggt7 || lookupregrmgt7) {
+					// REX-Prefix == 01000R0B
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					
+					lookupregrm %= 8;
+					lookupregreg %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x72;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb7;
 				
-				// Append the immediate value.
-				append8bitsimm(0);
+				if (b->isimmused == IMM32) {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append32bitsimm(0);
+					
+				} else {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append8bitsimm(0);
+				}
 			}
 		}
 		
-		void jltur (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x73;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jltui (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x73;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlteu (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void ld16i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x77;
 				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
+				ldi(r, 0);
+				ld16r(r, r);
 				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			} else {
+				// Specification from the Intel manual.
+				// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 				
-				j();
+				u8 lookupregr = lookupreg(r);
 				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 86 cd	JBE rel32	#Jump near if below or equal (CF=1 or ZF=1).
+				if (lookupregrgt7) {
+					// REX-Prefix == 01000R00
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
+					
+					lookupregr %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x86;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb7;
 				
-				// Append the immediate value.
-				append32bitsimm(0);
+				// Note that in x64, a ModR/M byte with
+				// MOD == 0b00 and R/M == 0b101 correspond
+				// to RIP-relative addressing; hence
+				// the reason an alternate encoding
+				// that use an extra SIB byte is used.
 				
-			} else {
-				// Specification from the Intel manual.
-				// 76 cb	JBE rel8	#Jump short if below or equal (CF=1 or ZF=1).
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x76;
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
-				append8bitsimm(0);
+				append32bitsimm(0);
 			}
 		}
 		
-		void jlteur (uint r1, uint r2, uint r3) {
-			
-			cmp(r1, r2);
-			
-			// Specification from the Intel manual.
-			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x77;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r3);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlteui (uint r1, uint r2) {
-			
-			cmp(r1, r2);
-			
+		void ld32r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
+			// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
 			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x77;
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
 			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			u8 lookupregrmgt7 = (lookupregrm > 7);
+			u8 lookupregreggt7 = (lookupregreg > 7);
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			if (lookupregreggt7 || lookupregrmgt7) {
+				// REX-Prefix == 01000R0B
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				
+				lookupregrm %= 8;
+				lookupregreg %= 8;
+			}
 			
-			ji();
+			// Append the opcode byte.
+			*binaryappend1() = 0x8b;
 			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
+				
+			} else {
+				// When I get here, I use a SIB byte.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
 		}
 		
-		void jz (uint r) {
-			
-			cmptozero(r);
-			
+		void ld32 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
 				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
-				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-				
-				j();
-				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+				if (r1 == r2) {
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(0);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+					
+					ldi(unusedreg, 0);
+					add(unusedreg, r2);
+					ld32r(r1, unusedreg);
+					
+					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					
+				} else {
+					
+					ldi(r1, 0);
+					add(r1, r2);
+					ld32r(r1, r1);
+				}
 				
-			} else if (b->isimmused == IMM32) {
+			} else {
 				// Specification from the Intel manual.
-				// 0F 84 cd	JZ rel32	#Jump near if zero (ZF=1).
+				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x84;
+				u8 lookupregrm = lookupreg(r2);
+				u8 lookupregreg = lookupreg(r1);
 				
-				// Append the immediate value.
-				append32bitsimm(0);
+				u8 lookupregrmgt7 = (lookupregrm > 7);
+				u8 lookupregreggt7 = (lookupregreg > 7);
 				
-			} else {
-				// Specification from the Intel manual.
-				// 74 cb	JZ rel8	#Jump short if zero (ZF=1).
+				if (lookupregreggt7 || lookupregrmgt7) {
+					// REX-Prefix == 01000R0B
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					
+					lookupregrm %= 8;
+					lookupregreg %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
+				*binaryappend1() = 0x8b;
 				
-				// Append the immediate value.
-				append8bitsimm(0);
+				if (b->isimmused == IMM32) {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append32bitsimm(0);
+					
+				} else {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append8bitsimm(0);
+				}
 			}
 		}
 		
-		void jzr (uint r1, uint r2) {
-			
-			cmptozero(r1);
-			
-			// Specification from the Intel manual.
-			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r2);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jzi (uint r) {
-			
-			cmptozero(r);
-			
-			// Specification from the Intel manual.
-			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jnz (uint r) {
-			
-			cmptozero(r);
-			
+		void ld32i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Specification from the Intel manual.
-				// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
-				
-				// Append the 8bits immediate
-				// field which is the bytesize
-				// of the following branching
-				// instruction.
-				u8* imm = arrayu8append1(&b->binary);
+				ldi(r, 0);
+				ld32r(r, r);
 				
-				u8* bbinaryptr = b->binary.ptr;
-				u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			} else {
+				// Specification from the Intel manual.
+				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
 				
-				j();
+				u8 lookupregr = lookupreg(r);
 				
-				bbinaryptr = b->binary.ptr;
-				// Set the 8bits immediate field appended above.
-				*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
-			} else if (b->isimmused == IMM32) {
-				// Specification from the Intel manual.
-				// 0F 85 cd	JNZ rel32	#Jump near if not zero (ZF=0).
+				if (lookupregrgt7) {
+					// REX-Prefix == 01000R00
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
+					
+					lookupregr %= 8;
+				}
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x85;
+				*binaryappend1() = 0x8b;
 				
-				// Append the immediate value.
-				append32bitsimm(0);
+				// Note that in x64, a ModR/M byte with
+				// MOD == 0b00 and R/M == 0b101 correspond
+				// to RIP-relative addressing; hence
+				// the reason an alternate encoding
+				// that use an extra SIB byte is used.
 				
-			} else {
-				// Specification from the Intel manual.
-				// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
-				append8bitsimm(0);
+				append32bitsimm(0);
 			}
 		}
 		
-		void jnzr (uint r1, uint r2) {
-			
-			cmptozero(r1);
-			
+		void ld64r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
+			// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
 			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
 			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			// REX-Prefix == 0100WR0B
+			*binaryappend1() = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			lookupregrm %= 8;
+			lookupregreg %= 8;
 			
-			jr(r2);
+			// Append the opcode byte.
+			*binaryappend1() = 0x8b;
 			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
+				
+			} else {
+				// When I get here, I use a SIB byte.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
 		}
 		
-		void jnzi (uint r) {
-			
-			cmptozero(r);
-			
-			// Specification from the Intel manual.
-			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
-			
-			// Append the 8bits immediate
-			// field which is the bytesize
-			// of the following branching
-			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			ji();
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		// Generate the instruction that compute
-		// in r, an RIP-relative address, and return
-		// the address of the 32bits immediate field
-		// which is set to the displacement from RIP.
-		/* // ### Commented-out as RIP-relative addressing is failing.
-		u32* gip32 (uint r) {
-			// Specification from the Intel manual.
-			// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
-			// The ModR/M byte get set such that
-			// a 32bits displacement is expected.
-			
-			u8 lookupregr = lookupreg(r);
-			
-			// REX-Prefix == 0100WR00
-			u8 rex = (0x48|((lookupregr>7)<<2));
-			
-			lookupregr %= 8;
-			
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b00;
-			// REG == reg[2:0]; #Only the 3 least significant bits matters.
-			// R/M == 0b101
-			u8 modrm = ((lookupregr<<3)|0b101);
-			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = rex;
-			*arrayu8append1(&b->binary) = 0x8b;
-			
-			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = modrm;
-			
-			// Append a 32bits offset immediate field,
-			// set it null and return its address.
-			u32* imm = (u32*)arrayu8append2(&b->binary, sizeof(u32));
-			*imm = 0;
-			return imm;
-		}*/
-		
-		// Generate the instruction that compute
-		// in r, an RIP-relative address, and return
-		// the address of the 8bits immediate field
-		// which is set to the displacement from RIP.
-		u8* gip8 (uint r) {
-			// Specification from the Intel manual.
-			// E8 cd	CALL rel32	#Call relative.
-			// ### Using the rel16 variant
-			// ### (by prefixing 0x66) which
-			// ### is shorter, would segfault.
-			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
-			
-			// Append a 32bits offset immediate value of zero.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			// Pop in r the return address
-			// which is the address of
-			// the POP instruction itself.
-			pop(r);
-			
-			// Specification from the Intel manual.
-			// REX.W 83 /0 ib     ADD r/m64, imm8         #Add sign-extended imm8 to r/m64.
-			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x48;
-			*arrayu8append1(&b->binary) = 0x83;
-			
-			// Append the ModR/M byte.
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			*arrayu8append1(&b->binary) = ((0b11<<6)|lookupreg(r));
-			
-			// Append the 8bits immediate field to be later set.
-			u8* imm = arrayu8append1(&b->binary);
-			
-			bbinaryptr = b->binary.ptr;
-			// Set the immediate value
-			// to account for instructions from
-			// after the CALL instruction.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-			
-			return imm;
-		}
-		
-		void jl (uint r) {
-			
-			u8* imm = gip8(r);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			j();
-			
-			bbinaryptr = b->binary.ptr;
-			// Increment the 8bits immediate field from gip8().
-			*imm += (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jlr (uint r1, uint r2) {
-			
-			u8* imm = gip8(r1);
-			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
-			
-			jr(r2);
-			
-			bbinaryptr = b->binary.ptr;
-			// Increment the 8bits immediate field from gip8().
-			*imm += (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
-		}
-		
-		void jli (uint r) {
-			// The x64 instruction set
-			// do not have a jump instruction
-			// to an immediate absolute address,
-			// so I use an unused register to hold
-			// the absolute address to jump to.
-			
-			// Look for an unused register.
-			uint unusedreg = findunusedreg(0);
-			
-			// Since all registers are
-			// flushed before a branching,
-			// there should be unused
-			// registers available.
-			if (!unusedreg) throwerror();
-			
-			// Mark unused register as temporarily used.
-			regsinusetmp[unusedreg] = 1;
-			
-			ldi(unusedreg, 0);
-			
-			jlr(r, unusedreg);
-			
-			// Unmark register as temporarily used.
-			regsinusetmp[unusedreg] = 0;
-		}
-		
-		void jpushr (uint r) {
-			// Specification from the Intel manual.
-			// FF /2	CALL r/m64	#Call absolute.
-			
-			u8 lookupregr = lookupreg(r);
-			
-			if (lookupregr > 7) {
-				// REX-Prefix == 0100000B
-				*arrayu8append1(&b->binary) = 0x41;
-				
-				lookupregr %= 8;
-			}
-			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xff;
-			
-			// Append the ModR/M byte.
-			// From the most significant bit to the least significant bit.
-			// MOD == 0b11;
-			// REG == op[2:0]; #Only the 3 least significant bits matters.
-			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			*arrayu8append1(&b->binary) = ((0b11<<6)|(2<<3)|lookupregr);
-		}
-		
-		void jpush () {
+		void ld64 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// There is always enough
-				// unused registers before
-				// a non-conditional branching,
-				// because all registers
-				// are flushed and discarded.
-				if (!unusedreg) throwerror();
-				
-				// Mark unused register as temporarily used.
-				regsinusetmp[unusedreg] = 1;
-				
-				afip(unusedreg);
-				jpushr(unusedreg);
 				
-				// Unmark register as temporarily used.
-				regsinusetmp[unusedreg] = 0;
+				if (r1 == r2) {
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(0);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+					
+					ldi(unusedreg, 0);
+					add(unusedreg, r2);
+					ld64r(r1, unusedreg);
+					
+					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					
+				} else {
+					
+					ldi(r1, 0);
+					add(r1, r2);
+					ld64r(r1, r1);
+				}
 				
 			} else {
 				// Specification from the Intel manual.
-				// E8 cd	CALL rel32	#Call relative.
+				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
 				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0xe8;
+				u8 lookupregrm = lookupreg(r2);
+				u8 lookupregreg = lookupreg(r1);
 				
-				// Append the immediate value.
-				append32bitsimm(0);
-			}
-		}
-		
-		void jpushi () {
-			// The x64 instruction set
-			// do not have a jump instruction
-			// to an immediate absolute address,
-			// so I use an unused register to hold
-			// the absolute address to jump to.
-			
-			// Look for an unused register.
-			uint unusedreg = findunusedreg(0);
-			
-			// Since all registers are
-			// flushed before a branching,
-			// there should be unused
-			// registers available.
-			if (!unusedreg) throwerror();
-			
-			// Mark unused register as temporarily used.
-			regsinusetmp[unusedreg] = 1;
-			
-			ldi(unusedreg, 0);
-			
-			jpushr(unusedreg);
-			
-			// Unmark register as temporarily used.
-			regsinusetmp[unusedreg] = 0;
-		}
-		
-		void jpop () {
-			// Specification from the Intel manual.
-			// C3	RET	#return to calling procedure.
-			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc3;
-		}
-		
-		void ld8r (uint r1, uint r2) {
-			// Specification from the Intel manual.
-			// 0F B6 /r	MOVZX r32, r/m8	#Move r/m8 to r32, zero-extension.
-			
-			u8 lookupregrm = lookupreg(r2);
-			u8 lookupregreg = lookupreg(r1);
-			
-			u8 lookupregrmgt7 = (lookupregrm > 7);
-			u8 lookupregreggt7 = (lookupregreg > 7);
-			
-			if (lookupregreggt7 || lookupregrmgt7) {
-				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				// REX-Prefix == 0100WR0B
+				*binaryappend1() = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
-			}
-			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb6;
-			
-			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
 				
-			} else {
-				// When I get here, I use a SIB byte.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b01;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-				
-				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
-			}
-		}
-		
-		void ld8 (uint r1, uint r2) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				
-				if (r1 == r2) {
-					// Look for an unused register.
-					uint unusedreg = findunusedreg(0);
-					
-					// The compiler should have insured
-					// that there are enough unused
-					// registers available.
-					if (!unusedreg) throwerror();
-					
-					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-					
-					ldi(unusedreg, 0);
-					add(unusedreg, r2);
-					ld8r(r1, unusedreg);
-					
-					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					
-				} else {
-					
-					ldi(r1, 0);
-					add(r1, r2);
-					ld8r(r1, r1);
-				}
-				
-			} else {
-				// Specification from the Intel manual.
-				// 0F B6 /r	MOVZX r32, r/m8	#Move r/m8 to r32, zero-extension.
-				
-				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(r1);
-				
-				u8 lookupregrmgt7 = (lookupregrm > 7);
-				u8 lookupregreggt7 = (lookupregreg > 7);
-				
-				if (lookupregreggt7 || lookupregrmgt7) {
-					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
-					
-					lookupregrm %= 8;
-					lookupregreg %= 8;
-				}
-				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb6;
+				// Append the opcode byte.
+				*binaryappend1() = 0x8b;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -6912,7 +6534,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -6922,13 +6544,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -6942,7 +6564,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -6952,13 +6574,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -6967,32 +6589,27 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void ld8i (uint r) {
+		void ld64i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
 				
 				ldi(r, 0);
-				ld8r(r, r);
+				ld64r(r, r);
 				
 			} else {
 				// Specification from the Intel manual.
-				// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
+				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
 				
 				u8 lookupregr = lookupreg(r);
 				
-				u8 lookupregrgt7 = (lookupregr > 7);
+				// REX-Prefix == 0100WR00
+				*binaryappend1() = (0x48|((lookupregr>7)<<2));
 				
-				if (lookupregrgt7) {
-					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
-					
-					lookupregr %= 8;
-				}
+				lookupregr %= 8;
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb6;
+				// Append the opcode byte.
+				*binaryappend1() = 0x8b;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -7005,40 +6622,77 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void ld16r (uint r1, uint r2) {
+		void st8r (uint r1, uint r2) {
+			// r1 must be a register that
+			// can be encoded in the field reg
+			// of an instruction ModR/M when
+			// it is used as an 8bits operand;
+			// either RAX, RBX, RCX, RDX;
+			
+			// Variable to be set to the register
+			// which will be encoded in the field
+			// reg of the instruction ModR/M.
+			uint rvalid;
+			
+			// Variable set to 1 if
+			// the register rvalid
+			// was saved.
+			uint rvalidwassaved = 0;
+			
+			// I find a valid unused register
+			// to use if r1 is not either
+			// of RAX, RBX, RCX, RDX.
+			if (r1 < RAX || r1 > RDX) {
+				
+				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
+					// I get here if r1 was not
+					// either of RAX, RBX, RCX, RDX
+					// and I could not find a valid
+					// unused register to use.
+					
+					if (r2 != RAX) rvalid = RAX;
+					else rvalid = RBX;
+					
+					savereg(rvalid); rvalidwassaved = 1;
+					
+				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+				
+				cpy(rvalid, r1);
+				
+			} else rvalid = r1;
+			
 			// Specification from the Intel manual.
-			// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
+			// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
 			
 			u8 lookupregrm = lookupreg(r2);
-			u8 lookupregreg = lookupreg(r1);
+			u8 lookupregreg = lookupreg(rvalid);
 			
 			u8 lookupregrmgt7 = (lookupregrm > 7);
 			u8 lookupregreggt7 = (lookupregreg > 7);
 			
 			if (lookupregreggt7 || lookupregrmgt7) {
 				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb7;
+			// Append the opcode byte.
+			*binaryappend1() = 0x88;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -7046,7 +6700,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -7056,69 +6710,104 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
+			}
+			
+			if (rvalid != r1) {
+				
+				if (rvalidwassaved) restorereg(rvalid);
+				// Unmark register as temporarily used.
+				else regsinusetmp[rvalid] = 0;
 			}
 		}
 		
-		void ld16 (uint r1, uint r2) {
+		void st8 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				if (r1 == r2) {
-					// Look for an unused register.
-					uint unusedreg = findunusedreg(0);
-					
-					// The compiler should have insured
-					// that there are enough unused
-					// registers available.
-					if (!unusedreg) throwerror();
-					
-					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-					
-					ldi(unusedreg, 0);
-					add(unusedreg, r2);
-					ld16r(r1, unusedreg);
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				add(unusedreg, r2);
+				st8r(r1, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+				
+			} else {
+				// r1 must be a register that
+				// can be encoded in the field reg
+				// of an instruction ModR/M when
+				// it is used as an 8bits operand;
+				// either RAX, RBX, RCX, RDX;
+				
+				// Variable to be set to the register
+				// which will be encoded in the field
+				// reg of the instruction ModR/M.
+				uint rvalid;
+				
+				// Variable set to 1 if
+				// the register rvalid
+				// was saved.
+				uint rvalidwassaved = 0;
+				
+				// I find a valid unused register
+				// to use if r1 is not either
+				// of RAX, RBX, RCX, RDX.
+				if (r1 < RAX || r1 > RDX) {
 					
-					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
+						// I get here if r1 was not
+						// either of RAX, RBX, RCX, RDX
+						// and I could not find a valid
+						// unused register to use.
+						
+						if (r2 != RAX) rvalid = RAX;
+						else rvalid = RBX;
+						
+						savereg(rvalid); rvalidwassaved = 1;
+						
+					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
 					
-				} else {
+					cpy(rvalid, r1);
 					
-					ldi(r1, 0);
-					add(r1, r2);
-					ld16r(r1, r1);
-				}
+				} else rvalid = r1;
 				
-			} else {
 				// Specification from the Intel manual.
-				// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
+				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
 				
 				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(r1);
+				u8 lookupregreg = lookupreg(rvalid);
 				
 				u8 lookupregrmgt7 = (lookupregrm > 7);
 				u8 lookupregreggt7 = (lookupregreg > 7);
 				
 				if (lookupregreggt7 || lookupregrmgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 					
 					lookupregrm %= 8;
 					lookupregreg %= 8;
 				}
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb7;
+				// Append the opcode byte.
+				*binaryappend1() = 0x88;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -7128,7 +6817,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7138,13 +6827,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7158,7 +6847,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7168,52 +6857,106 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
 					append8bitsimm(0);
 				}
+				
+				if (rvalid != r1) {
+					
+					if (rvalidwassaved) restorereg(rvalid);
+					// Unmark register as temporarily used.
+					else regsinusetmp[rvalid] = 0;
+				}
 			}
 		}
 		
-		void ld16i (uint r) {
+		void st8i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				ldi(r, 0);
-				ld16r(r, r);
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
 				
-			} else {
-				// Specification from the Intel manual.
-				// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
-				u8 lookupregr = lookupreg(r);
+				ldi(unusedreg, 0);
+				st8r(r, unusedreg);
 				
-				u8 lookupregrgt7 = (lookupregr > 7);
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
-				if (lookupregrgt7) {
-					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
-					
-					lookupregr %= 8;
-				}
+			} else {
+				// r must be a register that
+				// can be encoded in the field reg
+				// of an instruction ModR/M when
+				// it is used as an 8bits operand;
+				// either RAX, RBX, RCX, RDX;
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb7;
+				// Variable to be set to the register
+				// which will be encoded in the field
+				// reg of the instruction ModR/M.
+				uint rvalid;
 				
-				// Note that in x64, a ModR/M byte with
-				// MOD == 0b00 and R/M == 0b101 correspond
-				// to RIP-relative addressing; hence
-				// the reason an alternate encoding
+				// Variable set to 1 if
+				// the register rvalid
+				// was saved.
+				uint rvalidwassaved = 0;
+				
+				// I find a valid unused register
+				// to use if r is not either
+				// of RAX, RBX, RCX, RDX.
+				if (r < RAX || r > RDX) {
+					
+					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
+						// I get here if r was not
+						// either of RAX, RBX, RCX, RDX
+						// and I could not find a valid
+						// unused register to use.
+						
+						rvalid = RAX;
+						
+						savereg(rvalid); rvalidwassaved = 1;
+						
+					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
+					
+					cpy(rvalid, r);
+					
+				} else rvalid = r;
+				
+				// Specification from the Intel manual.
+				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				u8 lookupregrgt7 = (lookupregr > 7);
+				
+				if (lookupregrgt7) {
+					// REX-Prefix == 01000R00
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
+					
+					lookupregr %= 8;
+				}
+				
+				// Append the opcode byte.
+				*binaryappend1() = 0x88;
+				
+				// Note that in x64, a ModR/M byte with
+				// MOD == 0b00 and R/M == 0b101 correspond
+				// to RIP-relative addressing; hence
+				// the reason an alternate encoding
 				// that use an extra SIB byte is used.
 				
 				// Append the ModR/M byte.
@@ -7221,22 +6964,29 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
+				
+				if (rvalid != r) {
+					
+					if (rvalidwassaved) restorereg(rvalid);
+					// Unmark register as temporarily used.
+					else regsinusetmp[rvalid] = 0;
+				}
 			}
 		}
 		
-		void ld32r (uint r1, uint r2) {
+		void st16r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
+			// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
@@ -7244,16 +6994,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 lookupregrmgt7 = (lookupregrm > 7);
 			u8 lookupregreggt7 = (lookupregreg > 7);
 			
+			// Append the prefix byte 0x66
+			// to consider operands as 16bits;
+			// it must precede the REX-Prefix.
+			*binaryappend1() = 0x66;
+			
 			if (lookupregreggt7 || lookupregrmgt7) {
 				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x8b;
+			*binaryappend1() = 0x89;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -7261,7 +7016,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -7271,51 +7026,42 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void ld32 (uint r1, uint r2) {
+		void st16 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				if (r1 == r2) {
-					// Look for an unused register.
-					uint unusedreg = findunusedreg(0);
-					
-					// The compiler should have insured
-					// that there are enough unused
-					// registers available.
-					if (!unusedreg) throwerror();
-					
-					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-					
-					ldi(unusedreg, 0);
-					add(unusedreg, r2);
-					ld32r(r1, unusedreg);
-					
-					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					
-				} else {
-					
-					ldi(r1, 0);
-					add(r1, r2);
-					ld32r(r1, r1);
-				}
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				add(unusedreg, r2);
+				st16r(r1, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
+				// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(r1);
@@ -7323,16 +7069,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 lookupregrmgt7 = (lookupregrm > 7);
 				u8 lookupregreggt7 = (lookupregreg > 7);
 				
+				// Append the prefix byte 0x66
+				// to consider operands as 16bits;
+				// it must precede the REX-Prefix.
+				*binaryappend1() = 0x66;
+				
 				if (lookupregreggt7 || lookupregrmgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 					
 					lookupregrm %= 8;
 					lookupregreg %= 8;
 				}
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x8b;
+				// Append the opcode byte.
+				*binaryappend1() = 0x89;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -7342,7 +7093,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7352,13 +7103,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7372,7 +7123,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7382,13 +7133,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7397,31 +7148,47 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void ld32i (uint r) {
+		void st16i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				ldi(r, 0);
-				ld32r(r, r);
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				st16r(r, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32, zero-extension.
+				// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
 				
 				u8 lookupregr = lookupreg(r);
 				
 				u8 lookupregrgt7 = (lookupregr > 7);
 				
+				// Append the prefix byte 0x66
+				// to consider operands as 16bits;
+				// it must precede the REX-Prefix.
+				*binaryappend1() = 0x66;
+				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
 					
 					lookupregr %= 8;
 				}
 				
-				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x8b;
+				// Append the opcode byte.
+				*binaryappend1() = 0x89;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -7434,34 +7201,39 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void ld64r (uint r1, uint r2) {
+		void st32r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
 			
-			// REX-Prefix == 0100WR0B
-			*arrayu8append1(&b->binary) = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
+			u8 lookupregrmgt7 = (lookupregrm > 7);
+			u8 lookupregreggt7 = (lookupregreg > 7);
 			
-			lookupregrm %= 8;
-			lookupregreg %= 8;
+			if (lookupregreggt7 || lookupregrmgt7) {
+				// REX-Prefix == 01000R0B
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				
+				lookupregrm %= 8;
+				lookupregreg %= 8;
+			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x8b;
+			*binaryappend1() = 0x89;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -7469,7 +7241,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -7479,63 +7251,59 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void ld64 (uint r1, uint r2) {
+		void st32 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				if (r1 == r2) {
-					// Look for an unused register.
-					uint unusedreg = findunusedreg(0);
-					
-					// The compiler should have insured
-					// that there are enough unused
-					// registers available.
-					if (!unusedreg) throwerror();
-					
-					regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-					
-					ldi(unusedreg, 0);
-					add(unusedreg, r2);
-					ld64r(r1, unusedreg);
-					
-					regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					
-				} else {
-					
-					ldi(r1, 0);
-					add(r1, r2);
-					ld64r(r1, r1);
-				}
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				add(unusedreg, r2);
+				st32r(r1, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(r1);
 				
-				// REX-Prefix == 0100WR0B
-				*arrayu8append1(&b->binary) = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
+				u8 lookupregrmgt7 = (lookupregrm > 7);
+				u8 lookupregreggt7 = (lookupregreg > 7);
 				
-				lookupregrm %= 8;
-				lookupregreg %= 8;
+				if (lookupregreggt7 || lookupregrmgt7) {
+					// REX-Prefix == 01000R0B
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					
+					lookupregrm %= 8;
+					lookupregreg %= 8;
+				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x8b;
+				*binaryappend1() = 0x89;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -7545,7 +7313,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7555,13 +7323,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7575,7 +7343,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7585,13 +7353,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7600,27 +7368,42 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void ld64i (uint r) {
+		void st32i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
 				
-				ldi(r, 0);
-				ld64r(r, r);
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				st32r(r, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 				
 				u8 lookupregr = lookupreg(r);
 				
-				// REX-Prefix == 0100WR00
-				*arrayu8append1(&b->binary) = (0x48|((lookupregr>7)<<2));
+				u8 lookupregrgt7 = (lookupregr > 7);
 				
-				lookupregr %= 8;
+				if (lookupregrgt7) {
+					// REX-Prefix == 01000R00
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
+					
+					lookupregr %= 8;
+				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x8b;
+				*binaryappend1() = 0x89;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -7633,51 +7416,260 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void st8r (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
+		void st64r (uint r1, uint r2) {
+			// Specification from the Intel manual.
+			// 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
 			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			u8 lookupregrmgt7 = (lookupregrm > 7);
+			u8 lookupregreggt7 = (lookupregreg > 7);
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
+			// REX-Prefix == 0100WR0B
+			*binaryappend1() = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
+			
+			lookupregrm %= 8;
+			lookupregreg %= 8;
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0x89;
+			
+			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
+				
+			} else {
+				// When I get here, I use a SIB byte.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
+		}
+		
+		void st64 (uint r1, uint r2) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
+				
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				add(unusedreg, r2);
+				st64r(r1, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+				
+			} else {
+				// Specification from the Intel manual.
+				// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+				
+				u8 lookupregrm = lookupreg(r2);
+				u8 lookupregreg = lookupreg(r1);
+				
+				u8 lookupregrmgt7 = (lookupregrm > 7);
+				u8 lookupregreggt7 = (lookupregreg > 7);
+				
+				// REX-Prefix == 0100WR0B
+				*binaryappend1() = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
+				
+				lookupregrm %= 8;
+				lookupregreg %= 8;
+				
+				// Append the opcode byte.
+				*binaryappend1() = 0x89;
+				
+				if (b->isimmused == IMM32) {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b10;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append32bitsimm(0);
+					
+				} else {
+					
+					if (lookupregrm != LOOKUPREGRSP) {
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						
+					} else {
+						// When I get here, I use a SIB byte.
+						
+						// Append the ModR/M byte.
+						// From the most significant bit to the least significant bit.
+						// MOD == 0b01;
+						// REG == reg[2:0]; #Only the 3 least significant bits matters.
+						// R/M == 0b100;
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						
+						// Append the SIB byte.
+						// scale: 0b00;
+						// index: 0b100; #A register for index is not used and scale is ignored.
+						// base: rm[2:0]; #Only the 3 least significant bits matters.
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
+					}
+					
+					// Append the immediate value.
+					append8bitsimm(0);
+				}
+			}
+		}
+		
+		void st64i (uint r) {
+			// If b->isimmused is set, then
+			// I am redoing the lyricalinstruction.
+			if (b->isimmused == IMM64) {
+				// Look for an unused register.
+				uint unusedreg = findunusedreg(0);
+				
+				// The compiler should have insured
+				// that there are enough unused
+				// registers available.
+				if (!unusedreg) throwerror();
+				
+				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+				
+				ldi(unusedreg, 0);
+				st64r(r, unusedreg);
+				
+				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+				
+			} else {
+				// Specification from the Intel manual.
+				// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+				
+				u8 lookupregr = lookupreg(r);
+				
+				u8 lookupregrgt7 = (lookupregr > 7);
+				
+				// REX-Prefix == 0100WR00
+				*binaryappend1() = (0x48|(lookupregrgt7<<2));
+				
+				lookupregr %= 8;
+				
+				// Append the opcode byte.
+				*binaryappend1() = 0x89;
+				
+				// Note that in x64, a ModR/M byte with
+				// MOD == 0b00 and R/M == 0b101 correspond
+				// to RIP-relative addressing; hence
+				// the reason an alternate encoding
+				// that use an extra SIB byte is used.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
+				*binaryappend1() = ((0b100<<3)|0b101);
+				
+				// Append the immediate value.
+				append32bitsimm(0);
+			}
+		}
+		
+		void ldst8r (uint r1, uint r2) {
+			// r1 must be a register that
+			// can be encoded in the field reg
+			// of an instruction ModR/M when
+			// it is used as an 8bits operand;
+			// either RAX, RBX, RCX, RDX;
+			
+			// Variable to be set to the register
+			// which will be encoded in the field
+			// reg of the instruction ModR/M.
+			uint rvalid;
+			
+			// Variable set to 1 if
+			// the register rvalid
+			// was saved.
+			uint rvalidwassaved = 0;
+			
+			// I find a valid unused register
+			// to use if r1 is not either
+			// of RAX, RBX, RCX, RDX.
+			if (r1 < RAX || r1 > RDX) {
+				
+				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
+					// I get here if r1 was not
+					// either of RAX, RBX, RCX, RDX
+					// and I could not find a valid
+					// unused register to use.
+					
+					if (r2 != RAX) rvalid = RAX;
+					else rvalid = RBX;
+					
+					savereg(rvalid); rvalidwassaved = 1;
 					
 				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
 				
@@ -7686,7 +7678,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			} else rvalid = r1;
 			
 			// Specification from the Intel manual.
-			// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+			// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(rvalid);
@@ -7696,14 +7688,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			if (lookupregreggt7 || lookupregrmgt7) {
 				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x88;
+			*binaryappend1() = 0x86;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -7711,7 +7703,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -7721,27 +7713,29 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 			
 			if (rvalid != r1) {
 				
+				cpy(r1, rvalid);
+				
 				if (rvalidwassaved) restorereg(rvalid);
 				// Unmark register as temporarily used.
 				else regsinusetmp[rvalid] = 0;
 			}
 		}
 		
-		void st8 (uint r1, uint r2) {
+		void ldst8 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -7757,7 +7751,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				ldi(unusedreg, 0);
 				add(unusedreg, r2);
-				st8r(r1, unusedreg);
+				ldst8r(r1, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
@@ -7801,7 +7795,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				} else rvalid = r1;
 				
 				// Specification from the Intel manual.
-				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+				// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(rvalid);
@@ -7811,14 +7805,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregreggt7 || lookupregrmgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 					
 					lookupregrm %= 8;
 					lookupregreg %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x88;
+				*binaryappend1() = 0x86;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -7828,7 +7822,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7838,13 +7832,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7858,7 +7852,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -7868,13 +7862,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -7883,6 +7877,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (rvalid != r1) {
 					
+					cpy(r1, rvalid);
+					
 					if (rvalidwassaved) restorereg(rvalid);
 					// Unmark register as temporarily used.
 					else regsinusetmp[rvalid] = 0;
@@ -7890,7 +7886,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void st8i (uint r) {
+		void ldst8i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -7905,7 +7901,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
 				ldi(unusedreg, 0);
-				st8r(r, unusedreg);
+				ldst8r(r, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
@@ -7948,7 +7944,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				} else rvalid = r;
 				
 				// Specification from the Intel manual.
-				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+				// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 				
 				u8 lookupregr = lookupreg(r);
 				
@@ -7956,13 +7952,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
 					
 					lookupregr %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x88;
+				*binaryappend1() = 0x86;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -7975,19 +7971,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 				
 				if (rvalid != r) {
 					
+					cpy(r, rvalid);
+					
 					if (rvalidwassaved) restorereg(rvalid);
 					// Unmark register as temporarily used.
 					else regsinusetmp[rvalid] = 0;
@@ -7995,9 +7993,9 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void st16r (uint r1, uint r2) {
+		void ldst16r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
+			// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
@@ -8005,20 +8003,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 lookupregrmgt7 = (lookupregrm > 7);
 			u8 lookupregreggt7 = (lookupregreg > 7);
 			
+			// Append the prefix byte 0x66
+			// to consider operands as 16bits;
+			// it must precede the REX-Prefix.
+			*binaryappend1() = 0x66;
+			
 			if (lookupregreggt7 || lookupregrmgt7) {
 				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
-			// Append the prefix byte 0x66
-			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
-			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x87;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -8026,7 +8025,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -8036,20 +8035,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void st16 (uint r1, uint r2) {
+		void ldst16 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8065,13 +8064,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				ldi(unusedreg, 0);
 				add(unusedreg, r2);
-				st16r(r1, unusedreg);
+				ldst16r(r1, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
+				// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(r1);
@@ -8079,20 +8078,21 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 lookupregrmgt7 = (lookupregrm > 7);
 				u8 lookupregreggt7 = (lookupregreg > 7);
 				
+				// Append the prefix byte 0x66
+				// to consider operands as 16bits;
+				// it must precede the REX-Prefix.
+				*binaryappend1() = 0x66;
+				
 				if (lookupregreggt7 || lookupregrmgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 					
 					lookupregrm %= 8;
 					lookupregreg %= 8;
 				}
 				
-				// Append the prefix byte 0x66
-				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
-				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -8102,7 +8102,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8112,13 +8112,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8132,7 +8132,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8142,13 +8142,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8157,7 +8157,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void st16i (uint r) {
+		void ldst16i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8172,31 +8172,32 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
 				ldi(unusedreg, 0);
-				st16r(r, unusedreg);
+				ldst16r(r, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 89 /r	MOV r/m16,r16		#Move r16 to r/m16.
+				// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
 				
 				u8 lookupregr = lookupreg(r);
 				
 				u8 lookupregrgt7 = (lookupregr > 7);
 				
+				// Append the prefix byte 0x66
+				// to consider operands as 16bits;
+				// it must precede the REX-Prefix.
+				*binaryappend1() = 0x66;
+				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
 					
 					lookupregr %= 8;
 				}
 				
-				// Append the prefix byte 0x66
-				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
-				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -8209,22 +8210,22 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void st32r (uint r1, uint r2) {
+		void ldst32r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
+			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
@@ -8234,14 +8235,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			
 			if (lookupregreggt7 || lookupregrmgt7) {
 				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x87;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -8249,7 +8250,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -8259,20 +8260,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void st32 (uint r1, uint r2) {
+		void ldst32 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8288,13 +8289,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				ldi(unusedreg, 0);
 				add(unusedreg, r2);
-				st32r(r1, unusedreg);
+				ldst32r(r1, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
+				// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(r1);
@@ -8304,14 +8305,14 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregreggt7 || lookupregrmgt7) {
 					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+					*binaryappend1() = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
 					
 					lookupregrm %= 8;
 					lookupregreg %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -8321,7 +8322,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8331,13 +8332,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8351,7 +8352,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8361,13 +8362,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8376,7 +8377,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void st32i (uint r) {
+		void ldst32i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8391,13 +8392,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
 				ldi(unusedreg, 0);
-				st32r(r, unusedreg);
+				ldst32r(r, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
+				// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 				
 				u8 lookupregr = lookupreg(r);
 				
@@ -8405,13 +8406,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				if (lookupregrgt7) {
 					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
+					*binaryappend1() = (0x40|(lookupregrgt7<<2));
 					
 					lookupregr %= 8;
 				}
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -8424,22 +8425,22 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void st64r (uint r1, uint r2) {
+		void ldst64r (uint r1, uint r2) {
 			// Specification from the Intel manual.
-			// 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+			// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
 			
 			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
@@ -8448,13 +8449,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			u8 lookupregreggt7 = (lookupregreg > 7);
 			
 			// REX-Prefix == 0100WR0B
-			*arrayu8append1(&b->binary) = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
+			*binaryappend1() = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
 			
 			lookupregrm %= 8;
 			lookupregreg %= 8;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x87;
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -8462,7 +8463,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -8472,20 +8473,20 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
-		void st64 (uint r1, uint r2) {
+		void ldst64 (uint r1, uint r2) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8501,13 +8502,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				ldi(unusedreg, 0);
 				add(unusedreg, r2);
-				st64r(r1, unusedreg);
+				ldst64r(r1, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+				// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
 				
 				u8 lookupregrm = lookupreg(r2);
 				u8 lookupregreg = lookupreg(r1);
@@ -8516,13 +8517,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				u8 lookupregreggt7 = (lookupregreg > 7);
 				
 				// REX-Prefix == 0100WR0B
-				*arrayu8append1(&b->binary) = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
+				*binaryappend1() = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				if (b->isimmused == IMM32) {
 					
@@ -8532,7 +8533,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8542,13 +8543,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b10;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b10<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8562,7 +8563,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
 						
 					} else {
 						// When I get here, I use a SIB byte.
@@ -8572,13 +8573,13 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						// MOD == 0b01;
 						// REG == reg[2:0]; #Only the 3 least significant bits matters.
 						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+						*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 						
 						// Append the SIB byte.
 						// scale: 0b00;
 						// index: 0b100; #A register for index is not used and scale is ignored.
 						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+						*binaryappend1() = ((0b100<<3)|lookupregrm);
 					}
 					
 					// Append the immediate value.
@@ -8587,7 +8588,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			}
 		}
 		
-		void st64i (uint r) {
+		void ldst64i (uint r) {
 			// If b->isimmused is set, then
 			// I am redoing the lyricalinstruction.
 			if (b->isimmused == IMM64) {
@@ -8602,25 +8603,25 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 				
 				ldi(unusedreg, 0);
-				st64r(r, unusedreg);
+				ldst64r(r, unusedreg);
 				
 				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 				
 			} else {
 				// Specification from the Intel manual.
-				// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+				// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
 				
 				u8 lookupregr = lookupreg(r);
 				
 				u8 lookupregrgt7 = (lookupregr > 7);
 				
 				// REX-Prefix == 0100WR00
-				*arrayu8append1(&b->binary) = (0x48|(lookupregrgt7<<2));
+				*binaryappend1() = (0x48|(lookupregrgt7<<2));
 				
 				lookupregr %= 8;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x89;
+				*binaryappend1() = 0x87;
 				
 				// Note that in x64, a ModR/M byte with
 				// MOD == 0b00 and R/M == 0b101 correspond
@@ -8633,77 +8634,98 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
+				*binaryappend1() = (((lookupregr)<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
+				*binaryappend1() = ((0b100<<3)|0b101);
 				
 				// Append the immediate value.
 				append32bitsimm(0);
 			}
 		}
 		
-		void ldst8r (uint r1, uint r2) {
-			// r1 must be a register that
-			// can be encoded in the field reg
-			// of an instruction ModR/M when
-			// it is used as an 8bits operand;
-			// either RAX, RBX, RCX, RDX;
-			
-			// Variable to be set to the register
-			// which will be encoded in the field
-			// reg of the instruction ModR/M.
-			uint rvalid;
+		// Function used to get a register
+		// to use temporarily, which is
+		// neither of the registers x, y, z.
+		// An unused register is used if
+		// there is one, otherwise the value
+		// of the register returned is saved.
+		// The register must be released
+		// using releasetmpreg() in the
+		// reverse order it was obtained.
+		uint gettmpreg (uint x, uint y, uint z) {
 			
-			// Variable set to 1 if
-			// the register rvalid
-			// was saved.
-			uint rvalidwassaved = 0;
+			uint r;
 			
-			// I find a valid unused register
-			// to use if r1 is not either
-			// of RAX, RBX, RCX, RDX.
-			if (r1 < RAX || r1 > RDX) {
-				
-				if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-					// I get here if r1 was not
-					// either of RAX, RBX, RCX, RDX
-					// and I could not find a valid
-					// unused register to use.
-					
-					if (r2 != RAX) rvalid = RAX;
-					else rvalid = RBX;
-					
-					savereg(rvalid); rvalidwassaved = 1;
-					
-				} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-				
-				cpy(rvalid, r1);
+			if ((r = findunusedreg(0))) {
+				// Mark unused register as temporarily used.
+				regsinusetmp[r] = 1;
 				
-			} else rvalid = r1;
+				return r;
+			}
+			
+			r = RBX;
+			
+			while (r == x || r == y || r == z) ++r;
+			
+			savereg(r);
 			
+			return r;
+		}
+		
+		void releasetmpreg (uint r) {
+			// Restore register value.
+			if (savedregs[r]) restorereg(r);
+			// Unmark register as temporarily used.
+			else regsinusetmp[r] = 0;
+		}
+		
+		// Function used to generate
+		// a lock prefixed instruction
+		// where r is the register operand
+		// and the memory operand is at
+		// the address in the register m.
+		// The argument size is the byte size
+		// of the operands, and the argument
+		// opcode is the opcode used when
+		// the size of the operands is 16,
+		// 32 or 64 bits; the opcode used
+		// when the size of the operands is
+		// 8 bits is expected to be opcode-1.
+		void lockedop (u8 opcode, uint r, uint m, uint size) {
 			// Specification from the Intel manual.
-			// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
+			// F0		LOCK		#Asserts LOCK# signal for duration of the accompanying instruction.
+			*binaryappend1() = 0xf0;
 			
-			u8 lookupregrm = lookupreg(r2);
-			u8 lookupregreg = lookupreg(rvalid);
+			// Specification from the Intel manual.
+			// 66		#Operand-size override prefix.
+			if (size == 2) *binaryappend1() = 0x66;
+			
+			u8 lookupregrm = lookupreg(m);
+			u8 lookupregreg = lookupreg(r);
 			
 			u8 lookupregrmgt7 = (lookupregrm > 7);
 			u8 lookupregreggt7 = (lookupregreg > 7);
 			
-			if (lookupregreggt7 || lookupregrmgt7) {
-				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+			// A REX prefix, even without any
+			// of its bits set, allow for any
+			// register to be used as an 8bits
+			// operand, since SPL, BPL, SIL and DIL
+			// get encoded instead of AH, CH, DH, BH.
+			if (size == 8 || size == 1 || lookupregreggt7 || lookupregrmgt7) {
+				// REX-Prefix == 0100WR0B
+				*binaryappend1() = (0x40|((size == 8)<<3)|(lookupregreggt7<<2)|lookupregrmgt7);
 				
 				lookupregrm %= 8;
 				lookupregreg %= 8;
 			}
 			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x86;
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = (opcode - (size == 1));
 			
 			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
 				// Append the ModR/M byte.
@@ -8711,7 +8733,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b00;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
+				*binaryappend1() = ((lookupregreg<<3)|lookupregrm);
 				
 			} else {
 				// When I get here, I use a SIB byte.
@@ -8721,1038 +8743,772 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// MOD == 0b01;
 				// REG == reg[2:0]; #Only the 3 least significant bits matters.
 				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
 				
 				// Append the SIB byte.
 				// scale: 0b00;
 				// index: 0b100; #A register for index is not used and scale is ignored.
 				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
+			}
+		}
+		
+		// Specification from the Intel manual.
+		// 0F B0 /r		CMPXCHG r/m8, r8	#Compare AL with r/m8. If equal, ZF is set and r8 is loaded into r/m8. Else, clear ZF and load r/m8 into AL.
+		// 0F B1 /r		CMPXCHG r/m16, r16	#Compare AX with r/m16. If equal, ZF is set and r16 is loaded into r/m16. Else, clear ZF and load r/m16 into AX.
+		// 0F B1 /r		CMPXCHG r/m32, r32	#Compare EAX with r/m32. If equal, ZF is set and r32 is loaded into r/m32. Else, clear ZF and load r/m32 into EAX.
+		// REX.W 0F B1 /r	CMPXCHG r/m64, r64	#Compare RAX with r/m64. If equal, ZF is set and r64 is loaded into r/m64. Else, clear ZF and load r/m64 into RAX.
+		enum {CMPXCHGOPCODE = 0xb1};
+		
+		// Specification from the Intel manual.
+		// 0F C0 /r		XADD r/m8, r8		#Exchange r8 and r/m8; load sum into r/m8.
+		// 0F C1 /r		XADD r/m16, r16		#Exchange r16 and r/m16; load sum into r/m16.
+		// 0F C1 /r		XADD r/m32, r32		#Exchange r32 and r/m32; load sum into r/m32.
+		// REX.W 0F C1 /r	XADD r/m64, r64		#Exchange r64 and r/m64; load sum into r/m64.
+		enum {XADDOPCODE = 0xc1};
+		
+		void cas (uint r1, uint r2, uint r3, uint size) {
+			// The instruction cmpxchg use RAX
+			// for the value to compare with,
+			// and set RAX to the value that
+			// was in memory; so if r1 is not RAX,
+			// their values are exchanged,
+			// and the registers r2 and r3 are
+			// renamed accordingly.
+			if (r1 != RAX) {
+				
+				xchg(r1, RAX);
+				
+				if (r2 == RAX) r2 = r1;
+				else if (r2 == r1) r2 = RAX;
+				
+				if (r3 == RAX) r3 = r1;
+				else if (r3 == r1) r3 = RAX;
 			}
 			
-			if (rvalid != r1) {
+			uint raxwasinusetmp = regsinusetmp[RAX];
+			
+			// Mark RAX as temporarily used
+			// so that it is not returned
+			// by gettmpreg().
+			regsinusetmp[RAX] = 1;
+			
+			// If r2 or r3 were the same
+			// register as r1, their value
+			// is now in RAX, which will
+			// get modified by cmpxchg;
+			// so a temporary register is used.
+			uint t = 0;
+			
+			if (r2 == RAX || r3 == RAX) {
 				
-				cpy(r1, rvalid);
+				t = gettmpreg(RAX, r2, r3);
 				
-				if (rvalidwassaved) restorereg(rvalid);
-				// Unmark register as temporarily used.
-				else regsinusetmp[rvalid] = 0;
+				cpy(t, RAX);
+				
+				if (r2 == RAX) r2 = t;
+				if (r3 == RAX) r3 = t;
 			}
+			
+			lockedop(CMPXCHGOPCODE, r3, r2, size);
+			
+			if (t) releasetmpreg(t);
+			
+			regsinusetmp[RAX] = raxwasinusetmp;
+			
+			if (r1 != RAX) xchg(r1, RAX);
+			
+			// When the comparison succeed,
+			// RAX is not modified; and when
+			// it fails, only the bits of
+			// the size of the operands are
+			// loaded; so zero extension is done.
+			if (size < 8) zxt(r1, size*8);
 		}
 		
-		void ldst8 (uint r1, uint r2) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+		void fetchadd (uint r1, uint r2, uint size, uint issub) {
+			
+			uint t = 0;
+			
+			// If r1 and r2 are the same
+			// register, the address is copied
+			// in a temporary register since
+			// r1 get modified by xadd.
+			if (r1 == r2) {
 				
-				ldi(unusedreg, 0);
-				add(unusedreg, r2);
-				ldst8r(r1, unusedreg);
+				t = gettmpreg(r1, r1, r1);
 				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+				cpy(t, r1);
 				
-			} else {
-				// r1 must be a register that
-				// can be encoded in the field reg
-				// of an instruction ModR/M when
-				// it is used as an 8bits operand;
-				// either RAX, RBX, RCX, RDX;
+				r2 = t;
+			}
+			
+			// Substraction is done adding
+			// the two's complement of r1.
+			if (issub) neg(r1);
+			
+			lockedop(XADDOPCODE, r1, r2, size);
+			
+			if (t) releasetmpreg(t);
+			
+			// xadd only load the bits
+			// of the size of the operands;
+			// so zero extension is done.
+			if (size < 8) zxt(r1, size*8);
+		}
+		
+		void fetchandor (uint r1, uint r2, uint size, uint isor) {
+			// There is no x64 instruction which
+			// atomically do "and" or "or" while
+			// returning the value that was in memory;
+			// so a loop using cmpxchg is generated.
+			// RAX is used for the value read from
+			// memory; so if r1 is not RAX,
+			// their values are exchanged,
+			// and the register r2 is renamed
+			// accordingly.
+			if (r1 != RAX) {
 				
-				// Variable to be set to the register
-				// which will be encoded in the field
-				// reg of the instruction ModR/M.
-				uint rvalid;
+				xchg(r1, RAX);
 				
-				// Variable set to 1 if
-				// the register rvalid
-				// was saved.
-				uint rvalidwassaved = 0;
+				if (r2 == RAX) r2 = r1;
+				else if (r2 == r1) r2 = RAX;
+			}
+			
+			uint raxwasinusetmp = regsinusetmp[RAX];
+			
+			// Mark RAX as temporarily used
+			// so that it is not returned
+			// by gettmpreg().
+			regsinusetmp[RAX] = 1;
+			
+			// The operand is copied from RAX
+			// to the register v, which is also
+			// used for the address if r1 and r2
+			// were the same register.
+			uint v = gettmpreg(RAX, r2, r2);
+			
+			cpy(v, RAX);
+			
+			if (r2 == RAX) r2 = v;
+			
+			// Register used to compute
+			// the value to store in memory.
+			uint t = gettmpreg(RAX, r2, v);
+			
+			// Load in RAX, the value in memory;
+			// the load zero extend the value.
+			if (size == 1) ld8r(RAX, r2);
+			else if (size == 2) ld16r(RAX, r2);
+			else if (size == 4) ld32r(RAX, r2);
+			else ld64r(RAX, r2);
+			
+			uint loopstart = b->binarysz;
+			
+			cpy(t, RAX);
+			
+			if (isor) or(t, v);
+			else and(t, v);
+			
+			lockedop(CMPXCHGOPCODE, t, r2, size);
+			
+			// Specification from the Intel manual.
+			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
+			*binaryappend1() = 0x75;
+			
+			// Append the 8bits offset which branch
+			// back to the start of the loop if
+			// the value in memory was modified.
+			uint imm = b->binarysz;
+			binaryappend1();
+			binaryptr()[imm] = (loopstart - b->binarysz);
+			
+			releasetmpreg(t);
+			releasetmpreg(v);
+			
+			regsinusetmp[RAX] = raxwasinusetmp;
+			
+			// RAX has the zero extended value
+			// that was in memory, since cmpxchg
+			// only modify the bits of the size
+			// of the operands when it fails.
+			if (r1 != RAX) xchg(r1, RAX);
+		}
+		
+		void fence () {
+			// Specification from the Intel manual.
+			// 0F AE F0	MFENCE		#Serializes load and store operations.
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xae;
+			*binaryappend1() = 0xf0;
+		}
+		
+		// Function used to generate an SSE2
+		// instruction which use the opcode bytes
+		// 0F op, prefixed with the byte prefix.
+		// The arguments reg and rm are the values
+		// of the fields REG and R/M of the ModR/M byte,
+		// either XMM register numbers or values
+		// returned by lookupreg(); when ismem is true,
+		// the R/M operand is the memory location
+		// at the address in the register rm.
+		// When isrexw is true, REX.W is set.
+		void sse2op (u8 prefix, u8 op, u8 reg, u8 rm, uint ismem, uint isrexw) {
+			
+			*binaryappend1() = prefix;
+			
+			u8 reggt7 = (reg > 7);
+			u8 rmgt7 = (rm > 7);
+			
+			// The REX prefix must come
+			// after the mandatory prefix.
+			if (isrexw || reggt7 || rmgt7) {
+				// REX-Prefix == 0100WR0B
+				*binaryappend1() = (0x40|(isrexw<<3)|(reggt7<<2)|rmgt7);
 				
-				// I find a valid unused register
-				// to use if r1 is not either
-				// of RAX, RBX, RCX, RDX.
-				if (r1 < RAX || r1 > RDX) {
-					
-					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-						// I get here if r1 was not
-						// either of RAX, RBX, RCX, RDX
-						// and I could not find a valid
-						// unused register to use.
-						
-						if (r2 != RAX) rvalid = RAX;
-						else rvalid = RBX;
-						
-						savereg(rvalid); rvalidwassaved = 1;
-						
-					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-					
-					cpy(rvalid, r1);
-					
-				} else rvalid = r1;
+				reg %= 8;
+				rm %= 8;
+			}
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = op;
+			
+			if (!ismem) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b11;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b11<<6)|(reg<<3)|rm);
 				
-				// Specification from the Intel manual.
-				// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
+			} else if (rm != LOOKUPREGRSP && rm != LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((reg<<3)|rm);
 				
-				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(rvalid);
+			} else if (rm == LOOKUPREGRBP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b01<<6)|(reg<<3)|rm);
 				
-				u8 lookupregrmgt7 = (lookupregrm > 7);
-				u8 lookupregreggt7 = (lookupregreg > 7);
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
 				
-				if (lookupregreggt7 || lookupregrmgt7) {
-					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
-					
-					lookupregrm %= 8;
-					lookupregreg %= 8;
-				}
+			} else {
+				// When I get here, I use a SIB byte.
 				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x86;
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b00;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((reg<<3)|0b100);
 				
-				if (b->isimmused == IMM32) {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append32bitsimm(0);
-					
-				} else {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append8bitsimm(0);
-				}
-				
-				if (rvalid != r1) {
-					
-					cpy(r1, rvalid);
-					
-					if (rvalidwassaved) restorereg(rvalid);
-					// Unmark register as temporarily used.
-					else regsinusetmp[rvalid] = 0;
-				}
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|rm);
 			}
 		}
 		
-		void ldst8i (uint r) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				ldst8r(r, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+		// Vector lyricalinstruction are done
+		// using XMM0 and XMM1, which are never
+		// used otherwise by the generated code.
+		enum {XMM0, XMM1};
+		
+		// Specification from the Intel manual.
+		// F3 0F 6F /r	MOVDQU xmm1, xmm2/m128	#Move unaligned double quadword from xmm2/m128 to xmm1.
+		void vld (uint x, uint r) {
+			sse2op(0xf3, 0x6f, x, lookupreg(r), 1, 0);
+		}
+		
+		// Specification from the Intel manual.
+		// F3 0F 7F /r	MOVDQU xmm2/m128, xmm1	#Move unaligned double quadword from xmm1 to xmm2/m128.
+		void vst (uint r, uint x) {
+			sse2op(0xf3, 0x7f, x, lookupreg(r), 1, 0);
+		}
+		
+		// Specification from the Intel manual.
+		// 66 0F FC /r	PADDB xmm1, xmm2/m128	#Add packed byte integers from xmm2/m128 and xmm1.
+		// 66 0F FD /r	PADDW xmm1, xmm2/m128	#Add packed word integers from xmm2/m128 and xmm1.
+		// 66 0F FE /r	PADDD xmm1, xmm2/m128	#Add packed doubleword integers from xmm2/m128 and xmm1.
+		// 66 0F D4 /r	PADDQ xmm1, xmm2/m128	#Add packed quadword integers from xmm2/m128 and xmm1.
+		// 66 0F F8 /r	PSUBB xmm1, xmm2/m128	#Subtract packed byte integers in xmm2/m128 from xmm1.
+		// 66 0F F9 /r	PSUBW xmm1, xmm2/m128	#Subtract packed word integers in xmm2/m128 from xmm1.
+		// 66 0F FA /r	PSUBD xmm1, xmm2/m128	#Subtract packed doubleword integers in xmm2/m128 from xmm1.
+		// 66 0F FB /r	PSUBQ xmm1, xmm2/m128	#Subtract packed quadword integers in xmm2/m128 from xmm1.
+		// 66 0F DB /r	PAND xmm1, xmm2/m128	#Bitwise AND of xmm2/m128 and xmm1.
+		// 66 0F EB /r	POR xmm1, xmm2/m128	#Bitwise OR of xmm2/m128 and xmm1.
+		// 66 0F EF /r	PXOR xmm1, xmm2/m128	#Bitwise XOR of xmm2/m128 and xmm1.
+		// 66 0F 74 /r	PCMPEQB xmm1, xmm2/m128	#Compare packed bytes in xmm2/m128 and xmm1 for equality.
+		// 66 0F 75 /r	PCMPEQW xmm1, xmm2/m128	#Compare packed words in xmm2/m128 and xmm1 for equality.
+		// 66 0F 76 /r	PCMPEQD xmm1, xmm2/m128	#Compare packed doublewords in xmm2/m128 and xmm1 for equality.
+		void vop (u8 op, uint r1, uint r2, uint r3) {
+			// The second operand is loaded
+			// in XMM1 instead of being used
+			// as a memory operand, because
+			// memory operands of SSE2 instructions
+			// must be aligned to 16 bytes.
+			vld(XMM0, r2);
+			vld(XMM1, r3);
+			
+			sse2op(0x66, op, XMM0, XMM1, 0, 0);
+			
+			vst(r1, XMM0);
+		}
+		
+		void vmovmsk8 (uint r1, uint r2) {
+			
+			vld(XMM0, r2);
+			
+			// Specification from the Intel manual.
+			// 66 0F D7 /r	PMOVMSKB reg, xmm	#Move a byte mask of xmm to reg; the upper bits of reg are zero filled.
+			sse2op(0x66, 0xd7, lookupreg(r1), XMM0, 0, 0);
+		}
+		
+		// Specification from the Intel manual.
+		// 66 0F 6E /r		MOVD xmm, r/m32		#Move doubleword from r/m32 to xmm.
+		// 66 REX.W 0F 6E /r	MOVQ xmm, r/m64		#Move quadword from r/m64 to xmm.
+		void movtoxmm (uint x, uint r, uint size) {
+			sse2op(0x66, 0x6e, x, lookupreg(r), 0, (size == 8));
+		}
+		
+		// Specification from the Intel manual.
+		// 66 0F 7E /r		MOVD r/m32, xmm		#Move doubleword from xmm to r/m32.
+		// 66 REX.W 0F 7E /r	MOVQ r/m64, xmm		#Move quadword from xmm to r/m64.
+		void movfromxmm (uint r, uint x, uint size) {
+			sse2op(0x66, 0x7e, x, lookupreg(r), 0, (size == 8));
+		}
+		
+		void vbcast (uint r1, uint r2, uint size) {
+			
+			movtoxmm(XMM0, r2, size);
+			
+			if (size == 8) {
+				// Specification from the Intel manual.
+				// 66 0F 6C /r	PUNPCKLQDQ xmm1, xmm2/m128	#Interleave low-order quadwords from xmm1 and xmm2/m128 into xmm1.
+				sse2op(0x66, 0x6c, XMM0, XMM0, 0, 0);
 				
 			} else {
-				// r must be a register that
-				// can be encoded in the field reg
-				// of an instruction ModR/M when
-				// it is used as an 8bits operand;
-				// either RAX, RBX, RCX, RDX;
-				
-				// Variable to be set to the register
-				// which will be encoded in the field
-				// reg of the instruction ModR/M.
-				uint rvalid;
-				
-				// Variable set to 1 if
-				// the register rvalid
-				// was saved.
-				uint rvalidwassaved = 0;
-				
-				// I find a valid unused register
-				// to use if r is not either
-				// of RAX, RBX, RCX, RDX.
-				if (r < RAX || r > RDX) {
-					
-					if (!(rvalid = findunusedregfor8bitsoperand(0))) {
-						// I get here if r was not
-						// either of RAX, RBX, RCX, RDX
-						// and I could not find a valid
-						// unused register to use.
-						
-						rvalid = RAX;
-						
-						savereg(rvalid); rvalidwassaved = 1;
-						
-					} else regsinusetmp[rvalid] = 1; // Mark unused register as temporarily used.
-					
-					cpy(rvalid, r);
-					
-				} else rvalid = r;
-				
 				// Specification from the Intel manual.
-				// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
-				
-				u8 lookupregr = lookupreg(r);
+				// 66 0F 60 /r	PUNPCKLBW xmm1, xmm2/m128	#Interleave low-order bytes from xmm1 and xmm2/m128 into xmm1.
+				// 66 0F 61 /r	PUNPCKLWD xmm1, xmm2/m128	#Interleave low-order words from xmm1 and xmm2/m128 into xmm1.
+				if (size == 1) sse2op(0x66, 0x60, XMM0, XMM0, 0, 0);
+				if (size <= 2) sse2op(0x66, 0x61, XMM0, XMM0, 0, 0);
 				
-				u8 lookupregrgt7 = (lookupregr > 7);
-				
-				if (lookupregrgt7) {
-					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
-					
-					lookupregr %= 8;
-				}
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x86;
-				
-				// Note that in x64, a ModR/M byte with
-				// MOD == 0b00 and R/M == 0b101 correspond
-				// to RIP-relative addressing; hence
-				// the reason an alternate encoding
-				// that use an extra SIB byte is used.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
-				
-				// Append the immediate value.
-				append32bitsimm(0);
+				// Specification from the Intel manual.
+				// 66 0F 70 /r ib	PSHUFD xmm1, xmm2/m128, imm8	#Shuffle the doublewords in xmm2/m128 based on the encoding in imm8.
+				sse2op(0x66, 0x70, XMM0, XMM0, 0, 0);
 				
-				if (rvalid != r) {
-					
-					cpy(r, rvalid);
-					
-					if (rvalidwassaved) restorereg(rvalid);
-					// Unmark register as temporarily used.
-					else regsinusetmp[rvalid] = 0;
-				}
+				// Append the 8bits immediate value
+				// which select the first doubleword
+				// for all the doublewords.
+				*binaryappend1() = 0;
 			}
+			
+			vst(r1, XMM0);
 		}
 		
-		void ldst16r (uint r1, uint r2) {
+		// Floating point lyricalinstruction
+		// are also done using XMM0 and XMM1;
+		// the bits of a floating point value are
+		// held in the least significant bits of a gpr,
+		// and size is the bytesize of that value.
+		// The scalar SSE2 instructions use the prefix
+		// F2 for 64bits floating point values
+		// and F3 for 32bits floating point values.
+		
+		// Specification from the Intel manual.
+		// F2 0F 58 /r	ADDSD xmm1, xmm2/m64	#Add the low double-precision floating-point value from xmm2/m64 to xmm1.
+		// F3 0F 58 /r	ADDSS xmm1, xmm2/m32	#Add the low single-precision floating-point value from xmm2/m32 to xmm1.
+		// F2 0F 5C /r	SUBSD xmm1, xmm2/m64	#Subtract the low double-precision floating-point value in xmm2/m64 from xmm1.
+		// F3 0F 5C /r	SUBSS xmm1, xmm2/m32	#Subtract the low single-precision floating-point value in xmm2/m32 from xmm1.
+		// F2 0F 59 /r	MULSD xmm1, xmm2/m64	#Multiply the low double-precision floating-point value in xmm2/m64 by xmm1.
+		// F3 0F 59 /r	MULSS xmm1, xmm2/m32	#Multiply the low single-precision floating-point value in xmm2/m32 by xmm1.
+		// F2 0F 5E /r	DIVSD xmm1, xmm2/m64	#Divide the low double-precision floating-point value in xmm1 by xmm2/m64.
+		// F3 0F 5E /r	DIVSS xmm1, xmm2/m32	#Divide the low single-precision floating-point value in xmm1 by xmm2/m32.
+		void fop (u8 op, uint r1, uint r2, uint r3, uint size) {
+			
+			movtoxmm(XMM0, r2, size);
+			movtoxmm(XMM1, r3, size);
+			
+			sse2op((size == 8) ? 0xf2 : 0xf3, op, XMM0, XMM1, 0, 0);
+			
+			movfromxmm(r1, XMM0, size);
+		}
+		
+		// The predicate is 0 for equal,
+		// 1 for less-than and 2 for less-than-or-equal;
+		// those predicates are false when
+		// any of the operands is a NaN.
+		void fcmp (u8 predicate, uint r1, uint r2, uint r3, uint size) {
+			
+			movtoxmm(XMM0, r2, size);
+			movtoxmm(XMM1, r3, size);
+			
 			// Specification from the Intel manual.
-			// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
+			// F2 0F C2 /r ib	CMPSD xmm1, xmm2/m64, imm8	#Compare low double-precision floating-point value in xmm2/m64 and xmm1 using imm8 as comparison predicate.
+			// F3 0F C2 /r ib	CMPSS xmm1, xmm2/m32, imm8	#Compare low single-precision floating-point value in xmm2/m32 and xmm1 using imm8 as comparison predicate.
+			sse2op((size == 8) ? 0xf2 : 0xf3, 0xc2, XMM0, XMM1, 0, 0);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = predicate;
+			
+			// The result of the comparison
+			// is a mask of all ones or all zeros,
+			// from which only the lsb is kept.
+			movfromxmm(r1, XMM0, 4);
+			
+			andimm(r1, 1);
+		}
+		
+		void itof (uint r1, uint r2, uint size) {
+			// Specification from the Intel manual.
+			// F2 REX.W 0F 2A /r	CVTSI2SD xmm1, r/m64	#Convert one signed quadword integer from r/m64 to one double-precision floating-point value in xmm1.
+			// F3 REX.W 0F 2A /r	CVTSI2SS xmm1, r/m64	#Convert one signed quadword integer from r/m64 to one single-precision floating-point value in xmm1.
+			sse2op((size == 8) ? 0xf2 : 0xf3, 0x2a, XMM0, lookupreg(r2), 0, 1);
+			
+			movfromxmm(r1, XMM0, size);
+		}
+		
+		void ftoi (uint r1, uint r2, uint size) {
+			
+			movtoxmm(XMM0, r2, size);
+			
+			// Specification from the Intel manual.
+			// F2 REX.W 0F 2C /r	CVTTSD2SI r64, xmm1/m64	#Convert one double-precision floating-point value from xmm1/m64 to one signed quadword integer in r64 using truncation.
+			// F3 REX.W 0F 2C /r	CVTTSS2SI r64, xmm1/m32	#Convert one single-precision floating-point value from xmm1/m32 to one signed quadword integer in r64 using truncation.
+			sse2op((size == 8) ? 0xf2 : 0xf3, 0x2c, lookupreg(r1), XMM0, 0, 1);
+		}
+		
+		// The argument size is the bytesize
+		// of the floating point value to convert.
+		void ftof (uint r1, uint r2, uint size) {
+			
+			movtoxmm(XMM0, r2, size);
+			
+			// Specification from the Intel manual.
+			// F3 0F 5A /r	CVTSS2SD xmm1, xmm2/m32	#Convert one single-precision floating-point value in xmm2/m32 to one double-precision floating-point value in xmm1.
+			// F2 0F 5A /r	CVTSD2SS xmm1, xmm2/m64	#Convert one double-precision floating-point value in xmm2/m64 to one single-precision floating-point value in xmm1.
+			sse2op((size == 8) ? 0xf2 : 0xf3, 0x5a, XMM0, XMM0, 0, 0);
+			
+			movfromxmm(r1, XMM0, (size == 8) ? 4 : 8);
+		}
+		
+		// Function used to generate
+		// an instruction which use the
+		// opcode bytes 0F op with a 64bits
+		// register operand r1 and a 64bits
+		// register or memory operand r2;
+		// when isf3 is true, the instruction
+		// is prefixed with the byte F3.
+		void bitcountop (uint isf3, u8 op, uint r1, uint r2) {
 			
-			u8 lookupregrm = lookupreg(r2);
 			u8 lookupregreg = lookupreg(r1);
+			u8 lookupregrm = lookupreg(r2);
 			
-			u8 lookupregrmgt7 = (lookupregrm > 7);
-			u8 lookupregreggt7 = (lookupregreg > 7);
+			// The F3 prefix must come
+			// before the REX prefix.
+			if (isf3) *binaryappend1() = 0xf3;
 			
-			if (lookupregreggt7 || lookupregrmgt7) {
-				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
+			// REX-Prefix == 0100WR0B
+			u8 rex = (0x48|((lookupregreg>7)<<2)|(lookupregrm>7));
+			
+			lookupregreg %= 8;
+			lookupregrm %= 8;
+			
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == reg[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			u8 modrm = ((0b11<<6)|(lookupregreg<<3)|lookupregrm);
+			
+			// Append the opcode bytes.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = op;
+			
+			// Append the ModR/M byte.
+			*binaryappend1() = modrm;
+		}
+		
+		void popcnt (uint r1, uint r2) {
+			
+			if (haspopcnt) {
+				// Specification from the Intel manual.
+				// F3 REX.W 0F B8 /r	POPCNT r64, r/m64	#POPCNT on r/m64.
+				bitcountop(1, 0xb8, r1, r2);
+				
+				return;
+			}
+			
+			// I get here if the CPU do not
+			// support the instruction POPCNT.
+			// The bits are counted in parallel
+			// within groups of 2, 4 and 8 bits,
+			// and the counts of the groups of
+			// 8 bits are summed by a multiplication
+			// which leave their sum in the
+			// most significant byte.
+			
+			uint t = gettmpreg(r1, r2, r2);
+			uint c = gettmpreg(r1, r2, t);
+			
+			// x = x - ((x >> 1) & 0x5555555555555555);
+			cpy(t, r2);
+			srlimm(t, 1);
+			loadimm(c, 0x5555555555555555);
+			and(t, c);
+			if (r1 != r2) cpy(r1, r2);
+			sub(r1, t);
+			
+			// x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+			cpy(t, r1);
+			srlimm(t, 2);
+			loadimm(c, 0x3333333333333333);
+			and(t, c);
+			and(r1, c);
+			add(r1, t);
+			
+			// x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0f;
+			cpy(t, r1);
+			srlimm(t, 4);
+			add(r1, t);
+			loadimm(c, 0x0f0f0f0f0f0f0f0f);
+			and(r1, c);
+			
+			// x = (x * 0x0101010101010101) >> 56;
+			loadimm(c, 0x0101010101010101);
+			mul(r1, c);
+			srlimm(r1, 56);
+			
+			releasetmpreg(c);
+			releasetmpreg(t);
+		}
+		
+		// Function used to generate
+		// a jnz rel8 over the instruction
+		// that load the immediate value n
+		// in the register r.
+		void jnzoverloadimm (uint r, u64 n) {
+			// Specification from the Intel manual.
+			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
+			*binaryappend1() = 0x75;
+			
+			uint imm = b->binarysz;
+			binaryappend1();
+			
+			loadimm(r, n);
+			
+			binaryptr()[imm] = (b->binarysz - (imm + 1));
+		}
+		
+		void clz (uint r1, uint r2) {
+			
+			if (haslzcnt) {
+				// Specification from the Intel manual.
+				// F3 REX.W 0F BD /r	LZCNT r64, r/m64	#Count the number of leading zero bits in r/m64, return result in r64.
+				bitcountop(1, 0xbd, r1, r2);
 				
-				lookupregrm %= 8;
-				lookupregreg %= 8;
+				return;
 			}
 			
-			// Append the prefix byte 0x66
-			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			// I get here if the CPU do not
+			// support the instruction LZCNT.
+			
+			// Specification from the Intel manual.
+			// REX.W 0F BD /r	BSR r64, r/m64		#Bit scan reverse on r/m64.
+			bitcountop(0, 0xbd, r1, r2);
+			
+			// BSR set ZF and leave its destination
+			// undefined when its source is null;
+			// 127 is loaded in that case, so that
+			// the xor below result in 64.
+			jnzoverloadimm(r1, 127);
+			
+			// The index of the most significant
+			// bit set is converted to a count of
+			// leading null bits using (63 ^ index).
+			
+			// Specification from the Intel manual.
+			// REX.W 83 /6 ib	XOR r/m64, imm8		#r/m64 XOR imm8 (sign-extended).
+			
+			u8 lookupregr = lookupreg(r1);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregr>7));
+			
+			lookupregr %= 8;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x83;
 			
-			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
-				
-			} else {
-				// When I get here, I use a SIB byte.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b01;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-				
-				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
-			}
+			// Append the ModR/M byte.
+			// From the most significant bit to the least significant bit.
+			// MOD == 0b11;
+			// REG == op[2:0]; #Only the 3 least significant bits matters.
+			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+			*binaryappend1() = ((0b11<<6)|(6<<3)|lookupregr);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = 63;
 		}
 		
-		void ldst16 (uint r1, uint r2) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				add(unusedreg, r2);
-				ldst16r(r1, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
+		void ctz (uint r1, uint r2) {
+			
+			if (hastzcnt) {
 				// Specification from the Intel manual.
-				// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
-				
-				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(r1);
+				// F3 REX.W 0F BC /r	TZCNT r64, r/m64	#Count the number of trailing zero bits in r/m64, return result in r64.
+				bitcountop(1, 0xbc, r1, r2);
 				
-				u8 lookupregrmgt7 = (lookupregrm > 7);
-				u8 lookupregreggt7 = (lookupregreg > 7);
-				
-				if (lookupregreggt7 || lookupregrmgt7) {
-					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
-					
-					lookupregrm %= 8;
-					lookupregreg %= 8;
-				}
-				
-				// Append the prefix byte 0x66
-				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				if (b->isimmused == IMM32) {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append32bitsimm(0);
-					
-				} else {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append8bitsimm(0);
-				}
+				return;
 			}
+			
+			// I get here if the CPU do not
+			// support the instruction TZCNT.
+			
+			// Specification from the Intel manual.
+			// REX.W 0F BC /r	BSF r64, r/m64		#Bit scan forward on r/m64.
+			bitcountop(0, 0xbc, r1, r2);
+			
+			// BSF set ZF and leave its destination
+			// undefined when its source is null;
+			// 64 is loaded in that case.
+			jnzoverloadimm(r1, 64);
 		}
 		
-		void ldst16i (uint r) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				ldst16r(r, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
-				// Specification from the Intel manual.
-				// 87 /r	XCHG r/m16, r16		#Exchange r16 with doubleword from r/m16.
-				
-				u8 lookupregr = lookupreg(r);
-				
-				u8 lookupregrgt7 = (lookupregr > 7);
-				
-				if (lookupregrgt7) {
-					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
-					
-					lookupregr %= 8;
-				}
-				
-				// Append the prefix byte 0x66
-				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				// Note that in x64, a ModR/M byte with
-				// MOD == 0b00 and R/M == 0b101 correspond
-				// to RIP-relative addressing; hence
-				// the reason an alternate encoding
-				// that use an extra SIB byte is used.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
-				
-				// Append the immediate value.
-				append32bitsimm(0);
-			}
+		void bswap (uint r) {
+			// Specification from the Intel manual.
+			// REX.W 0F C8+rd	BSWAP r64		#Reverses the byte order of a 64-bit register.
+			
+			u8 lookupregr = lookupreg(r);
+			
+			// REX-Prefix == 0100W00B
+			u8 rex = (0x48|(lookupregr>7));
+			
+			lookupregr %= 8;
+			
+			// Append the opcode bytes.
+			*binaryappend1() = rex;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = (0xc8+lookupregr);
 		}
 		
-		void ldst32r (uint r1, uint r2) {
-			// Specification from the Intel manual.
-			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
+		void mem8cpy (uint r1, uint r2, uint r3) {
+			// r1, r2, r3 are assumed
+			// different registers.
 			
-			u8 lookupregrm = lookupreg(r2);
-			u8 lookupregreg = lookupreg(r1);
+			uint rdiwassaved = 0;
+			uint rsiwassaved = 0;
+			uint rcxwassaved = 0;
 			
-			u8 lookupregrmgt7 = (lookupregrm > 7);
-			u8 lookupregreggt7 = (lookupregreg > 7);
+			if (r1 != RDI && r2 != RDI && r3 != RDI) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(RDI)) {
+					savereg(RDI); rdiwassaved = 1;
+				} else regsinusetmp[RDI] = 1; // Mark unused register as temporarily used.
+			}
 			
-			if (lookupregreggt7 || lookupregrmgt7) {
-				// REX-Prefix == 01000R0B
-				*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
-				
-				lookupregrm %= 8;
-				lookupregreg %= 8;
+			if (r1 != RSI && r2 != RSI && r3 != RSI) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(RSI)) {
+					savereg(RSI); rsiwassaved = 1;
+				} else regsinusetmp[RSI] = 1; // Mark unused register as temporarily used.
+			}
+			
+			if (r1 != RCX && r2 != RCX && r3 != RCX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(RCX)) {
+					savereg(RCX); rcxwassaved = 1;
+				} else regsinusetmp[RCX] = 1; // Mark unused register as temporarily used.
+			}
+			
+			// Set RDI, RSI, RCX
+			// respectively
+			// to r1, r2, r3 by
+			// first pushing them
+			// in the stack, and
+			// poping them in the
+			// order they were pushed.
+			if (r3 != RCX) push(r3);
+			if (r2 != RSI) push(r2);
+			if (r1 != RDI) {
+				push(r1);
+				pop(RDI);
 			}
+			if (r2 != RSI) pop(RSI);
+			if (r3 != RCX) pop(RCX);
 			
+			// Clear direction flag to
+			// select incremental copy.
+			
+			// Specification from the Intel manual.
+			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0xfc;
 			
-			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
-				
-			} else {
-				// When I get here, I use a SIB byte.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b01;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-				
-				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
-			}
-		}
-		
-		void ldst32 (uint r1, uint r2) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				add(unusedreg, r2);
-				ldst32r(r1, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
-				// Specification from the Intel manual.
-				// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
-				
-				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(r1);
-				
-				u8 lookupregrmgt7 = (lookupregrm > 7);
-				u8 lookupregreggt7 = (lookupregreg > 7);
-				
-				if (lookupregreggt7 || lookupregrmgt7) {
-					// REX-Prefix == 01000R0B
-					*arrayu8append1(&b->binary) = (0x40|(lookupregreggt7<<2)|lookupregrmgt7);
-					
-					lookupregrm %= 8;
-					lookupregreg %= 8;
-				}
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				if (b->isimmused == IMM32) {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append32bitsimm(0);
-					
-				} else {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append8bitsimm(0);
-				}
-			}
-		}
-		
-		void ldst32i (uint r) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				ldst32r(r, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
-				// Specification from the Intel manual.
-				// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
-				
-				u8 lookupregr = lookupreg(r);
-				
-				u8 lookupregrgt7 = (lookupregr > 7);
-				
-				if (lookupregrgt7) {
-					// REX-Prefix == 01000R00
-					*arrayu8append1(&b->binary) = (0x40|(lookupregrgt7<<2));
-					
-					lookupregr %= 8;
-				}
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				// Note that in x64, a ModR/M byte with
-				// MOD == 0b00 and R/M == 0b101 correspond
-				// to RIP-relative addressing; hence
-				// the reason an alternate encoding
-				// that use an extra SIB byte is used.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
-				
-				// Append the immediate value.
-				append32bitsimm(0);
-			}
-		}
-		
-		void ldst64r (uint r1, uint r2) {
-			// Specification from the Intel manual.
-			// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
+			// Repeat the instruction movsb
+			// until RCX become null.
 			
-			u8 lookupregrm = lookupreg(r2);
-			u8 lookupregreg = lookupreg(r1);
+			// Specification from the Intel manual.
+			// F3 A4	MOVSB		#Move 8bits data from address RSI to address RDI.
+			// Append the opcode bytes.
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa4;
 			
-			u8 lookupregrmgt7 = (lookupregrm > 7);
-			u8 lookupregreggt7 = (lookupregreg > 7);
+			// Set r1, r2
+			// respectively
+			// to RSI, RDI by
+			// first pushing them
+			// in the stack, and
+			// poping them in the
+			// order they were pushed.
+			if (r2 != RSI) push(RSI);
+			if (r1 != RDI) {
+				push(RDI);
+				pop(r1);
+			}
+			if (r2 != RSI) pop(r2);
 			
-			// REX-Prefix == 0100WR0B
-			*arrayu8append1(&b->binary) = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
+			// If r3 != RCX, the value
+			// of r3 is set null because
+			// RCX is certainly null.
+			if (r3 != RCX) xor(r3, r3);
 			
-			lookupregrm %= 8;
-			lookupregreg %= 8;
+			if (rcxwassaved) {
+				// Restore register value.
+				restorereg(RCX);
+			// Unmark register as temporarily used.
+			} else regsinusetmp[RCX] = 0;
 			
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			if (rsiwassaved) {
+				// Restore register value.
+				restorereg(RSI);
+			// Unmark register as temporarily used.
+			} else regsinusetmp[RSI] = 0;
 			
-			if (lookupregrm != LOOKUPREGRSP && lookupregrm != LOOKUPREGRBP) {
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((lookupregreg<<3)|lookupregrm);
-				
-			} else {
-				// When I get here, I use a SIB byte.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b01;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: rm[2:0]; #Only the 3 least significant bits matters.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-				
-				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
-			}
-		}
-		
-		void ldst64 (uint r1, uint r2) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				add(unusedreg, r2);
-				ldst64r(r1, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
-				// Specification from the Intel manual.
-				// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
-				
-				u8 lookupregrm = lookupreg(r2);
-				u8 lookupregreg = lookupreg(r1);
-				
-				u8 lookupregrmgt7 = (lookupregrm > 7);
-				u8 lookupregreggt7 = (lookupregreg > 7);
-				
-				// REX-Prefix == 0100WR0B
-				*arrayu8append1(&b->binary) = (0x48|(lookupregreggt7<<2)|lookupregrmgt7);
-				
-				lookupregrm %= 8;
-				lookupregreg %= 8;
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				if (b->isimmused == IMM32) {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b10;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append32bitsimm(0);
-					
-				} else {
-					
-					if (lookupregrm != LOOKUPREGRSP) {
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
-						
-					} else {
-						// When I get here, I use a SIB byte.
-						
-						// Append the ModR/M byte.
-						// From the most significant bit to the least significant bit.
-						// MOD == 0b01;
-						// REG == reg[2:0]; #Only the 3 least significant bits matters.
-						// R/M == 0b100;
-						*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupregreg<<3)|0b100);
-						
-						// Append the SIB byte.
-						// scale: 0b00;
-						// index: 0b100; #A register for index is not used and scale is ignored.
-						// base: rm[2:0]; #Only the 3 least significant bits matters.
-						*arrayu8append1(&b->binary) = ((0b100<<3)|lookupregrm);
-					}
-					
-					// Append the immediate value.
-					append8bitsimm(0);
-				}
-			}
-		}
-		
-		void ldst64i (uint r) {
-			// If b->isimmused is set, then
-			// I am redoing the lyricalinstruction.
-			if (b->isimmused == IMM64) {
-				// Look for an unused register.
-				uint unusedreg = findunusedreg(0);
-				
-				// The compiler should have insured
-				// that there are enough unused
-				// registers available.
-				if (!unusedreg) throwerror();
-				
-				regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-				
-				ldi(unusedreg, 0);
-				ldst64r(r, unusedreg);
-				
-				regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-				
-			} else {
-				// Specification from the Intel manual.
-				// REX.W 87 /r	XCHG r/m64, r64		#Exchange r64 with doubleword from r/m64.
-				
-				u8 lookupregr = lookupreg(r);
-				
-				u8 lookupregrgt7 = (lookupregr > 7);
-				
-				// REX-Prefix == 0100WR00
-				*arrayu8append1(&b->binary) = (0x48|(lookupregrgt7<<2));
-				
-				lookupregr %= 8;
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x87;
-				
-				// Note that in x64, a ModR/M byte with
-				// MOD == 0b00 and R/M == 0b101 correspond
-				// to RIP-relative addressing; hence
-				// the reason an alternate encoding
-				// that use an extra SIB byte is used.
-				
-				// Append the ModR/M byte.
-				// From the most significant bit to the least significant bit.
-				// MOD == 0b00;
-				// REG == reg[2:0]; #Only the 3 least significant bits matters.
-				// R/M == 0b100;
-				*arrayu8append1(&b->binary) = (((lookupregr)<<3)|0b100);
-				
-				// Append the SIB byte.
-				// scale: 0b00;
-				// index: 0b100; #A register for index is not used and scale is ignored.
-				// base: 0b101; #A register for base is not used and a 32bits immediate is expected.
-				*arrayu8append1(&b->binary) = ((0b100<<3)|0b101);
-				
-				// Append the immediate value.
-				append32bitsimm(0);
-			}
-		}
-		
-		void mem8cpy (uint r1, uint r2, uint r3) {
-			// r1, r2, r3 are assumed
-			// different registers.
-			
-			uint rdiwassaved = 0;
-			uint rsiwassaved = 0;
-			uint rcxwassaved = 0;
-			
-			if (r1 != RDI && r2 != RDI && r3 != RDI) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(RDI)) {
-					savereg(RDI); rdiwassaved = 1;
-				} else regsinusetmp[RDI] = 1; // Mark unused register as temporarily used.
-			}
-			
-			if (r1 != RSI && r2 != RSI && r3 != RSI) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(RSI)) {
-					savereg(RSI); rsiwassaved = 1;
-				} else regsinusetmp[RSI] = 1; // Mark unused register as temporarily used.
-			}
-			
-			if (r1 != RCX && r2 != RCX && r3 != RCX) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(RCX)) {
-					savereg(RCX); rcxwassaved = 1;
-				} else regsinusetmp[RCX] = 1; // Mark unused register as temporarily used.
-			}
-			
-			// Set RDI, RSI, RCX
-			// respectively
-			// to r1, r2, r3 by
-			// first pushing them
-			// in the stack, and
-			// poping them in the
-			// order they were pushed.
-			if (r3 != RCX) push(r3);
-			if (r2 != RSI) push(r2);
-			if (r1 != RDI) {
-				push(r1);
-				pop(RDI);
-			}
-			if (r2 != RSI) pop(RSI);
-			if (r3 != RCX) pop(RCX);
-			
-			// Clear direction flag to
-			// select incremental copy.
-			
-			// Specification from the Intel manual.
-			// FC	CLD	#Clear DF Flag.
-			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
-			
-			// Repeat the instruction movsb
-			// until RCX become null.
-			
-			// Specification from the Intel manual.
-			// F3 A4	MOVSB		#Move 8bits data from address RSI to address RDI.
-			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa4;
-			
-			// Set r1, r2
-			// respectively
-			// to RSI, RDI by
-			// first pushing them
-			// in the stack, and
-			// poping them in the
-			// order they were pushed.
-			if (r2 != RSI) push(RSI);
-			if (r1 != RDI) {
-				push(RDI);
-				pop(r1);
-			}
-			if (r2 != RSI) pop(r2);
-			
-			// If r3 != RCX, the value
-			// of r3 is set null because
-			// RCX is certainly null.
-			if (r3 != RCX) xor(r3, r3);
-			
-			if (rcxwassaved) {
-				// Restore register value.
-				restorereg(RCX);
-			// Unmark register as temporarily used.
-			} else regsinusetmp[RCX] = 0;
-			
-			if (rsiwassaved) {
-				// Restore register value.
-				restorereg(RSI);
-			// Unmark register as temporarily used.
-			} else regsinusetmp[RSI] = 0;
-			
-			if (rdiwassaved) {
-				// Restore register value.
-				restorereg(RDI);
-			// Unmark register as temporarily used.
-			} else regsinusetmp[RDI] = 0;
+			if (rdiwassaved) {
+				// Restore register value.
+				restorereg(RDI);
+			// Unmark register as temporarily used.
+			} else regsinusetmp[RDI] = 0;
 		}
 		
 		void mem8cpy2 (uint r1, uint r2, uint r3) {
@@ -9809,7 +9565,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Repeat the instruction movsb
 			// until RCX become null.
@@ -9817,8 +9573,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A4	MOVSB		#Move 8bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa4;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa4;
 			
 			// Set r1, r2
 			// respectively
@@ -9912,11 +9668,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -9924,8 +9680,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSW		#Move 16bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10019,11 +9775,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -10031,8 +9787,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSW		#Move 16bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10126,7 +9882,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -10134,8 +9890,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSD		#Move 32bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10229,7 +9985,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -10237,8 +9993,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSD		#Move 32bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10332,7 +10088,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -10340,9 +10096,9 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 REX.W A5	MOVSQ		#Move 64bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0x48;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0x48;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10436,7 +10192,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Repeat the instruction movsd
 			// until RCX become null.
@@ -10444,9 +10200,9 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 REX.W A5	MOVSQ		#Move 64bits data from address RSI to address RDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0x48;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0x48;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -10486,19 +10242,160 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 			} else regsinusetmp[RDI] = 0;
 		}
 		
-		void pushi (u64 imm) {
+		// Function used to load in r1, when isstore
+		// is null, or store from r1, when isstore
+		// is non-null, a value of size bytes located
+		// in memory at the address in r2 added to
+		// the 8bits displacement disp.
+		// A loaded value smaller than 32bits
+		// is zero extended.
+		void ldstdisp8 (uint r1, uint r2, s8 disp, uint size, uint isstore) {
 			
-			if ((((sint)imm < 0) ? -imm : imm) < (1 << 7)) {
+			u8 lookupregrm = lookupreg(r2);
+			u8 lookupregreg = lookupreg(r1);
+			
+			// Specification from the Intel manual.
+			// 66		#Operand-size override prefix.
+			if (size == 2 && isstore) *binaryappend1() = 0x66;
+			
+			// REX-Prefix == 0100WR0B
+			u8 rex = (0x40|((size == 8)<<3)|((lookupregreg>7)<<2)|(lookupregrm>7));
+			
+			// The REX-Prefix is always used when storing
+			// 8bits so that the registers SPL, BPL, SIL, DIL
+			// get encoded instead of AH, CH, DH, BH.
+			if (rex != 0x40 || (size == 1 && isstore)) *binaryappend1() = rex;
+			
+			lookupregrm %= 8;
+			lookupregreg %= 8;
+			
+			// Append the opcode bytes.
+			if (isstore) {
 				// Specification from the Intel manual.
-				// 6A		PUSH imm8	#Push imm8 (Sign-extended).
-				
-				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x6a;
+				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32; r16 to r/m16 with prefix 66; r64 to r/m64 with REX.W.
+				*binaryappend1() = ((size == 1) ? 0x88 : 0x89);
 				
-				// Append the 8bits immediate value.
-				*arrayu8append1(&b->binary) = imm;
+			} else if (size < 4) {
+				// Specification from the Intel manual.
+				// 0F B6 /r	MOVZX r32, r/m8		#Move byte to doubleword, zero-extension.
+				// 0F B7 /r	MOVZX r32, r/m16	#Move word to doubleword, zero-extension.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = ((size == 1) ? 0xb6 : 0xb7);
 				
-			}
+			} else {
+				// Specification from the Intel manual.
+				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32; r/m64 to r64 with REX.W.
+				*binaryappend1() = 0x8b;
+			}
+			
+			if (lookupregrm != LOOKUPREGRSP) {
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|lookupregrm);
+				
+			} else {
+				// When I get here, I use a SIB byte.
+				
+				// Append the ModR/M byte.
+				// From the most significant bit to the least significant bit.
+				// MOD == 0b01;
+				// REG == reg[2:0]; #Only the 3 least significant bits matters.
+				// R/M == 0b100;
+				*binaryappend1() = ((0b01<<6)|(lookupregreg<<3)|0b100);
+				
+				// Append the SIB byte.
+				// scale: 0b00;
+				// index: 0b100; #A register for index is not used and scale is ignored.
+				// base: rm[2:0]; #Only the 3 least significant bits matters.
+				*binaryappend1() = ((0b100<<3)|lookupregrm);
+			}
+			
+			// Append the 8bits displacement.
+			*binaryappend1() = disp;
+		}
+		
+		// Largest count of bytes for which the
+		// instructions LYRICALOPMEM*CPYI* are
+		// expanded into load and store pairs.
+		// Beyond that count, the string move
+		// instructions are faster than the extra
+		// instruction bytes fetched and decoded,
+		// especially since their use require
+		// saving and restoring RDI, RSI, RCX.
+		// It must not be greater than 64 because
+		// the displacements used are 8bits.
+		#define MEMCPYIEXPANDMAXSIZE 64
+		
+		// Function used to expand the
+		// lyricalinstruction MEM*CPYI* being
+		// converted when its immediate value
+		// is a constant small enough; in which
+		// case each element of size bytes is copied
+		// using a load and a store through an
+		// unused register, in the same order that
+		// the string move instruction would have used.
+		// isdecrementing is non-null for MEM*CPYI2.
+		// Null is returned if the lyricalinstruction
+		// could not be expanded.
+		uint expandmemcpyi (uint size, uint isdecrementing) {
+			
+			lyricalimmval* imm = i->imm;
+			
+			if (imm->type != LYRICALIMMVALUE || imm->next) return 0;
+			
+			u64 n = imm->n;
+			
+			if (!n || n > (MEMCPYIEXPANDMAXSIZE/size)) return 0;
+			
+			// Look for an unused register.
+			uint unusedreg = findunusedreg(0);
+			
+			if (!unusedreg) return 0;
+			
+			// Mark unused register as temporarily used.
+			regsinusetmp[unusedreg] = 1;
+			
+			uint j;
+			
+			for (j = 0; j < n; ++j) {
+				
+				s8 disp = (isdecrementing ? -(j*size) : (j*size));
+				
+				ldstdisp8(unusedreg, i->r2, disp, size, 0);
+				ldstdisp8(unusedreg, i->r1, disp, size, 1);
+			}
+			
+			// At the end of the copy, r1 and r2
+			// hold the address of the next memory
+			// locations that would have been used.
+			s8 disp = (isdecrementing ? -(n*size) : (n*size));
+			
+			inc8(i->r1, disp);
+			inc8(i->r2, disp);
+			
+			// Unmark register as temporarily used.
+			regsinusetmp[unusedreg] = 0;
+			
+			return 1;
+		}
+		
+		void pushi (u64 imm) {
+			
+			if ((((sint)imm < 0) ? -imm : imm) < (1 << 7)) {
+				// Specification from the Intel manual.
+				// 6A		PUSH imm8	#Push imm8 (Sign-extended).
+				
+				// Append the opcode byte.
+				*binaryappend1() = 0x6a;
+				
+				// Append the 8bits immediate value.
+				*binaryappend1() = imm;
+				
+			}
 			#if 0
 			else if ((((sint)imm < 0) ? -imm : imm) < (1 << 15)) {
 				// Specification from the Intel manual.
@@ -10509,25 +10406,25 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				
 				// Append the prefix byte 0x66
 				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
+				*binaryappend1() = 0x66;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x68;
+				*binaryappend1() = 0x68;
 				
 				// Append the 16bits immediate value.
-				*(u16*)arrayu8append2(&b->binary, sizeof(u16)) = imm;
+				*(u16*)binaryappend2(sizeof(u16)) = imm;
 				
 			}
 			#endif
-			else if ((((sint)imm < 0) ? -imm : imm) < (1 << 31)) {
+			else if ((((sint)imm < 0) ? -imm : imm) < ((u64)1 << 31)) {
 				// Specification from the Intel manual.
 				// 68		PUSH imm32	#Push imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x68;
+				*binaryappend1() = 0x68;
 				
 				// Append the 32bits immediate value.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = imm;
+				*(u32*)binaryappend2(sizeof(u32)) = imm;
 				
 			} else {
 				// Look for an unused register.
@@ -10612,121 +10509,792 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				// redoing lyricalinstruction.
 				b = i->backenddata;
 				
-				if (bintreefind(toredo, (uint)i)) {
+				if (b->redobinary.ptr) {
+					
+					mmfree(b->redobinary.ptr);
+					
+					b->redobinary = arrayu8null;
+				}
+				
+				b->binarysz = 0;
+				
+				// Reset the immediates misc values null
+				// as they are fields that get incremented.
+				b->immmiscvalue = 0;
+				b->imm2miscvalue = 0;
+				
+			} else {
+				
+				b = &backenddatas[layoutidx];
+				
+				b->codeoffset = codebufsz;
+				
+				i->backenddata = b;
+			}
+			
+			switch(i->op) {
+				
+				case LYRICALOPADD:
+					
+					if (i->r1 != i->r3) {
+						// When the destination register
+						// is neither of the source registers,
+						// LEA does the addition without having
+						// to first copy a source register;
+						// RSP cannot be an index register.
+						if (i->r1 != i->r2 && (i->r2 != RSP || i->r3 != RSP)) {
+							
+							if (i->r3 == RSP) lea(i->r1, i->r3, i->r2, 0);
+							else lea(i->r1, i->r2, i->r3, 0);
+							
+							break;
+						}
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						add(i->r1, i->r3);
+						
+					} else {
+						
+						add(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPADDI:
+					// When the destination register
+					// is not the source register, LEA
+					// does the addition without having
+					// to first copy the source register.
+					if (i->r1 != i->r2 && b->isimmused != IMM64) {
+						
+						leai(i->r1, i->r2);
+						
+						break;
+					}
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					addi(i->r1);
+					
+					break;
+					
+				case LYRICALOPSUB:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						sub(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						
+						sub(i->r3, i->r2);
+						
+						neg(i->r1);
+						
+					} else {
+						
+						sub(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPNEG:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					neg(i->r1);
+					
+					break;
+					
+				case LYRICALOPMUL:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						mul(i->r1, i->r3);
+						
+					} else {
+						
+						mul(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPMULH:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						mulh(i->r1, i->r3);
+						
+					} else {
+						
+						mulh(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPDIV:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						div(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						div(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						div(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPMOD:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						mod(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						mod(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						mod(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPMULHU:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						mulhu(i->r1, i->r3);
+						
+					} else {
+						
+						mulhu(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPDIVU:
 					
-					mmfree(b->binary.ptr);
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						divu(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						divu(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						divu(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPMODU:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						modu(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						modu(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						modu(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPMULI: {
+					
+					lyricalimmval* imm = i->imm;
+					
+					u64 n = *(u64*)&imm->n;
+					
+					// Multiplications by 3, 5 or 9
+					// are done using a single LEA
+					// computing r1 = r2 + (r2 << scale);
+					// RSP cannot be an index register.
+					if (imm->type == LYRICALIMMVALUE && !imm->next &&
+						(n == 3 || n == 5 || n == 9) && i->r2 != RSP) {
+						
+						lea(i->r1, i->r2, i->r2, (n == 3) ? 1 : (n == 5) ? 2 : 3);
+						
+						break;
+					}
+					
+					muli(i->r1, i->r2);
+					
+					break;
+				}
+					
+				case LYRICALOPMULHI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					mulhi(i->r1);
+					
+					break;
+					
+				case LYRICALOPDIVI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					divi(i->r1);
+					
+					break;
+					
+				case LYRICALOPMODI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					modi(i->r1);
+					
+					break;
+					
+				case LYRICALOPDIVI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						div(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RAX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						div(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
+					
+					break;
+					
+				case LYRICALOPMODI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						mod(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RAX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						mod(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
+					
+					break;
+					
+				case LYRICALOPMULHUI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					mulhui(i->r1);
+					
+					break;
+					
+				case LYRICALOPDIVUI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					divui(i->r1);
+					
+					break;
+					
+				case LYRICALOPMODUI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					modui(i->r1);
+					
+					break;
+					
+				case LYRICALOPDIVUI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						divu(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RAX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						divu(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
+					
+					break;
+					
+				case LYRICALOPMODUI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						modu(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RAX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						modu(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
+					
+					break;
+					
+				case LYRICALOPAND:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						and(i->r1, i->r3);
+						
+					} else {
+						
+						and(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPANDI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					andi(i->r1);
+					
+					break;
+					
+				case LYRICALOPOR:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						or(i->r1, i->r3);
+						
+					} else {
+						
+						or(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPORI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					ori(i->r1);
+					
+					break;
+					
+				case LYRICALOPXOR:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						xor(i->r1, i->r3);
+						
+					} else {
+						
+						xor(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPXORI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					xori(i->r1);
+					
+					break;
+					
+				case LYRICALOPNOT:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					not(i->r1);
+					
+					break;
+					
+				case LYRICALOPCPY:
+					
+					cpy(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPSLL:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						sll(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RCX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						sll(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						sll(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPSLLI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					slli(i->r1);
+					
+					break;
+					
+				case LYRICALOPSLLI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						sll(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						sll(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
 					
-					b->binary = arrayu8null;
+					break;
 					
-				} else goto skipredo;
-				
-				// Reset the immediates misc values null
-				// as they are fields that get incremented.
-				b->immmiscvalue = 0;
-				b->imm2miscvalue = 0;
-				
-			} else {
-				
-				b = (backenddata*)mmallocz(sizeof(backenddata));
-				
-				i->backenddata = b;
-			}
-			
-			switch(i->op) {
-				
-				case LYRICALOPADD:
+				case LYRICALOPSRL:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						add(i->r1, i->r3);
+						srl(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RCX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						srl(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 						
 					} else {
 						
-						add(i->r1, i->r2);
+						srl(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPADDI:
+				case LYRICALOPSRLI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					addi(i->r1);
+					srli(i->r1);
 					
 					break;
 					
-				case LYRICALOPSUB:
+				case LYRICALOPSRLI2:
+					
+					if (i->r1 != i->r2) {
+						
+						ldi(i->r1, 0);
+						srl(i->r1, i->r2);
+						
+					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						srl(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+					}
+					
+					break;
+					
+				case LYRICALOPSRA:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						sub(i->r1, i->r3);
+						sra(i->r1, i->r3);
 						
 					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RCX);
 						
-						sub(i->r3, i->r2);
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
 						
-						neg(i->r1);
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						sra(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 						
 					} else {
 						
-						sub(i->r1, i->r2);
+						sra(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPNEG:
+				case LYRICALOPSRAI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					neg(i->r1);
+					srai(i->r1);
 					
 					break;
 					
-				case LYRICALOPMUL:
+				case LYRICALOPSRAI2:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					if (i->r1 != i->r2) {
 						
-						mul(i->r1, i->r3);
+						ldi(i->r1, 0);
+						sra(i->r1, i->r2);
 						
 					} else {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(0);
 						
-						mul(i->r1, i->r2);
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						ldi(unusedreg, 0);
+						sra(unusedreg, i->r1);
+						cpy(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 					}
 					
 					break;
 					
-				case LYRICALOPMULH:
+				case LYRICALOPROL:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						mulh(i->r1, i->r3);
+						rol(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(RCX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						rol(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 						
 					} else {
 						
-						mulh(i->r1, i->r2);
+						rol(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPDIV:
+				case LYRICALOPROLI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					roli(i->r1);
+					
+					break;
+					
+				case LYRICALOPROR:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						div(i->r1, i->r3);
+						ror(i->r1, i->r3);
 						
 					} else if (i->r1 != i->r2) {
 						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
+						uint unusedreg = findunusedreg(RCX);
 						
 						// The compiler should have insured
 						// that there are enough unused
@@ -10737,1229 +11305,1072 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						
 						cpy(unusedreg, i->r1);
 						cpy(i->r1, i->r2);
-						div(i->r1, unusedreg);
+						ror(i->r1, unusedreg);
 						
 						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
 						
 					} else {
 						
-						div(i->r1, i->r2);
+						ror(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPRORI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					rori(i->r1);
+					
+					break;
+					
+				case LYRICALOPBSWAP:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					bswap(i->r1);
+					
+					break;
+					
+				case LYRICALOPPOPCNT:
+					
+					popcnt(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPCLZ:
+					
+					clz(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPCTZ:
+					
+					ctz(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPZXT:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					// A single lyricalimmval
+					// of type LYRICALIMMVALUE is
+					// guaranteed to have been used.
+					zxt(i->r1, *(u8*)&i->imm->n);
+					
+					break;
+					
+				case LYRICALOPSXT:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					// A single lyricalimmval
+					// of type LYRICALIMMVALUE is
+					// guaranteed to have been used.
+					sxt(i->r1, *(u8*)&i->imm->n);
+					
+					break;
+					
+				case LYRICALOPSEQ:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						seq(i->r1, i->r3);
+						
+					} else {
+						
+						seq(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPSNE:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						sne(i->r1, i->r3);
+						
+					} else {
+						
+						sne(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPMOD:
+				case LYRICALOPSEQI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					seqi(i->r1);
+					
+					break;
+					
+				case LYRICALOPSNEI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					snei(i->r1);
+					
+					break;
+					
+				case LYRICALOPSLT:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						mod(i->r1, i->r3);
+						slt(i->r1,i->r3);
 						
 					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						mod(i->r1, unusedreg);
 						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						sgt(i->r3, i->r2);
 						
 					} else {
 						
-						mod(i->r1, i->r2);
+						slt(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPMULHU:
+				case LYRICALOPSLTE:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						mulhu(i->r1, i->r3);
+						slte(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						
+						sgte(i->r3, i->r2);
 						
 					} else {
 						
-						mulhu(i->r1, i->r2);
+						slte(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPDIVU:
+				case LYRICALOPSLTU:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						divu(i->r1, i->r3);
+						sltu(i->r1, i->r3);
 						
 					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
 						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						divu(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						sgtu(i->r3, i->r2);
 						
 					} else {
 						
-						divu(i->r1, i->r2);
+						sltu(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPMODU:
+				case LYRICALOPSLTEU:
 					
 					if (i->r1 != i->r3) {
 						
 						if (i->r1 != i->r2) cpy(i->r1, i->r2);
 						
-						modu(i->r1, i->r3);
+						slteu(i->r1, i->r3);
 						
 					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						modu(i->r1, unusedreg);
 						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						sgteu(i->r3, i->r2);
 						
 					} else {
 						
-						modu(i->r1, i->r2);
+						slteu(i->r1, i->r2);
 					}
 					
 					break;
 					
-				case LYRICALOPMULI:
+				case LYRICALOPSLTI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					muli(i->r1);
+					slti(i->r1);
 					
 					break;
 					
-				case LYRICALOPMULHI:
+				case LYRICALOPSLTEI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					mulhi(i->r1);
+					sltei(i->r1);
 					
 					break;
 					
-				case LYRICALOPDIVI:
+				case LYRICALOPSLTUI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					divi(i->r1);
+					sltui(i->r1);
 					
 					break;
 					
-				case LYRICALOPMODI:
+				case LYRICALOPSLTEUI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					modi(i->r1);
+					slteui(i->r1);
 					
 					break;
 					
-				case LYRICALOPDIVI2:
+				case LYRICALOPSGTI:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						div(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RAX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						div(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					sgti(i->r1);
 					
 					break;
 					
-				case LYRICALOPMODI2:
+				case LYRICALOPSGTEI:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						mod(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RAX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						mod(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					sgtei(i->r1);
 					
 					break;
 					
-				case LYRICALOPMULHUI:
+				case LYRICALOPSGTUI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					mulhui(i->r1);
+					sgtui(i->r1);
 					
 					break;
 					
-				case LYRICALOPDIVUI:
+				case LYRICALOPSGTEUI:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					divui(i->r1);
+					sgteui(i->r1);
 					
 					break;
 					
-				case LYRICALOPMODUI:
+				case LYRICALOPSZ:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
 					
-					modui(i->r1);
+					sz(i->r1);
 					
 					break;
 					
-				case LYRICALOPDIVUI2:
+				case LYRICALOPSNZ:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						divu(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RAX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						divu(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					snz(i->r1);
+					
+					break;
+					
+				case LYRICALOPJEQ:
+					
+					jeq(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJEQI:
+					
+					jeqi(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJEQR:
+					
+					jeqr(i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPJNE:
+					
+					jne(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJNEI:
+					
+					jnei(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJNER:
+					
+					jner(i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPJLT:
+					
+					jlt(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJLTI:
+					
+					jlti(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJLTR:
+					
+					jltr(i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPJLTE:
+					
+					jlte(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJLTEI:
+					
+					jltei(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPJLTER:
+					
+					jlter(i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPMODUI2:
+				case LYRICALOPJLTU:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						modu(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RAX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						modu(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					jltu(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPAND:
+				case LYRICALOPJLTUI:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						and(i->r1, i->r3);
-						
-					} else {
-						
-						and(i->r1, i->r2);
-					}
+					jltui(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPANDI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPJLTUR:
 					
-					andi(i->r1);
+					jltur(i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPOR:
+				case LYRICALOPJLTEU:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						or(i->r1, i->r3);
-						
-					} else {
-						
-						or(i->r1, i->r2);
-					}
+					jlteu(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPORI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPJLTEUI:
 					
-					ori(i->r1);
+					jlteui(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPXOR:
+				case LYRICALOPJLTEUR:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						xor(i->r1, i->r3);
-						
-					} else {
-						
-						xor(i->r1, i->r2);
-					}
+					jlteur(i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPXORI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPJZ:
 					
-					xori(i->r1);
+					jz(i->r1);
 					
 					break;
 					
-				case LYRICALOPNOT:
+				case LYRICALOPJZI:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					jzi(i->r1);
 					
-					not(i->r1);
+					break;
+					
+				case LYRICALOPJZR:
+					
+					jzr(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPCPY:
+				case LYRICALOPJNZ:
 					
-					cpy(i->r1, i->r2);
+					jnz(i->r1);
 					
 					break;
 					
-				case LYRICALOPSLL:
+				case LYRICALOPJNZI:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						sll(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RCX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						sll(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-						
-					} else {
-						
-						sll(i->r1, i->r2);
-					}
+					jnzi(i->r1);
 					
 					break;
 					
-				case LYRICALOPSLLI:
+				case LYRICALOPJNZR:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					jnzr(i->r1, i->r2);
 					
-					slli(i->r1);
+					break;
+					
+				case LYRICALOPJ:
+					
+					j();
 					
 					break;
 					
-				case LYRICALOPSLLI2:
+				case LYRICALOPJI:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						sll(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						sll(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					ji();
 					
 					break;
 					
-				case LYRICALOPSRL:
+				case LYRICALOPJR:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						srl(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RCX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						srl(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-						
-					} else {
-						
-						srl(i->r1, i->r2);
-					}
+					jr(i->r1);
 					
 					break;
 					
-				case LYRICALOPSRLI:
+				case LYRICALOPJL:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					jl(i->r1);
 					
-					srli(i->r1);
+					break;
+					
+				case LYRICALOPJLI:
+					
+					jli(i->r1);
 					
 					break;
 					
-				case LYRICALOPSRLI2:
+				case LYRICALOPJLR:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						srl(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						srl(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					jlr(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSRA:
+				case LYRICALOPJPUSH:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						sra(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(RCX);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						cpy(unusedreg, i->r1);
-						cpy(i->r1, i->r2);
-						sra(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-						
-					} else {
-						
-						sra(i->r1, i->r2);
-					}
+					jpush();
 					
 					break;
 					
-				case LYRICALOPSRAI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPJPUSHI:
 					
-					srai(i->r1);
+					jpushi();
 					
 					break;
 					
-				case LYRICALOPSRAI2:
+				case LYRICALOPJPUSHR:
 					
-					if (i->r1 != i->r2) {
-						
-						ldi(i->r1, 0);
-						sra(i->r1, i->r2);
-						
-					} else {
-						// Look for an unused register.
-						uint unusedreg = findunusedreg(0);
-						
-						// The compiler should have insured
-						// that there are enough unused
-						// registers available.
-						if (!unusedreg) throwerror();
-						
-						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
-						
-						ldi(unusedreg, 0);
-						sra(unusedreg, i->r1);
-						cpy(i->r1, unusedreg);
-						
-						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
-					}
+					jpushr(i->r1);
 					
 					break;
 					
-				case LYRICALOPZXT:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPJPOP:
 					
-					// A single lyricalimmval
-					// of type LYRICALIMMVALUE is
-					// guaranteed to have been used.
-					zxt(i->r1, *(u8*)&i->imm->n);
+					jpop();
 					
 					break;
 					
-				case LYRICALOPSXT:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPAFIP:
 					
-					// A single lyricalimmval
-					// of type LYRICALIMMVALUE is
-					// guaranteed to have been used.
-					sxt(i->r1, *(u8*)&i->imm->n);
+					afip(i->r1);
 					
 					break;
 					
-				case LYRICALOPSEQ:
+				case LYRICALOPLI:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						seq(i->r1, i->r3);
-						
-					} else {
-						
-						seq(i->r1, i->r2);
-					}
+					ldi(i->r1, 0);
 					
 					break;
 					
-				case LYRICALOPSNE:
+				case LYRICALOPLD8:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						sne(i->r1, i->r3);
-						
-					} else {
-						
-						sne(i->r1, i->r2);
-					}
+					ld8(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSEQI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPLD8R:
 					
-					seqi(i->r1);
+					ld8r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSNEI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPLD8I:
 					
-					snei(i->r1);
+					ld8i(i->r1);
 					
 					break;
 					
-				case LYRICALOPSLT:
+				case LYRICALOPLD16:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						slt(i->r1,i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						
-						sgt(i->r3, i->r2);
-						
-					} else {
-						
-						slt(i->r1, i->r2);
-					}
+					ld16(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSLTE:
+				case LYRICALOPLD16R:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						slte(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						
-						sgte(i->r3, i->r2);
-						
-					} else {
-						
-						slte(i->r1, i->r2);
-					}
+					ld16r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSLTU:
+				case LYRICALOPLD16I:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						sltu(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						
-						sgtu(i->r3, i->r2);
-						
-					} else {
-						
-						sltu(i->r1, i->r2);
-					}
+					ld16i(i->r1);
 					
 					break;
 					
-				case LYRICALOPSLTEU:
+				case LYRICALOPLD32:
 					
-					if (i->r1 != i->r3) {
-						
-						if (i->r1 != i->r2) cpy(i->r1, i->r2);
-						
-						slteu(i->r1, i->r3);
-						
-					} else if (i->r1 != i->r2) {
-						
-						sgteu(i->r3, i->r2);
-						
-					} else {
-						
-						slteu(i->r1, i->r2);
-					}
+					ld32(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSLTI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPLD32R:
 					
-					slti(i->r1);
+					ld32r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSLTEI:
-					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+				case LYRICALOPLD32I:
 					
-					sltei(i->r1);
+					ld32i(i->r1);
 					
 					break;
 					
-				case LYRICALOPSLTUI:
+				case LYRICALOPLD64:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					ld64(i->r1, i->r2);
 					
-					sltui(i->r1);
+					break;
+					
+				case LYRICALOPLD64R:
+					
+					ld64r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSLTEUI:
+				case LYRICALOPLD64I:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					ld64i(i->r1);
 					
-					slteui(i->r1);
+					break;
+					
+				case LYRICALOPST8:
+					
+					st8(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSGTI:
+				case LYRICALOPST8R:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st8r(i->r1, i->r2);
 					
-					sgti(i->r1);
+					break;
+					
+				case LYRICALOPST8I:
+					
+					st8i(i->r1);
 					
 					break;
 					
-				case LYRICALOPSGTEI:
+				case LYRICALOPST16:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st16(i->r1, i->r2);
 					
-					sgtei(i->r1);
+					break;
+					
+				case LYRICALOPST16R:
+					
+					st16r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSGTUI:
+				case LYRICALOPST16I:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st16i(i->r1);
 					
-					sgtui(i->r1);
+					break;
+					
+				case LYRICALOPST32:
+					
+					st32(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSGTEUI:
+				case LYRICALOPST32R:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st32r(i->r1, i->r2);
 					
-					sgteui(i->r1);
+					break;
+					
+				case LYRICALOPST32I:
+					
+					st32i(i->r1);
 					
 					break;
 					
-				case LYRICALOPSZ:
+				case LYRICALOPST64:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st64(i->r1, i->r2);
 					
-					sz(i->r1);
+					break;
+					
+				case LYRICALOPST64R:
+					
+					st64r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPSNZ:
+				case LYRICALOPST64I:
 					
-					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					st64i(i->r1);
 					
-					snz(i->r1);
+					break;
+					
+				case LYRICALOPLDST8:
+					
+					ldst8(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJEQ:
+				case LYRICALOPLDST8R:
 					
-					jeq(i->r1, i->r2);
+					ldst8r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJEQI:
+				case LYRICALOPLDST8I:
 					
-					jeqi(i->r1, i->r2);
+					ldst8i(i->r1);
 					
 					break;
 					
-				case LYRICALOPJEQR:
+				case LYRICALOPLDST16:
 					
-					jeqr(i->r1, i->r2, i->r3);
+					ldst16(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJNE:
+				case LYRICALOPLDST16R:
 					
-					jne(i->r1, i->r2);
+					ldst16r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJNEI:
+				case LYRICALOPLDST16I:
 					
-					jnei(i->r1, i->r2);
+					ldst16i(i->r1);
 					
 					break;
 					
-				case LYRICALOPJNER:
+				case LYRICALOPLDST32:
 					
-					jner(i->r1, i->r2, i->r3);
+					ldst32(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJLT:
+				case LYRICALOPLDST32R:
 					
-					jlt(i->r1, i->r2);
+					ldst32r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJLTI:
+				case LYRICALOPLDST32I:
 					
-					jlti(i->r1, i->r2);
+					ldst32i(i->r1);
 					
 					break;
 					
-				case LYRICALOPJLTR:
+				case LYRICALOPLDST64:
 					
-					jltr(i->r1, i->r2, i->r3);
+					ldst64(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJLTE:
+				case LYRICALOPLDST64R:
 					
-					jlte(i->r1, i->r2);
+					ldst64r(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPJLTEI:
+				case LYRICALOPLDST64I:
 					
-					jltei(i->r1, i->r2);
+					ldst64i(i->r1);
 					
 					break;
 					
-				case LYRICALOPJLTER:
+				case LYRICALOPCAS8:
 					
-					jlter(i->r1, i->r2, i->r3);
+					cas(i->r1, i->r2, i->r3, 1);
 					
 					break;
 					
-				case LYRICALOPJLTU:
+				case LYRICALOPCAS16:
 					
-					jltu(i->r1, i->r2);
+					cas(i->r1, i->r2, i->r3, 2);
 					
 					break;
 					
-				case LYRICALOPJLTUI:
+				case LYRICALOPCAS32:
 					
-					jltui(i->r1, i->r2);
+					cas(i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPJLTUR:
+				case LYRICALOPCAS64:
 					
-					jltur(i->r1, i->r2, i->r3);
+					cas(i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPJLTEU:
+				case LYRICALOPFETCHADD8:
 					
-					jlteu(i->r1, i->r2);
+					fetchadd(i->r1, i->r2, 1, 0);
 					
 					break;
 					
-				case LYRICALOPJLTEUI:
+				case LYRICALOPFETCHADD16:
 					
-					jlteui(i->r1, i->r2);
+					fetchadd(i->r1, i->r2, 2, 0);
 					
 					break;
 					
-				case LYRICALOPJLTEUR:
+				case LYRICALOPFETCHADD32:
 					
-					jlteur(i->r1, i->r2, i->r3);
+					fetchadd(i->r1, i->r2, 4, 0);
 					
 					break;
 					
-				case LYRICALOPJZ:
+				case LYRICALOPFETCHADD64:
 					
-					jz(i->r1);
+					fetchadd(i->r1, i->r2, 8, 0);
 					
 					break;
 					
-				case LYRICALOPJZI:
+				case LYRICALOPFETCHSUB8:
 					
-					jzi(i->r1);
+					fetchadd(i->r1, i->r2, 1, 1);
 					
 					break;
 					
-				case LYRICALOPJZR:
+				case LYRICALOPFETCHSUB16:
 					
-					jzr(i->r1, i->r2);
+					fetchadd(i->r1, i->r2, 2, 1);
 					
 					break;
 					
-				case LYRICALOPJNZ:
+				case LYRICALOPFETCHSUB32:
 					
-					jnz(i->r1);
+					fetchadd(i->r1, i->r2, 4, 1);
 					
 					break;
 					
-				case LYRICALOPJNZI:
+				case LYRICALOPFETCHSUB64:
 					
-					jnzi(i->r1);
+					fetchadd(i->r1, i->r2, 8, 1);
 					
 					break;
 					
-				case LYRICALOPJNZR:
+				case LYRICALOPFETCHAND8:
 					
-					jnzr(i->r1, i->r2);
+					fetchandor(i->r1, i->r2, 1, 0);
 					
 					break;
 					
-				case LYRICALOPJ:
+				case LYRICALOPFETCHAND16:
 					
-					j();
+					fetchandor(i->r1, i->r2, 2, 0);
 					
 					break;
 					
-				case LYRICALOPJI:
+				case LYRICALOPFETCHAND32:
 					
-					ji();
+					fetchandor(i->r1, i->r2, 4, 0);
 					
 					break;
 					
-				case LYRICALOPJR:
+				case LYRICALOPFETCHAND64:
 					
-					jr(i->r1);
+					fetchandor(i->r1, i->r2, 8, 0);
 					
 					break;
 					
-				case LYRICALOPJL:
+				case LYRICALOPFETCHOR8:
 					
-					jl(i->r1);
+					fetchandor(i->r1, i->r2, 1, 1);
 					
 					break;
 					
-				case LYRICALOPJLI:
+				case LYRICALOPFETCHOR16:
 					
-					jli(i->r1);
+					fetchandor(i->r1, i->r2, 2, 1);
 					
 					break;
 					
-				case LYRICALOPJLR:
+				case LYRICALOPFETCHOR32:
 					
-					jlr(i->r1, i->r2);
+					fetchandor(i->r1, i->r2, 4, 1);
 					
 					break;
 					
-				case LYRICALOPJPUSH:
+				case LYRICALOPFETCHOR64:
 					
-					jpush();
+					fetchandor(i->r1, i->r2, 8, 1);
 					
 					break;
 					
-				case LYRICALOPJPUSHI:
+				case LYRICALOPFENCE:
 					
-					jpushi();
+					fence();
 					
 					break;
 					
-				case LYRICALOPJPUSHR:
+				case LYRICALOPVCPY:
 					
-					jpushr(i->r1);
+					vld(XMM0, i->r2);
+					
+					vst(i->r1, XMM0);
 					
 					break;
 					
-				case LYRICALOPJPOP:
+				case LYRICALOPVADD8:
 					
-					jpop();
+					vop(0xfc, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPAFIP:
+				case LYRICALOPVADD16:
 					
-					afip(i->r1);
+					vop(0xfd, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLI:
+				case LYRICALOPVADD32:
 					
-					ldi(i->r1, 0);
+					vop(0xfe, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD8:
+				case LYRICALOPVADD64:
 					
-					ld8(i->r1, i->r2);
+					vop(0xd4, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD8R:
+				case LYRICALOPVSUB8:
 					
-					ld8r(i->r1, i->r2);
+					vop(0xf8, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD8I:
+				case LYRICALOPVSUB16:
 					
-					ld8i(i->r1);
+					vop(0xf9, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD16:
+				case LYRICALOPVSUB32:
 					
-					ld16(i->r1, i->r2);
+					vop(0xfa, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD16R:
+				case LYRICALOPVSUB64:
 					
-					ld16r(i->r1, i->r2);
+					vop(0xfb, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD16I:
+				case LYRICALOPVAND:
 					
-					ld16i(i->r1);
+					vop(0xdb, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD32:
+				case LYRICALOPVOR:
 					
-					ld32(i->r1, i->r2);
+					vop(0xeb, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD32R:
+				case LYRICALOPVXOR:
 					
-					ld32r(i->r1, i->r2);
+					vop(0xef, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD32I:
+				case LYRICALOPVCMPEQ8:
 					
-					ld32i(i->r1);
+					vop(0x74, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD64:
+				case LYRICALOPVCMPEQ16:
 					
-					ld64(i->r1, i->r2);
+					vop(0x75, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD64R:
+				case LYRICALOPVCMPEQ32:
 					
-					ld64r(i->r1, i->r2);
+					vop(0x76, i->r1, i->r2, i->r3);
 					
 					break;
 					
-				case LYRICALOPLD64I:
+				case LYRICALOPVMOVMSK8:
 					
-					ld64i(i->r1);
+					vmovmsk8(i->r1, i->r2);
 					
 					break;
 					
-				case LYRICALOPST8:
+				case LYRICALOPVBCAST8:
 					
-					st8(i->r1, i->r2);
+					vbcast(i->r1, i->r2, 1);
 					
 					break;
 					
-				case LYRICALOPST8R:
+				case LYRICALOPVBCAST16:
 					
-					st8r(i->r1, i->r2);
+					vbcast(i->r1, i->r2, 2);
 					
 					break;
 					
-				case LYRICALOPST8I:
+				case LYRICALOPVBCAST32:
 					
-					st8i(i->r1);
+					vbcast(i->r1, i->r2, 4);
 					
 					break;
 					
-				case LYRICALOPST16:
+				case LYRICALOPVBCAST64:
 					
-					st16(i->r1, i->r2);
+					vbcast(i->r1, i->r2, 8);
 					
 					break;
 					
-				case LYRICALOPST16R:
+				case LYRICALOPFADD32:
 					
-					st16r(i->r1, i->r2);
+					fop(0x58, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPST16I:
+				case LYRICALOPFADD64:
 					
-					st16i(i->r1);
+					fop(0x58, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPST32:
+				case LYRICALOPFSUB32:
 					
-					st32(i->r1, i->r2);
+					fop(0x5c, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPST32R:
+				case LYRICALOPFSUB64:
 					
-					st32r(i->r1, i->r2);
+					fop(0x5c, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPST32I:
+				case LYRICALOPFMUL32:
 					
-					st32i(i->r1);
+					fop(0x59, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPST64:
+				case LYRICALOPFMUL64:
 					
-					st64(i->r1, i->r2);
+					fop(0x59, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPST64R:
+				case LYRICALOPFDIV32:
 					
-					st64r(i->r1, i->r2);
+					fop(0x5e, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPST64I:
+				case LYRICALOPFDIV64:
 					
-					st64i(i->r1);
+					fop(0x5e, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPLDST8:
+				case LYRICALOPFEQ32:
 					
-					ldst8(i->r1, i->r2);
+					fcmp(0, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPLDST8R:
+				case LYRICALOPFEQ64:
 					
-					ldst8r(i->r1, i->r2);
+					fcmp(0, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPLDST8I:
+				case LYRICALOPFLT32:
 					
-					ldst8i(i->r1);
+					fcmp(1, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPLDST16:
+				case LYRICALOPFLT64:
 					
-					ldst16(i->r1, i->r2);
+					fcmp(1, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPLDST16R:
+				case LYRICALOPFLTE32:
 					
-					ldst16r(i->r1, i->r2);
+					fcmp(2, i->r1, i->r2, i->r3, 4);
 					
 					break;
 					
-				case LYRICALOPLDST16I:
+				case LYRICALOPFLTE64:
 					
-					ldst16i(i->r1);
+					fcmp(2, i->r1, i->r2, i->r3, 8);
 					
 					break;
 					
-				case LYRICALOPLDST32:
+				case LYRICALOPITOF32:
 					
-					ldst32(i->r1, i->r2);
+					itof(i->r1, i->r2, 4);
 					
 					break;
 					
-				case LYRICALOPLDST32R:
+				case LYRICALOPITOF64:
 					
-					ldst32r(i->r1, i->r2);
+					itof(i->r1, i->r2, 8);
 					
 					break;
 					
-				case LYRICALOPLDST32I:
+				case LYRICALOPF32TOI:
 					
-					ldst32i(i->r1);
+					ftoi(i->r1, i->r2, 4);
 					
 					break;
 					
-				case LYRICALOPLDST64:
+				case LYRICALOPF64TOI:
 					
-					ldst64(i->r1, i->r2);
+					ftoi(i->r1, i->r2, 8);
 					
 					break;
 					
-				case LYRICALOPLDST64R:
+				case LYRICALOPF32TOF64:
 					
-					ldst64r(i->r1, i->r2);
+					ftof(i->r1, i->r2, 4);
 					
 					break;
 					
-				case LYRICALOPLDST64I:
+				case LYRICALOPF64TOF32:
 					
-					ldst64i(i->r1);
+					ftof(i->r1, i->r2, 8);
 					
 					break;
 					
@@ -11970,6 +12381,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM8CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u8), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -11998,6 +12413,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM8CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u8), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -12026,6 +12445,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM16CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u16), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -12054,6 +12477,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM16CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u16), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -12075,6 +12502,70 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 				}
 				
+				case LYRICALOPMEM32CPY:
+					
+					mem32cpy(i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPMEM32CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u32), 0)) break;
+					
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(RCX);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					// Mark unused register as temporarily used.
+					regsinusetmp[unusedreg] = 1;
+					
+					ldi(unusedreg, 0);
+					
+					mem32cpy(i->r1, i->r2, unusedreg);
+					
+					// Unmark register as temporarily used.
+					regsinusetmp[unusedreg] = 0;
+				
+					break;
+				}
+				
+				case LYRICALOPMEM32CPY2:
+					
+					mem32cpy2(i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPMEM32CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u32), 1)) break;
+					
+					// Look for an unused register.
+					uint unusedreg = findunusedreg(RCX);
+					
+					// The compiler should have insured
+					// that there are enough unused
+					// registers available.
+					if (!unusedreg) throwerror();
+					
+					// Mark unused register as temporarily used.
+					regsinusetmp[unusedreg] = 1;
+					
+					ldi(unusedreg, 0);
+					
+					mem32cpy2(i->r1, i->r2, unusedreg);
+					
+					// Unmark register as temporarily used.
+					regsinusetmp[unusedreg] = 0;
+				
+					break;
+				}
+				
 				case LYRICALOPMEM64CPY:
 					
 					mem64cpy(i->r1, i->r2, i->r3);
@@ -12082,6 +12573,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM64CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u64), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -12110,6 +12605,10 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM64CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u64), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(RCX);
 					
@@ -12255,8 +12754,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					loadimm(R9, 0); // offset.
 					
 					// Append the instruction SYSCALL.
-					*arrayu8append1(&b->binary) = 0x0f;
-					*arrayu8append1(&b->binary) = 0x05;
+					*binaryappend1() = 0x0f;
+					*binaryappend1() = 0x05;
 					
 					if (r1 != RAX) cpy(r1, RAX);
 					
@@ -12418,6 +12917,66 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						savereg(R11); r11wassaved = 1;
 					} else regsinusetmp[R11] = 1; // Mark unused register as temporarily used.
 					
+					// Offsets of the 32bits immediate
+					// fields of the branching instructions
+					// used with the stack page pool.
+					uint poolemptyimm, pooldoneimm;
+					
+					if (i->op == LYRICALOPSTACKPAGEALLOC) {
+						// I generate the instructions which
+						// take a page from the stack page pool
+						// if it is not empty; %RDI is set to
+						// the address of the stack page pool
+						// and %RAX to the page taken.
+						
+						afip(RDI);
+						
+						// Specification from the Intel manual.
+						// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+						// REX.W 85 /r	TEST r/m64,r64		#AND r64 with r/m64; set SF, ZF, PF according to result.
+						// 0F 84 cd	JE rel32		#Jump near if equal (ZF=1).
+						// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+						// REX.W FF /1	DEC r/m64		#Decrement r/m64 by 1.
+						// REX.W FF /0	INC r/m64		#Increment r/m64 by 1.
+						// E9 cd	JMP rel32		#Jump near, relative.
+						
+						// mov %RAX, [%RDI];
+						*binaryappend1() = 0x48; *binaryappend1() = 0x8b; *binaryappend1() = 0x07;
+						
+						// test %RAX, %RAX;
+						*binaryappend1() = 0x48; *binaryappend1() = 0x85; *binaryappend1() = 0xc0;
+						
+						// je poolempty;
+						*binaryappend1() = 0x0f; *binaryappend1() = 0x84;
+						poolemptyimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// mov %RSI, [%RAX];
+						*binaryappend1() = 0x48; *binaryappend1() = 0x8b; *binaryappend1() = 0x30;
+						
+						// mov [%RDI], %RSI;
+						*binaryappend1() = 0x48; *binaryappend1() = 0x89; *binaryappend1() = 0x37;
+						
+						// dec qword [%RDI+8];
+						*binaryappend1() = 0x48; *binaryappend1() = 0xff; *binaryappend1() = 0x4f; *binaryappend1() = 8;
+						
+						// inc qword [%RDI+16];
+						*binaryappend1() = 0x48; *binaryappend1() = 0xff; *binaryappend1() = 0x47; *binaryappend1() = 16;
+						
+						// jmp pooldone;
+						*binaryappend1() = 0xe9;
+						pooldoneimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// poolempty:
+						*(u32*)(binaryptr() + poolemptyimm) = (b->binarysz - (poolemptyimm + sizeof(u32)));
+						
+						// The address of the stack page pool
+						// is needed after the syscall, which
+						// use %RDI for its first argument.
+						push(RDI);
+					}
+					
 					// Generate the instructions
 					// to use the syscall mmap():
 					// void* mmap(void* addr, uint length, uint prot,
@@ -12425,15 +12984,77 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					
 					loadimm(RAX, 9); // syscall mmap().
 					loadimm(RDI, 0); // addr.
-					loadimm(RSI, (i->op == LYRICALOPSTACKPAGEALLOC) ? PAGESIZE : ((*(u64*)&i->imm->n)*PAGESIZE)); // length.
+					loadimm(RSI, (i->op == LYRICALOPSTACKPAGEALLOC) ? (STACKPAGEBATCH*PAGESIZE) : ((*(u64*)&i->imm->n)*PAGESIZE)); // length.
 					loadimm(RDX, PROT_READ|PROT_WRITE); // prot.
 					loadimm(R10, MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED|((i->op == LYRICALOPSTACKPAGEALLOC) ? MAP_STACK : 0)); // flags.
 					loadimm(R8, 0); // fd.
 					loadimm(R9, 0); // offset.
 					
 					// Append the instruction SYSCALL.
-					*arrayu8append1(&b->binary) = 0x0f;
-					*arrayu8append1(&b->binary) = 0x05;
+					*binaryappend1() = 0x0f;
+					*binaryappend1() = 0x05;
+					
+					if (i->op == LYRICALOPSTACKPAGEALLOC) {
+						// I generate the instructions which
+						// count the pages allocated using
+						// the syscall, and which add to
+						// the stack page pool the pages
+						// allocated beside the first one.
+						
+						pop(RDI);
+						
+						// Specification from the Intel manual.
+						// REX.W FF /0	INC r/m64		#Increment r/m64 by 1.
+						// REX.W 85 /r	TEST r/m64,r64		#AND r64 with r/m64; set SF, ZF, PF according to result.
+						// 78 cb	JS rel8			#Jump short if sign (SF=1).
+						// REX.W 8D /r	LEA r64,m		#Store effective address for m in register r64.
+						// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+						// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+						// REX.W 83 /0 ib	ADD r/m64,imm8		#Add sign-extended imm8 to r/m64.
+						
+						// inc qword [%RDI+24];
+						*binaryappend1() = 0x48; *binaryappend1() = 0xff; *binaryappend1() = 0x47; *binaryappend1() = 24;
+						
+						if (STACKPAGEBATCH > 1) {
+							// test %RAX, %RAX;
+							*binaryappend1() = 0x48; *binaryappend1() = 0x85; *binaryappend1() = 0xc0;
+							
+							// js pooldone;
+							*binaryappend1() = 0x78;
+							uint imm = b->binarysz;
+							binaryappend1();
+							
+							uint opstart = b->binarysz;
+							
+							uint n = STACKPAGEBATCH-1;
+							
+							do {
+								// lea %RSI, [%RAX+(n*PAGESIZE)];
+								*binaryappend1() = 0x48; *binaryappend1() = 0x8d; *binaryappend1() = 0xb0;
+								*(u32*)binaryappend2(sizeof(u32)) = (n*PAGESIZE);
+								
+								// mov %RDX, [%RDI];
+								*binaryappend1() = 0x48; *binaryappend1() = 0x8b; *binaryappend1() = 0x17;
+								
+								// mov [%RSI], %RDX;
+								*binaryappend1() = 0x48; *binaryappend1() = 0x89; *binaryappend1() = 0x16;
+								
+								// mov [%RDI], %RSI;
+								*binaryappend1() = 0x48; *binaryappend1() = 0x89; *binaryappend1() = 0x37;
+								
+							} while (--n);
+							
+							// add qword [%RDI+8], STACKPAGEBATCH-1;
+							*binaryappend1() = 0x48; *binaryappend1() = 0x83; *binaryappend1() = 0x47; *binaryappend1() = 8;
+							*binaryappend1() = (STACKPAGEBATCH-1);
+							
+							// Set the 8bits immediate field appended above.
+							binaryptr()[imm] = (b->binarysz - opstart);
+						}
+						
+						// pooldone:
+						*(u32*)(binaryptr() + pooldoneimm) = (b->binarysz - (pooldoneimm + sizeof(u32)));
+					}
 					
 					if (r1 != RAX) cpy(r1, RAX);
 					
@@ -12582,8 +13203,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					loadimm(RAX, 11); // syscall munmap().
 					
 					// Append the instruction SYSCALL.
-					*arrayu8append1(&b->binary) = 0x0f;
-					*arrayu8append1(&b->binary) = 0x05;
+					*binaryappend1() = 0x0f;
+					*binaryappend1() = 0x05;
 					
 					if (r11wassaved) {
 						// Restore register value.
@@ -12659,6 +13280,59 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 						savereg(RSI); rsiwassaved = 1;
 					} else regsinusetmp[RSI] = 1; // Mark unused register as temporarily used.
 					
+					// Offset of the 32bits immediate
+					// field of the branching instruction
+					// used with the stack page pool.
+					uint pooldoneimm;
+					
+					if (i->op == LYRICALOPSTACKPAGEFREE) {
+						// I generate the instructions which
+						// add the page to the stack page pool
+						// if it is not full; %RAX is set to
+						// the address of the stack page pool.
+						
+						afip(RAX);
+						
+						// Specification from the Intel manual.
+						// REX.W 83 /7 ib	CMP r/m64,imm8		#Compare imm8 with r/m64.
+						// 73 cb	JAE rel8		#Jump short if above or equal (CF=0).
+						// REX.W 8B /r	MOV r64,r/m64		#Move r/m64 to r64.
+						// REX.W 89 /r	MOV r/m64,r64		#Move r64 to r/m64.
+						// REX.W FF /0	INC r/m64		#Increment r/m64 by 1.
+						// E9 cd	JMP rel32		#Jump near, relative.
+						
+						// cmp qword [%RAX+8], STACKPAGEPOOLMAX;
+						*binaryappend1() = 0x48; *binaryappend1() = 0x83; *binaryappend1() = 0x78; *binaryappend1() = 8;
+						*binaryappend1() = STACKPAGEPOOLMAX;
+						
+						// jae poolfull;
+						*binaryappend1() = 0x73;
+						uint imm = b->binarysz;
+						binaryappend1();
+						
+						uint opstart = b->binarysz;
+						
+						// mov %RSI, [%RAX];
+						*binaryappend1() = 0x48; *binaryappend1() = 0x8b; *binaryappend1() = 0x30;
+						
+						// mov [%RDI], %RSI;
+						*binaryappend1() = 0x48; *binaryappend1() = 0x89; *binaryappend1() = 0x37;
+						
+						// mov [%RAX], %RDI;
+						*binaryappend1() = 0x48; *binaryappend1() = 0x89; *binaryappend1() = 0x38;
+						
+						// inc qword [%RAX+8];
+						*binaryappend1() = 0x48; *binaryappend1() = 0xff; *binaryappend1() = 0x40; *binaryappend1() = 8;
+						
+						// jmp pooldone;
+						*binaryappend1() = 0xe9;
+						pooldoneimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// poolfull:
+						binaryptr()[imm] = (b->binarysz - opstart);
+					}
+					
 					// Compute in RSI the byte count
 					// equivalent of the page count.
 					loadimm(RSI, (i->op == LYRICALOPSTACKPAGEFREE) ? PAGESIZE : ((*(u64*)&i->imm->n)*PAGESIZE));
@@ -12682,8 +13356,8 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					loadimm(RAX, 11); // syscall munmap().
 					
 					// Append the instruction SYSCALL.
-					*arrayu8append1(&b->binary) = 0x0f;
-					*arrayu8append1(&b->binary) = 0x05;
+					*binaryappend1() = 0x0f;
+					*binaryappend1() = 0x05;
 					
 					if (r11wassaved) {
 						// Restore register value.
@@ -12697,6 +13371,11 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					// Unmark register as temporarily used if it was marked.
 					} else regsinusetmp[RCX] = 0;
 					
+					if (i->op == LYRICALOPSTACKPAGEFREE) {
+						// pooldone:
+						*(u32*)(binaryptr() + pooldoneimm) = (b->binarysz - (pooldoneimm + sizeof(u32)));
+					}
+					
 					if (rsiwassaved) {
 						// Restore register value.
 						restorereg(RSI);
@@ -12823,18 +13502,18 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					// REX.W 83 /0 ib     ADD r/m64, imm8         #Add sign-extended imm8 to r/m64.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x48;
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x48;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					// From the most significant bit to the least significant bit.
 					// MOD == 0b11;
 					// REG == op[2:0]; #Only the 3 least significant bits matters.
 					// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-					*arrayu8append1(&b->binary) = ((0b11<<6)|lookupreg(RSP));
+					*binaryappend1() = ((0b11<<6)|lookupreg(RSP));
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = (1*sizeof(u64));
+					*binaryappend1() = (1*sizeof(u64));
 					
 					// Unmark register as temporarily used if it was marked.
 					if (r9wassetused) regsinusetmp[R9] = 0;
@@ -12966,18 +13645,18 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m64, imm8         #Add sign-extended imm8 to r/m64.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x48;
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x48;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					// From the most significant bit to the least significant bit.
 					// MOD == 0b11;
 					// REG == op[2:0]; #Only the 3 least significant bits matters.
 					// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-					*arrayu8append1(&b->binary) = ((0b11<<6)|lookupreg(RSP));
+					*binaryappend1() = ((0b11<<6)|lookupreg(RSP));
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = (1*sizeof(u64));
+					*binaryappend1() = (1*sizeof(u64));
 					
 					// Unmark register as temporarily used if it was marked.
 					if (r9wassetused) regsinusetmp[R9] = 0;
@@ -13180,7 +13859,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					uint iopmachinecodesz = stringmmsz(i->opmachinecode);
 					
 					bytcpy(
-						arrayu8append2(&b->binary, iopmachinecodesz),
+						binaryappend2(iopmachinecodesz),
 						i->opmachinecode.ptr,
 						iopmachinecodesz);
 					
@@ -13202,9 +13881,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 					throwerror();
 			}
 			
-			skipredo:;
-			
-			uint bbinarysz = arrayu8sz(b->binary);
+			uint bbinarysz = b->binarysz;
 			
 			uint ibinsz = i->binsz;
 			
@@ -13223,31 +13900,348 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 				}
 			}
 			
-			b->binaryoffset = executableinstrsz;
+			if (toredo.ptr) {
+				// Update the size of the binary
+				// in the layout; its offset, as well
+				// as the offset of the binaries that
+				// follow, get recomputed later.
+				layoutsz.ptr[b->layoutidx] = bbinarysz;
+				
+				// The lyricalinstruction to redo
+				// are stored in the order in which
+				// they get laid out, hence the first
+				// one redone is the lowest index from
+				// where offsets must be recomputed.
+				if (!toredoidx) layoutdirtyidx = b->layoutidx;
+				
+				toredoidx += 2;
+				
+				// Stop when there are no more
+				// lyricalinstruction to redo
+				// within the current lyricalfunction.
+				if (toredoidx >= arrayu64sz(toredo) ||
+					(lyricalfunction*)toredo.ptr[toredoidx] != f)
+					break;
+					
+				i = (lyricalinstruction*)toredo.ptr[toredoidx+1];
+				
+			} else {
+				
+				b->layoutidx = layoutidx;
+				
+				layoutinstr.ptr[layoutidx] = (uint)i;
+				layoutsz.ptr[layoutidx] = bbinarysz;
+				
+				++layoutidx;
+				
+				if ((i = i->next) == f->i->next) break;
+			}
+		}
+		
+	} while (toredo.ptr ?
+		((toredoidx < arrayu64sz(toredo)) && (f = (lyricalfunction*)toredo.ptr[toredoidx])) :
+		((f = f->next) != compileresult.rootfunc));
+		
+	if (toredo.ptr) {
+		
+		mmfree(toredo.ptr);
+		
+		toredo = arrayu64null;
+		
+		toredoidx = 0;
+		
+		wasredone = 1;
+		
+		f = compileresult.rootfunc;
+		
+	} else if (codealign) {
+		// Mark the lyricalinstruction which
+		// executable binary must be aligned;
+		// it is done once all lyricalinstruction
+		// have been laid out, so that whether
+		// a branching instruction target a
+		// lyricalinstruction laid out before
+		// it can be determined from layoutidx.
+		do {
+			// Note that f->i is always non-null,
+			// so there is no need to check it.
+			
+			// The first instruction of
+			// a lyricalfunction is always
+			// aligned since it is its entry.
+			((backenddata*)f->i->next->backenddata)->isaligned = 1;
 			
-			// Report in the lyricalcompileresult,
-			// the offset of the binary generated
-			// for the lyricalinstruction.
-			i->dbginfo.binoffset = executableinstrsz;
+			i = f->i->next;
 			
-			executableinstrsz += bbinarysz;
+			do {
+				// All branching lyricalop are between
+				// LYRICALOPJEQ and LYRICALOPJPOP; a branching
+				// instruction which target a lyricalinstruction
+				// that is not after it, is the end of a loop
+				// which head is that lyricalinstruction.
+				if (i->op >= LYRICALOPJEQ && i->op <= LYRICALOPJPOP &&
+					i->imm && i->imm->type == LYRICALIMMOFFSETTOINSTRUCTION) {
+					
+					backenddata* target = i->imm->i->backenddata;
+					
+					if (target->layoutidx <= ((backenddata*)i->backenddata)->layoutidx)
+						target->isaligned = 1;
+				}
+				
+			} while ((i = i->next) != f->i->next);
 			
-			if ((i = i->next) == f->i->next) break;
-		}
+		} while ((f = f->next) != compileresult.rootfunc);
+	}
+	
+	// When I get here f == compileresult.rootfunc;
+	
+	// Recompute the offset of the binary
+	// of each lyricalinstruction starting
+	// from the lowest index in the layout
+	// that had its size changed; since
+	// sizes only ever grow, it is the only
+	// place from where offsets can change.
+	uint executableinstrsz = (layoutdirtyidx ?
+		(((backenddata*)((lyricalinstruction*)layoutinstr.ptr[layoutdirtyidx-1])->backenddata)->binaryoffset +
+			layoutsz.ptr[layoutdirtyidx-1]) : 0);
+			
+	for (uint n = layoutdirtyidx; n < layoutinstrsz; ++n) {
+		
+		i = (lyricalinstruction*)layoutinstr.ptr[n];
+		
+		// The gap created by the alignment
+		// get filled with no-operation
+		// instructions once every binary
+		// has been moved to its final offset.
+		if (((backenddata*)i->backenddata)->isaligned)
+			executableinstrsz = ROUNDUPTOPOWEROFTWO(executableinstrsz, codealign);
+			
+		((backenddata*)i->backenddata)->binaryoffset = executableinstrsz;
+		
+		// Report in the lyricalcompileresult,
+		// the offset of the binary generated
+		// for the lyricalinstruction.
+		i->dbginfo.binoffset = executableinstrsz;
+		
+		executableinstrsz += layoutsz.ptr[n];
+	}
+	
+	layoutdirtyidx = layoutinstrsz;
+	
+	uint compileresultstringregionsz = arrayu8sz(compileresult.stringregion);
+	
+	// Sizes of the instructions to execute
+	// and constant strings, aligned as they
+	// will be assumed by the instructions
+	// to execute when resolving immediates.
+	uint alignedexecutableinstrsz;
+	uint alignedconstantstringssz;
+	
+	if (flag&(LYRICALBACKENDX64PAGEALIGNED|LYRICALBACKENDX64COMPACTPAGEALIGNED)) {
+		
+		alignedexecutableinstrsz = ROUNDUPTOPOWEROFTWO(executableinstrsz, 0x1000); // Aligning to pagesize.
+		
+		alignedconstantstringssz = ROUNDUPTOPOWEROFTWO(compileresultstringregionsz, 0x1000); // Aligning to pagesize.
+		
+	} else {
+		
+		alignedexecutableinstrsz = ROUNDUPTOPOWEROFTWO(executableinstrsz, 4); // Aligning to 4bytes.
+		
+		alignedconstantstringssz = ROUNDUPTOPOWEROFTWO(compileresultstringregionsz, 4); // Aligning to 4bytes.
+	}
+	
+	// Function which return the
+	// resolved value of the immediate2
+	// of the lyricalinstruction pointed
+	// by i, which is always the offset
+	// to the sys field located right after
+	// the fields arg and env which are at
+	// the top of the global variable region.
+	u64 resolveimm2 () {
+		// Calculate the relative address
+		// from the next instruction.
+		return (b->imm2miscvalue +
+			((alignedexecutableinstrsz + alignedconstantstringssz + (2*sizeof(u64))) -
+				(b->binaryoffset + b->imm2fieldoffset +
+					((b->isimm2used == IMM64) ? sizeof(u64) :
+						(b->isimm2used == IMM32) ? sizeof(u32) :
+						sizeof(u8)))));
+	}
+	
+	// Function which return the
+	// resolved value of the immediate
+	// of the lyricalinstruction pointed by i.
+	u64 resolveimm () {
+		// This variable will hold the value
+		// of the immediate value to return.
+		u64 immvalue = b->immmiscvalue;
+		
+		// Offset of the end of the immediate
+		// field, from where relative addresses
+		// are calculated.
+		uint immfieldend = (b->binaryoffset + b->immfieldoffset +
+			((b->isimmused == IMM64) ? sizeof(u64) :
+				(b->isimmused == IMM32) ? sizeof(u32) :
+				sizeof(u8)));
+				
+		lyricalimmval* imm = i->imm;
+		
+		// When calculating relative addresses
+		// from the next instruction, there is no
+		// need to check whether there is a next
+		// instruction because, there will always
+		// be at least the instruction used
+		// to return from the function.
+		
+		do {
+			switch (imm->type) {
+				
+				case LYRICALIMMVALUE:
+					
+					immvalue += *(u64*)&imm->n;
+					
+					break;
+					
+				case LYRICALIMMOFFSETTOINSTRUCTION:
+					// Calculate the relative address
+					// from the next instruction.
+					immvalue += (((backenddata*)imm->i->backenddata)->binaryoffset - immfieldend);
+					
+					break;
+					
+				case LYRICALIMMOFFSETTOFUNCTION:
+					// Calculate the relative address
+					// from the next instruction.
+					// Note that the field i of
+					// an lyricalfunction always
+					// points to the last instruction
+					// generated, so to get to
+					// the first instruction generated,
+					// I use the field next since
+					// the instructions of an lyricalfunction
+					// pointed by their field i
+					// form a circular linkedlist.
+					immvalue += (((backenddata*)imm->f->i->next->backenddata)->binaryoffset - immfieldend);
+					
+					break;
+					
+				case LYRICALIMMOFFSETTOGLOBALREGION:
+					// Calculate the relative address
+					// from the next instruction.
+					immvalue += ((alignedexecutableinstrsz + alignedconstantstringssz) - immfieldend);
+					
+					break;
+					
+				case LYRICALIMMOFFSETTOSTRINGREGION:
+					// Calculate the relative address
+					// from the next instruction.
+					immvalue += (alignedexecutableinstrsz - immfieldend);
+					
+					break;
+			}
+			
+		} while (imm = imm->next);
+		
+		return immvalue;
+	}
+	
+	// Function which return the
+	// immediate size to use in order
+	// to encode the value given as argument,
+	// never choosing a size smaller than
+	// the immediate size given as argument.
+	uint immsizeneeded (u64 immvalue, uint immsize) {
+		
+		u64 absimmvalue = (((sint)immvalue < 0) ? -immvalue : immvalue);
+		
+		if (immsize == IMM8 && absimmvalue < (1 << 7)) return IMM8;
+		
+		if (immsize != IMM64 && absimmvalue < ((u64)1 << 31)) return IMM32;
+		
+		return IMM64;
+	}
+	
+	// Check whether every immediate
+	// can be encoded using the size
+	// that was chosen for it; all
+	// immediates start with the smallest
+	// size, and only the lyricalinstruction
+	// which immediate cannot fit get their
+	// immediate size increased and get redone.
+	do {
+		// Note that f->i is always non-null,
+		// so there is no need to check it.
+		
+		// Note that f->i point to the last
+		// intruction that was generated and
+		// f->i->next point to the first
+		// instruction generated.
+		i = f->i->next;
+		
+		do {
+			b = (backenddata*)i->backenddata;
+			
+			uint toredoi = 0;
+			
+			if (b->isimm2used) {
+				
+				uint immsize = immsizeneeded(resolveimm2(), b->isimm2used);
+				
+				if (immsize != b->isimm2used) {
+					// I set the backenddata
+					// so that a larger offset
+					// get used instead when
+					// the lyricalinstruction
+					// will be redone.
+					b->isimm2used = immsize;
+					
+					toredoi = 1;
+				}
+			}
+			
+			if (b->isimmused) {
+				
+				uint immsize = immsizeneeded(resolveimm(), b->isimmused);
+				
+				if (immsize != b->isimmused) {
+					// I set the backenddata
+					// so that a larger immediate
+					// get used instead when
+					// the lyricalinstruction
+					// will be redone.
+					b->isimmused = immsize;
+					
+					toredoi = 1;
+				}
+			}
+			
+			if (toredoi) {
+				// I save the lyricalinstruction* to redo.
+				*arrayu64append1(&toredo) = (uint)f;
+				*arrayu64append1(&toredo) = (uint)i;
+			}
+			
+			i = i->next;
+			
+		} while (i != f->i->next);
 		
 	} while ((f = f->next) != compileresult.rootfunc);
 	
 	// When I get here f == compileresult.rootfunc;
 	
-	if (toredo.ptr) {
-		bintreeempty(&toredo);
-	}
+	// Redo only the lyricalinstruction
+	// which immediate did not fit; the
+	// offsets get recomputed afterward,
+	// and immediates get checked again,
+	// until every immediate fit.
+	if (toredo.ptr) goto redo;
+	
+	mmfree(layoutinstr.ptr);
+	mmfree(layoutsz.ptr);
 	
 	// Variable to return.
 	lyricalbackendx64result* retvar = mmalloc(sizeof(lyricalbackendx64result));
 	
-	uint compileresultstringregionsz = arrayu8sz(compileresult.stringregion);
-	
 	// Constant strings region size
 	// which will be aligned and used
 	// to generate the executable binary.
@@ -13270,10 +14264,104 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		constantstringssz = ROUNDUPTOPOWEROFTWO(constantstringssz, 4); // Aligning to 4bytes.
 	}
 	
-	// I allocate memory for
-	// the executable binary
-	// to return.
-	retvar->execbin.ptr = mmalloc(executableinstrsz + constantstringssz);
+	// The buffer in which instructions
+	// were emitted is resized to become
+	// the executable binary to return.
+	retvar->execbin.ptr = mmrealloc(codebuf.ptr, executableinstrsz + constantstringssz);
+	
+	// Function which fill with
+	// no-operation instructions,
+	// the gap of size sz pointed by ptr;
+	// multi-byte no-operation instructions
+	// are used so that as few instructions
+	// as possible get decoded when
+	// executing through the gap.
+	void fillwithnop (u8* ptr, uint sz) {
+		// Specification from the Intel manual.
+		// 90				NOP		#One byte no-operation instruction.
+		// 66 90			NOP		#Two bytes no-operation instruction.
+		// 0F 1F 00			NOP DWORD ptr [EAX]		#Three bytes no-operation instruction.
+		// 0F 1F 40 00			NOP DWORD ptr [EAX + 00H]		#Four bytes no-operation instruction.
+		// 0F 1F 44 00 00		NOP DWORD ptr [EAX + EAX*1 + 00H]		#Five bytes no-operation instruction.
+		// 66 0F 1F 44 00 00		NOP WORD ptr [EAX + EAX*1 + 00H]		#Six bytes no-operation instruction.
+		// 0F 1F 80 00 00 00 00		NOP DWORD ptr [EAX + 00000000H]		#Seven bytes no-operation instruction.
+		// 0F 1F 84 00 00 00 00 00	NOP DWORD ptr [EAX + EAX*1 + 00000000H]		#Eight bytes no-operation instruction.
+		// 66 0F 1F 84 00 00 00 00 00	NOP WORD ptr [EAX + EAX*1 + 00000000H]		#Nine bytes no-operation instruction.
+		
+		static u8 nops[9][9] = {
+			{0x90},
+			{0x66, 0x90},
+			{0x0f, 0x1f, 0x00},
+			{0x0f, 0x1f, 0x40, 0x00},
+			{0x0f, 0x1f, 0x44, 0x00, 0x00},
+			{0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00},
+			{0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00},
+			{0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+			{0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+		};
+		
+		while (sz) {
+			
+			uint nopsz = ((sz > 9) ? 9 : sz);
+			
+			bytcpy(ptr, nops[nopsz-1], nopsz);
+			
+			ptr += nopsz;
+			sz -= nopsz;
+		}
+	}
+	
+	if (wasredone || codealign) {
+		// Move the executable binary of
+		// each instruction to its final offset,
+		// starting from the last instruction;
+		// since sizes only ever grow, and
+		// alignment only ever add gaps, the final
+		// offset of an instruction is never lower
+		// than where it was emitted, hence moving
+		// from the last instruction never overwrite
+		// bytes that have yet to be moved.
+		uint n = layoutinstrsz;
+		
+		// Offset where the executable binary
+		// of the instruction moved last start;
+		// the gap between the end of the
+		// executable binary of the instruction
+		// being moved and that offset is filled
+		// with no-operation instructions.
+		uint nextbinaryoffset = retvar->executableinstrsz;
+		
+		while (n) {
+			
+			b = &backenddatas[--n];
+			
+			if (b->redobinary.ptr) {
+				
+				bytcpy(retvar->execbin.ptr + b->binaryoffset, b->redobinary.ptr, b->binarysz);
+				
+				mmfree(b->redobinary.ptr);
+				
+				b->redobinary = arrayu8null;
+				
+			} else if (b->codeoffset != b->binaryoffset)
+				bytcpy(retvar->execbin.ptr + b->binaryoffset, retvar->execbin.ptr + b->codeoffset, b->binarysz);
+				
+			b->codeoffset = b->binaryoffset;
+			
+			uint binaryend = b->binaryoffset + b->binarysz;
+			
+			// Every executable binary that
+			// could still be moved is located
+			// before binaryend, hence the gap
+			// can be filled right away.
+			if (binaryend < nextbinaryoffset)
+				fillwithnop(retvar->execbin.ptr + binaryend, nextbinaryoffset - binaryend);
+				
+			nextbinaryoffset = b->binaryoffset;
+		}
+	}
+	
+	codebuf.ptr = retvar->execbin.ptr;
 	
 	// Copy the constant strings to the result.
 	bytcpy(
@@ -13291,6 +14379,29 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	retvar->exportinfo = arrayu8null;
 	retvar->importinfo = arrayu8null;
 	
+	// Array which will hold
+	// section1 debug information.
+	arrayu64 dbginfosection1;
+	
+	// Array which will hold
+	// pointers to strings for
+	// section2 debug information.
+	arrayu64 dbginfosection2;
+	// Variable which store the total length
+	// of all strings for which the pointers
+	// are stored in dbginfosection2.
+	uint dbginfosection2len = 0;
+	
+	dbginfosection1 = arrayu64null;
+	
+	// Reserve space at the top
+	// for storing the byte usage
+	// of section1 debug information.
+	*arrayu64append1(&dbginfosection1) = 0;
+	
+	dbginfosection2 = arrayu64null;
+	
+	
 	// Variable used to save the linenumber of
 	// the last debug information entry generated.
 	// It is also used to determine whether
@@ -13354,294 +14465,40 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		do {
 			b = (backenddata*)i->backenddata;
 			
+			// Function which write the immediate
+			// value given as argument at the location
+			// given by immfieldoffset, within the binary
+			// of the instruction, using the immediate
+			// size given by immsize; the layout fixpoint
+			// insured that the value always fit.
+			void writeimm (uint immfieldoffset, u64 immvalue, uint immsize) {
+				
+				u8* bbinaryptr = (retvar->execbin.ptr + b->binaryoffset);
+				
+				if (immsize == IMM8) *(u8*)(bbinaryptr + immfieldoffset) = immvalue;
+				else if (immsize == IMM32) *(u32*)(bbinaryptr + immfieldoffset) = immvalue;
+				else if (immsize == IMM64) *(u64*)(bbinaryptr + immfieldoffset) = immvalue;
+				// This else case is not necessary.
+				// It is only there to make sure
+				// that immsize was valid.
+				else throwerror();
+			}
+			
 			// If the instruction used
 			// an immediate2 value,
 			// I resolve it and write it
 			// in the appropriate location
 			// within its binary.
-			if (b->isimm2used) {
-				// This variable will hold the value
-				// of the immediate2 value to write.
-				u64 imm2value = b->imm2miscvalue;
-				
-				// Calculate the relative address
-				// from the next instruction.
-				// The sys field is located right after
-				// the fields arg and env which are at
-				// the top of the global variable region.
-				imm2value += ((executableinstrsz + constantstringssz + (2*sizeof(u64))) -
-					(b->binaryoffset + b->imm2fieldoffset +
-						((b->isimm2used == IMM64) ? sizeof(u64) :
-							(b->isimm2used == IMM32) ? sizeof(u32) :
-							sizeof(u8))));
-				
-				if (b->isimm2used == IMM8) {
-					// Check whether the absolute
-					// value of the offset can
-					// be encoded using 8bits.
-					if ((((sint)imm2value < 0) ? -imm2value : imm2value) < (1 << 7)) {
-						// An 8bits offset can be used.
-						
-						// Write the computed offset value
-						// in the appropriate location within
-						// the binary of the instruction.
-						// An 8 bits value is written.
-						
-						*(u8*)(b->binary.ptr + b->imm2fieldoffset) = imm2value;
-						
-					} else {
-						// An 8bits offset cannot be used.
-						
-						if ((((sint)imm2value < 0) ? -imm2value : imm2value) < (1 << 31)) {
-							// A 32bits offset is what would fit.
-							
-							// I set the backenddata
-							// so that a 32bits offset
-							// get tried instead when
-							// the lyricalinstruction
-							// will be redone.
-							b->isimm2used = IMM32;
-							
-						} else {
-							// A 64bits offset is what would fit.
-							
-							// I set the backenddata
-							// so that a 64bits offset
-							// get tried instead when
-							// the lyricalinstruction
-							// will be redone.
-							b->isimm2used = IMM64;
-						}
-						
-						// I save the lyricalinstruction* to redo.
-						bintreeadd(&toredo, (uint)i, i);
-					}
-					
-				} else if (b->isimm2used == IMM32) {
-					// Check whether the absolute
-					// value of the offset can
-					// be encoded using 16bits.
-					if ((((sint)imm2value < 0) ? -imm2value : imm2value) < (1 << 31)) {
-						// A 32bits offset can be used.
-						
-						// Write the computed offset value
-						// in the appropriate location within
-						// the binary of the instruction.
-						// A 32 bits value is written.
-						
-						*(u32*)(b->binary.ptr + b->imm2fieldoffset) = imm2value;
-						
-					} else {
-						// A 32bits offset cannot be used.
-						// A 64bits offset is what would fit.
-						
-						// I set the backenddata
-						// so that a 64bits offset
-						// get tried instead when
-						// the lyricalinstruction
-						// will be redone.
-						b->isimm2used = IMM64;
-						
-						// I save the lyricalinstruction* to redo.
-						bintreeadd(&toredo, (uint)i, i);
-					}
-					
-				} else if (b->isimm2used == IMM64) {
-					// Write the computed offset value
-					// in the appropriate location within
-					// the binary of the instruction.
-					// A 64 bits value is written.
-					
-					*(u64*)(b->binary.ptr + b->imm2fieldoffset) = imm2value;
-					
-				// This else case is not necessary.
-				// It is only there to make sure
-				// that b->isimm2used was valid.
-				} else throwerror();
-			}
+			if (b->isimm2used) writeimm(b->imm2fieldoffset, resolveimm2(), b->isimm2used);
 			
 			// If the instruction used
 			// an immediate value,
 			// I resolve it and write it
 			// in the appropriate location
 			// within its binary.
-			if (b->isimmused) {
-				// This variable will hold the value
-				// of the immediate value to write.
-				u64 immvalue = b->immmiscvalue;
-				
-				lyricalimmval* imm = i->imm;
-				
-				// When calculating relative addresses
-				// from the next instruction, there is no
-				// need to check whether there is a next
-				// instruction because, there will always
-				// be at least the instruction used
-				// to return from the function.
-				
-				keepprocessing:
-				
-				switch (imm->type) {
-					
-					case LYRICALIMMVALUE:
-						
-						immvalue += *(u64*)&imm->n;
-						
-						break;
-						
-					case LYRICALIMMOFFSETTOINSTRUCTION:
-						// Calculate the relative address
-						// from the next instruction.
-						immvalue += (((backenddata*)imm->i->backenddata)->binaryoffset -
-							(b->binaryoffset + b->immfieldoffset +
-								((b->isimmused == IMM64) ? sizeof(u64) :
-									(b->isimmused == IMM32) ? sizeof(u32) :
-									sizeof(u8))));
-						
-						break;
-						
-					case LYRICALIMMOFFSETTOFUNCTION:
-						// Calculate the relative address
-						// from the next instruction.
-						// Note that the field i of
-						// an lyricalfunction always
-						// points to the last instruction
-						// generated, so to get to
-						// the first instruction generated,
-						// I use the field next since
-						// the instructions of an lyricalfunction
-						// pointed by their field i
-						// form a circular linkedlist.
-						immvalue += (((backenddata*)imm->f->i->next->backenddata)->binaryoffset -
-							(b->binaryoffset + b->immfieldoffset +
-								((b->isimmused == IMM64) ? sizeof(u64) :
-									(b->isimmused == IMM32) ? sizeof(u32) :
-									sizeof(u8))));
-						
-						break;
-						
-					case LYRICALIMMOFFSETTOGLOBALREGION:
-						// Calculate the relative address
-						// from the next instruction.
-						immvalue += ((executableinstrsz + constantstringssz) -
-							(b->binaryoffset + b->immfieldoffset +
-								((b->isimmused == IMM64) ? sizeof(u64) :
-									(b->isimmused == IMM32) ? sizeof(u32) :
-									sizeof(u8))));
-						
-						break;
-						
-					case LYRICALIMMOFFSETTOSTRINGREGION:
-						// Calculate the relative address
-						// from the next instruction.
-						immvalue += (executableinstrsz -
-							(b->binaryoffset + b->immfieldoffset +
-								((b->isimmused == IMM64) ? sizeof(u64) :
-									(b->isimmused == IMM32) ? sizeof(u32) :
-									sizeof(u8))));
-						
-						break;
-				}
-				
-				if (imm->next) {
-					imm = imm->next;
-					goto keepprocessing;
-				}
-				
-				if (b->isimmused == IMM8) {
-					// Check whether the absolute
-					// value of the immediate can
-					// be encoded using 8bits.
-					if ((((sint)immvalue < 0) ? -immvalue : immvalue) < (1 << 7)) {
-						// An 8bits immediate can be used.
-						
-						// Write the computed immediate value
-						// in the appropriate location within
-						// the binary of the instruction.
-						// An 8 bits value is written.
-						
-						*(u8*)(b->binary.ptr + b->immfieldoffset) = immvalue;
-						
-					} else {
-						// An 8bits immediate cannot be used.
-						
-						if ((((sint)immvalue < 0) ? -immvalue : immvalue) < (1 << 31)) {
-							// A 32bits immediate is what would fit.
-							
-							// I set the backenddata
-							// so that a 32bits immediate
-							// get tried instead when
-							// the lyricalinstruction
-							// will be redone.
-							b->isimmused = IMM32;
-							
-						} else {
-							// A 64bits immediate is what would fit.
-							
-							// I set the backenddata
-							// so that a 64bits immediate
-							// get tried instead when
-							// the lyricalinstruction
-							// will be redone.
-							b->isimmused = IMM64;
-						}
-						
-						// I save the lyricalinstruction* to redo.
-						bintreeadd(&toredo, (uint)i, i);
-					}
-					
-				} else if (b->isimmused == IMM32) {
-					// Check whether the absolute
-					// value of the immediate can
-					// be encoded using 16bits.
-					if ((((sint)immvalue < 0) ? -immvalue : immvalue) < (1 << 31)) {
-						// A 32bits immediate can be used.
-						
-						// Write the computed immediate value
-						// in the appropriate location within
-						// the binary of the instruction.
-						// A 32 bits value is written.
-						
-						*(u32*)(b->binary.ptr + b->immfieldoffset) = immvalue;
-						
-					} else {
-						// A 32bits immediate cannot be used.
-						// A 64bits immediate is what would fit.
-						
-						// I set the backenddata
-						// so that a 64bits immediate
-						// get tried instead when
-						// the lyricalinstruction
-						// will be redone.
-						b->isimmused = IMM64;
-						
-						// I save the lyricalinstruction* to redo.
-						bintreeadd(&toredo, (uint)i, i);
-					}
-					
-				} else if (b->isimmused == IMM64) {
-					// Write the computed immediate value
-					// in the appropriate location within
-					// the binary of the instruction.
-					// A 64 bits value is written.
-					
-					*(u64*)(b->binary.ptr + b->immfieldoffset) = immvalue;
-					
-				// This else case is not necessary.
-				// It is only there to make sure
-				// that b->isimmused was valid.
-				} else throwerror();
-			}
+			if (b->isimmused) writeimm(b->immfieldoffset, resolveimm(), b->isimmused);
 			
-			// If there was at least one lyricalinstruction
-			// to redo, there is no need to keep copying data
-			// to retvar->execbin and processing debug information.
-			if (!toredo.ptr && b->binary.ptr) {
-				
-				bytcpy(
-					retvar->execbin.ptr + b->binaryoffset,
-					b->binary.ptr,
-					arrayu8sz(b->binary));
+			if (b->binarysz) {
 				
 				if (i->dbginfo.linenumber) {
 					// I generate a new section1 debug information entry
@@ -13709,18 +14566,6 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 	
 	// When I get here f == compileresult.rootfunc;
 	
-	// Check if there was lyricalinstruction to redo.
-	if (toredo.ptr) {
-		
-		mmfree(retvar->execbin.ptr);
-		
-		if (dbginfosection1.ptr) mmfree(dbginfosection1.ptr);
-		
-		if (dbginfosection2.ptr) mmfree(dbginfosection2.ptr);
-		
-		goto redo;
-	}
-	
 	if (saveddbginfolinenumber) {
 		// Retrieve the last instruction
 		// that was converted.
@@ -13731,7 +14576,7 @@ lyricalbackendx64result* lyricalbackendx64 (lyricalcompileresult compileresult,
 		// in dbginfosection1, with an entry
 		// for which the field binoffset
 		// is the upper limit offset.
-		*arrayu64append1(&dbginfosection1) = b->binaryoffset + arrayu8sz(b->binary); // binoffset.
+		*arrayu64append1(&dbginfosection1) = b->binaryoffset + b->binarysz; // binoffset.
 		*arrayu64append1(&dbginfosection1) = 0; // filepath.
 		*arrayu64append1(&dbginfosection1) = 0; // linenumber.
 		*arrayu64append1(&dbginfosection1) = 0; // lineoffset.
@@ -138,6 +138,19 @@ typedef enum {
 	// aligned to a pagesize (4096 bytes).
 	LYRICALBACKENDX64PAGEALIGNED,
 	
+	// The following values can be
+	// or'ed with any of the above;
+	// when used, the first instruction
+	// of each function, and each loop head,
+	// which is the target of a branching
+	// instruction located after it within
+	// the same function, are aligned to
+	// the boundary selected, padding with
+	// no-operation instructions.
+	LYRICALBACKENDX64ALIGN16 = (1<<2),
+	LYRICALBACKENDX64ALIGN32 = (2<<2),
+	LYRICALBACKENDX64ALIGN64 = (3<<2),
+	
 } lyricalbackendx64flag;
 
 // Backend which convert
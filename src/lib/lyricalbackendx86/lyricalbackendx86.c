@@ -34,6 +34,9 @@
 #include <arrayu32.h>
 #include <bintree.h>
 #include <lyrical.h>
+#ifndef LYRICALBACKENDX86BASELINEISA
+#include <cpuid.h>
+#endif
 
 
 // # On Linux, to disassemble a raw binary file, use the following command:
@@ -46,6 +49,35 @@
 #error "little endian required"
 #endif
 
+// Macros setting the count of stack pages
+// allocated at once when the stack page pool
+// is empty, and the count of stack pages
+// that the stack page pool can hold.
+#ifndef LYRICALBACKENDX86STACKPAGEBATCH
+#define LYRICALBACKENDX86STACKPAGEBATCH 4
+#endif
+#ifndef LYRICALBACKENDX86STACKPAGEPOOLMAX
+#define LYRICALBACKENDX86STACKPAGEPOOLMAX 16
+#endif
+#if LYRICALBACKENDX86STACKPAGEBATCH < 1 || LYRICALBACKENDX86STACKPAGEBATCH > 8
+#error "LYRICALBACKENDX86STACKPAGEBATCH must be from 1 to 8"
+#endif
+#if LYRICALBACKENDX86STACKPAGEPOOLMAX > 127
+#error "LYRICALBACKENDX86STACKPAGEPOOLMAX must be less than 128"
+#endif
+
+// When the macro LYRICALBACKENDX86BASELINEISA
+// is defined, the instructions POPCNT, LZCNT
+// and TZCNT are never generated, even if
+// the CPU on which the compiler is running
+// support them; instruction sequences using
+// only the baseline x86 instruction set
+// are generated instead.
+// Vector lyricalinstruction require SSE2,
+// and are not supported when the CPU
+// do not support it, or when the macro
+// LYRICALBACKENDX86BASELINEISA is defined.
+
 
 // Structure used by
 // lyricalbackendx86()
@@ -163,6 +195,19 @@ typedef enum {
 	// aligned to a pagesize (4096 bytes).
 	LYRICALBACKENDX86PAGEALIGNED,
 	
+	// The following values can be
+	// or'ed with any of the above;
+	// when used, the first instruction
+	// of each function, and each loop head,
+	// which is the target of a branching
+	// instruction located after it within
+	// the same function, are aligned to
+	// the boundary selected, padding with
+	// no-operation instructions.
+	LYRICALBACKENDX86ALIGN16 = (1<<2),
+	LYRICALBACKENDX86ALIGN32 = (2<<2),
+	LYRICALBACKENDX86ALIGN64 = (3<<2),
+	
 } lyricalbackendx86flag;
 
 enum {
@@ -217,9 +262,20 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	// to convert to its binary
 	// executable equivalent.
 	typedef struct {
-		// Executable binary
-		// of the instruction.
-		arrayu8 binary;
+		// Byte offset, within codebuf, where
+		// the executable binary of the instruction
+		// was emitted, unless the instruction
+		// was redone, in which case its executable
+		// binary is in the field redobinary.
+		uint codeoffset;
+		
+		// Byte size of the executable
+		// binary of the instruction.
+		uint binarysz;
+		
+		// Executable binary of the
+		// instruction when it was redone.
+		arrayu8 redobinary;
 		
 		// This field hold the
 		// byte offset location,
@@ -286,6 +342,54 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	// instructions that manipulate the stack.
 	enum {PAGESIZE = 4096};
 	
+	// Count of stack pages allocated at once by
+	// LYRICALOPSTACKPAGEALLOC when the stack page pool
+	// is empty; the pages beside the one used are added
+	// to the stack page pool.
+	enum {STACKPAGEBATCH = LYRICALBACKENDX86STACKPAGEBATCH};
+	
+	// Count of stack pages that the stack page pool
+	// can hold; LYRICALOPSTACKPAGEFREE free the page
+	// instead of adding it to the stack page pool
+	// when the stack page pool is full.
+	enum {STACKPAGEPOOLMAX = LYRICALBACKENDX86STACKPAGEPOOLMAX};
+	
+	// Variables set to whether the CPU
+	// on which the compiler is running
+	// support the instructions POPCNT,
+	// LZCNT and TZCNT; when the CPU do not
+	// support them, instruction sequences
+	// using only the baseline x86 instruction
+	// set are generated instead.
+	uint haspopcnt = 0, haslzcnt = 0, hastzcnt = 0;
+	
+	// Variable set to whether the CPU
+	// on which the compiler is running
+	// support SSE2, which is required
+	// by vector lyricalinstruction.
+	uint hassse2 = 0;
+	
+	#ifndef LYRICALBACKENDX86BASELINEISA
+	{
+		u32 eax, ebx, ecx, edx;
+		
+		// CPUID.01H:ECX.POPCNT[bit 23].
+		// CPUID.01H:EDX.SSE2[bit 26].
+		if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+			haspopcnt = ((ecx>>23)&1);
+			hassse2 = ((edx>>26)&1);
+		}
+		
+		// CPUID.80000001H:ECX.LZCNT[bit 5].
+		if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx))
+			haslzcnt = ((ecx>>5)&1);
+			
+		// CPUID.(EAX=07H, ECX=0H):EBX.BMI1[bit 3].
+		if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+			hastzcnt = ((ebx>>3)&1);
+	}
+	#endif
+	
 	// Array that will be used to track
 	// which register was used to save
 	// the value of the register given
@@ -301,11 +405,107 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	// unused register used.
 	uint regsinusetmp[REGCOUNT] = {0, 0, 0, 0, 0, 0, 0, 0};
 	
+	// Buffer in which the executable binary
+	// of every instruction get emitted, one after
+	// the other; it grows by doubling its size,
+	// and once every instruction has been laid
+	// out, it becomes the executable binary
+	// returned; hence its size is a capacity,
+	// and the count of bytes used is codebufsz.
+	arrayu8 codebuf = arrayu8null;
+	uint codebufsz = 0;
+	
 	// Binary tree that will be used
 	// to store all lyricalinstruction*
 	// to redo.
 	bintree toredo = bintreenull;
 	
+	// Boundary to which the first
+	// instruction of each function
+	// and each loop head get aligned;
+	// null when no alignment is done.
+	uint codealign = ((flag>>2)&3) ? (8<<((flag>>2)&3)) : 0;
+	
+	// Binary tree that will be used
+	// to store all lyricalinstruction*
+	// which executable binary must be
+	// aligned to codealign.
+	bintree toalign = bintreenull;
+	
+	if (codealign) {
+		// Binary tree used to store
+		// the lyricalinstruction* already
+		// walked through within the
+		// current lyricalfunction.
+		bintree walked = bintreenull;
+		
+		do {
+			// Note that f->i is always non-null,
+			// so there is no need to check it.
+			
+			lyricalinstruction* i = f->i->next;
+			
+			// The first instruction of
+			// a lyricalfunction is always
+			// aligned since it is its entry.
+			bintreeadd(&toalign, (uint)i, i);
+			
+			do {
+				bintreeadd(&walked, (uint)i, i);
+				
+				// All branching lyricalop are between
+				// LYRICALOPJEQ and LYRICALOPJPOP; a branching
+				// instruction which target a lyricalinstruction
+				// already walked through, is the end of a loop
+				// which head is that lyricalinstruction.
+				if (i->op >= LYRICALOPJEQ && i->op <= LYRICALOPJPOP &&
+					i->imm && i->imm->type == LYRICALIMMOFFSETTOINSTRUCTION &&
+					bintreefind(walked, (uint)i->imm->i))
+					bintreeadd(&toalign, (uint)i->imm->i, i->imm->i);
+					
+			} while ((i = i->next) != f->i->next);
+			
+			bintreeempty(&walked);
+			
+		} while ((f = f->next) != compileresult.rootfunc);
+		
+		// When I get here f == compileresult.rootfunc;
+	}
+	
+	lyricalinstruction* i;
+	
+	// Variable which get set
+	// to the backenddata* set
+	// in i->backenddata.
+	backenddata* b;
+	
+	// Count of lyricalinstruction
+	// among all lyricalfunction.
+	uint backenddatassz = 0;
+	
+	do {
+		i = f->i->next;
+		
+		do ++backenddatassz; while ((i = i->next) != f->i->next);
+		
+	} while ((f = f->next) != compileresult.rootfunc);
+	
+	// When I get here f == compileresult.rootfunc;
+	
+	// The backenddata of all lyricalinstruction
+	// are allocated at once, in the order in
+	// which their lyricalinstruction get laid out.
+	backenddata* backenddatas = mmallocz(backenddatassz*sizeof(backenddata));
+	
+	// Index within backenddatas of
+	// the backenddata to use for
+	// the next lyricalinstruction.
+	uint backenddatasidx = 0;
+	
+	// Set to 1 when at least one
+	// lyricalinstruction was redone.
+	uint wasredone = 0;
+	
 	// Label I jump to in order to
 	// begin redoing lyricalinstruction.
 	redo:;
@@ -337,13 +537,6 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	// to execute.
 	uint executableinstrsz = 0;
 	
-	lyricalinstruction* i;
-	
-	// Variable which get set
-	// to the backenddata* set
-	// in i->backenddata.
-	backenddata* b;
-	
 	do {
 		// Note that f->i is always non-null,
 		// so there is no need to check it.
@@ -396,6 +589,56 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			}
 		}
 		
+		// Function which append the count
+		// of bytes given as argument to the
+		// executable binary of the instruction
+		// pointed by i, and return the address
+		// of the first byte appended; that
+		// address is only valid until the next
+		// call to this function, since the buffer
+		// in which bytes get emitted can move.
+		u8* binaryappend2 (uint count) {
+			
+			b->binarysz += count;
+			
+			// An instruction being redone
+			// get emitted in its own buffer,
+			// since the bytes that follow it
+			// in codebuf are still in use.
+			if (toredo.ptr) return arrayu8append2(&b->redobinary, count);
+			
+			uint n = codebufsz;
+			
+			codebufsz += count;
+			
+			uint codebufcapacity = arrayu8sz(codebuf);
+			
+			if (codebufsz > codebufcapacity) {
+				
+				codebufcapacity = (codebufcapacity ? (codebufcapacity*2) : PAGESIZE);
+				
+				if (codebufcapacity < codebufsz) codebufcapacity = codebufsz;
+				
+				codebuf.ptr = mmrealloc(codebuf.ptr, codebufcapacity);
+			}
+			
+			return (codebuf.ptr + n);
+		}
+		
+		u8* binaryappend1 () {
+			return binaryappend2(1);
+		}
+		
+		// Function which return the address
+		// of the executable binary of the
+		// instruction pointed by i.
+		u8* binaryptr () {
+			
+			if (b->redobinary.ptr) return b->redobinary.ptr;
+			
+			return (codebuf.ptr + b->codeoffset);
+		}
+		
 		// Function used to generate
 		// the ModR/M byte when I have
 		// a single register operand.
@@ -404,7 +647,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// MOD == 0b11;
 			// REG == op[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters.
-			*arrayu8append1(&b->binary) = ((3<<6)|(op<<3)|(lookupreg(rm)));
+			*binaryappend1() = ((3<<6)|(op<<3)|(lookupreg(rm)));
 		}
 		
 		// Function is used to generate
@@ -415,7 +658,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// MOD == 0b11;
 			// REG == reg[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-			*arrayu8append1(&b->binary) = ((3<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
+			*binaryappend1() = ((3<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
 		}
 		
 		// Function is used to generate
@@ -428,7 +671,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// MOD == 0b00;
 			// REG == reg[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-			*arrayu8append1(&b->binary) = ((lookupreg(reg)<<3)|(lookupreg(rm)));
+			*binaryappend1() = ((lookupreg(reg)<<3)|(lookupreg(rm)));
 		}
 		
 		// Function is used to generate
@@ -441,7 +684,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// MOD == 0b01;
 			// REG == reg[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-			*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
+			*binaryappend1() = ((0b01<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
 		}
 		
 		// Function is used to generate
@@ -454,7 +697,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// MOD == 0b10;
 			// REG == reg[2:0]; #Only the 3 least significant bits matters.
 			// R/M == rm[2:0]; #Only the 3 least significant bits matters. */
-			*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
+			*binaryappend1() = ((0b10<<6)|(lookupreg(reg)<<3)|(lookupreg(rm)));
 		}
 		
 		// This function set the fields
@@ -469,13 +712,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate value.
 			b->isimmused = IMM8;
-			b->immfieldoffset = arrayu8sz(b->binary);
+			b->immfieldoffset = b->binarysz;
 			b->immmiscvalue += n;
 			
 			// Here I simply create space
 			// for a 8bits immediate value
 			// to be resolved later.
-			arrayu8append1(&b->binary);
+			binaryappend1();
 		}
 		
 		// This function set the fields
@@ -490,13 +733,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate2 value.
 			b->isimm2used = IMM8;
-			b->imm2fieldoffset = arrayu8sz(b->binary);
+			b->imm2fieldoffset = b->binarysz;
 			b->imm2miscvalue += n;
 			
 			// Here I simply create space
 			// for a 8bits immediate2 value
 			// to be resolved later.
-			arrayu8append1(&b->binary);
+			binaryappend1();
 		}
 		
 		// This function set the fields
@@ -511,13 +754,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate value.
 			b->isimmused = IMM32;
-			b->immfieldoffset = arrayu8sz(b->binary);
+			b->immfieldoffset = b->binarysz;
 			b->immmiscvalue += n;
 			
 			// Here I simply create space
 			// for a 32bits immediate value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u32));
+			binaryappend2(sizeof(u32));
 		}
 		
 		// This function set the fields
@@ -532,13 +775,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Set the attributes
 			// of the immediate2 value.
 			b->isimm2used = IMM32;
-			b->imm2fieldoffset = arrayu8sz(b->binary);
+			b->imm2fieldoffset = b->binarysz;
 			b->imm2miscvalue += n;
 			
 			// Here I simply create space
 			// for a 32bits immediate2 value
 			// to be resolved later.
-			arrayu8append2(&b->binary, sizeof(u32));
+			binaryappend2(sizeof(u32));
 		}
 		
 		// This function is used to encode the modrm
@@ -571,10 +814,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// appended after the modrm and sib bytes.
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = ((0b10<<6)|(lookupreg(reg)<<3)|0b100);
+			*binaryappend1() = ((0b10<<6)|(lookupreg(reg)<<3)|0b100);
 			
 			// Append the SIB byte.
-			*arrayu8append1(&b->binary) = ((0b100<<3)|lookupreg(base));
+			*binaryappend1() = ((0b100<<3)|lookupreg(base));
 		}
 		
 		// This function is used to encode the modrm
@@ -607,10 +850,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// appended after the modrm and sib bytes.
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = ((0b01<<6)|(lookupreg(reg)<<3)|0b100);
+			*binaryappend1() = ((0b01<<6)|(lookupreg(reg)<<3)|0b100);
 			
 			// Append the SIB byte.
-			*arrayu8append1(&b->binary) = ((0b100<<3)|lookupreg(base));
+			*binaryappend1() = ((0b100<<3)|lookupreg(base));
 		}
 		
 		// This function is used to encode
@@ -633,7 +876,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// appended after the modrm byte.
 			
 			// Append the ModR/M byte.
-			*arrayu8append1(&b->binary) = ((lookupreg(reg)<<3)|0b101);
+			*binaryappend1() = ((lookupreg(reg)<<3)|0b101);
 		}
 		
 		void nop () {
@@ -641,7 +884,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 90		NOP		#One byte no-operation instruction.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x90;
+			*binaryappend1() = 0x90;
 		}
 		
 		// Instruction size in bytes
@@ -653,7 +896,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -664,7 +907,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 50+rd	PUSH r32	#Push r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0x50+lookupreg(r));
+			*binaryappend1() = (0x50+lookupreg(r));
 		}
 		
 		void pop (uint r) {
@@ -680,7 +923,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 58+rd	POP r32		#Pop r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0x58+lookupreg(r));
+			*binaryappend1() = (0x58+lookupreg(r));
 		}
 		
 		// This function return the id
@@ -869,7 +1112,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 01 /r	ADD r/m32, r32		#Add r32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x01;
+			*binaryappend1() = 0x01;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -883,7 +1126,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /0 id	ADD r/m32, imm32	#Add imm32 to r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(0, r);
@@ -896,7 +1139,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /0 ib	ADD r/m32, imm8	#Add imm8 (sign-extended to 32bits) to r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(0, r);
@@ -914,7 +1157,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /0 id	ADD r/m32, imm32	#Add imm32 to r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(0, r);
@@ -927,7 +1170,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /0 ib	ADD r/m32, imm8	#Add imm8 (sign-extended to 32bits) to r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(0, r);
@@ -944,7 +1187,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 40+rd	INC r32		#Increment r32 by 1.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0x40+lookupreg(r));
+			*binaryappend1() = (0x40+lookupreg(r));
 		}
 		
 		// Increment register by 32bits immediate
@@ -954,14 +1197,15 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 81 /0 id	ADD r/m32, imm32	#Add imm32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x81;
+			*binaryappend1() = 0x81;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, r);
 			
 			// Append 32bits immediate value.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = n;
+			*(u32*)binaryappend2(sizeof(u32)) = n;
 		}
+		#endif
 		
 		// Increment register by 8bits immediate
 		// value given as argument.
@@ -970,22 +1214,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 83 /0 ib	ADD r/m32, imm8	#Add imm8 (sign-extended to 32bits) to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x83;
+			*binaryappend1() = 0x83;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, r);
 			
 			// Append 8bits immediate value.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
-		#endif
 		
 		void sub (uint r1, uint r2) {
 			// Specification from the Intel manual.
 			// 29 /r	SUB r/m32, r32		#Subtract r32 from r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x29;
+			*binaryappend1() = 0x29;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -1001,7 +1244,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /5 id	SUB r/m32, imm32	#Substract imm32 from r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(5, r);
@@ -1014,7 +1257,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /5 ib	ADD r/m32, imm8	#Substract imm8 (sign-extended to 32bits) from r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(5, r);
@@ -1030,7 +1273,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// F7 /3	NEG r/m32	#Two's complement negate r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(3, r);
@@ -1043,7 +1286,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -1054,8 +1297,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F AF /r	IMUL r32, r/m32		#reg = reg * r/m32.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xaf;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xaf;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r1, r2);
@@ -1124,7 +1367,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with the low result stored in EAX and high result stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(5, x);
@@ -1157,12 +1400,23 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 31 /r	XOR r/m32, r32		#r/m32 XOR r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x31;
+			*binaryappend1() = 0x31;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
 		}
 		
+		// Function used to sign-extend
+		// EAX into EDX:EAX, which is
+		// the dividend of IDIV.
+		void cdq () {
+			// Specification from the Intel manual.
+			// 99	CDQ	#EDX:EAX = sign-extend of EAX.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0x99;
+		}
+		
 		void div (uint r1, uint r2) {
 			
 			uint r1r2wasxchged = 0;
@@ -1221,14 +1475,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				} else regsinusetmp[EDX] = 1; // Mark unused register as temporarily used.
 			}
 			
-			xor(EDX, EDX);
+			cdq();
 			
 			// Specification from the Intel manual.
 			// F7 /7	IDIV r/m32	#Signed divide EDX:EAX by r/m32,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, x);
@@ -1314,14 +1568,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				} else regsinusetmp[EDX] = 1; // Mark unused register as temporarily used.
 			}
 			
-			xor(EDX, EDX);
+			cdq();
 			
 			// Specification from the Intel manual.
 			// F7 /7	IDIV r/m32	#Signed divide EDX:EAX by r/m32,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, x);
@@ -1412,7 +1666,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with the low result stored in EAX and high result stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, x);
@@ -1505,7 +1759,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(6, x);
@@ -1598,7 +1852,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(6, x);
@@ -1634,7 +1888,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 69 /r id	IMUL r32, r/m32, imm32		#reg = r/m32 * imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x69;
+				*binaryappend1() = 0x69;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(r, r);
@@ -1647,7 +1901,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 6b /r id	IMUL r32, r/m32, imm8		#reg = r/m32 * imm8.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x6b;
+				*binaryappend1() = 0x6b;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(r, r);
@@ -1663,10 +1917,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// B8+rd id	MOV r32, imm32		#Move imm32 to r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = (0xb8+lookupreg(r));
+			*binaryappend1() = (0xb8+lookupreg(r));
 			
 			// Append 32bits immediate value.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = n;
+			*(u32*)binaryappend2(sizeof(u32)) = n;
 		}
 		
 		// Function used to load the
@@ -1688,7 +1942,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// B8+rd id	MOV r32, imm32		#Move imm32 to r32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = (0xb8+lookupreg(r));
+					*binaryappend1() = (0xb8+lookupreg(r));
 					
 					// Append the immediate value.
 					append32bitsimm(n);
@@ -1731,7 +1985,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with the low result stored in EAX and high result stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(5, EDX);
@@ -1790,14 +2044,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			ldi(x, 0);
 			
-			xor(EDX, EDX);
+			cdq();
 			
 			// Specification from the Intel manual.
 			// F7 /7	IDIV r/m32	#Signed divide EDX:EAX by r/m32,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, x);
@@ -1858,14 +2112,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			ldi(x, 0);
 			
-			xor(EDX, EDX);
+			cdq();
 			
 			// Specification from the Intel manual.
 			// F7 /7	IDIV r/m32	#Signed divide EDX:EAX by r/m32,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, x);
@@ -1921,7 +2175,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with the low result stored in EAX and high result stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, EDX);
@@ -1987,7 +2241,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(6, x);
@@ -2055,7 +2309,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// with quotient stored in EAX and remainder stored in EDX.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(6, x);
@@ -2086,7 +2340,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 21 /r	AND r/m32, r32		#r/m32 AND r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x21;
+			*binaryappend1() = 0x21;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -2100,7 +2354,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /4 id	AND r/m32, imm32	#r/m32 AND imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(4, r);
@@ -2113,7 +2367,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /4 ib	AND r/m32, imm8	#r/m32 AND imm8 (sign-extended to 32bits).
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(4, r);
@@ -2130,26 +2384,26 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /4 ib	AND r/m32, imm8	#r/m32 AND imm8 (sign-extended to 32bits).
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(4, r);
 				
 				// Append the immediate value.
-				*arrayu8append1(&b->binary) = n;
+				*binaryappend1() = n;
 				
 			} else {
 				// Specification from the Intel manual.
 				// 81 /4 id	AND r/m32, imm32	#r/m32 AND imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(4, r);
 				
 				// Append 32bits immediate value.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = n;
+				*(u32*)binaryappend2(sizeof(u32)) = n;
 			}
 		}
 		
@@ -2158,7 +2412,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 09 /r	OR r/m32, r32		#r/m32 OR r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x09;
+			*binaryappend1() = 0x09;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -2172,7 +2426,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /1 id	OR r/m32, imm32	#r/m32 OR imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(1, r);
@@ -2185,7 +2439,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /1 ib	OR r/m32, imm8	#r/m32 OR imm8 (sign-extended to 32bits).
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(1, r);
@@ -2203,7 +2457,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /6 id	XOR r/m32, imm32	#r/m32 XOR imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(6, r);
@@ -2216,7 +2470,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /6 ib	XOR r/m32, imm8	#r/m32 XOR imm8 (sign-extended to 32bits).
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(6, r);
@@ -2231,7 +2485,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// F7 /2	NOT r/m32	#Reverse each bit of r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xf7;
+			*binaryappend1() = 0xf7;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(2, r);
@@ -2273,7 +2527,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// D3 /4	SHL r/m32, CL		#Shift logically r/m32 left CL times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, r1);
@@ -2294,7 +2548,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C1 /4 ib	SHL r/m32, imm8		#Shift logically r/m32 left imm8 times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, r);
@@ -2308,13 +2562,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C1 /4 ib	SHL r/m32, imm8		#Shift logically r/m32 left imm8 times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, r);
 			
 			// Append the 8bits immediate value.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
 		
 		void srl (uint r1, uint r2) {
@@ -2353,7 +2607,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// D3 /5	SHR r/m32, CL		#Shift logically r/m32 right CL times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(5, r1);
@@ -2374,7 +2628,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C1 /5 ib	SHR r/m32, imm8		#Shift logically r/m32 right imm8 times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(5, r);
@@ -2383,6 +2637,20 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			append8bitsimm(0);
 		}
 		
+		void srlimm (uint r, u8 n) {
+			// Specification from the Intel manual.
+			// C1 /5 ib	SHR r/m32, imm8		#Shift logically r/m32 right imm8 times.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(5, r);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = n;
+		}
+		
 		void sra (uint r1, uint r2) {
 			
 			uint r1r2wasxchged = 0;
@@ -2419,7 +2687,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// D3 /7	SAR r/m32, CL		#Shift arithmetically r/m32 right CL times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xd3;
+			*binaryappend1() = 0xd3;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, r1);
@@ -2440,7 +2708,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C1 /7 ib	SAR r/m32, imm8		#Shift arithmetically r/m32 right imm8 times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, r);
@@ -2454,18 +2722,150 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C1 /7 ib	SAR r/m32, imm8		#Shift arithmetically r/m32 right imm8 times.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc1;
+			*binaryappend1() = 0xc1;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(7, r);
 			
 			// Append the shift amount.
-			*arrayu8append1(&b->binary) = n;
+			*binaryappend1() = n;
 		}
 		
 		// Function which zero extend
 		// the n least significant bits
 		// of the register r.
+		void rol (uint r1, uint r2) {
+			
+			uint r1r2wasxchged = 0;
+			
+			if (r2 != ECX && r1 == ECX) {
+				// If I get here, I xchg r1 and r2
+				// so as to generate the least
+				// amount of intructions while
+				// setting up the rotation amount
+				// in ECX.
+				
+				xchg(r1, r2);
+				
+				// Set r1 and r2 to the register id
+				// that contain their values.
+				r1 ^= r2; r2 ^= r1; r1 ^= r2;
+				
+				r1r2wasxchged = 1;
+			}
+			
+			uint ecxwassaved = 0;
+			
+			if (r2 != ECX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(ECX)) {
+					savereg(ECX); ecxwassaved = 1;
+				} else regsinusetmp[ECX] = 1; // Mark unused register as temporarily used.
+				
+				cpy(ECX, r2);
+			}
+			
+			// Specification from the Intel manual.
+			// D3 /0	ROL r/m32, CL		#Rotate 32 bits r/m32 left CL times.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0xd3;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(0, r1);
+			
+			if (r2 != ECX) {
+				
+				if (ecxwassaved) {
+					// Restore register value.
+					restorereg(ECX);
+				} else regsinusetmp[ECX] = 0; // Unmark register as temporarily used.
+			}
+			
+			if (r1r2wasxchged) xchg(r1, r2); // Restore registers value.
+		}
+		
+		void roli (uint r) {
+			// Specification from the Intel manual.
+			// C1 /0 ib	ROL r/m32, imm8		#Rotate 32 bits r/m32 left imm8 times.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(0, r);
+			
+			// Append the immediate value.
+			append8bitsimm(0);
+		}
+		
+		void ror (uint r1, uint r2) {
+			
+			uint r1r2wasxchged = 0;
+			
+			if (r2 != ECX && r1 == ECX) {
+				// If I get here, I xchg r1 and r2
+				// so as to generate the least
+				// amount of intructions while
+				// setting up the rotation amount
+				// in ECX.
+				
+				xchg(r1, r2);
+				
+				// Set r1 and r2 to the register id
+				// that contain their values.
+				r1 ^= r2; r2 ^= r1; r1 ^= r2;
+				
+				r1r2wasxchged = 1;
+			}
+			
+			uint ecxwassaved = 0;
+			
+			if (r2 != ECX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(ECX)) {
+					savereg(ECX); ecxwassaved = 1;
+				} else regsinusetmp[ECX] = 1; // Mark unused register as temporarily used.
+				
+				cpy(ECX, r2);
+			}
+			
+			// Specification from the Intel manual.
+			// D3 /1	ROR r/m32, CL		#Rotate 32 bits r/m32 right CL times.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0xd3;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(1, r1);
+			
+			if (r2 != ECX) {
+				
+				if (ecxwassaved) {
+					// Restore register value.
+					restorereg(ECX);
+				} else regsinusetmp[ECX] = 0; // Unmark register as temporarily used.
+			}
+			
+			if (r1r2wasxchged) xchg(r1, r2); // Restore registers value.
+		}
+		
+		void rori (uint r) {
+			// Specification from the Intel manual.
+			// C1 /1 ib	ROR r/m32, imm8		#Rotate 32 bits r/m32 right imm8 times.
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0xc1;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(1, r);
+			
+			// Append the immediate value.
+			append8bitsimm(0);
+		}
+		
 		void zxt (uint r, u8 n) {
 			
 			if (n == 8) {
@@ -2510,8 +2910,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb6;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb6;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(rvalid, rvalid);
@@ -2530,8 +2930,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xb7;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xb7;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(r, r);
@@ -2551,26 +2951,26 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /4 ib	AND r/m32, imm8		#r/m32 AND imm8 (sign-extended).
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(4, r);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = bitselect;
+					*binaryappend1() = bitselect;
 					
 				} else {
 					// Specification from the Intel manual.
 					// 81 /4 id	AND r/m32, imm32	#r/m32 AND imm32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x81;
+					*binaryappend1() = 0x81;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(4, r);
 					
 					// Append the 32bits immediate value.
-					*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = bitselect;
+					*(u32*)binaryappend2(sizeof(u32)) = bitselect;
 				}
 			}
 		}
@@ -2622,8 +3022,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F BE /r	MOVSX r32, r/m8		#Move r/m8 to r32, sign-extension.
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xbe;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xbe;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(rvalid, rvalid);
@@ -2642,8 +3042,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F BF /r	MOVSX r32, r/m16	#Move r/m16 to r32, sign-extension.
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0xbf;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0xbf;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor2reg(r, r);
@@ -2669,7 +3069,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 39 /r	CMP r/m32, r32		#Compare r32 with r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x39;
+			*binaryappend1() = 0x39;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r2, r1);
@@ -2720,8 +3120,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x94;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -2784,8 +3184,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x95;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -2811,7 +3211,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 81 /7 id	CMP r/m32, imm32	#Compare imm32 with r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x81;
+				*binaryappend1() = 0x81;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(7, r);
@@ -2824,7 +3224,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 83 /7 ib	CMP r/m32, imm8	#Compare imm8 (sign-extended to 32bits) with r/m32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x83;
+				*binaryappend1() = 0x83;
 				
 				// Append the ModR/M byte.
 				appendmodrmfor1reg(7, r);
@@ -2878,8 +3278,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 94	SETE r/m8	#Set byte if equal (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x94;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -2941,8 +3341,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 95	SETNE r/m8	#Set byte if not equal (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x95;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3005,8 +3405,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9c;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9c;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3069,8 +3469,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9e;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9e;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3133,8 +3533,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 92	SETB r/m8	#Set byte if below (CF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x92;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x92;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3197,8 +3597,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x96;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x96;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3261,8 +3661,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9f;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9f;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3325,8 +3725,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9d;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9d;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3389,8 +3789,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x97;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x97;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3453,8 +3853,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x93;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x93;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3516,8 +3916,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9C	SETL r/m8	#Set byte if less (SF≠OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9c;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9c;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3579,8 +3979,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9E	SETLE r/m8	#Set byte if less or equal (ZF=1 or SF≠OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9e;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9e;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3642,8 +4042,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 92	SETB r/m8	#Set byte if below (CF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x92;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x92;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3705,8 +4105,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 96	SETBE r/m8	#Set byte if below or equal (CF=1 or ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x96;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x96;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3768,8 +4168,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9F	SETG r/m8	#Set byte if greater (ZF=0 and SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9f;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9f;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3831,8 +4231,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 9D	SETGE r/m8	#Set byte if greater or equal (SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x9d;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x9d;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3894,8 +4294,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 97	SETA r/m8	#Set byte if above (CF=0 and ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x97;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x97;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3957,8 +4357,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 93	SETAE r/m8	#Set byte if above or equal (CF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x93;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x93;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -3983,7 +4383,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 85 /r	TEST r/m64, r64		# AND r32 with r/m32; set SF, ZF, PF according to result.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x85;
+			*binaryappend1() = 0x85;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor2reg(r, r);
@@ -4033,8 +4433,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 94	SETZ r/m8	#Set byte if zero (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x94;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x94;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -4096,8 +4496,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F 95	SETNZ r/m8	#Set byte if not zero (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0x95;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0x95;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, rvalid);
@@ -4126,8 +4526,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 84 cd	JE rel32	#Jump near if equal (ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x84;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x84;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4137,7 +4537,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 74 cb	JE rel8	#Jump short if equal (ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
+				*binaryappend1() = 0x74;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4149,7 +4549,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// FF /4	JMP r/m32	#Jump absolute.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xff;
+			*binaryappend1() = 0xff;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(4, r);
@@ -4163,22 +4563,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
+			*binaryappend1() = 0x75;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void ji () {
@@ -4224,22 +4623,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
+			*binaryappend1() = 0x75;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jne (uint r1, uint r2) {
@@ -4253,8 +4651,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 85 cd	JNE rel32	#Jump near if not equal (ZF=0).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x85;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x85;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4264,7 +4662,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
+				*binaryappend1() = 0x75;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4279,22 +4677,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
+			*binaryappend1() = 0x74;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jnei (uint r1, uint r2) {
@@ -4305,22 +4702,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 74 cb	JE rel8		#Jump short if equal (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
+			*binaryappend1() = 0x74;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlt (uint r1, uint r2) {
@@ -4334,8 +4730,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 8C cd	JL rel32	#Jump near if less (SF≠OF).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x8c;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x8c;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4345,7 +4741,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 7C cb	JL rel8	#Jump short if less (SF≠OF).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7c;
+				*binaryappend1() = 0x7c;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4360,22 +4756,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7d;
+			*binaryappend1() = 0x7d;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlti (uint r1, uint r2) {
@@ -4386,22 +4781,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 7D cb	JNL rel8	#Jump short if not less (SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7d;
+			*binaryappend1() = 0x7d;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlte (uint r1, uint r2) {
@@ -4415,8 +4809,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 8E cd	JLE rel32	#Jump near if less or equal (ZF=1 or SF≠OF).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x8e;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x8e;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4426,7 +4820,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 7E cb	JLE rel8	#Jump short if less or equal (ZF=1 or SF≠OF).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x7e;
+				*binaryappend1() = 0x7e;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4441,22 +4835,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7f;
+			*binaryappend1() = 0x7f;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jltei (uint r1, uint r2) {
@@ -4467,22 +4860,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 7F cb	JNLE rel8	#Jump short if not less or equal (ZF=0 and SF=OF).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x7f;
+			*binaryappend1() = 0x7f;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jltu (uint r1, uint r2) {
@@ -4496,8 +4888,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 82 cd	JB rel32	#Jump near if below (CF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x82;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x82;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4507,7 +4899,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 72 cb	JB rel8	#Jump short if below (CF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x72;
+				*binaryappend1() = 0x72;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4522,22 +4914,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x73;
+			*binaryappend1() = 0x73;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jltui (uint r1, uint r2) {
@@ -4548,22 +4939,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 73 cb	JNB rel8	#Jump short if not below (CF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x73;
+			*binaryappend1() = 0x73;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlteu (uint r1, uint r2) {
@@ -4577,8 +4967,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 86 cd	JBE rel32	#Jump near if below or equal (CF=1 or ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x86;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x86;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4588,7 +4978,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 76 cb	JBE rel8	#Jump short if below or equal (CF=1 or ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x76;
+				*binaryappend1() = 0x76;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4603,22 +4993,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x77;
+			*binaryappend1() = 0x77;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r3);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlteui (uint r1, uint r2) {
@@ -4629,22 +5018,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 77 cb	JNBE rel8	#Jump short if not below or equal (CF=0 and ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x77;
+			*binaryappend1() = 0x77;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jz (uint r) {
@@ -4658,8 +5046,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 84 cd	JZ rel32	#Jump near if zero (ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x84;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x84;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4669,7 +5057,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 74 cb	JZ rel8	#Jump short if zero (ZF=1).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x74;
+				*binaryappend1() = 0x74;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4684,22 +5072,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
+			*binaryappend1() = 0x75;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r2);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jzi (uint r) {
@@ -4710,22 +5097,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x75;
+			*binaryappend1() = 0x75;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jnz (uint r) {
@@ -4739,8 +5125,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 0F 85 cd	JNZ rel32	#Jump near if not zero (ZF=0).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x0f;
-				*arrayu8append1(&b->binary) = 0x85;
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = 0x85;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4750,7 +5136,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0x75;
+				*binaryappend1() = 0x75;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4765,22 +5151,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
+			*binaryappend1() = 0x74;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			jr(r2);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jnzi (uint r) {
@@ -4791,22 +5176,21 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 74 cb	JZ rel8		#Jump short if zero (ZF=1).
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x74;
+			*binaryappend1() = 0x74;
 			
 			// Append the 8bits immediate
 			// field which is the bytesize
 			// of the following branching
 			// instruction.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			ji();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void j () {
@@ -4817,7 +5201,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// E9 cd	JMP rel32	#Jump relative, RIP = RIP + 32-bit.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0xe9;
+				*binaryappend1() = 0xe9;
 				
 				// Append the immediate value.
 				append32bitsimm(0);
@@ -4827,7 +5211,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// EB cb	JMP rel8	#Jump relative, RIP = RIP + 8-bit.
 				
 				// Append the opcode bytes.
-				*arrayu8append1(&b->binary) = 0xeb;
+				*binaryappend1() = 0xeb;
 				
 				// Append the immediate value.
 				append8bitsimm(0);
@@ -4848,13 +5232,12 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// ### is shorter, would segfault.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
+			*binaryappend1() = 0xe8;
 			
 			// Append a 32bits offset immediate value of zero.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
+			*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			// Pop in r the return address
 			// which is the address of
@@ -4869,19 +5252,19 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 83 /0 ib	ADD r/m32, imm8	#Add sign-extended imm8 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x83;
+			*binaryappend1() = 0x83;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, r);
 			
 			// Append 8bits immediate field.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
 			j();
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jlr (uint r1, uint r2) {
@@ -4898,13 +5281,12 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// ### is shorter, would segfault.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
+			*binaryappend1() = 0xe8;
 			
 			// Append a 32bits offset immediate value of zero.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
+			*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 			
-			u8* bbinaryptr = b->binary.ptr;
-			u8* opstartptr = (bbinaryptr + mmsz(bbinaryptr));
+			uint opstart = b->binarysz;
 			
 			// Pop in r1 the return address
 			// which is the address of
@@ -4919,19 +5301,19 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 83 /0 ib	ADD r/m32, imm8	#Add sign-extended imm8 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x83;
+			*binaryappend1() = 0x83;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(0, r1);
 			
 			// Append 8bits immediate field.
-			u8* imm = arrayu8append1(&b->binary);
+			uint imm = b->binarysz;
+			binaryappend1();
 			
 			jr(r2);
 			
-			bbinaryptr = b->binary.ptr;
 			// Set the 8bits immediate field appended above.
-			*imm = (mmsz(bbinaryptr) - ((uint)opstartptr - (uint)bbinaryptr));
+			binaryptr()[imm] = (b->binarysz - opstart);
 		}
 		
 		void jli (uint r) {
@@ -4966,7 +5348,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// E8 cd	CALL rel32	#Call relative.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
+			*binaryappend1() = 0xe8;
 			
 			// Append the immediate value.
 			append32bitsimm(0);
@@ -4977,7 +5359,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// FF /2	CALL r/m32	#Call absolute.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xff;
+			*binaryappend1() = 0xff;
 			
 			// Append the ModR/M byte.
 			appendmodrmfor1reg(2, r);
@@ -5015,7 +5397,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// C3	RET	#return to calling procedure.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xc3;
+			*binaryappend1() = 0xc3;
 		}
 		
 		void afip (uint r) {
@@ -5032,12 +5414,12 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// ### is shorter, would segfault.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
+			*binaryappend1() = 0xe8;
 			
 			// Append a 32bits offset immediate value of zero.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
+			*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 			
-			uint mmszbbinaryptr = mmsz(b->binary.ptr);
+			uint bbinarysz = b->binarysz;
 			
 			// Pop in r the return address
 			// which is the address of
@@ -5052,7 +5434,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Increment the immediate misc value
 			// to account for instructions from
 			// after the CALL instruction.
-			b->immmiscvalue += (mmsz(b->binary.ptr) - mmszbbinaryptr);
+			b->immmiscvalue += (b->binarysz - bbinarysz);
 		}
 		
 		void afip2 (uint r) {
@@ -5069,12 +5451,12 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// ### is shorter, would segfault.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xe8;
+			*binaryappend1() = 0xe8;
 			
 			// Append a 32bits offset immediate value of zero.
-			*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = (u32)0;
+			*(u32*)binaryappend2(sizeof(u32)) = (u32)0;
 			
-			uint mmszbbinaryptr = mmsz(b->binary.ptr);
+			uint bbinarysz = b->binarysz;
 			
 			// Pop in r the return address
 			// which is the address of
@@ -5089,7 +5471,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Increment the immediate misc value
 			// to account for instructions from
 			// after the CALL instruction.
-			b->imm2miscvalue += (mmsz(b->binary.ptr) - mmszbbinaryptr);
+			b->imm2miscvalue += (b->binarysz - bbinarysz);
 		}
 		
 		void ld8r (uint r1, uint r2) {
@@ -5097,8 +5479,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb6;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb6;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5107,7 +5489,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5116,8 +5498,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb6;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb6;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5144,8 +5526,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B6 /r	MOVZX r32, r/m8		#Move r/m8 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb6;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb6;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5159,8 +5541,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb7;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb7;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5169,7 +5551,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5178,8 +5560,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb7;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb7;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5206,8 +5588,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 0F B7 /r	MOVZX r32, r/m16	#Move r/m16 to r32, zero-extension.
 			
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0x0f;
-			*arrayu8append1(&b->binary) = 0xb7;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = 0xb7;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5221,7 +5603,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 8B /r	MOV r32,r/m32		#Move r/m32 to r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x8b;
+			*binaryappend1() = 0x8b;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5230,7 +5612,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5239,7 +5621,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 8B /r	MOV r32,r/m32		#Move r/m32 to r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x8b;
+			*binaryappend1() = 0x8b;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5266,7 +5648,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 8B /r	MOV r32,r/m32		#Move r/m32 to r32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x8b;
+			*binaryappend1() = 0x8b;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5318,7 +5700,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x88;
+			*binaryappend1() = 0x88;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(rvalid, r2);
@@ -5327,7 +5709,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(rvalid, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 			
 			if (rvalid != r1) {
@@ -5381,7 +5763,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x88;
+			*binaryappend1() = 0x88;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5452,7 +5834,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x88;
+			*binaryappend1() = 0x88;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(rvalid);
@@ -5474,10 +5856,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5486,7 +5868,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5496,10 +5878,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5527,10 +5909,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5544,7 +5926,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5553,7 +5935,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5562,7 +5944,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5589,7 +5971,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x89;
+			*binaryappend1() = 0x89;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5641,7 +6023,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x86;
+			*binaryappend1() = 0x86;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(rvalid, r2);
@@ -5650,7 +6032,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(rvalid, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 			
 			if (rvalid != r1) {
@@ -5706,7 +6088,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x86;
+			*binaryappend1() = 0x86;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5779,7 +6161,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 86 /r	XCHG r/m8, r8		#Exchange r8 with byte from r/m8.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x86;
+			*binaryappend1() = 0x86;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(rvalid);
@@ -5803,10 +6185,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5815,7 +6197,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5825,10 +6207,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5856,10 +6238,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5873,7 +6255,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			if (r2 != ESP && r2 != EBP)
 				modrmfor2regformemaccess(r1, r2);
@@ -5882,7 +6264,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				appendmodrmsib8bitsimm(r1, r2);
 				
 				// Append an 8bits immediate value of zero.
-				*arrayu8append1(&b->binary) = 0;
+				*binaryappend1() = 0;
 			}
 		}
 		
@@ -5891,7 +6273,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			if (b->isimmused == IMM32) {
 				
@@ -5918,7 +6300,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// 87 /r	XCHG r/m32, r32		#Exchange r32 with doubleword from r/m32.
 			
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0x87;
+			*binaryappend1() = 0x87;
 			
 			// Append the ModR/M byte.
 			appendmodrmimmaddr(r);
@@ -5927,45 +6309,711 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			append32bitsimm(0);
 		}
 		
-		void mem8cpy (uint r1, uint r2, uint r3) {
-			// r1, r2, r3 are assumed
-			// different registers.
+		// Function used to get a register
+		// to use temporarily, which is
+		// neither of the registers x, y, z.
+		// When is8bits is non-null, the register
+		// returned can be encoded in the field reg
+		// of an instruction ModR/M when it is used
+		// as an 8bits operand; either EBX, ECX, EDX,
+		// since EAX is expected to be in use.
+		// An unused register is used if
+		// there is one, otherwise the value
+		// of the register returned is saved.
+		// The register must be released
+		// using releasetmpreg() in the
+		// reverse order it was obtained.
+		uint gettmpreg (uint x, uint y, uint z, uint is8bits) {
 			
-			uint ediwassaved = 0;
-			uint esiwassaved = 0;
-			uint ecxwassaved = 0;
+			uint r;
 			
-			if (r1 != EDI && r2 != EDI && r3 != EDI) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(EDI)) {
-					savereg(EDI); ediwassaved = 1;
-				} else regsinusetmp[EDI] = 1; // Mark unused register as temporarily used.
+			if ((r = (is8bits ? findunusedregfor8bitsoperand(0) : findunusedreg(0)))) {
+				// Mark unused register as temporarily used.
+				regsinusetmp[r] = 1;
+				
+				return r;
 			}
 			
-			if (r1 != ESI && r2 != ESI && r3 != ESI) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(ESI)) {
-					savereg(ESI); esiwassaved = 1;
-				} else regsinusetmp[ESI] = 1; // Mark unused register as temporarily used.
-			}
+			r = EBX;
 			
-			if (r1 != ECX && r2 != ECX && r3 != ECX) {
-				// Save register value
-				// if it is being used.
-				if (isreginuse(ECX)) {
-					savereg(ECX); ecxwassaved = 1;
-				} else regsinusetmp[ECX] = 1; // Mark unused register as temporarily used.
-			}
+			while (r == x || r == y || r == z) ++r;
 			
-			// Set EDI, ESI, ECX
-			// respectively
-			// to r1, r2, r3 by
-			// first pushing them
-			// in the stack, and
-			// poping them in the
-			// order they were pushed.
+			savereg(r);
+			
+			return r;
+		}
+		
+		void releasetmpreg (uint r) {
+			// Restore register value.
+			if (savedregs[r]) restorereg(r);
+			// Unmark register as temporarily used.
+			else regsinusetmp[r] = 0;
+		}
+		
+		// Function used to generate
+		// a lock prefixed instruction
+		// where r is the register operand
+		// and the memory operand is at
+		// the address in the register m.
+		// The argument size is the byte size
+		// of the operands, and the argument
+		// opcode is the opcode used when
+		// the size of the operands is 16
+		// or 32 bits; the opcode used
+		// when the size of the operands is
+		// 8 bits is expected to be opcode-1.
+		// When the size of the operands is
+		// 8 bits, r must be either of EAX,
+		// EBX, ECX, EDX.
+		void lockedop (u8 opcode, uint r, uint m, uint size) {
+			// Specification from the Intel manual.
+			// F0		LOCK		#Asserts LOCK# signal for duration of the accompanying instruction.
+			*binaryappend1() = 0xf0;
+			
+			// Specification from the Intel manual.
+			// 66		#Operand-size override prefix.
+			if (size == 2) *binaryappend1() = 0x66;
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = (opcode - (size == 1));
+			
+			if (m != ESP && m != EBP)
+				modrmfor2regformemaccess(r, m);
+			else {
+				// Append the ModR/M and SIB bytes.
+				appendmodrmsib8bitsimm(r, m);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
+		}
+		
+		// Specification from the Intel manual.
+		// 0F B0 /r	CMPXCHG r/m8, r8	#Compare AL with r/m8. If equal, ZF is set and r8 is loaded into r/m8. Else, clear ZF and load r/m8 into AL.
+		// 0F B1 /r	CMPXCHG r/m16, r16	#Compare AX with r/m16. If equal, ZF is set and r16 is loaded into r/m16. Else, clear ZF and load r/m16 into AX.
+		// 0F B1 /r	CMPXCHG r/m32, r32	#Compare EAX with r/m32. If equal, ZF is set and r32 is loaded into r/m32. Else, clear ZF and load r/m32 into EAX.
+		enum {CMPXCHGOPCODE = 0xb1};
+		
+		// Specification from the Intel manual.
+		// 0F C0 /r	XADD r/m8, r8		#Exchange r8 and r/m8; load sum into r/m8.
+		// 0F C1 /r	XADD r/m16, r16		#Exchange r16 and r/m16; load sum into r/m16.
+		// 0F C1 /r	XADD r/m32, r32		#Exchange r32 and r/m32; load sum into r/m32.
+		enum {XADDOPCODE = 0xc1};
+		
+		void cas (uint r1, uint r2, uint r3, uint size) {
+			// The instruction cmpxchg use EAX
+			// for the value to compare with,
+			// and set EAX to the value that
+			// was in memory; so if r1 is not EAX,
+			// their values are exchanged,
+			// and the registers r2 and r3 are
+			// renamed accordingly.
+			if (r1 != EAX) {
+				
+				xchg(r1, EAX);
+				
+				if (r2 == EAX) r2 = r1;
+				else if (r2 == r1) r2 = EAX;
+				
+				if (r3 == EAX) r3 = r1;
+				else if (r3 == r1) r3 = EAX;
+			}
+			
+			uint eaxwasinusetmp = regsinusetmp[EAX];
+			
+			// Mark EAX as temporarily used
+			// so that it is not returned
+			// by gettmpreg().
+			regsinusetmp[EAX] = 1;
+			
+			// If r2 was the same register
+			// as r1, its value is now in EAX,
+			// which will get modified by cmpxchg;
+			// so a temporary register is used.
+			uint t2 = 0;
+			
+			if (r2 == EAX) {
+				
+				t2 = gettmpreg(EAX, r3, r3, 0);
+				
+				cpy(t2, EAX);
+				
+				r2 = t2;
+			}
+			
+			// Similarly a temporary register
+			// is used for r3 if it was the same
+			// register as r1, or if it cannot be
+			// used as an 8bits operand.
+			uint t3 = 0;
+			
+			if (r3 == EAX || (size == 1 && r3 > EDX)) {
+				
+				t3 = gettmpreg(EAX, r2, r3, (size == 1));
+				
+				cpy(t3, r3);
+				
+				r3 = t3;
+			}
+			
+			lockedop(CMPXCHGOPCODE, r3, r2, size);
+			
+			if (t3) releasetmpreg(t3);
+			if (t2) releasetmpreg(t2);
+			
+			regsinusetmp[EAX] = eaxwasinusetmp;
+			
+			if (r1 != EAX) xchg(r1, EAX);
+			
+			// When the comparison succeed,
+			// EAX is not modified; and when
+			// it fails, only the bits of
+			// the size of the operands are
+			// loaded; so zero extension is done.
+			if (size < 4) zxt(r1, size*8);
+		}
+		
+		void fetchadd (uint r1, uint r2, uint size, uint issub) {
+			
+			uint t = 0;
+			
+			// If r1 and r2 are the same
+			// register, the address is copied
+			// in a temporary register since
+			// r1 get modified by xadd.
+			if (r1 == r2) {
+				
+				t = gettmpreg(r1, r1, r1, 0);
+				
+				cpy(t, r1);
+				
+				r2 = t;
+			}
+			
+			// Register which will be
+			// used with xadd; it must be
+			// usable as an 8bits operand
+			// when the size of the operands
+			// is 8 bits.
+			uint v = r1;
+			
+			if (size == 1 && (r1 < EAX || r1 > EDX)) {
+				
+				v = gettmpreg(r1, r2, r2, 1);
+				
+				cpy(v, r1);
+			}
+			
+			// Substraction is done adding
+			// the two's complement of r1.
+			if (issub) neg(v);
+			
+			lockedop(XADDOPCODE, v, r2, size);
+			
+			if (v != r1) {
+				
+				cpy(r1, v);
+				
+				releasetmpreg(v);
+			}
+			
+			if (t) releasetmpreg(t);
+			
+			// xadd only load the bits
+			// of the size of the operands;
+			// so zero extension is done.
+			if (size < 4) zxt(r1, size*8);
+		}
+		
+		void fetchandor (uint r1, uint r2, uint size, uint isor) {
+			// There is no x86 instruction which
+			// atomically do "and" or "or" while
+			// returning the value that was in memory;
+			// so a loop using cmpxchg is generated.
+			// EAX is used for the value read from
+			// memory; so if r1 is not EAX,
+			// their values are exchanged,
+			// and the register r2 is renamed
+			// accordingly.
+			if (r1 != EAX) {
+				
+				xchg(r1, EAX);
+				
+				if (r2 == EAX) r2 = r1;
+				else if (r2 == r1) r2 = EAX;
+			}
+			
+			uint eaxwasinusetmp = regsinusetmp[EAX];
+			
+			// Mark EAX as temporarily used
+			// so that it is not returned
+			// by gettmpreg().
+			regsinusetmp[EAX] = 1;
+			
+			// The operand is copied from EAX
+			// to the register v, which is also
+			// used for the address if r1 and r2
+			// were the same register.
+			uint v = gettmpreg(EAX, r2, r2, 0);
+			
+			cpy(v, EAX);
+			
+			if (r2 == EAX) r2 = v;
+			
+			// Register used to compute
+			// the value to store in memory.
+			uint t = gettmpreg(EAX, r2, v, (size == 1));
+			
+			// Load in EAX, the value in memory;
+			// the load zero extend the value.
+			if (size == 1) ld8r(EAX, r2);
+			else if (size == 2) ld16r(EAX, r2);
+			else ld32r(EAX, r2);
+			
+			uint loopstart = b->binarysz;
+			
+			cpy(t, EAX);
+			
+			if (isor) or(t, v);
+			else and(t, v);
+			
+			lockedop(CMPXCHGOPCODE, t, r2, size);
+			
+			// Specification from the Intel manual.
+			// 75 cb	JNE rel8	#Jump short if not equal (ZF=0).
+			*binaryappend1() = 0x75;
+			
+			// Append the 8bits offset which branch
+			// back to the start of the loop if
+			// the value in memory was modified.
+			uint imm = b->binarysz;
+			binaryappend1();
+			binaryptr()[imm] = (loopstart - b->binarysz);
+			
+			releasetmpreg(t);
+			releasetmpreg(v);
+			
+			regsinusetmp[EAX] = eaxwasinusetmp;
+			
+			// EAX has the zero extended value
+			// that was in memory, since cmpxchg
+			// only modify the bits of the size
+			// of the operands when it fails.
+			if (r1 != EAX) xchg(r1, EAX);
+		}
+		
+		void fence () {
+			// The instruction mfence is not
+			// available on all x86 processors;
+			// a lock prefixed instruction which
+			// do not modify memory is used instead,
+			// since it is also a full memory fence.
+			
+			// Specification from the Intel manual.
+			// F0		LOCK		#Asserts LOCK# signal for duration of the accompanying instruction.
+			// 83 /1 ib	OR r/m32, imm8		#r/m32 OR imm8 (sign-extended).
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0xf0;
+			*binaryappend1() = 0x83;
+			
+			// Append the ModR/M and SIB bytes
+			// for the address (ESP + 0); ECX
+			// is used since it encode /1.
+			appendmodrmsib8bitsimm(ECX, ESP);
+			*binaryappend1() = 0;
+			
+			// Append the immediate value of zero.
+			*binaryappend1() = 0;
+		}
+		
+		// Vector lyricalinstruction are done
+		// using XMM0 and XMM1, which are never
+		// used otherwise by the generated code.
+		// Their values are the ids of the registers
+		// which lookupreg() convert to 0 and 1,
+		// so that the functions generating
+		// the ModR/M byte can be used with them.
+		enum {XMM0 = EAX, XMM1 = ECX};
+		
+		// Function used to generate an SSE2
+		// instruction which use the opcode bytes
+		// 0F op, prefixed with the byte prefix;
+		// when ismem is true, the R/M operand
+		// is the memory location at the address
+		// in the register rm.
+		void sse2op (u8 prefix, u8 op, uint reg, uint rm, uint ismem) {
+			// Vector and floating point
+			// lyricalinstruction are not supported
+			// when the CPU do not support SSE2.
+			if (!hassse2) throwerror();
+			
+			// Append the opcode bytes.
+			*binaryappend1() = prefix;
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = op;
+			
+			if (!ismem) appendmodrmfor2reg(reg, rm);
+			else if (rm != ESP && rm != EBP) modrmfor2regformemaccess(reg, rm);
+			else {
+				// Append the ModR/M and SIB bytes.
+				appendmodrmsib8bitsimm(reg, rm);
+				
+				// Append an 8bits immediate value of zero.
+				*binaryappend1() = 0;
+			}
+		}
+		
+		// Specification from the Intel manual.
+		// F3 0F 6F /r	MOVDQU xmm1, xmm2/m128	#Move unaligned double quadword from xmm2/m128 to xmm1.
+		void vld (uint x, uint r) {
+			sse2op(0xf3, 0x6f, x, r, 1);
+		}
+		
+		// Specification from the Intel manual.
+		// F3 0F 7F /r	MOVDQU xmm2/m128, xmm1	#Move unaligned double quadword from xmm1 to xmm2/m128.
+		void vst (uint r, uint x) {
+			sse2op(0xf3, 0x7f, x, r, 1);
+		}
+		
+		// Specification from the Intel manual.
+		// 66 0F FC /r	PADDB xmm1, xmm2/m128	#Add packed byte integers from xmm2/m128 and xmm1.
+		// 66 0F FD /r	PADDW xmm1, xmm2/m128	#Add packed word integers from xmm2/m128 and xmm1.
+		// 66 0F FE /r	PADDD xmm1, xmm2/m128	#Add packed doubleword integers from xmm2/m128 and xmm1.
+		// 66 0F D4 /r	PADDQ xmm1, xmm2/m128	#Add packed quadword integers from xmm2/m128 and xmm1.
+		// 66 0F F8 /r	PSUBB xmm1, xmm2/m128	#Subtract packed byte integers in xmm2/m128 from xmm1.
+		// 66 0F F9 /r	PSUBW xmm1, xmm2/m128	#Subtract packed word integers in xmm2/m128 from xmm1.
+		// 66 0F FA /r	PSUBD xmm1, xmm2/m128	#Subtract packed doubleword integers in xmm2/m128 from xmm1.
+		// 66 0F FB /r	PSUBQ xmm1, xmm2/m128	#Subtract packed quadword integers in xmm2/m128 from xmm1.
+		// 66 0F DB /r	PAND xmm1, xmm2/m128	#Bitwise AND of xmm2/m128 and xmm1.
+		// 66 0F EB /r	POR xmm1, xmm2/m128	#Bitwise OR of xmm2/m128 and xmm1.
+		// 66 0F EF /r	PXOR xmm1, xmm2/m128	#Bitwise XOR of xmm2/m128 and xmm1.
+		// 66 0F 74 /r	PCMPEQB xmm1, xmm2/m128	#Compare packed bytes in xmm2/m128 and xmm1 for equality.
+		// 66 0F 75 /r	PCMPEQW xmm1, xmm2/m128	#Compare packed words in xmm2/m128 and xmm1 for equality.
+		// 66 0F 76 /r	PCMPEQD xmm1, xmm2/m128	#Compare packed doublewords in xmm2/m128 and xmm1 for equality.
+		void vop (u8 op, uint r1, uint r2, uint r3) {
+			// The second operand is loaded
+			// in XMM1 instead of being used
+			// as a memory operand, because
+			// memory operands of SSE2 instructions
+			// must be aligned to 16 bytes.
+			vld(XMM0, r2);
+			vld(XMM1, r3);
+			
+			sse2op(0x66, op, XMM0, XMM1, 0);
+			
+			vst(r1, XMM0);
+		}
+		
+		void vmovmsk8 (uint r1, uint r2) {
+			
+			vld(XMM0, r2);
+			
+			// Specification from the Intel manual.
+			// 66 0F D7 /r	PMOVMSKB reg, xmm	#Move a byte mask of xmm to reg; the upper bits of reg are zero filled.
+			sse2op(0x66, 0xd7, r1, XMM0, 0);
+		}
+		
+		void vbcast (uint r1, uint r2, uint size) {
+			// Specification from the Intel manual.
+			// 66 0F 6E /r	MOVD xmm, r/m32		#Move doubleword from r/m32 to xmm.
+			sse2op(0x66, 0x6e, XMM0, r2, 0);
+			
+			// Specification from the Intel manual.
+			// 66 0F 60 /r	PUNPCKLBW xmm1, xmm2/m128	#Interleave low-order bytes from xmm1 and xmm2/m128 into xmm1.
+			// 66 0F 61 /r	PUNPCKLWD xmm1, xmm2/m128	#Interleave low-order words from xmm1 and xmm2/m128 into xmm1.
+			if (size == 1) sse2op(0x66, 0x60, XMM0, XMM0, 0);
+			if (size <= 2) sse2op(0x66, 0x61, XMM0, XMM0, 0);
+			
+			// Specification from the Intel manual.
+			// 66 0F 70 /r ib	PSHUFD xmm1, xmm2/m128, imm8	#Shuffle the doublewords in xmm2/m128 based on the encoding in imm8.
+			sse2op(0x66, 0x70, XMM0, XMM0, 0);
+			
+			// Append the 8bits immediate value
+			// which select the first doubleword
+			// for all the doublewords.
+			*binaryappend1() = 0;
+			
+			vst(r1, XMM0);
+		}
+		
+		// Floating point lyricalinstruction
+		// are also done using XMM0 and XMM1;
+		// the bits of a 32bits floating point value
+		// are held in a gpr; 64bits floating point
+		// values are not supported because they
+		// do not fit in a gpr.
+		
+		// Specification from the Intel manual.
+		// 66 0F 6E /r	MOVD xmm, r/m32		#Move doubleword from r/m32 to xmm.
+		void movtoxmm (uint x, uint r) {
+			sse2op(0x66, 0x6e, x, r, 0);
+		}
+		
+		// Specification from the Intel manual.
+		// 66 0F 7E /r	MOVD r/m32, xmm		#Move doubleword from xmm to r/m32.
+		void movfromxmm (uint r, uint x) {
+			sse2op(0x66, 0x7e, x, r, 0);
+		}
+		
+		// Specification from the Intel manual.
+		// F3 0F 58 /r	ADDSS xmm1, xmm2/m32	#Add the low single-precision floating-point value from xmm2/m32 to xmm1.
+		// F3 0F 5C /r	SUBSS xmm1, xmm2/m32	#Subtract the low single-precision floating-point value in xmm2/m32 from xmm1.
+		// F3 0F 59 /r	MULSS xmm1, xmm2/m32	#Multiply the low single-precision floating-point value in xmm2/m32 by xmm1.
+		// F3 0F 5E /r	DIVSS xmm1, xmm2/m32	#Divide the low single-precision floating-point value in xmm1 by xmm2/m32.
+		void fop (u8 op, uint r1, uint r2, uint r3) {
+			
+			movtoxmm(XMM0, r2);
+			movtoxmm(XMM1, r3);
+			
+			sse2op(0xf3, op, XMM0, XMM1, 0);
+			
+			movfromxmm(r1, XMM0);
+		}
+		
+		// The predicate is 0 for equal,
+		// 1 for less-than and 2 for less-than-or-equal;
+		// those predicates are false when
+		// any of the operands is a NaN.
+		void fcmp (u8 predicate, uint r1, uint r2, uint r3) {
+			
+			movtoxmm(XMM0, r2);
+			movtoxmm(XMM1, r3);
+			
+			// Specification from the Intel manual.
+			// F3 0F C2 /r ib	CMPSS xmm1, xmm2/m32, imm8	#Compare low single-precision floating-point value in xmm2/m32 and xmm1 using imm8 as comparison predicate.
+			sse2op(0xf3, 0xc2, XMM0, XMM1, 0);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = predicate;
+			
+			// The result of the comparison
+			// is a mask of all ones or all zeros,
+			// from which only the lsb is kept.
+			movfromxmm(r1, XMM0);
+			
+			andimm(r1, 1);
+		}
+		
+		void itof (uint r1, uint r2) {
+			// Specification from the Intel manual.
+			// F3 0F 2A /r	CVTSI2SS xmm1, r/m32	#Convert one signed doubleword integer from r/m32 to one single-precision floating-point value in xmm1.
+			sse2op(0xf3, 0x2a, XMM0, r2, 0);
+			
+			movfromxmm(r1, XMM0);
+		}
+		
+		void ftoi (uint r1, uint r2) {
+			
+			movtoxmm(XMM0, r2);
+			
+			// Specification from the Intel manual.
+			// F3 0F 2C /r	CVTTSS2SI r32, xmm1/m32	#Convert one single-precision floating-point value from xmm1/m32 to one signed doubleword integer in r32 using truncation.
+			sse2op(0xf3, 0x2c, r1, XMM0, 0);
+		}
+		
+		// Function used to generate
+		// an instruction which use the
+		// opcode bytes 0F op with a 32bits
+		// register operand r1 and a 32bits
+		// register or memory operand r2;
+		// when isf3 is true, the instruction
+		// is prefixed with the byte F3.
+		void bitcountop (uint isf3, u8 op, uint r1, uint r2) {
+			
+			if (isf3) *binaryappend1() = 0xf3;
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = op;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor2reg(r1, r2);
+		}
+		
+		void popcnt (uint r1, uint r2) {
+			
+			if (haspopcnt) {
+				// Specification from the Intel manual.
+				// F3 0F B8 /r	POPCNT r32, r/m32	#POPCNT on r/m32.
+				bitcountop(1, 0xb8, r1, r2);
+				
+				return;
+			}
+			
+			// I get here if the CPU do not
+			// support the instruction POPCNT.
+			// The bits are counted in parallel
+			// within groups of 2, 4 and 8 bits,
+			// and the counts of the groups of
+			// 8 bits are summed by a multiplication
+			// which leave their sum in the
+			// most significant byte.
+			
+			uint t = gettmpreg(r1, r2, r2, 0);
+			uint c = gettmpreg(r1, r2, t, 0);
+			
+			// x = x - ((x >> 1) & 0x55555555);
+			cpy(t, r2);
+			srlimm(t, 1);
+			loadimm(c, 0x55555555);
+			and(t, c);
+			if (r1 != r2) cpy(r1, r2);
+			sub(r1, t);
+			
+			// x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+			cpy(t, r1);
+			srlimm(t, 2);
+			loadimm(c, 0x33333333);
+			and(t, c);
+			and(r1, c);
+			add(r1, t);
+			
+			// x = (x + (x >> 4)) & 0x0f0f0f0f;
+			cpy(t, r1);
+			srlimm(t, 4);
+			add(r1, t);
+			loadimm(c, 0x0f0f0f0f);
+			and(r1, c);
+			
+			// x = (x * 0x01010101) >> 24;
+			loadimm(c, 0x01010101);
+			mul(r1, c);
+			srlimm(r1, 24);
+			
+			releasetmpreg(c);
+			releasetmpreg(t);
+		}
+		
+		// Function used to generate
+		// a jnz rel8 over the instruction
+		// that load the immediate value n
+		// in the register r.
+		void jnzoverloadimm (uint r, u32 n) {
+			// Specification from the Intel manual.
+			// 75 cb	JNZ rel8	#Jump short if not zero (ZF=0).
+			*binaryappend1() = 0x75;
+			
+			uint imm = b->binarysz;
+			binaryappend1();
+			
+			loadimm(r, n);
+			
+			binaryptr()[imm] = (b->binarysz - (imm + 1));
+		}
+		
+		void clz (uint r1, uint r2) {
+			
+			if (haslzcnt) {
+				// Specification from the Intel manual.
+				// F3 0F BD /r	LZCNT r32, r/m32	#Count the number of leading zero bits in r/m32, return result in r32.
+				bitcountop(1, 0xbd, r1, r2);
+				
+				return;
+			}
+			
+			// I get here if the CPU do not
+			// support the instruction LZCNT.
+			
+			// Specification from the Intel manual.
+			// 0F BD /r	BSR r32, r/m32		#Bit scan reverse on r/m32.
+			bitcountop(0, 0xbd, r1, r2);
+			
+			// BSR set ZF and leave its destination
+			// undefined when its source is null;
+			// 63 is loaded in that case, so that
+			// the xor below result in 32.
+			jnzoverloadimm(r1, 63);
+			
+			// The index of the most significant
+			// bit set is converted to a count of
+			// leading null bits using (31 ^ index).
+			
+			// Specification from the Intel manual.
+			// 83 /6 ib	XOR r/m32, imm8		#r/m32 XOR imm8 (sign-extended).
+			
+			// Append the opcode byte.
+			*binaryappend1() = 0x83;
+			
+			// Append the ModR/M byte.
+			appendmodrmfor1reg(6, r1);
+			
+			// Append the 8bits immediate value.
+			*binaryappend1() = 31;
+		}
+		
+		void ctz (uint r1, uint r2) {
+			
+			if (hastzcnt) {
+				// Specification from the Intel manual.
+				// F3 0F BC /r	TZCNT r32, r/m32	#Count the number of trailing zero bits in r/m32, return result in r32.
+				bitcountop(1, 0xbc, r1, r2);
+				
+				return;
+			}
+			
+			// I get here if the CPU do not
+			// support the instruction TZCNT.
+			
+			// Specification from the Intel manual.
+			// 0F BC /r	BSF r32, r/m32		#Bit scan forward on r/m32.
+			bitcountop(0, 0xbc, r1, r2);
+			
+			// BSF set ZF and leave its destination
+			// undefined when its source is null;
+			// 32 is loaded in that case.
+			jnzoverloadimm(r1, 32);
+		}
+		
+		void bswap (uint r) {
+			// Specification from the Intel manual.
+			// 0F C8+rd	BSWAP r32		#Reverses the byte order of a 32-bit register.
+			
+			// Append the opcode bytes.
+			*binaryappend1() = 0x0f;
+			*binaryappend1() = (0xc8+lookupreg(r));
+		}
+		
+		void mem8cpy (uint r1, uint r2, uint r3) {
+			// r1, r2, r3 are assumed
+			// different registers.
+			
+			uint ediwassaved = 0;
+			uint esiwassaved = 0;
+			uint ecxwassaved = 0;
+			
+			if (r1 != EDI && r2 != EDI && r3 != EDI) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(EDI)) {
+					savereg(EDI); ediwassaved = 1;
+				} else regsinusetmp[EDI] = 1; // Mark unused register as temporarily used.
+			}
+			
+			if (r1 != ESI && r2 != ESI && r3 != ESI) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(ESI)) {
+					savereg(ESI); esiwassaved = 1;
+				} else regsinusetmp[ESI] = 1; // Mark unused register as temporarily used.
+			}
+			
+			if (r1 != ECX && r2 != ECX && r3 != ECX) {
+				// Save register value
+				// if it is being used.
+				if (isreginuse(ECX)) {
+					savereg(ECX); ecxwassaved = 1;
+				} else regsinusetmp[ECX] = 1; // Mark unused register as temporarily used.
+			}
+			
+			// Set EDI, ESI, ECX
+			// respectively
+			// to r1, r2, r3 by
+			// first pushing them
+			// in the stack, and
+			// poping them in the
+			// order they were pushed.
 			if (r3 != ECX) push(r3);
 			if (r2 != ESI) push(r2);
 			if (r1 != EDI) {
@@ -5981,7 +7029,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Repeat the instruction movsb
 			// until ECX become null.
@@ -5989,8 +7037,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A4	MOVSB		#Move 8bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa4;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa4;
 			
 			// Set r1, r2
 			// respectively
@@ -6084,7 +7132,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Repeat the instruction movsb
 			// until ECX become null.
@@ -6092,8 +7140,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A4	MOVSB		#Move 8bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa4;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa4;
 			
 			// Set r1, r2
 			// respectively
@@ -6187,11 +7235,11 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Repeat the instruction movsd
 			// until ECX become null.
@@ -6199,8 +7247,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSW		#Move 16bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -6294,11 +7342,11 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Append the prefix byte 0x66
 			// to consider operands as 16bits.
-			*arrayu8append1(&b->binary) = 0x66;
+			*binaryappend1() = 0x66;
 			
 			// Repeat the instruction movsd
 			// until ECX become null.
@@ -6306,8 +7354,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSW		#Move 16bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -6401,7 +7449,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FC	CLD	#Clear DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfc;
+			*binaryappend1() = 0xfc;
 			
 			// Repeat the instruction movsd
 			// until ECX become null.
@@ -6409,8 +7457,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSD		#Move 32bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -6504,7 +7552,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// FD	STD	#Set DF Flag.
 			// Append the opcode byte.
-			*arrayu8append1(&b->binary) = 0xfd;
+			*binaryappend1() = 0xfd;
 			
 			// Repeat the instruction movsd
 			// until ECX become null.
@@ -6512,8 +7560,8 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// Specification from the Intel manual.
 			// F3 A5	MOVSD		#Move 32bits data from address ESI to address EDI.
 			// Append the opcode bytes.
-			*arrayu8append1(&b->binary) = 0xf3;
-			*arrayu8append1(&b->binary) = 0xa5;
+			*binaryappend1() = 0xf3;
+			*binaryappend1() = 0xa5;
 			
 			// Set r1, r2
 			// respectively
@@ -6553,6 +7601,118 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			} else regsinusetmp[EDI] = 0;
 		}
 		
+		// Function used to load in r1, when isstore
+		// is null, or store from r1, when isstore
+		// is non-null, a value of size bytes located
+		// in memory at the address in r2 added to
+		// the 8bits displacement disp.
+		// A loaded value smaller than 32bits
+		// is zero extended.
+		// When storing 8bits, r1 must be
+		// either EAX, EBX, ECX, EDX.
+		void ldstdisp8 (uint r1, uint r2, s8 disp, uint size, uint isstore) {
+			// Specification from the Intel manual.
+			// 66		#Operand-size override prefix.
+			if (size == 2 && isstore) *binaryappend1() = 0x66;
+			
+			// Append the opcode bytes.
+			if (isstore) {
+				// Specification from the Intel manual.
+				// 88 /r	MOV r/m8,r8		#Move r8 to r/m8.
+				// 89 /r	MOV r/m32,r32		#Move r32 to r/m32; r16 to r/m16 with prefix 66.
+				*binaryappend1() = ((size == 1) ? 0x88 : 0x89);
+				
+			} else if (size < 4) {
+				// Specification from the Intel manual.
+				// 0F B6 /r	MOVZX r32, r/m8		#Move byte to doubleword, zero-extension.
+				// 0F B7 /r	MOVZX r32, r/m16	#Move word to doubleword, zero-extension.
+				*binaryappend1() = 0x0f;
+				*binaryappend1() = ((size == 1) ? 0xb6 : 0xb7);
+				
+			} else {
+				// Specification from the Intel manual.
+				// 8B /r	MOV r32,r/m32		#Move r/m32 to r32.
+				*binaryappend1() = 0x8b;
+			}
+			
+			// Append the ModR/M byte, and
+			// the SIB byte when r2 is ESP.
+			if (r2 != ESP) appendmodrmfor2regformemaccesswith8imm(r1, r2);
+			else appendmodrmsib8bitsimm(r1, r2);
+			
+			// Append the 8bits displacement.
+			*binaryappend1() = disp;
+		}
+		
+		// Largest count of bytes for which the
+		// instructions LYRICALOPMEM*CPYI* are
+		// expanded into load and store pairs.
+		// Beyond that count, the string move
+		// instructions are faster than the extra
+		// instruction bytes fetched and decoded,
+		// especially since their use require
+		// saving and restoring EDI, ESI, ECX.
+		// It must not be greater than 64 because
+		// the displacements used are 8bits.
+		#define MEMCPYIEXPANDMAXSIZE 64
+		
+		// Function used to expand the
+		// lyricalinstruction MEM*CPYI* being
+		// converted when its immediate value
+		// is a constant small enough; in which
+		// case each element of size bytes is copied
+		// using a load and a store through an
+		// unused register, in the same order that
+		// the string move instruction would have used.
+		// isdecrementing is non-null for MEM*CPYI2.
+		// Null is returned if the lyricalinstruction
+		// could not be expanded.
+		uint expandmemcpyi (uint size, uint isdecrementing) {
+			
+			lyricalimmval* imm = i->imm;
+			
+			if (imm->type != LYRICALIMMVALUE || imm->next) return 0;
+			
+			u32 n = imm->n;
+			
+			if (!n || n > (MEMCPYIEXPANDMAXSIZE/size)) return 0;
+			
+			// Look for an unused register;
+			// storing 8bits require a register
+			// that can be used as an 8bits operand.
+			uint unusedreg = ((size == 1) ?
+				findunusedregfor8bitsoperand(0) :
+				findunusedreg(0));
+				
+			if (!unusedreg) return 0;
+			
+			// Mark unused register as temporarily used.
+			regsinusetmp[unusedreg] = 1;
+			
+			uint j;
+			
+			for (j = 0; j < n; ++j) {
+				
+				s8 disp = (isdecrementing ? -(j*size) : (j*size));
+				
+				ldstdisp8(unusedreg, i->r2, disp, size, 0);
+				ldstdisp8(unusedreg, i->r1, disp, size, 1);
+			}
+			
+			// At the end of the copy, r1 and r2
+			// hold the address of the next memory
+			// locations that would have been used.
+			s8 disp = (isdecrementing ? -(n*size) : (n*size));
+			
+			inc8(i->r1, disp);
+			inc8(i->r2, disp);
+			
+			// Unmark register as temporarily used.
+			regsinusetmp[unusedreg] = 0;
+			
+			return 1;
+		}
+		
 		void pushi (u32 imm) {
 			
 			if ((((sint)imm < 0) ? -imm : imm) < (1 << 7)) {
@@ -6560,10 +7720,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 6A		PUSH imm8	#Push imm8 (Sign-extended).
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x6a;
+				*binaryappend1() = 0x6a;
 				
 				// Append the 8bits immediate value.
-				*arrayu8append1(&b->binary) = imm;
+				*binaryappend1() = imm;
 				
 			}
 			#if 0
@@ -6576,13 +7736,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				
 				// Append the prefix byte 0x66
 				// to consider operands as 16bits.
-				*arrayu8append1(&b->binary) = 0x66;
+				*binaryappend1() = 0x66;
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x68;
+				*binaryappend1() = 0x68;
 				
 				// Append the 16bits immediate value.
-				*(u16*)arrayu8append2(&b->binary, sizeof(u16)) = imm;
+				*(u16*)binaryappend2(sizeof(u16)) = imm;
 				
 			}
 			#endif
@@ -6591,10 +7751,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				// 68		PUSH imm32	#Push imm32.
 				
 				// Append the opcode byte.
-				*arrayu8append1(&b->binary) = 0x68;
+				*binaryappend1() = 0x68;
 				
 				// Append the 32bits immediate value.
-				*(u32*)arrayu8append2(&b->binary, sizeof(u32)) = imm;
+				*(u32*)binaryappend2(sizeof(u32)) = imm;
 			}
 		}
 		
@@ -6665,9 +7825,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				
 				if (bintreefind(toredo, (uint)i)) {
 					
-					mmfree(b->binary.ptr);
+					if (b->redobinary.ptr) {
+						
+						mmfree(b->redobinary.ptr);
+						
+						b->redobinary = arrayu8null;
+					}
 					
-					b->binary = arrayu8null;
+					b->binarysz = 0;
 					
 				} else goto skipredo;
 				
@@ -6678,7 +7843,9 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				
 			} else {
 				
-				b = (backenddata*)mmallocz(sizeof(backenddata));
+				b = &backenddatas[backenddatasidx++];
+				
+				b->codeoffset = codebufsz;
 				
 				i->backenddata = b;
 			}
@@ -7358,6 +8525,112 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					
 					break;
 					
+				case LYRICALOPROL:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						rol(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(ECX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						rol(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						rol(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPROLI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					roli(i->r1);
+					
+					break;
+					
+				case LYRICALOPROR:
+					
+					if (i->r1 != i->r3) {
+						
+						if (i->r1 != i->r2) cpy(i->r1, i->r2);
+						
+						ror(i->r1, i->r3);
+						
+					} else if (i->r1 != i->r2) {
+						// Look for an unused register.
+						uint unusedreg = findunusedreg(ECX);
+						
+						// The compiler should have insured
+						// that there are enough unused
+						// registers available.
+						if (!unusedreg) throwerror();
+						
+						regsinusetmp[unusedreg] = 1; // Mark unused register as temporarily used.
+						
+						cpy(unusedreg, i->r1);
+						cpy(i->r1, i->r2);
+						ror(i->r1, unusedreg);
+						
+						regsinusetmp[unusedreg] = 0; // Unmark register as temporarily used.
+						
+					} else {
+						
+						ror(i->r1, i->r2);
+					}
+					
+					break;
+					
+				case LYRICALOPRORI:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					rori(i->r1);
+					
+					break;
+					
+				case LYRICALOPBSWAP:
+					
+					if (i->r1 != i->r2) cpy(i->r1, i->r2);
+					
+					bswap(i->r1);
+					
+					break;
+					
+				case LYRICALOPPOPCNT:
+					
+					popcnt(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPCLZ:
+					
+					clz(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPCTZ:
+					
+					ctz(i->r1, i->r2);
+					
+					break;
+					
 				case LYRICALOPZXT:
 					
 					if (i->r1 != i->r2) cpy(i->r1, i->r2);
@@ -7960,6 +9233,272 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					
 					break;
 					
+				case LYRICALOPCAS8:
+					
+					cas(i->r1, i->r2, i->r3, 1);
+					
+					break;
+					
+				case LYRICALOPCAS16:
+					
+					cas(i->r1, i->r2, i->r3, 2);
+					
+					break;
+					
+				case LYRICALOPCAS32:
+					
+					cas(i->r1, i->r2, i->r3, 4);
+					
+					break;
+					
+				case LYRICALOPFETCHADD8:
+					
+					fetchadd(i->r1, i->r2, 1, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHADD16:
+					
+					fetchadd(i->r1, i->r2, 2, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHADD32:
+					
+					fetchadd(i->r1, i->r2, 4, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHSUB8:
+					
+					fetchadd(i->r1, i->r2, 1, 1);
+					
+					break;
+					
+				case LYRICALOPFETCHSUB16:
+					
+					fetchadd(i->r1, i->r2, 2, 1);
+					
+					break;
+					
+				case LYRICALOPFETCHSUB32:
+					
+					fetchadd(i->r1, i->r2, 4, 1);
+					
+					break;
+					
+				case LYRICALOPFETCHAND8:
+					
+					fetchandor(i->r1, i->r2, 1, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHAND16:
+					
+					fetchandor(i->r1, i->r2, 2, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHAND32:
+					
+					fetchandor(i->r1, i->r2, 4, 0);
+					
+					break;
+					
+				case LYRICALOPFETCHOR8:
+					
+					fetchandor(i->r1, i->r2, 1, 1);
+					
+					break;
+					
+				case LYRICALOPFETCHOR16:
+					
+					fetchandor(i->r1, i->r2, 2, 1);
+					
+					break;
+					
+				case LYRICALOPFETCHOR32:
+					
+					fetchandor(i->r1, i->r2, 4, 1);
+					
+					break;
+					
+				case LYRICALOPFENCE:
+					
+					fence();
+					
+					break;
+					
+				case LYRICALOPVCPY:
+					
+					vld(XMM0, i->r2);
+					
+					vst(i->r1, XMM0);
+					
+					break;
+					
+				case LYRICALOPVADD8:
+					
+					vop(0xfc, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVADD16:
+					
+					vop(0xfd, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVADD32:
+					
+					vop(0xfe, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVADD64:
+					
+					vop(0xd4, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVSUB8:
+					
+					vop(0xf8, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVSUB16:
+					
+					vop(0xf9, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVSUB32:
+					
+					vop(0xfa, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVSUB64:
+					
+					vop(0xfb, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVAND:
+					
+					vop(0xdb, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVOR:
+					
+					vop(0xeb, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVXOR:
+					
+					vop(0xef, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVCMPEQ8:
+					
+					vop(0x74, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVCMPEQ16:
+					
+					vop(0x75, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVCMPEQ32:
+					
+					vop(0x76, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPVMOVMSK8:
+					
+					vmovmsk8(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPVBCAST8:
+					
+					vbcast(i->r1, i->r2, 1);
+					
+					break;
+					
+				case LYRICALOPVBCAST16:
+					
+					vbcast(i->r1, i->r2, 2);
+					
+					break;
+					
+				case LYRICALOPVBCAST32:
+					
+					vbcast(i->r1, i->r2, 4);
+					
+					break;
+					
+				case LYRICALOPFADD32:
+					
+					fop(0x58, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFSUB32:
+					
+					fop(0x5c, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFMUL32:
+					
+					fop(0x59, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFDIV32:
+					
+					fop(0x5e, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFEQ32:
+					
+					fcmp(0, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFLT32:
+					
+					fcmp(1, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPFLTE32:
+					
+					fcmp(2, i->r1, i->r2, i->r3);
+					
+					break;
+					
+				case LYRICALOPITOF32:
+					
+					itof(i->r1, i->r2);
+					
+					break;
+					
+				case LYRICALOPF32TOI:
+					
+					ftoi(i->r1, i->r2);
+					
+					break;
+					
 				case LYRICALOPMEM8CPY:
 					
 					mem8cpy(i->r1, i->r2, i->r3);
@@ -7967,6 +9506,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM8CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u8), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -7995,6 +9538,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM8CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u8), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -8023,6 +9570,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM16CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u16), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -8051,6 +9602,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM16CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u16), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -8079,6 +9634,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM32CPYI: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u32), 0)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -8107,6 +9666,10 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					break;
 					
 				case LYRICALOPMEM32CPYI2: {
+					// Small copies are expanded
+					// into load and store pairs.
+					if (expandmemcpyi(sizeof(u32), 1)) break;
+					
 					// Look for an unused register.
 					uint unusedreg = findunusedreg(ECX);
 					
@@ -8203,13 +9766,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = (6*sizeof(u32));
+					*binaryappend1() = (6*sizeof(u32));
 					
 					// Set EAX to 90 which
 					// is the value for
@@ -8221,14 +9784,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// B0+rb        MOV r8, imm8            #Move imm8 to r8.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = (0xb0+lookupreg(EAX));
+					*binaryappend1() = (0xb0+lookupreg(EAX));
 					
 					// Append the immediate value.
-					*arrayu8append1(&b->binary) = 90;
+					*binaryappend1() = 90;
 					
 					// Append the instruction INT80.
-					*arrayu8append1(&b->binary) = 0xcd;
-					*arrayu8append1(&b->binary) = 0x80;
+					*binaryappend1() = 0xcd;
+					*binaryappend1() = 0x80;
 					
 					if (r1 != EAX) cpy(r1, EAX);
 					
@@ -8281,6 +9844,71 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 						savereg(EBX); ebxwassaved = 1;
 					} else regsinusetmp[EBX] = 1; // Mark unused register as temporarily used.
 					
+					// Offset of the 32bits immediate
+					// field of the branching instruction
+					// used with the stack page pool.
+					uint pooldoneimm;
+					
+					if (i->op == LYRICALOPSTACKPAGEALLOC) {
+						// I generate the instructions which
+						// take a page from the stack page pool
+						// if it is not empty; %EBX is set to
+						// the address of the stack page pool
+						// and %EAX to the page taken.
+						
+						afip(EBX);
+						
+						// Specification from the Intel manual.
+						// 8B /r	MOV r32,r/m32		#Move r/m32 to r32.
+						// 85 /r	TEST r/m32,r32		#AND r32 with r/m32; set SF, ZF, PF according to result.
+						// 0F 84 cd	JE rel32		#Jump near if equal (ZF=1).
+						// FF /6	PUSH r/m32		#Push r/m32.
+						// 8F /0	POP r/m32		#Pop top of stack into m32; increment stack pointer.
+						// FF /1	DEC r/m32		#Decrement r/m32 by 1.
+						// FF /0	INC r/m32		#Increment r/m32 by 1.
+						// E9 cd	JMP rel32		#Jump near, relative.
+						
+						// mov %EAX, [%EBX];
+						*binaryappend1() = 0x8b; *binaryappend1() = 0x03;
+						
+						// test %EAX, %EAX;
+						*binaryappend1() = 0x85; *binaryappend1() = 0xc0;
+						
+						// je poolempty;
+						*binaryappend1() = 0x0f; *binaryappend1() = 0x84;
+						uint poolemptyimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// Without a register to spare, the
+						// address of the next page in the pool
+						// is copied through the stack.
+						
+						// push dword [%EAX];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x30;
+						
+						// pop dword [%EBX];
+						*binaryappend1() = 0x8f; *binaryappend1() = 0x03;
+						
+						// dec dword [%EBX+4];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x4b; *binaryappend1() = 4;
+						
+						// inc dword [%EBX+8];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x43; *binaryappend1() = 8;
+						
+						// jmp pooldone;
+						*binaryappend1() = 0xe9;
+						pooldoneimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// poolempty:
+						*(u32*)(binaryptr() + poolemptyimm) = (b->binarysz - (poolemptyimm + sizeof(u32)));
+						
+						// The address of the stack page pool
+						// is needed after the syscall, which
+						// use %EBX for its argument.
+						push(EBX);
+					}
+					
 					// Arguments to mmap() get
 					// pushed in the stack from
 					// the last to first argument,
@@ -8292,7 +9920,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// fd:          0
 					// flags:       MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED|((i->op == LYRICALOPSTACKPAGEALLOC) ? MAP_STACK : 0)
 					// prot:        PROT_READ|PROT_WRITE
-					// length:      (i->op == LYRICALOPSTACKPAGEALLOC) ? PAGESIZE : (i->imm->n*PAGESIZE)
+					// length:      (i->op == LYRICALOPSTACKPAGEALLOC) ? (STACKPAGEBATCH*PAGESIZE) : (i->imm->n*PAGESIZE)
 					// start:       0
 					pushi(0);
 					pushi(0);
@@ -8300,7 +9928,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					pushi(PROT_READ|PROT_WRITE);
 					// With LYRICALOPPAGEALLOCI, a single lyricalimmval
 					// of type LYRICALIMMVALUE is guaranteed to have been used.
-					pushi((i->op == LYRICALOPSTACKPAGEALLOC) ? PAGESIZE : ((*(u32*)&i->imm->n)*PAGESIZE));
+					pushi((i->op == LYRICALOPSTACKPAGEALLOC) ? (STACKPAGEBATCH*PAGESIZE) : ((*(u32*)&i->imm->n)*PAGESIZE));
 					pushi(0);
 					
 					cpy(EBX, ESP);
@@ -8313,13 +9941,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = (6*sizeof(u32));
+					*binaryappend1() = (6*sizeof(u32));
 					
 					// Set EAX to 90 which
 					// is the value for
@@ -8331,14 +9959,84 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// B0+rb        MOV r8, imm8            #Move imm8 to r8.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = (0xb0+lookupreg(EAX));
+					*binaryappend1() = (0xb0+lookupreg(EAX));
 					
 					// Append the immediate value.
-					*arrayu8append1(&b->binary) = 90;
+					*binaryappend1() = 90;
 					
 					// Append the instruction INT80.
-					*arrayu8append1(&b->binary) = 0xcd;
-					*arrayu8append1(&b->binary) = 0x80;
+					*binaryappend1() = 0xcd;
+					*binaryappend1() = 0x80;
+					
+					if (i->op == LYRICALOPSTACKPAGEALLOC) {
+						// I generate the instructions which
+						// count the pages allocated using
+						// the syscall, and which add to
+						// the stack page pool the pages
+						// allocated beside the first one.
+						
+						pop(EBX);
+						
+						// Specification from the Intel manual.
+						// FF /0	INC r/m32		#Increment r/m32 by 1.
+						// 3D id	CMP EAX,imm32		#Compare imm32 with EAX.
+						// 77 cb	JA rel8			#Jump short if above (CF=0 and ZF=0).
+						// FF /6	PUSH r/m32		#Push r/m32.
+						// 8F /0	POP r/m32		#Pop top of stack into m32; increment stack pointer.
+						// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
+						// 81 /0 id	ADD r/m32,imm32		#Add imm32 to r/m32.
+						// 83 /0 ib	ADD r/m32,imm8		#Add sign-extended imm8 to r/m32.
+						
+						// inc dword [%EBX+12];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x43; *binaryappend1() = 12;
+						
+						if (STACKPAGEBATCH > 1) {
+							// Addresses above 0x7fffffff
+							// can be returned by the syscall,
+							// hence failure is an unsigned
+							// value greater than -4096.
+							
+							// cmp %EAX, -4096;
+							*binaryappend1() = 0x3d;
+							*(u32*)binaryappend2(sizeof(u32)) = -4096;
+							
+							// ja pooldone;
+							*binaryappend1() = 0x77;
+							uint imm = b->binarysz;
+							binaryappend1();
+							
+							uint opstart = b->binarysz;
+							
+							uint n = STACKPAGEBATCH-1;
+							
+							do {
+								// push dword [%EBX];
+								*binaryappend1() = 0xff; *binaryappend1() = 0x33;
+								
+								// pop dword [%EAX+(n*PAGESIZE)];
+								*binaryappend1() = 0x8f; *binaryappend1() = 0x80;
+								*(u32*)binaryappend2(sizeof(u32)) = (n*PAGESIZE);
+								
+								// mov [%EBX], %EAX;
+								*binaryappend1() = 0x89; *binaryappend1() = 0x03;
+								
+								// add dword [%EBX], (n*PAGESIZE);
+								*binaryappend1() = 0x81; *binaryappend1() = 0x03;
+								*(u32*)binaryappend2(sizeof(u32)) = (n*PAGESIZE);
+								
+							} while (--n);
+							
+							// add dword [%EBX+4], STACKPAGEBATCH-1;
+							*binaryappend1() = 0x83; *binaryappend1() = 0x43; *binaryappend1() = 4;
+							*binaryappend1() = (STACKPAGEBATCH-1);
+							
+							// Set the 8bits immediate field appended above.
+							binaryptr()[imm] = (b->binarysz - opstart);
+						}
+						
+						// pooldone:
+						*(u32*)(binaryptr() + pooldoneimm) = (b->binarysz - (pooldoneimm + sizeof(u32)));
+					}
 					
 					if (r1 != EAX) cpy(r1, EAX);
 					
@@ -8432,14 +10130,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// B0+rb        MOV r8, imm8            #Move imm8 to r8.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = (0xb0+lookupreg(EAX));
+					*binaryappend1() = (0xb0+lookupreg(EAX));
 					
 					// Append the immediate value.
-					*arrayu8append1(&b->binary) = 91;
+					*binaryappend1() = 91;
 					
 					// Append the instruction INT80.
-					*arrayu8append1(&b->binary) = 0xcd;
-					*arrayu8append1(&b->binary) = 0x80;
+					*binaryappend1() = 0xcd;
+					*binaryappend1() = 0x80;
 					
 					if (ecxwassaved) {
 						// Restore register value.
@@ -8493,6 +10191,60 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// RoundDown to pagesize 0x1000.
 					andimm(EBX, -0x1000);
 					
+					// Offset of the 32bits immediate
+					// field of the branching instruction
+					// used with the stack page pool.
+					uint pooldoneimm;
+					
+					if (i->op == LYRICALOPSTACKPAGEFREE) {
+						// I generate the instructions which
+						// add the page to the stack page pool
+						// if it is not full; %EAX is set to
+						// the address of the stack page pool.
+						
+						afip(EAX);
+						
+						// Specification from the Intel manual.
+						// 83 /7 ib	CMP r/m32,imm8		#Compare imm8 with r/m32.
+						// 73 cb	JAE rel8		#Jump short if above or equal (CF=0).
+						// FF /6	PUSH r/m32		#Push r/m32.
+						// 8F /0	POP r/m32		#Pop top of stack into m32; increment stack pointer.
+						// 89 /r	MOV r/m32,r32		#Move r32 to r/m32.
+						// FF /0	INC r/m32		#Increment r/m32 by 1.
+						// E9 cd	JMP rel32		#Jump near, relative.
+						
+						// cmp dword [%EAX+4], STACKPAGEPOOLMAX;
+						*binaryappend1() = 0x83; *binaryappend1() = 0x78; *binaryappend1() = 4;
+						*binaryappend1() = STACKPAGEPOOLMAX;
+						
+						// jae poolfull;
+						*binaryappend1() = 0x73;
+						uint imm = b->binarysz;
+						binaryappend1();
+						
+						uint opstart = b->binarysz;
+						
+						// push dword [%EAX];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x30;
+						
+						// pop dword [%EBX];
+						*binaryappend1() = 0x8f; *binaryappend1() = 0x03;
+						
+						// mov [%EAX], %EBX;
+						*binaryappend1() = 0x89; *binaryappend1() = 0x18;
+						
+						// inc dword [%EAX+4];
+						*binaryappend1() = 0xff; *binaryappend1() = 0x40; *binaryappend1() = 4;
+						
+						// jmp pooldone;
+						*binaryappend1() = 0xe9;
+						pooldoneimm = b->binarysz;
+						binaryappend2(sizeof(u32));
+						
+						// poolfull:
+						binaryptr()[imm] = (b->binarysz - opstart);
+					}
+					
 					// Save register value
 					// if it is being used.
 					if (isreginuse(ECX)) {
@@ -8513,14 +10265,14 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// B0+rb        MOV r8, imm8            #Move imm8 to r8.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = (0xb0+lookupreg(EAX));
+					*binaryappend1() = (0xb0+lookupreg(EAX));
 					
 					// Append the immediate value.
-					*arrayu8append1(&b->binary) = 91;
+					*binaryappend1() = 91;
 					
 					// Append the instruction INT80.
-					*arrayu8append1(&b->binary) = 0xcd;
-					*arrayu8append1(&b->binary) = 0x80;
+					*binaryappend1() = 0xcd;
+					*binaryappend1() = 0x80;
 					
 					if (ecxwassaved) {
 						// Restore register value.
@@ -8528,6 +10280,11 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// Unmark register as temporarily used if it was marked.
 					} else regsinusetmp[ECX] = 0;
 					
+					if (i->op == LYRICALOPSTACKPAGEFREE) {
+						// pooldone:
+						*(u32*)(binaryptr() + pooldoneimm) = (b->binarysz - (pooldoneimm + sizeof(u32)));
+					}
+					
 					if (ebxwassaved) {
 						// Restore register value.
 						restorereg(EBX);
@@ -8599,13 +10356,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = ((6+1)*sizeof(u32));
+					*binaryappend1() = ((6+1)*sizeof(u32));
 					
 					popusedregs(r1);
 					
@@ -8663,13 +10420,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = ((6+1)*sizeof(u32));
+					*binaryappend1() = ((6+1)*sizeof(u32));
 					
 					popusedregs(r1);
 					
@@ -8717,13 +10474,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = ((2+1)*sizeof(u32));
+					*binaryappend1() = ((2+1)*sizeof(u32));
 					
 					popusedregs(0);
 					
@@ -8768,13 +10525,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// 83 /0 ib     ADD r/m32, imm8         #Add sign-extended imm8 to r/m32.
 					
 					// Append the opcode byte.
-					*arrayu8append1(&b->binary) = 0x83;
+					*binaryappend1() = 0x83;
 					
 					// Append the ModR/M byte.
 					appendmodrmfor1reg(0, ESP);
 					
 					// Append the 8bits immediate value.
-					*arrayu8append1(&b->binary) = ((2+1)*sizeof(u32));
+					*binaryappend1() = ((2+1)*sizeof(u32));
 					
 					popusedregs(0);
 					
@@ -8788,7 +10545,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					uint iopmachinecodesz = stringmmsz(i->opmachinecode);
 					
 					bytcpy(
-						arrayu8append2(&b->binary, iopmachinecodesz),
+						binaryappend2(iopmachinecodesz),
 						i->opmachinecode.ptr,
 						iopmachinecodesz);
 					
@@ -8812,7 +10569,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			
 			skipredo:;
 			
-			uint bbinarysz = arrayu8sz(b->binary);
+			uint bbinarysz = b->binarysz;
 			
 			uint ibinsz = i->binsz;
 			
@@ -8831,6 +10588,13 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 				}
 			}
 			
+			// The gap created by the alignment
+			// get filled with no-operation
+			// instructions when copying
+			// binaries to the result.
+			if (codealign && bintreefind(toalign, (uint)i))
+				executableinstrsz = ROUNDUPTOPOWEROFTWO(executableinstrsz, codealign);
+				
 			b->binaryoffset = executableinstrsz;
 			
 			// Report in the lyricalcompileresult,
@@ -8878,17 +10642,122 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 		constantstringssz = ROUNDUPTOPOWEROFTWO(constantstringssz, 4); // Aligning to 4bytes.
 	}
 	
-	// I allocate memory for
-	// the executable binary
-	// to return.
-	retvar->execbin.ptr = mmalloc(executableinstrsz + constantstringssz);
+	// The buffer in which instructions
+	// were emitted is resized to become
+	// the executable binary to return.
+	retvar->execbin.ptr = mmrealloc(codebuf.ptr, executableinstrsz + constantstringssz);
+	
+	// Function which fill with
+	// no-operation instructions,
+	// the gap of size sz pointed by ptr.
+	void fillwithnop (u8* ptr, uint sz) {
+		#ifdef LYRICALBACKENDX86BASELINEISA
+		// Specification from the Intel manual.
+		// 90		NOP		#One byte no-operation instruction.
+		
+		while (sz) {
+			*ptr++ = 0x90;
+			--sz;
+		}
+		#else
+		// Multi-byte no-operation instructions
+		// are used so that as few instructions
+		// as possible get decoded when
+		// executing through the gap.
+		
+		// Specification from the Intel manual.
+		// 90				NOP		#One byte no-operation instruction.
+		// 66 90			NOP		#Two bytes no-operation instruction.
+		// 0F 1F 00			NOP DWORD ptr [EAX]		#Three bytes no-operation instruction.
+		// 0F 1F 40 00			NOP DWORD ptr [EAX + 00H]		#Four bytes no-operation instruction.
+		// 0F 1F 44 00 00		NOP DWORD ptr [EAX + EAX*1 + 00H]		#Five bytes no-operation instruction.
+		// 66 0F 1F 44 00 00		NOP WORD ptr [EAX + EAX*1 + 00H]		#Six bytes no-operation instruction.
+		// 0F 1F 80 00 00 00 00		NOP DWORD ptr [EAX + 00000000H]		#Seven bytes no-operation instruction.
+		// 0F 1F 84 00 00 00 00 00	NOP DWORD ptr [EAX + EAX*1 + 00000000H]		#Eight bytes no-operation instruction.
+		// 66 0F 1F 84 00 00 00 00 00	NOP WORD ptr [EAX + EAX*1 + 00000000H]		#Nine bytes no-operation instruction.
+		
+		static u8 nops[9][9] = {
+			{0x90},
+			{0x66, 0x90},
+			{0x0f, 0x1f, 0x00},
+			{0x0f, 0x1f, 0x40, 0x00},
+			{0x0f, 0x1f, 0x44, 0x00, 0x00},
+			{0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00},
+			{0x0f, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00},
+			{0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+			{0x66, 0x0f, 0x1f, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00},
+		};
+		
+		while (sz) {
+			
+			uint nopsz = ((sz > 9) ? 9 : sz);
+			
+			bytcpy(ptr, nops[nopsz-1], nopsz);
+			
+			ptr += nopsz;
+			sz -= nopsz;
+		}
+		#endif
+	}
+	
+	if (wasredone || codealign) {
+		// Move the executable binary of
+		// each instruction to its final offset,
+		// starting from the last instruction;
+		// since sizes only ever grow, and
+		// alignment only ever add gaps, the final
+		// offset of an instruction is never lower
+		// than where it was emitted, hence moving
+		// from the last instruction never overwrite
+		// bytes that have yet to be moved.
+		uint n = backenddatassz;
+		
+		// Offset where the executable binary
+		// of the instruction moved last start;
+		// the gap between the end of the
+		// executable binary of the instruction
+		// being moved and that offset is filled
+		// with no-operation instructions.
+		uint nextbinaryoffset = retvar->executableinstrsz;
+		
+		while (n) {
+			
+			b = &backenddatas[--n];
+			
+			if (b->redobinary.ptr) {
+				
+				bytcpy(retvar->execbin.ptr + b->binaryoffset, b->redobinary.ptr, b->binarysz);
+				
+				mmfree(b->redobinary.ptr);
+				
+				b->redobinary = arrayu8null;
+				
+			} else if (b->codeoffset != b->binaryoffset)
+				bytcpy(retvar->execbin.ptr + b->binaryoffset, retvar->execbin.ptr + b->codeoffset, b->binarysz);
+				
+			b->codeoffset = b->binaryoffset;
+			
+			uint binaryend = b->binaryoffset + b->binarysz;
+			
+			// Every executable binary that
+			// could still be moved is located
+			// before binaryend, hence the gap
+			// can be filled right away.
+			if (binaryend < nextbinaryoffset)
+				fillwithnop(retvar->execbin.ptr + binaryend, nextbinaryoffset - binaryend);
+				
+			nextbinaryoffset = b->binaryoffset;
+		}
+	}
+	
+	codebuf.ptr = retvar->execbin.ptr;
 	
 	// Copy the constant strings to the result.
 	bytcpy(
 		retvar->execbin.ptr + executableinstrsz,
 		compileresult.stringregion.ptr,
 		compileresultstringregionsz);
-	
+		
 	if (flag&LYRICALBACKENDX86COMPACTPAGEALIGNED) {
 		
 		executableinstrsz = ROUNDUPTOPOWEROFTWO(executableinstrsz, 0x1000); // Aligning to pagesize.
@@ -8905,6 +10774,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	// there was any debug information generated.
 	uint saveddbginfolinenumber = 0;
 	
+	
 	// Copy in the result,
 	// the instructions to
 	// execute resolving
@@ -8962,6 +10832,11 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 		do {
 			b = (backenddata*)i->backenddata;
 			
+			// Address of the executable
+			// binary of the instruction
+			// within the result.
+			u8* bbinaryptr = (retvar->execbin.ptr + b->binaryoffset);
+			
 			// If the instruction used
 			// an immediate2 value,
 			// I resolve it and write it
@@ -8993,7 +10868,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 						// the binary of the instruction.
 						// An 8 bits value is written.
 						
-						*(u8*)(b->binary.ptr + b->imm2fieldoffset) = imm2value;
+						*(u8*)(bbinaryptr + b->imm2fieldoffset) = imm2value;
 						
 					} else {
 						// An 8bits offset cannot be used.
@@ -9016,7 +10891,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// the binary of the instruction.
 					// A 32 bits value is written.
 					
-					*(u32*)(b->binary.ptr + b->imm2fieldoffset) = imm2value;
+					*(u32*)(bbinaryptr + b->imm2fieldoffset) = imm2value;
 					
 				// This else case is not necessary.
 				// It is only there to make sure
@@ -9116,7 +10991,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 						// the binary of the instruction.
 						// An 8 bits value is written.
 						
-						*(u8*)(b->binary.ptr + b->immfieldoffset) = immvalue;
+						*(u8*)(bbinaryptr + b->immfieldoffset) = immvalue;
 						
 					} else {
 						// An 8bits immediate cannot be used.
@@ -9139,7 +11014,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 					// the binary of the instruction.
 					// A 32 bits value is written.
 					
-					*(u32*)(b->binary.ptr + b->immfieldoffset) = immvalue;
+					*(u32*)(bbinaryptr + b->immfieldoffset) = immvalue;
 					
 				// This else case is not necessary.
 				// It is only there to make sure
@@ -9150,12 +11025,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 			// If there was at least one lyricalinstruction
 			// to redo, there is no need to keep copying data
 			// to retvar->execbin and processing debug information.
-			if (!toredo.ptr && b->binary.ptr) {
-				
-				bytcpy(
-					retvar->execbin.ptr + b->binaryoffset,
-					b->binary.ptr,
-					arrayu8sz(b->binary));
+			if (!toredo.ptr && b->binarysz) {
 				
 				if (i->dbginfo.linenumber) {
 					// I generate a new section1 debug information entry
@@ -9225,8 +11095,12 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 	
 	// Check if there was lyricalinstruction to redo.
 	if (toredo.ptr) {
+		// The executable binary is kept
+		// as codebuf, since the instructions
+		// that do not get redone keep their
+		// executable binary where it is.
 		
-		mmfree(retvar->execbin.ptr);
+		wasredone = 1;
 		
 		if (dbginfosection1.ptr) mmfree(dbginfosection1.ptr);
 		
@@ -9245,7 +11119,7 @@ lyricalbackendx86result* lyricalbackendx86 (lyricalcompileresult compileresult,
 		// in dbginfosection1, with an entry
 		// for which the field binoffset
 		// is the upper limit offset.
-		*arrayu32append1(&dbginfosection1) = b->binaryoffset + arrayu8sz(b->binary); // binoffset.
+		*arrayu32append1(&dbginfosection1) = b->binaryoffset + b->binarysz; // binoffset.
 		*arrayu32append1(&dbginfosection1) = 0; // filepath.
 		*arrayu32append1(&dbginfosection1) = 0; // linenumber.
 		*arrayu32append1(&dbginfosection1) = 0; // lineoffset.
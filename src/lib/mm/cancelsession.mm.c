@@ -82,6 +82,13 @@ void mmsessioncancel (mmsession s, mmsessionflag flag) {
 				b = bsaved;
 			}
 			
+			// I save the session to free before
+			// mmcurrentsession get modified; its parent's
+			// field nextsession cannot be used to retrieve it,
+			// since it may have been set by another thread
+			// which created a session from the same parent.
+			mmsessioninternal* sessiontofree = mmcurrentsession;
+			
 			// I set mmcurrentsession to the parent session.
 			mmcurrentsession = mmcurrentsession->prevsession;
 			
@@ -93,7 +100,7 @@ void mmsessioncancel (mmsession s, mmsessionflag flag) {
 			// Note that memory allocated for a session is not added
 			// to any session, hence mmfreeblock() is called with
 			// its argument flag set to null.
-			mmfreeblock((mmblock*)((void*)mmcurrentsession->nextsession - (sizeof(mmblock) - 2*sizeof(mmblock*))), 0);
+			mmfreeblock((mmblock*)((void*)sessiontofree - (sizeof(mmblock) - 2*sizeof(mmblock*))), 0);
 		}
 		
 		#ifdef MMTHREADSAFE
@@ -907,7 +907,16 @@ static mmsessioninternal mmfirstsession = {
 };
 
 // This variable point to the session currently being used.
+// When threadsafety is enabled, each thread has its own
+// current session, so that threads can each create and free
+// their own sessions concurrently, such as when lyricalcompile()
+// is called from multiple threads; the first session of
+// a thread is a subsession of mmfirstsession.
+#ifdef MMTHREADSAFE
+static __thread mmsessioninternal* mmcurrentsession = &mmfirstsession;
+#else
 static mmsessioninternal* mmcurrentsession = &mmfirstsession;
+#endif
 
 
 typedef struct {
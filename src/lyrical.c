@@ -36,6 +36,16 @@
 #error "unsupported"
 #endif
 
+// Size in bytes beyond which the least
+// recently used cache entries get evicted
+// from the store of cache entries.
+#define LYRICALCACHESTOREMAXSZ (256*1024*1024)
+
+// Size in bytes of a huge page, to which
+// the executable pages are aligned when
+// the option "hugepages" is used.
+#define LYRICALHUGEPAGESZ (2*1024*1024)
+
 // Path to the folder containing
 // the standard library.
 // Must be terminated with '/'.
@@ -68,6 +78,12 @@
 #include <sys/types.h>
 #include <fcntl.h>
 
+// Used for flock().
+#include <sys/file.h>
+
+// Used for waitpid().
+#include <sys/wait.h>
+
 // Used for mmap(), mprotect().
 #include <sys/mman.h>
 #ifndef MAP_STACK
@@ -76,6 +92,15 @@
 #ifndef MAP_UNINITIALIZED
 #define MAP_UNINITIALIZED 0x4000000
 #endif
+#ifndef MAP_POPULATE
+#define MAP_POPULATE 0x8000
+#endif
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+#endif
+
+// Used for getrusage().
+#include <sys/resource.h>
 
 #ifdef LYRICALUSEINOTIFY
 // Used for inotify.
@@ -85,6 +110,9 @@
 // Used for clone().
 #include <sched.h>
 
+// Used for clock_gettime().
+#include <time.h>
+
 // Used for tty functions.
 #include <termios.h>
 
@@ -129,12 +157,19 @@
 #include <lyricaldbg64.h>
 #endif
 
+// Used for struct sockaddr_un; it include
+// string.h, hence it is included after
+// string.h from the above.
+#include <sys/un.h>
 
-u8* helpstring = "Usage: lyrical sourcefile <ARGS>\n";
+
+u8* helpstring = "Usage: lyrical sourcefile <ARGS>\n"
+	"       lyrical --daemon\n"
+	"       lyrical --zygote sourcefile\n";
 
 void main (uint argc, u8** arg, u8** env) {
 	// Catchable-labels.
-	__label__ labelforinotifysetup, labelforskippingexec;
+	__label__ labelforinotifysetup, labelforskippingexec, labelforlibrary;
 	
 	// Variable which will hold
 	// the default exit status.
@@ -163,18 +198,102 @@ void main (uint argc, u8** arg, u8** env) {
 		// the compilation is also generated.
 		uint dbg;
 		
+		// When set, the counts of stack pages
+		// allocated from and outside of the stack
+		// page pool are written to stderr once
+		// execution of the binary complete.
+		uint stackpagestats;
+		
+		// When set using option "prefault",
+		// the pages of the executable instructions
+		// and constant strings of a cached
+		// executable binary are loaded in memory
+		// when mapped, instead of on first access.
+		uint prefault;
+		
+		// When set using option "hugepages",
+		// the executable pages are mapped at
+		// an address aligned to LYRICALHUGEPAGESZ,
+		// and their executable instructions and
+		// global variable region can use huge pages.
+		uint hugepages;
+		
+		// When set using option "faultstats",
+		// the counts of page faults which occured
+		// before execution of the binary started
+		// are written to stderr, and the counts
+		// of those which occured during its
+		// execution are written once it complete.
+		uint faultstats;
+		
+		// When set using option "snapshot",
+		// the global variable region of the
+		// executable binary is restored from
+		// the snapshot saved in its cache entry
+		// by the syscall LYRICALSYSCALLSNAPSHOT;
+		// the executable binary still run from
+		// its root function, and use the syscall
+		// LYRICALSYSCALLSNAPSHOTRESTORED to skip
+		// the initialization saved in the snapshot.
+		uint snapshot;
+		
+		// Set using option "codealign" to
+		// the flag of the backend that align
+		// function entries and loop heads
+		// to 16, 32 or 64 bytes.
+		uint codealign;
+		
+		// Set using option "trustcache"
+		// to a count of seconds during which
+		// a cached executable is trusted
+		// without checking its source files
+		// after they were last checked.
+		uint trustcache;
+		
 		// Used when option "tcpipv4addr" is used.
 		struct {
 			uint en;
 			struct sockaddr_in addr;
 		} tcpipv4svr;
 		
+		// Set using option "daemon" to run
+		// as compile daemon, which compile
+		// on behalf of other processes of
+		// the same user running a file
+		// which need to be compiled.
+		uint daemon;
+		
+		// Set using option "zygote" to run
+		// as the zygote of the file to run,
+		// which keep its executable binary
+		// mapped, and fork a process to run it
+		// for each request made by the processes
+		// of the same user running that file.
+		uint zygote;
+		
+		// Set using option "static" to compile
+		// the modules from the standard paths
+		// in the executable binary, instead
+		// of linking them as libraries;
+		// it is implied by option "g", since
+		// debug information is generated only
+		// for the executable binary.
+		uint staticlink;
+		
+		// Set in a process forked to compile
+		// the module which folder is the file
+		// to run, as a library; it is not
+		// an option of the command line.
+		uint lib;
+		
 	} options;
 	
 	bytsetz((void*)&options, sizeof(options));
 	
 	u8* parseargoptionswithvalue[] = {
 		"tcpipv4addr",
+		"codealign",
+		"trustcache",
 		0
 	};
 	
@@ -186,6 +305,7 @@ void main (uint argc, u8** arg, u8** env) {
 		
 		if (option[0] == 'l' && !option[1]) options.log = 1;
 		else if (option[0] == 'g' && !option[1]) options.dbg = 1;
+		else if (option[0] == 's' && !option[1]) options.stackpagestats = 1;
 		else if (stringiseq3(option, "tcpipv4addr")) {
 			
 			options.tcpipv4svr.en = 1;
@@ -216,6 +336,56 @@ void main (uint argc, u8** arg, u8** env) {
 			
 			options.tcpipv4svr.addr.sin_family = AF_INET;
 			
+		} else if (stringiseq3(option, "codealign")) {
+			
+			uint n = atoi(value);
+			
+			#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
+			if (n == 16) options.codealign = LYRICALBACKENDX86ALIGN16;
+			else if (n == 32) options.codealign = LYRICALBACKENDX86ALIGN32;
+			else if (n == 64) options.codealign = LYRICALBACKENDX86ALIGN64;
+			#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
+			if (n == 16) options.codealign = LYRICALBACKENDX64ALIGN16;
+			else if (n == 32) options.codealign = LYRICALBACKENDX64ALIGN32;
+			else if (n == 64) options.codealign = LYRICALBACKENDX64ALIGN64;
+			#endif
+			else {
+				fprintf(stderr, "lyrical: invalid code alignment \"%s\"\n", value);
+				exit(-1); // The shell use non-null for failing.
+			}
+			
+		} else if (stringiseq3(option, "trustcache")) {
+			
+			options.trustcache = atoi(value);
+			
+		} else if (stringiseq3(option, "daemon")) {
+			
+			options.daemon = 1;
+			
+		} else if (stringiseq3(option, "zygote")) {
+			
+			options.zygote = 1;
+			
+		} else if (stringiseq3(option, "static")) {
+			
+			options.staticlink = 1;
+			
+		} else if (stringiseq3(option, "prefault")) {
+			
+			options.prefault = 1;
+			
+		} else if (stringiseq3(option, "hugepages")) {
+			
+			options.hugepages = 1;
+			
+		} else if (stringiseq3(option, "faultstats")) {
+			
+			options.faultstats = 1;
+			
+		} else if (stringiseq3(option, "snapshot")) {
+			
+			options.snapshot = 1;
+			
 		} else {
 			fprintf(stderr, "lyrical: invalid option \"%s\"\n", option);
 			exit(-1); // The shell use non-null for failing.
@@ -229,6 +399,347 @@ void main (uint argc, u8** arg, u8** env) {
 	// Parse the command line for any option given.
 	arg = parsearglong2(arg, parseargcallback, parseargoptionswithvalue);
 	
+	// Path to the socket on which
+	// the compile daemon of the user
+	// accept requests.
+	string daemonpath = stringfmt("%sstore/%d/.daemon", LYRICALCACHEDIR, getuid());
+	
+	// Structure of a request sent to
+	// the compile daemon; it is followed
+	// by the null terminated absolute path
+	// of the file to compile, and sent along
+	// with the stderr of the process making
+	// the request, to which the compile daemon
+	// write errors while serving the request.
+	typedef struct {
+		// Options with which
+		// the file is to be run.
+		typeof(options) options;
+		
+		// flagshash computed by the process
+		// making the request; if it does not
+		// match the one computed by the compile
+		// daemon, they are different versions.
+		u64 flagshash;
+		
+	} daemonrequest;
+	
+	// Enum of the status replied
+	// by the compile daemon.
+	enum {
+		// The file was compiled, and
+		// its cache entry published.
+		DAEMONCOMPILED,
+		
+		// The compilation failed, and
+		// errors were written to the stderr
+		// of the process making the request.
+		DAEMONFAILED,
+		
+		// The request was not served,
+		// and the process making the request
+		// must compile the file itself.
+		DAEMONREJECTED
+	};
+	
+	// Function which connect to the
+	// compile daemon of the user; -1 is
+	// returned if it is not running.
+	int daemonconnect () {
+		
+		struct sockaddr_un addr = {.sun_family = AF_UNIX};
+		
+		if ((stringmmsz(daemonpath)+1) > sizeof(addr.sun_path)) return -1;
+		
+		bytcpy(addr.sun_path, daemonpath.ptr, stringmmsz(daemonpath)+1);
+		
+		int fid = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0);
+		
+		if (fid != -1 && connect(fid, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+			close(fid);
+			fid = -1;
+		}
+		
+		return fid;
+	}
+	
+	// Socket on which the compile daemon
+	// accept requests; it is -1 when
+	// not running as compile daemon.
+	int daemonlistenfid = -1;
+	
+	// Connection from which the request
+	// being served by the compile daemon
+	// was received; it is -1 when
+	// not serving a request.
+	int daemonconnfid = -1;
+	
+	// Duplicate of the stderr of
+	// the compile daemon, restored
+	// after serving each request.
+	int daemonstderr = -1;
+	
+	// Memory session in which all
+	// memory allocations made while
+	// serving a request are done.
+	mmsession daemonsession;
+	
+	// Buffer in which a request is received;
+	// the request being served is copied
+	// to daemonreq, and daemonarg is
+	// used as the array of arguments.
+	u8 daemonreqbuf[sizeof(daemonrequest) + 4096];
+	daemonrequest daemonreq;
+	u8* daemonarg[2];
+	
+	// Array used as the array of arguments
+	// by a process forked to compile a library.
+	u8* libarg[2];
+	
+	// Structure used by the compile
+	// daemon to cache the content
+	// of a file read by the compiler.
+	typedef struct {
+		// Absolute path of the file.
+		string path;
+		
+		// Identity of the file when
+		// its content was read; mtimens is
+		// -1 if it could not be read.
+		u64 dev;
+		u64 ino;
+		u64 size;
+		u64 mtimens;
+		
+		u8* content;
+		
+	} daemonfile;
+	
+	// Array of daemonfile, which
+	// remain allocated across requests
+	// served by the compile daemon, so that
+	// modules are not read again from the
+	// filesystem until they are modified.
+	arrayu8 daemonfiles = arrayu8null;
+	
+	// Function used by the compile daemon
+	// as lyricalcompilearg.readfile.
+	u8* daemonreadfile (u8* filepath) {
+		
+		struct stat st;
+		
+		if (stat(filepath, &st) == -1) return 0;
+		
+		u64 mtimens = ((u64)st.st_mtim.tv_sec*1000000000 + st.st_mtim.tv_nsec);
+		
+		daemonfile* f = (daemonfile*)daemonfiles.ptr;
+		daemonfile* flimit = (daemonfile*)(daemonfiles.ptr + arrayu8sz(daemonfiles));
+		
+		while (f < flimit && !stringiseq2(f->path, filepath)) ++f;
+		
+		if (f < flimit) {
+			
+			if (f->dev == st.st_dev && f->ino == st.st_ino &&
+				f->size == st.st_size && f->mtimens == mtimens) {
+				// The memory block is used by
+				// the compiler, then released
+				// using mmrefdown().
+				mmrefup(f->content);
+				
+				return f->content;
+			}
+			
+			if (f->content) mmfree(f->content);
+			
+		} else {
+			
+			f = (daemonfile*)arrayu8append2(&daemonfiles, sizeof(daemonfile));
+			
+			f->path = stringduplicate2(filepath);
+			
+			// I move the allocation out of
+			// the session of the request, since
+			// it is freed once the request served.
+			mmsessionextract(daemonsession, f->path.ptr);
+		}
+		
+		f->dev = st.st_dev;
+		f->ino = st.st_ino;
+		f->size = st.st_size;
+		
+		if ((f->content = fileread1(filepath).ptr)) {
+			
+			f->mtimens = mtimens;
+			
+			mmsessionextract(daemonsession, f->content);
+			
+			mmrefup(f->content);
+			
+		} else f->mtimens = -1;
+		
+		return f->content;
+	}
+	
+	// Function which accept a request
+	// to the compile daemon, setting
+	// daemonconnfid, daemonreq, daemonarg,
+	// and redirecting stderr to the stderr
+	// of the process making the request.
+	// Null is returned on failure.
+	uint daemonaccept () {
+		
+		if ((daemonconnfid = accept4(daemonlistenfid, 0, 0, SOCK_CLOEXEC)) == -1) return 0;
+		
+		union {
+			struct cmsghdr h;
+			u8 buf[CMSG_SPACE(sizeof(int))];
+		} cmsg;
+		
+		struct iovec iov = {
+			.iov_base = daemonreqbuf,
+			.iov_len = sizeof(daemonreqbuf)
+		};
+		
+		struct msghdr msg = {
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+			.msg_control = cmsg.buf,
+			.msg_controllen = sizeof(cmsg.buf)
+		};
+		
+		sint n = recvmsg(daemonconnfid, &msg, MSG_CMSG_CLOEXEC);
+		
+		int fid = -1;
+		
+		struct cmsghdr* c;
+		
+		if (n > 0 && (c = CMSG_FIRSTHDR(&msg)) &&
+			c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS)
+			fid = *(int*)CMSG_DATA(c);
+			
+		uint sz = ((n > 0) ? n : 0);
+		
+		// The request may not have been
+		// received in its entirety; it is
+		// complete once its path is.
+		while (n > 0 && (sz <= sizeof(daemonrequest) || daemonreqbuf[sz-1])) {
+			if ((n = read(daemonconnfid, daemonreqbuf + sz, sizeof(daemonreqbuf) - sz)) > 0)
+				sz += n;
+		}
+		
+		if (fid == -1 || sz <= sizeof(daemonrequest) || daemonreqbuf[sz-1]) {
+			
+			if (fid != -1) close(fid);
+			
+			close(daemonconnfid);
+			daemonconnfid = -1;
+			
+			return 0;
+		}
+		
+		dup2(fid, 2);
+		
+		close(fid);
+		
+		bytcpy((void*)&daemonreq, daemonreqbuf, sizeof(daemonrequest));
+		
+		daemonarg[0] = daemonreqbuf + sizeof(daemonrequest);
+		daemonarg[1] = 0;
+		
+		return 1;
+	}
+	
+	// Function which reply to the request
+	// being served by the compile daemon,
+	// with the status given as argument,
+	// and free the memory allocated
+	// while serving the request.
+	void daemonreply (u32 status) {
+		
+		send(daemonconnfid, &status, sizeof(status), MSG_NOSIGNAL);
+		
+		close(daemonconnfid);
+		daemonconnfid = -1;
+		
+		dup2(daemonstderr, 2);
+		
+		mmsessionfree(daemonsession, MMDOSUBSESSIONS);
+	}
+	
+	if (options.daemon) {
+		
+		string s = filedirname(daemonpath.ptr);
+		
+		uint retvar = filemkdirparents(s.ptr);
+		
+		mmfree(s.ptr);
+		
+		int fid = daemonconnect();
+		
+		if (fid != -1) {
+			close(fid);
+			fprintf(stderr, "lyrical: compile daemon already running\n");
+			exit(-1); // The shell use non-null for failing.
+		}
+		
+		// If I get here, no compile daemon
+		// is accepting requests; the socket,
+		// if it exist, was left by a compile
+		// daemon that got killed.
+		unlink(daemonpath.ptr);
+		
+		struct sockaddr_un addr = {.sun_family = AF_UNIX};
+		
+		if (retvar && (stringmmsz(daemonpath)+1) <= sizeof(addr.sun_path)) {
+			
+			bytcpy(addr.sun_path, daemonpath.ptr, stringmmsz(daemonpath)+1);
+			
+			daemonlistenfid = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0);
+		}
+		
+		if (daemonlistenfid == -1 ||
+			bind(daemonlistenfid, (struct sockaddr*)&addr, sizeof(addr)) == -1 ||
+			listen(daemonlistenfid, 64) == -1) {
+			fprintf(stderr, "lyrical: failure to listen on %s\n", daemonpath.ptr);
+			exit(-1); // The shell use non-null for failing.
+		}
+		
+		// Writing to the stderr of a process
+		// which made a request and terminated
+		// must not terminate the compile daemon.
+		signal(SIGPIPE, SIG_IGN);
+		
+		daemonstderr = fcntl(2, F_DUPFD_CLOEXEC, 3);
+		
+		// I allocate a memory block of size 0
+		// for daemonfiles so that it be outside
+		// of the memory session of each request.
+		daemonfiles.ptr = mmalloc(0);
+	}
+	
+	// I jump here when the compile daemon
+	// is done serving a request.
+	labelfordaemonrequest:;
+	
+	if (daemonlistenfid != -1) {
+		// Requests are served one
+		// at a time, in the order
+		// they were accepted.
+		if (!daemonaccept()) goto labelfordaemonrequest;
+		
+		daemonsession = mmsessionnew();
+		
+		exitstatus = 0;
+		
+		options = daemonreq.options;
+		
+		arg = daemonarg;
+	}
+	
+	// I jump here in a process forked
+	// to compile a library.
+	labelforlibrary:;
+	
 	// Test if there was
 	// any argument given.
 	if (!*arg) {
@@ -237,7 +748,14 @@ void main (uint argc, u8** arg, u8** env) {
 	}
 	
 	if (fileis2(*arg) == FILEISNOTEXIST) {
+		
 		fprintf(stderr, "input file not found\n");
+		
+		if (daemonconnfid != -1) {
+			exitstatus = -1; // The shell use non-null for failing.
+			goto labelforinotifysetup;
+		}
+		
 		exit(-1); // The shell use non-null for failing.
 	}
 	
@@ -250,6 +768,15 @@ void main (uint argc, u8** arg, u8** env) {
 	static string cachepath;
 	cachepath = stringfmt("%s%d", LYRICALCACHEDIR, getuid());
 	
+	// Path to the folder containing
+	// the cache entries of the user;
+	// each cache entry is a folder named
+	// after the hash of everything used
+	// to generate it, and cachepath
+	// is a symlink to the cache entry
+	// of the file to run.
+	string storepath = stringfmt("%sstore/%d", LYRICALCACHEDIR, getuid());
+	
 	// Path to the file "dbg" within
 	// the folder used for caching.
 	// A null string is allocated
@@ -383,6 +910,11 @@ void main (uint argc, u8** arg, u8** env) {
 		
 	} else stringappend2(&cachepath, *arg);
 	
+	// The cache entry of a library is
+	// pointed by a symlink within the
+	// folders mirroring its module folder.
+	if (options.lib) stringappend2(&cachepath, "/.lib");
+	
 	// Path to the file "log" within
 	// the folder used for caching.
 	string cachepathlog;
@@ -402,97 +934,760 @@ void main (uint argc, u8** arg, u8** env) {
 	string cachepathsrc = stringduplicate1(cachepath);
 	stringappend2(&cachepathsrc, "/src");
 	
-	// Path to the file "map" within
+	// Path to the file "mnf" within
 	// the folder used for caching.
-	string cachepathbinmap = stringduplicate1(cachepath);
-	stringappend2(&cachepathbinmap, "/map");
+	string cachepathmnf = stringduplicate1(cachepath);
+	stringappend2(&cachepathmnf, "/mnf");
 	
 	if (options.dbg) {
 		stringappend1(&cachepathdbg, cachepath);
 		stringappend2(&cachepathdbg, "/dbg");
 	}
 	
-	// Function which assess whether
-	// compilation is needed.
-	uint iscompileneeded () {
+	// Structure used to describe
+	// the executable binary
+	// stored to "bin".
+	#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
+	typedef struct {
+		u32 executableinstrsz;
+		u32 constantstringssz;
+		u32 globalvarregionsz;
+	} binmap;
+	#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
+	typedef struct {
+		u64 executableinstrsz;
+		u64 constantstringssz;
+		u64 globalvarregionsz;
+	} binmap;
+	#endif
+	
+	binmap execmap;
+	
+	// Value of the field magic of
+	// the file "mnf"; it must be changed
+	// whenever the layout of "mnf" change.
+	enum {MNFMAGIC = 0x32666e6d6c7279};
+	
+	// Structure used to describe the data
+	// at the top of the file "mnf", which
+	// is the manifest used to validate
+	// the cached executable binary without
+	// having to parse the file "src".
+	// It is followed by srcfilecount
+	// mnfentry, each followed by the
+	// null-terminated path of the source
+	// file that it describe, padded to
+	// a multiple of sizeof(u64).
+	typedef struct {
+		u64 magic;
+		// Hash of everything other than
+		// the source files that affect
+		// the executable binary generated.
+		u64 flagshash;
+		binmap execmap;
+		u64 srcfilecount;
+	} mnfheader;
+	
+	// Structure used to describe
+	// a source file that was used
+	// to build the executable binary.
+	typedef struct {
+		u64 dev;
+		u64 ino;
+		u64 size;
+		// Modification time in nanoseconds;
+		// it is -1 when the source file was
+		// modified while being compiled,
+		// so that it never match.
+		u64 mtimens;
+		// FNV-1a hash of the content
+		// of the source file, which is
+		// used when the source file was
+		// touched without being modified;
+		// it is null when not available.
+		u64 hash;
+		// Size of the path following
+		// the mnfentry, including its
+		// null-terminating byte and padding.
+		u64 pathsz;
+	} mnfentry;
+	
+	// Initial value of an FNV-1a hash.
+	u64 fnv1abasis = 0xcbf29ce484222325;
+	
+	// Function which return the FNV-1a
+	// hash given as argument updated
+	// with the data of size sz pointed
+	// by the argument ptr.
+	u64 fnv1a (u64 hash, u8* ptr, uint sz) {
+		
+		u8* ptrlimit = ptr + sz;
+		
+		while (ptr < ptrlimit) {
+			hash ^= *ptr++;
+			hash *= 0x100000001b3;
+		}
+		
+		return hash;
+	}
+	
+	// Function which return the path
+	// to the socket on which the zygote
+	// of the file to run accept requests;
+	// it is named after the hash of
+	// cachepath, since the path of
+	// a socket is limited in length.
+	string zygotepathfor () {
+		
+		u64 hash = fnv1a(fnv1abasis, cachepath.ptr, stringmmsz(cachepath));
+		
+		return stringfmt("%sstore/%d/.zygote/%08x%08x",
+			LYRICALCACHEDIR, getuid(), (uint)(u32)(hash>>32), (uint)(u32)hash);
+	}
+	
+	// Function which return the FNV-1a
+	// hash of the content of the file
+	// which path is given as argument,
+	// or null if it could not be read.
+	u64 srcfilehash (u8* path) {
+		
+		arrayu8 content = fileread1(path);
+		
+		if (!content.ptr) return 0;
+		
+		u64 hash = fnv1a(fnv1abasis, content.ptr, arrayu8sz(content));
+		
+		mmfree(content.ptr);
 		
-		if (fileis1(cachepath.ptr) == FILEISFOLDER) {
-			// If I get here, the folder
-			// for the cached compiled binary
-			// exist; I proceed to checking
-			// whether its source files were
-			// modified since it was last
-			// compiled.
+		// A null hash mean
+		// that it is not available.
+		return (hash ? hash : 1);
+	}
+	
+	// Flags used with lyricalcompile()
+	// when compiling a library; libraries
+	// export the functions declared by
+	// their module .lyh file, and import
+	// the ones of other libraries.
+	uint libcompileflag = (options.log ? LYRICALCOMPILECOMMENT : 0);
+	
+	// Flags used with lyricalcompile()
+	// and the backend; the file to run
+	// import the functions of libraries,
+	// unless it is linked statically.
+	uint compileflag = options.lib ? libcompileflag :
+		(LYRICALCOMPILENOFUNCTIONEXPORT
+		| ((options.dbg || options.staticlink) ? LYRICALCOMPILENOFUNCTIONIMPORT : 0)
+		| (options.dbg ? (LYRICALCOMPILEGENERATEDEBUGINFO|LYRICALCOMPILENOTAILCALL) : 0)
+		| (options.log ? LYRICALCOMPILECOMMENT : 0));
+	#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
+	uint backendflag = LYRICALBACKENDX86PAGEALIGNED|options.codealign;
+	#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
+	uint backendflag = LYRICALBACKENDX64PAGEALIGNED|options.codealign;
+	#endif
+	
+	// Function which return the hash
+	// of everything other than the source
+	// files that affect the executable binary
+	// generated using the compile flags given
+	// as argument; the date and time at which
+	// the runner was built stand for the version
+	// of the compiler and backend linked in it.
+	u64 flagshashfor (uint compileflag) {
+		
+		u8 compilerversion[] = __DATE__" "__TIME__;
+		
+		u64 hash = fnv1a(fnv1abasis, compilerversion, sizeof(compilerversion));
+		hash = fnv1a(hash, (u8*)&compileflag, sizeof(compileflag));
+		hash = fnv1a(hash, (u8*)&backendflag, sizeof(backendflag));
+		hash = fnv1a(hash, (u8*)&options.tcpipv4svr.en, sizeof(options.tcpipv4svr.en));
+		
+		return hash;
+	}
+	
+	// Hash of everything other than
+	// the source files that affect
+	// the executable binary generated.
+	u64 flagshash = flagshashfor(compileflag);
+	
+	// flagshash of the cache entries
+	// of the libraries; it is used to
+	// validate them without forking.
+	u64 libflagshash = flagshashfor(libcompileflag);
+	
+	// Function which return the key of the
+	// cache entry generated from the source
+	// files described in the "mnf" of size
+	// mnfsz pointed by mnf, which is the hash
+	// of flagshash, and of the path and
+	// content hash of each source file.
+	// When curhash is non-null, the hash
+	// of the current content of each source
+	// file is used instead of the one
+	// in its mnfentry.
+	// Null is returned if "mnf" is invalid
+	// or a source file could not be read.
+	u64 mnfkey (u8* mnf, uint mnfsz, uint curhash) {
+		
+		u64 key = fnv1a(fnv1abasis, (u8*)&flagshash, sizeof(flagshash));
+		
+		u8* ptr = mnf + sizeof(mnfheader);
+		u8* ptrlimit = mnf + mnfsz;
+		
+		uint srcfilecount = ((mnfheader*)mnf)->srcfilecount;
+		
+		while (srcfilecount) {
+			
+			mnfentry* e = (mnfentry*)ptr;
 			
-			// I get the timestamp of the executable.
-			uint cachepathbintimestamp = filetimestamp(cachepathbin.ptr);
+			if ((ptr + sizeof(mnfentry)) > ptrlimit ||
+				(ptr += (sizeof(mnfentry) + e->pathsz)) > ptrlimit)
+				return 0;
+				
+			u8* srcfilepath = (u8*)(e+1);
 			
-			if (!cachepathbintimestamp) goto deletecachepath;
+			u64 hash = (curhash ? srcfilehash(srcfilepath) : e->hash);
 			
-			// I load the file "src" which contain
-			// the list of source files which
-			// were used to build the executable.
-			arrayu8 cachepathsrcloaded = fileread1(cachepathsrc.ptr);
+			if (curhash && !hash) return 0;
 			
-			if (!cachepathsrcloaded.ptr) {
-				
-				mmfree(cachepathsrcloaded.ptr);
-				
-				goto deletecachepath;
-			}
+			key = fnv1a(key, srcfilepath, e->pathsz);
+			key = fnv1a(key, (u8*)&hash, sizeof(hash));
+			
+			--srcfilecount;
+		}
+		
+		return key;
+	}
+	
+	// Function which return the path
+	// of the cache entry which key is
+	// given as argument.
+	string storeentrypath (u64 key) {
+		return stringfmt("%s/%08x%08x", storepath.ptr, (uint)(u32)(key>>32), (uint)(u32)key);
+	}
+	
+	// Function which make cachepath
+	// a symlink to the cache entry which
+	// path is given as argument; the symlink
+	// is created in the store, and renamed
+	// to cachepath so as to atomically
+	// replace any previous symlink.
+	// Null is returned on failure.
+	uint cachepathlink (u8* entrypath) {
+		// A folder was used
+		// by previous versions.
+		if (fileis1(cachepath.ptr) == FILEISFOLDER &&
+			!fileremoverecursive(cachepath.ptr))
+			return 0;
+			
+		string s = filedirname(cachepath.ptr);
+		
+		uint retvar = filemkdirparents(s.ptr);
+		
+		mmfree(s.ptr);
+		
+		if (!retvar) return 0;
+		
+		s = stringfmt("%s/.%d", storepath.ptr, getpid());
+		
+		unlink(s.ptr);
+		
+		if (!(retvar = (!symlink(entrypath, s.ptr) && !rename(s.ptr, cachepath.ptr))))
+			unlink(s.ptr);
 			
-			// Check the timestamp of each
-			// of the files mentioned in "src".
+		mmfree(s.ptr);
+		
+		return retvar;
+	}
+	
+	// Function which evict the least
+	// recently used cache entries from
+	// the store, until the size of
+	// all its cache entries is no more
+	// than LYRICALCACHESTOREMAXSZ.
+	// The cache entry which path is
+	// given as argument is never evicted.
+	// The time at which a cache entry
+	// was last used is the modification
+	// time of its file "mnf".
+	// The folders in .tmp, left by processes
+	// that were killed while compiling,
+	// are removed as well.
+	void storeevict (u8* entrypath) {
+		
+		// The folders in .tmp are named after
+		// the pid of the process generating them;
+		// a folder which process is no longer
+		// alive is never going to be published.
+		string tmppath = stringfmt("%s/.tmp", storepath.ptr);
+		
+		uint tmpcallback (filelsdirtype type, string path) {
 			
-			u8* srcfilepath;
+			if (stringiseq1(path, tmppath)) return 1;
 			
-			u8* ptr = cachepathsrcloaded.ptr;
+			if (type != FILELSDIRTYPEDIRECTORY) return 1;
 			
-			while (*ptr) {
+			u8* name = path.ptr + stringmmsz(path);
+			while (name[-1] != '/') --name;
+			
+			pid_t pid = atoi(name);
+			
+			if (pid > 0 && kill(pid, 0) == -1 && errno == ESRCH)
+				fileremoverecursive(path.ptr);
 				
-				srcfilepath = ptr;
+			return -1;
+		}
+		
+		filelsdir(tmppath, tmpcallback);
+		
+		mmfree(tmppath.ptr);
+		
+		typedef struct {
+			string path;
+			u64 lastused;
+			u64 sz;
+		} storeentry;
+		
+		arrayu8 entries = arrayu8null;
+		
+		u64 storesz = 0;
+		
+		uint callback (filelsdirtype type, string path) {
+			
+			struct stat st;
+			
+			if (type == FILELSDIRTYPEDIRECTORY) {
 				
-				do ++ptr; while (*ptr && *ptr != '\n');
+				if (stringiseq1(path, storepath)) return 1;
 				
-				if (*ptr) {
-					*ptr = 0;
-					++ptr;
-				}
+				u8* name = path.ptr + stringmmsz(path);
+				while (name[-1] != '/') --name;
 				
-				uint srcfiletimestamp = filetimestamp(srcfilepath);
+				// Folders which name start with '.'
+				// are not cache entries, but are
+				// used for locking and for cache
+				// entries still being generated.
+				if (*name == '.') return -1;
 				
-				if (!srcfiletimestamp || srcfiletimestamp > cachepathbintimestamp) {
+				if (!stat(path.ptr, &st)) {
 					
-					mmfree(cachepathsrcloaded.ptr);
+					storeentry* e = (storeentry*)arrayu8append2(&entries, sizeof(storeentry));
 					
-					goto deletecachepath;
+					e->path = stringduplicate2(path.ptr);
+					e->lastused = st.st_mtime;
+					e->sz = 0;
 				}
-			}
-			
-			mmfree(cachepathsrcloaded.ptr);
-			
-			// I return 0 to signal that
-			// compilation is not needed.
-			return 0;
+				
+			} else if (type == FILELSDIRTYPEREGULAR && entries.ptr && !stat(path.ptr, &st)) {
+				// Since folders are listed before
+				// their content, the file belong
+				// to the last cache entry listed.
+				storeentry* e = (storeentry*)(entries.ptr + arrayu8sz(entries) - sizeof(storeentry));
+				
+				e->sz += st.st_size;
+				
+				storesz += st.st_size;
+				
+				uint pathsz = stringmmsz(path);
+				
+				if (pathsz > 4 && stringiseq3(path.ptr + pathsz - 4, "/mnf"))
+					e->lastused = st.st_mtime;
+					
+			} else if (type == FILELSDIRTYPESYMLINK) return -1;
 			
-		} else goto createcachepath;
-		
-		deletecachepath:
-		
-		if (!fileremoverecursive(cachepath.ptr)) {
-			fprintf(stderr, "failed to delete %s\n", cachepath.ptr);
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
+			return 1;
 		}
 		
-		createcachepath:
+		filelsdir(storepath, callback);
 		
-		// If I get here, the folder
-		// for the cached compiled binary
-		// do not exist; I create it.
+		storeentry* e = (storeentry*)entries.ptr;
+		storeentry* elimit = (storeentry*)(entries.ptr + arrayu8sz(entries));
 		
-		if (!filemkdirparents(cachepath.ptr)) {
-			fprintf(stderr, "failed to create %s\n", cachepath.ptr);
+		while (storesz > LYRICALCACHESTOREMAXSZ) {
+			// Find the least recently
+			// used cache entry left.
+			
+			storeentry* lru = 0;
+			
+			for (storeentry* ee = e; ee < elimit; ++ee) {
+				if (ee->path.ptr && !stringiseq2(ee->path, entrypath) &&
+					(!lru || ee->lastused < lru->lastused))
+					lru = ee;
+			}
+			
+			if (!lru) break;
+			
+			fileremoverecursive(lru->path.ptr);
+			
+			storesz -= lru->sz;
+			
+			mmfree(lru->path.ptr);
+			
+			lru->path = stringnull;
+		}
+		
+		while (e < elimit) {
+			if (e->path.ptr) mmfree(e->path.ptr);
+			++e;
+		}
+		
+		if (entries.ptr) mmfree(entries.ptr);
+	}
+	
+	// Function which check whether the
+	// cache entry which file "mnf" path
+	// is given as argument is valid, and
+	// was generated with the flagshash given
+	// by the argument hash, in which case
+	// the binmap pointed by the argument
+	// map get set and 1 is returned; only the file
+	// "mnf" get opened, and the source
+	// files get stat()'ed, unless they
+	// were checked less than
+	// options.trustcache seconds ago.
+	// When the cache entry is not valid,
+	// but its file "mnf" could be loaded,
+	// and savedmnf is non-null, the file
+	// "mnf" loaded is returned through
+	// savedmnf and savedmnfsz, and must
+	// be freed by the caller.
+	uint mnfcheck (u8* mnfpath, u64 hash, binmap* map, u8** savedmnf, uint* savedmnfsz) {
+		
+		int fid;
+		
+		if ((fid = open(mnfpath, O_RDWR)) == -1) return 0;
+		
+		struct stat st;
+		
+		if (fstat(fid, &st) == -1 || st.st_size < sizeof(mnfheader)) {
+			close(fid);
+			return 0;
+		}
+		
+		// I load the file "mnf".
+		
+		uint mnfsz = st.st_size;
+		
+		u8* mnf = mmalloc(mnfsz);
+		
+		if (read(fid, mnf, mnfsz) != mnfsz || ((mnfheader*)mnf)->magic != MNFMAGIC) {
+			mmfree(mnf);
+			close(fid);
+			return 0;
+		}
+		
+		// The cache entry was generated
+		// using different flags or
+		// a different compiler.
+		if (((mnfheader*)mnf)->flagshash != hash) goto mnfisinvalid;
+		
+		struct timespec now;
+		clock_gettime(CLOCK_REALTIME, &now);
+		
+		// When the source files were
+		// checked less than options.trustcache
+		// seconds ago, they are trusted to
+		// still be unmodified; the modification
+		// time of "mnf" is the time they were
+		// last checked.
+		if (options.trustcache && now.tv_sec >= st.st_mtim.tv_sec &&
+			now.tv_sec < (st.st_mtim.tv_sec + options.trustcache))
+			goto mnfisvalid;
+			
+		// Check each of the source
+		// files mentioned in "mnf".
+		
+		u8* ptr = mnf + sizeof(mnfheader);
+		u8* ptrlimit = mnf + mnfsz;
+		
+		uint srcfilecount = ((mnfheader*)mnf)->srcfilecount;
+		
+		while (srcfilecount) {
+			
+			mnfentry* e = (mnfentry*)ptr;
+			
+			if ((ptr + sizeof(mnfentry)) > ptrlimit ||
+				(ptr += (sizeof(mnfentry) + e->pathsz)) > ptrlimit)
+				goto mnfisinvalid;
+				
+			u8* srcfilepath = (u8*)(e+1);
+			
+			if (stat(srcfilepath, &st) == -1) goto mnfisinvalid;
+			
+			u64 mtimens = ((u64)st.st_mtim.tv_sec*1000000000 + st.st_mtim.tv_nsec);
+			
+			if (e->dev != st.st_dev || e->ino != st.st_ino ||
+				e->size != st.st_size || e->mtimens != mtimens) {
+				// The source file is still
+				// unmodified if its content
+				// has the same size and hash.
+				if (e->size != st.st_size || !e->hash ||
+					srcfilehash(srcfilepath) != e->hash)
+					goto mnfisinvalid;
+					
+				// Update the mnfentry so that
+				// the hash of the source file
+				// do not get computed again.
+				e->dev = st.st_dev;
+				e->ino = st.st_ino;
+				e->mtimens = mtimens;
+				
+				pwrite(fid, e, sizeof(mnfentry), (u8*)e - mnf);
+			}
+			
+			--srcfilecount;
+		}
+		
+		// Set the modification time of "mnf"
+		// to the time the source files were
+		// checked, so that they get trusted
+		// for the next options.trustcache seconds;
+		// it is also the time at which the
+		// cache entry was last used.
+		futimens(fid, 0);
+		
+		mnfisvalid:
+		
+		*map = ((mnfheader*)mnf)->execmap;
+		
+		mmfree(mnf);
+		
+		close(fid);
+		
+		return 1;
+		
+		mnfisinvalid:
+		
+		if (savedmnf) {
+			*savedmnf = mnf;
+			*savedmnfsz = mnfsz;
+		} else mmfree(mnf);
+		
+		close(fid);
+		
+		return 0;
+	}
+	
+	// Function which check whether
+	// a valid cache entry exist for
+	// the file to run, in which case
+	// execmap get set and 1 is returned.
+	uint iscachevalid () {
+		
+		u8* mnf = 0;
+		uint mnfsz;
+		
+		if (mnfcheck(cachepathmnf.ptr, flagshash, &execmap, &mnf, &mnfsz)) return 1;
+		
+		// If I get here, the cache entry
+		// pointed by cachepath is missing
+		// or out of date; but a cache entry
+		// may exist for the current content
+		// of the source files it was generated
+		// from and the current flags, ie: when
+		// a modification or an option was reverted.
+		if (mnf) {
+			
+			u64 key = mnfkey(mnf, mnfsz, 1);
+			
+			mmfree(mnf);
+			
+			if (key) {
+				
+				string entrypath = storeentrypath(key);
+				
+				string entrypathmnf = stringfmt("%s/mnf", entrypath.ptr);
+				
+				uint isvalid = (mnfcheck(entrypathmnf.ptr, flagshash, &execmap, 0, 0) && cachepathlink(entrypath.ptr));
+				
+				mmfree(entrypathmnf.ptr);
+				mmfree(entrypath.ptr);
+				
+				if (isvalid) return 1;
+			}
+		}
+		
+		return 0;
+	}
+	
+	// Variable set to the file descriptor
+	// of the file locked by cachepathlock(),
+	// or -1 if the lock is not held.
+	int cachelockfid = -1;
+	
+	// Function which lock the file used
+	// to serialize the compilation of the
+	// file to run among processes running
+	// it concurrently, waiting for the
+	// process holding the lock if any.
+	// The lock is per path of the file
+	// to run rather than per cache entry,
+	// because the key of the cache entry
+	// is known only after compilation.
+	// The lock is released when cachelockfid
+	// is closed, or when the process exit.
+	// Null is returned on failure.
+	uint cachepathlock () {
+		
+		string s = stringfmt("%s/.lock", storepath.ptr);
+		
+		if (!filemkdirparents(s.ptr)) {
+			mmfree(s.ptr);
+			return 0;
+		}
+		
+		u64 hash = fnv1a(fnv1abasis, cachepath.ptr, stringmmsz(cachepath));
+		
+		string path = stringfmt("%s/%08x%08x", s.ptr, (uint)(u32)(hash>>32), (uint)(u32)hash);
+		
+		mmfree(s.ptr);
+		
+		cachelockfid = open(path.ptr, O_RDWR|O_CREAT|O_CLOEXEC, 0600);
+		
+		mmfree(path.ptr);
+		
+		if (cachelockfid == -1) return 0;
+		
+		while (flock(cachelockfid, LOCK_EX) == -1) {
+			if (errno != EINTR) {
+				close(cachelockfid);
+				cachelockfid = -1;
+				return 0;
+			}
+		}
+		
+		return 1;
+	}
+	
+	// Function which release
+	// the lock held if any.
+	void cachepathunlock () {
+		if (cachelockfid != -1) {
+			close(cachelockfid);
+			cachelockfid = -1;
+		}
+	}
+	
+	// Function which request the compile
+	// daemon of the user to compile the file
+	// to run, and return the status it replied;
+	// DAEMONREJECTED is returned if it is not
+	// running or failed to reply.
+	uint daemoncompile () {
+		// A process forked by the compile
+		// daemon to compile a library
+		// do not request it.
+		if (daemonlistenfid != -1) return DAEMONREJECTED;
+		
+		int fid = daemonconnect();
+		
+		if (fid == -1) return DAEMONREJECTED;
+		
+		daemonrequest req = {
+			.options = options,
+			.flagshash = flagshash
+		};
+		
+		// The absolute path of the file
+		// to run is the end of cachepath,
+		// unless it is the module folder
+		// of a library, since "/.lib" get
+		// appended to cachepath.
+		u8* filepath;
+		
+		if (options.lib) filepath = *arg;
+		else {
+			string s = stringfmt("%s%d", LYRICALCACHEDIR, getuid());
+			
+			filepath = cachepath.ptr + stringmmsz(s);
+			
+			mmfree(s.ptr);
+		}
+		
+		struct iovec iov[2] = {
+			{.iov_base = &req, .iov_len = sizeof(req)},
+			{.iov_base = filepath, .iov_len = stringsz(filepath) + 1}
+		};
+		
+		// The stderr of this process
+		// is sent along with the request.
+		union {
+			struct cmsghdr h;
+			u8 buf[CMSG_SPACE(sizeof(int))];
+		} cmsg;
+		
+		struct msghdr msg = {
+			.msg_iov = iov,
+			.msg_iovlen = 2,
+			.msg_control = cmsg.buf,
+			.msg_controllen = sizeof(cmsg.buf)
+		};
+		
+		struct cmsghdr* c = CMSG_FIRSTHDR(&msg);
+		c->cmsg_level = SOL_SOCKET;
+		c->cmsg_type = SCM_RIGHTS;
+		c->cmsg_len = CMSG_LEN(sizeof(int));
+		*(int*)CMSG_DATA(c) = 2;
+		
+		u32 status;
+		
+		// I wait for the reply, which come
+		// after the compilation completed.
+		if (sendmsg(fid, &msg, MSG_NOSIGNAL) != (iov[0].iov_len + iov[1].iov_len) ||
+			read(fid, &status, sizeof(status)) != sizeof(status))
+			status = DAEMONREJECTED;
+			
+		close(fid);
+		
+		return status;
+	}
+	
+	// Function which assess whether
+	// compilation is needed; when it
+	// is not needed, execmap get set.
+	// When compilation is needed,
+	// the lock from cachepathlock()
+	// is held, so that processes started
+	// concurrently to run the same file
+	// do not all compile it; they instead
+	// wait for the compilation to complete,
+	// and use the cache entry generated.
+	uint iscompileneeded () {
+		// I return 0 to signal that
+		// compilation is not needed.
+		if (iscachevalid()) return 0;
+		
+		// If the lock cannot be obtained,
+		// I compile without it, since the
+		// cache entry generated is anyway
+		// published atomically.
+		if (!cachepathlock()) {
+			fprintf(stderr, "failure to lock %s\n", cachepath.ptr);
+			return 1;
+		}
+		
+		// The cache entry may have been
+		// generated by the process which
+		// was holding the lock.
+		if (iscachevalid()) {
+			cachepathunlock();
+			return 0;
+		}
+		
+		// When the compile daemon of the user
+		// is running, I request it to compile
+		// the file; otherwise, or if the request
+		// was not served, I compile it myself.
+		uint status = daemoncompile();
+		
+		if (status == DAEMONCOMPILED && iscachevalid()) {
+			cachepathunlock();
+			return 0;
+		}
+		
+		if (status == DAEMONFAILED) {
+			// The compile daemon
+			// already wrote the errors.
 			exitstatus = -1; // The shell use non-null for failing.
 			goto labelforinotifysetup;
 		}
@@ -502,27 +1697,85 @@ void main (uint argc, u8** arg, u8** env) {
 		return 1;
 	}
 	
-	// Structure used to describe
-	// the data stored to "map".
-	#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
-	typedef struct {
-		u32 executableinstrsz;
-		u32 constantstringssz;
-		u32 globalvarregionsz;
-	} binmap;
-	#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
-	typedef struct {
-		u64 executableinstrsz;
-		u64 constantstringssz;
-		u64 globalvarregionsz;
-	} binmap;
-	#endif
+	// Function which generate the file
+	// "mnf", without execmap, from the list
+	// of source files used to build the
+	// executable binary; any source file
+	// modified after compilestart could
+	// have been read before its modification,
+	// hence it is made to never match.
+	// arrayu8null is returned on failure.
+	arrayu8 mnfgenerate (string srcfilepaths, struct timespec compilestart) {
+		
+		arrayu8 mnf = arrayu8null;
+		
+		mnfheader* h = (mnfheader*)arrayu8append2(&mnf, sizeof(mnfheader));
+		h->magic = MNFMAGIC;
+		h->flagshash = flagshash;
+		h->srcfilecount = 0;
+		
+		u64 compilestartns = ((u64)compilestart.tv_sec*1000000000 + compilestart.tv_nsec);
+		
+		u8* ptr = srcfilepaths.ptr;
+		
+		while (*ptr) {
+			
+			u8* srcfilepath = ptr;
+			
+			do ++ptr; while (*ptr && *ptr != '\n');
+			
+			u8 c = *ptr;
+			
+			*ptr = 0;
+			
+			struct stat st;
+			
+			if (stat(srcfilepath, &st) == -1) {
+				*ptr = c;
+				mmfree(mnf.ptr);
+				return arrayu8null;
+			}
+			
+			uint srcfilepathsz = ((ptr - srcfilepath) + 1);
+			
+			uint pathsz = ROUNDUPTOPOWEROFTWO(srcfilepathsz, sizeof(u64));
+			
+			mnfentry* e = (mnfentry*)arrayu8append2(&mnf, sizeof(mnfentry) + pathsz);
+			
+			e->dev = st.st_dev;
+			e->ino = st.st_ino;
+			e->size = st.st_size;
+			e->mtimens = ((u64)st.st_mtim.tv_sec*1000000000 + st.st_mtim.tv_nsec);
+			e->pathsz = pathsz;
+			
+			if (e->mtimens >= compilestartns) {
+				e->mtimens = -1;
+				e->hash = 0;
+			} else e->hash = srcfilehash(srcfilepath);
+			
+			bytcpy(e+1, srcfilepath, srcfilepathsz);
+			bytsetz((u8*)(e+1) + srcfilepathsz, pathsz - srcfilepathsz);
+			
+			// arrayu8append2() may have
+			// moved the array in memory.
+			++((mnfheader*)mnf.ptr)->srcfilecount;
+			
+			if ((*ptr = c)) ++ptr;
+		}
+		
+		return mnf;
+	}
 	
 	// Variable which will be set
 	// with the address to jump to
 	// in order to start execution.
 	void* execpages = 0;
 	
+	// Variable which will be set with
+	// the offset of the stack page pool
+	// within the global variable region.
+	uint stackpagepooloffset = 0;
+	
 	#ifdef LYRICALUSEINOTIFY
 	// Variable which will be set to
 	// the string containing the list
@@ -531,11 +1784,520 @@ void main (uint argc, u8** arg, u8** env) {
 	string execsrc = stringnull;
 	#endif
 	
-	binmap execmap;
+	// The compile daemon always compile
+	// the file, since the process making
+	// the request found it needed to be
+	// compiled, and hold the lock from
+	// cachepathlock() until replied.
+	if (daemonconnfid != -1 && daemonreq.flagshash != flagshash) {
+		daemonreply(DAEMONREJECTED);
+		goto labelfordaemonrequest;
+	}
+	
+	// Function which return whether
+	// the path given by the argument path
+	// is among the newline terminated
+	// paths of the list given as argument.
+	uint islisted (u8* list, u8* path) {
+		
+		uint pathsz = stringsz(path);
+		
+		while (*list) {
+			
+			u8* listend = list;
+			
+			while (*listend && *listend != '\n') ++listend;
+			
+			if ((listend - list) == pathsz && stringiseq4(list, path, pathsz)) return 1;
+			
+			list = (*listend ? listend+1 : listend);
+		}
+		
+		return 0;
+	}
+	
+	// Newline separated list of
+	// the folders of the modules
+	// which the file to run import
+	// as libraries; it is stored
+	// to the file "lib".
+	string libpaths = stringnull;
+	
+	// Structure used to describe
+	// a library linked with the
+	// executable binary.
+	typedef struct {
+		// Pages where the library
+		// get mapped, and its global
+		// variable region.
+		void* execpages;
+		void** globalvarregion;
+		
+	} librun;
+	
+	// Array of librun, in the order in
+	// which the root function of the libraries
+	// are run, before the root function
+	// of the executable binary; a library
+	// is run after the libraries it import.
+	arrayu8 libruns = arrayu8null;
+	
+	// Newline separated list of the symlinks
+	// pointing to the cache entries of the
+	// libraries linked; it is set only with
+	// option "zygote", which use it to check
+	// whether the libraries it mapped are
+	// still up to date.
+	string zygotelibs = stringnull;
+	
+	// Newline separated list of the folders
+	// of the modules of the libraries being
+	// compiled by this process and the processes
+	// that forked it; a library which get imported
+	// while being compiled is not imported, since
+	// waiting on its compilation would deadlock.
+	string libcompiling = stringnull;
+	
+	// Function which make sure that the cache entry
+	// of the library, which module folder is given
+	// by the argument path, is valid; the library is
+	// compiled by a forked process when needed,
+	// which do so the same way the file to run
+	// is compiled, then exit.
+	// It return 1 on success, setting map
+	// with the executable map of the library.
+	// When isquiet is 1, the forked process
+	// do not write the compilation errors.
+	uint libcompile (u8* path, binmap* map, uint isquiet) {
+		
+		string s = stringfmt("%s%d%s/.lib/mnf", LYRICALCACHEDIR, getuid(), path);
+		
+		uint retvar = mnfcheck(s.ptr, libflagshash, map, 0, 0);
+		
+		if (!retvar) {
+			// Output buffered so far must not
+			// get written again by the forked process.
+			fflush(stdout);
+			
+			pid_t pid = fork();
+			
+			if (!pid) {
+				
+				if (isquiet) {
+					
+					int fid = open("/dev/null", O_WRONLY);
+					
+					if (fid != -1) {
+						dup2(fid, 2);
+						close(fid);
+					}
+				}
+				
+				// The request being served, and the
+				// lock held, belong to the process
+				// which forked; note that the compile
+				// daemon is not requested by a process
+				// which it forked, as it would
+				// be waiting on that process.
+				if (daemonconnfid != -1) {
+					close(daemonconnfid);
+					daemonconnfid = -1;
+				}
+				
+				cachepathunlock();
+				
+				if (libcompiling.ptr) stringappend2(&libcompiling, path);
+				else libcompiling = stringduplicate2(path);
+				
+				stringappend4(&libcompiling, '\n');
+				
+				options.lib = 1;
+				
+				libarg[0] = path;
+				libarg[1] = 0;
+				
+				arg = libarg;
+				
+				goto labelforlibrary;
+			}
+			
+			int status;
+			
+			retvar = (pid != -1 && waitpid(pid, &status, 0) != -1 &&
+				WIFEXITED(status) && !WEXITSTATUS(status) &&
+				mnfcheck(s.ptr, libflagshash, map, 0, 0));
+		}
+		
+		mmfree(s.ptr);
+		
+		return retvar;
+	}
+	
+	// Function which return the address at which
+	// executable pages of the size given as argument
+	// are to be mapped using MAP_FIXED, or null
+	// to let mmap() choose it; with option "hugepages",
+	// an address range larger by LYRICALHUGEPAGESZ
+	// is reserved, then trimmed around the address
+	// aligned to LYRICALHUGEPAGESZ that it contain.
+	void* execpagesaddr (uint sz) {
+		
+		#if defined(__linux__)
+		if (!options.hugepages) return 0;
+		
+		void* pages = mmap(
+			0,
+			sz + LYRICALHUGEPAGESZ,
+			PROT_NONE,
+			MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE,
+			0, 0);
+			
+		if (pages == (void*)-1) return 0;
+		
+		void* alignedpages = (void*)ROUNDUPTOPOWEROFTWO((uint)pages, LYRICALHUGEPAGESZ);
+		
+		if (alignedpages != pages) munmap(pages, alignedpages - pages);
+		
+		munmap(alignedpages + sz, (pages + LYRICALHUGEPAGESZ) - alignedpages);
+		
+		return alignedpages;
+		#else
+		return 0;
+		#endif
+	}
+	
+	// Function which return the flags to use
+	// with mmap() in addition to MAP_PRIVATE when
+	// mapping the file "bin" of a cache entry at
+	// the address given as argument, which was
+	// returned by execpagesaddr(); with option
+	// "prefault", the pages of the file are loaded
+	// in memory by mmap(), instead of each getting
+	// loaded by a page fault on its first access.
+	uint execpagesmapflags (void* addr) {
+		
+		uint flags = (addr ? MAP_FIXED : 0);
+		
+		#if defined(__linux__)
+		if (options.prefault) flags |= MAP_POPULATE;
+		#endif
+		
+		return flags;
+	}
+	
+	// Function which, with option "hugepages",
+	// advise the kernel to use huge pages for
+	// the executable instructions and global variable
+	// region of the executable pages given as argument,
+	// using the binmap aligned to a pagesize given
+	// as argument; failures are ignored, since
+	// the pages remain usable without huge pages.
+	void execpagesadvise (void* pages, binmap map) {
+		
+		#if defined(__linux__)
+		if (!options.hugepages) return;
+		
+		madvise(pages, map.executableinstrsz, MADV_HUGEPAGE);
+		
+		if (map.globalvarregionsz) madvise(
+			pages + map.executableinstrsz + map.constantstringssz,
+			map.globalvarregionsz,
+			MADV_HUGEPAGE);
+		#endif
+	}
+	
+	// Structure of a request sent to
+	// the zygote of the file to run; it is
+	// followed by the null terminated strings
+	// of the current working directory,
+	// of the arguments and of the environment
+	// of the process making the request,
+	// and sent along with its stdin, stdout
+	// and stderr, which the process forked
+	// by the zygote use to run the file.
+	typedef struct {
+		// Options with which the file
+		// is to be run; the zygote serve
+		// only requests made with the options
+		// that it was run with.
+		typeof(options) options;
+		
+		// flagshash computed by the
+		// process making the request.
+		u64 flagshash;
+		
+		// Count of arguments and
+		// environment variables, and size
+		// of the strings following the request.
+		uint argc;
+		uint envc;
+		uint sz;
+		
+	} zygoterequest;
+	
+	// Function which request the zygote
+	// of the file to run, if it is running,
+	// to run it; the process forked by the
+	// zygote reply with its pid, then with
+	// its exit status once it terminate,
+	// with which this process exit.
+	// It return if the request was
+	// not served, ie: when the zygote
+	// found its cache entry out of date.
+	void zygoterun () {
+		
+		string s = zygotepathfor();
+		
+		struct sockaddr_un addr = {.sun_family = AF_UNIX};
+		
+		int fid = -1;
+		
+		if ((stringmmsz(s)+1) <= sizeof(addr.sun_path)) {
+			
+			bytcpy(addr.sun_path, s.ptr, stringmmsz(s)+1);
+			
+			fid = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0);
+			
+			if (fid != -1 && connect(fid, (struct sockaddr*)&addr, sizeof(addr)) == -1) {
+				// No process is listening on
+				// the socket, which was left
+				// by a zygote that got killed,
+				// hence I remove it.
+				if (errno == ECONNREFUSED) unlink(s.ptr);
+				close(fid);
+				fid = -1;
+			}
+		}
+		
+		mmfree(s.ptr);
+		
+		if (fid == -1) return;
+		
+		zygoterequest req = {
+			.options = options,
+			.flagshash = flagshash
+		};
+		
+		arrayu8 strs = arrayu8null;
+		
+		void strsappend (u8* str) {
+			uint sz = stringsz(str) + 1;
+			bytcpy(arrayu8append2(&strs, sz), str, sz);
+		}
+		
+		s = filegetcwd();
+		strsappend(s.ptr);
+		mmfree(s.ptr);
+		
+		for (u8** a = arg; *a; ++a, ++req.argc) strsappend(*a);
+		for (u8** e = env; *e; ++e, ++req.envc) strsappend(*e);
+		
+		req.sz = arrayu8sz(strs);
+		
+		struct iovec iov[2] = {
+			{.iov_base = &req, .iov_len = sizeof(req)},
+			{.iov_base = strs.ptr, .iov_len = req.sz}
+		};
+		
+		// The stdin, stdout and stderr of this
+		// process are sent along with the request.
+		union {
+			struct cmsghdr h;
+			u8 buf[CMSG_SPACE(3*sizeof(int))];
+		} cmsg;
+		
+		struct msghdr msg = {
+			.msg_iov = iov,
+			.msg_iovlen = 2,
+			.msg_control = cmsg.buf,
+			.msg_controllen = sizeof(cmsg.buf)
+		};
+		
+		struct cmsghdr* c = CMSG_FIRSTHDR(&msg);
+		c->cmsg_level = SOL_SOCKET;
+		c->cmsg_type = SCM_RIGHTS;
+		c->cmsg_len = CMSG_LEN(3*sizeof(int));
+		((int*)CMSG_DATA(c))[0] = 0;
+		((int*)CMSG_DATA(c))[1] = 1;
+		((int*)CMSG_DATA(c))[2] = 2;
+		
+		pid_t pid;
+		
+		uint retvar = (sendmsg(fid, &msg, MSG_NOSIGNAL) == (iov[0].iov_len + iov[1].iov_len) &&
+			read(fid, &pid, sizeof(pid)) == sizeof(pid));
+			
+		if (strs.ptr) mmfree(strs.ptr);
+		
+		if (!retvar) {
+			close(fid);
+			return;
+		}
+		
+		// Since the process forked by the zygote
+		// is not in the process group of this
+		// process, the signals used to interrupt
+		// this process are forwarded to it.
+		void forwardsignal (int sig) {
+			kill(pid, sig);
+		}
+		
+		signal(SIGINT, forwardsignal);
+		signal(SIGQUIT, forwardsignal);
+		signal(SIGTERM, forwardsignal);
+		signal(SIGHUP, forwardsignal);
+		
+		u32 status;
+		
+		sint n;
+		
+		while ((n = read(fid, &status, sizeof(status))) == -1 && errno == EINTR);
+		
+		// The forked process did not reply
+		// with its exit status if it got
+		// terminated by a signal.
+		exit((n == sizeof(status)) ? status : -1); // The shell use non-null for failing.
+	}
 	
+	// When the zygote of the file to run
+	// is running, I request it to run the file;
+	// the compile daemon, the processes compiling
+	// a library, and the servers do not request it.
+	if (!options.zygote && !options.lib && !options.tcpipv4svr.en && daemonlistenfid == -1)
+		zygoterun();
+		
 	// I check whether the file
 	// need to be compiled.
-	if (iscompileneeded()) {
+	if (daemonconnfid != -1 || iscompileneeded()) {
+		
+		// Path to the folder in which the results
+		// of preprocessing included files are persisted;
+		// its name start with '.' so that storeevict()
+		// ignore it; since the key of a result do not
+		// depend on the content of the file preprocessed,
+		// a file modified get its result replaced.
+		string preprocessedpath = stringfmt("%s/.pp", storepath.ptr);
+		
+		// Function which return the path of the file
+		// persisting the result of preprocessing an included
+		// file, which key is given as argument; the key is
+		// combined with flagshash so that results from
+		// another version of the compiler are not used.
+		string preprocessedfilepath (u64 key) {
+			key = fnv1a(flagshash, (u8*)&key, sizeof(key));
+			return stringfmt("%s/%08x%08x", preprocessedpath.ptr, (uint)(u32)(key>>32), (uint)(u32)key);
+		}
+		
+		// Function used as
+		// lyricalcompilearg.loadpreprocessed .
+		u8* loadpreprocessed (u64 key) {
+			
+			string s = preprocessedfilepath(key);
+			
+			u8* data = fileread1(s.ptr).ptr;
+			
+			mmfree(s.ptr);
+			
+			return data;
+		}
+		
+		// Function used as
+		// lyricalcompilearg.savepreprocessed ;
+		// the file is written under a temporary
+		// name, then renamed, so that it is never
+		// read incomplete by another process.
+		void savepreprocessed (u64 key, u8* data, uint sz) {
+			
+			if (!filemkdirparents(preprocessedpath.ptr)) return;
+			
+			string tmppath = stringfmt("%s/.%d", preprocessedpath.ptr, getpid());
+			
+			string s = preprocessedfilepath(key);
+			
+			if (!filewritetruncate1(tmppath.ptr, data, sz) || rename(tmppath.ptr, s.ptr))
+				unlink(tmppath.ptr);
+				
+			mmfree(s.ptr);
+			
+			mmfree(tmppath.ptr);
+		}
+		
+		// Function called by lyricalcompile()
+		// before including a module .lyc file;
+		// modules from the standard paths
+		// which have a .lyc file are imported
+		// as libraries, other than the module
+		// being compiled as a library.
+		// A module which cannot be compiled
+		// as a library, ei: when its functions
+		// use too much stack to be exported,
+		// is included instead.
+		uint importmodule (u8* modulelycpath) {
+			
+			if (fileis2(modulelycpath) != FILEISREGULAR) return 0;
+			
+			string s = filedirname(modulelycpath);
+			
+			// Since the path given as argument
+			// can be relative, and have "./"
+			// and "../" components, its canonical
+			// absolute path is used as the path
+			// of the folder of the module.
+			if (s.ptr[0] != '/') {
+				string cwd = filegetcwd();
+				stringappend4(&cwd, '/');
+				stringinsert1(&s, cwd, 0);
+				mmfree(cwd.ptr);
+			}
+			
+			string modulepath = filecanonicalpath(s.ptr);
+			
+			mmfree(s.ptr);
+			
+			uint retvar = 0;
+			
+			for (u8** path = stdpath; *path; ++path) {
+				
+				uint pathsz = stringsz(*path);
+				
+				if (stringmmsz(modulepath) > pathsz &&
+					stringiseq4(modulepath.ptr, *path, pathsz)) {
+					
+					retvar = 1;
+					
+					break;
+				}
+			}
+			
+			if (options.lib && stringiseq2(modulepath, *arg)) retvar = 0;
+			
+			if (retvar && libcompiling.ptr && islisted(libcompiling.ptr, modulepath.ptr)) retvar = 0;
+			
+			if (retvar) {
+				binmap map;
+				retvar = libcompile(modulepath.ptr, &map, 1);
+			}
+			
+			// A module imported more
+			// than once is listed once.
+			if (retvar && !(libpaths.ptr && islisted(libpaths.ptr, modulepath.ptr))) {
+				
+				if (libpaths.ptr) stringappend1(&libpaths, modulepath);
+				else {
+					libpaths = stringduplicate2(modulepath.ptr);
+					
+					// I move the allocation out of
+					// the session of lyricalcompile(),
+					// since it is freed once compiled.
+					mmsessionextract(memsession, libpaths.ptr);
+				}
+				
+				stringappend4(&libpaths, '\n');
+			}
+			
+			mmfree(modulepath.ptr);
+			
+			return retvar;
+		}
 		
 		lyricalcompilearg compilearg = {
 			.source = stringfmt(
@@ -543,7 +2305,7 @@ void main (uint argc, u8** arg, u8** env) {
 					((*arg)[0] == '.' && ((*arg)[1] == '/' ||
 						((*arg)[1] == '.' && (*arg)[2] == '/')))) ?
 				"%s`include \"%s\"" : "%s`include \"./%s\"",
-				(options.tcpipv4svr.en) ? "`include \"stdsck\"\n" : "",
+				(options.tcpipv4svr.en && !options.lib) ? "`include \"stdsck\"\n" : "",
 				*arg).ptr,
 			#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
 			.sizeofgpr = sizeof(u32),
@@ -600,11 +2362,13 @@ void main (uint argc, u8** arg, u8** env) {
 			.predeclaredmacros = globalmacros,
 			.standardpaths = stdpath,
 			.installmissingmodule = installmissingmodule,
+			.readfile = ((daemonconnfid != -1) ? daemonreadfile : 0),
+			.importmodule = ((options.dbg || options.staticlink) ? 0 : importmodule),
+			.loadpreprocessed = loadpreprocessed,
+			.savepreprocessed = savepreprocessed,
 			.lyxappend = ".stdsckout();",
 			.error = errorcallbackfunction,
-			.compileflag = LYRICALCOMPILENOFUNCTIONIMPORT | LYRICALCOMPILENOFUNCTIONEXPORT
-				| (options.dbg ? LYRICALCOMPILEGENERATEDEBUGINFO : 0)
-				| (options.log ? LYRICALCOMPILECOMMENT : 0)
+			.compileflag = compileflag
 		};
 		
 		bytsetz((void*)&compilearg.minunusedregcountforop, sizeof(compilearg.minunusedregcountforop));
@@ -616,65 +2380,134 @@ void main (uint argc, u8** arg, u8** env) {
 		#include "x64.minunusedregcountforop.lyrical.c"
 		#endif
 		
+		// Time at which compilation started,
+		// used by mnfgenerate() to detect source
+		// files modified during compilation.
+		struct timespec compilestart;
+		clock_gettime(CLOCK_REALTIME, &compilestart);
+		
 		lyricalcompileresult compileresult = lyricalcompile(&compilearg);
 		
 		mmfree(compilearg.source);
 		
+		mmfree(preprocessedpath.ptr);
+		
 		if (!compileresult.rootfunc) {
 			exitstatus = -1; // The shell use non-null for failing.
 			goto labelforinotifysetup;
 		}
 		
-		// I generate the file "src".
-		if (!filewritetruncate1(cachepathsrc.ptr, compileresult.srcfilepaths.ptr,
-			stringmmsz(compileresult.srcfilepaths))) {
-			fprintf(stderr, "failure to write to %s\n", cachepathsrc.ptr);
+		// I generate the file "mnf", which
+		// give the key of the cache entry.
+		arrayu8 mnf = mnfgenerate(compileresult.srcfilepaths, compilestart);
+		
+		if (!mnf.ptr) {
+			fprintf(stderr, "failure to stat source files\n");
 			exitstatus = -1; // The shell use non-null for failing.
 			goto labelforinotifysetup;
 		}
 		
+		// Path to the cache entry generated;
+		// cachepath get set to point to it
+		// once it has been published.
+		string entrypath = storeentrypath(mnfkey(mnf.ptr, arrayu8sz(mnf), 0));
+		
+		// Path to the folder in which
+		// the files generated are written;
+		// it is renamed to entrypath once
+		// they are all written, so that
+		// a cache entry is never seen
+		// by other processes incomplete.
+		// A folder left by a process that
+		// had the same pid and was killed
+		// while compiling, get removed.
+		string tmpentrypath = stringfmt("%s/.tmp/%d", storepath.ptr, getpid());
+		
+		// Function which return the path
+		// of the file which name is given
+		// as argument within tmpentrypath.
+		string entryfilepath (u8* name) {
+			return stringfmt("%s/%s", tmpentrypath.ptr, name);
+		}
+		
+		// Function which write to the
+		// file which name is given as argument
+		// within tmpentrypath, the data of size
+		// sz pointed by ptr.
+		// Null is returned on failure.
+		uint entryfilewrite (u8* name, void* ptr, uint sz) {
+			
+			string s = entryfilepath(name);
+			
+			uint retvar = filewritetruncate1(s.ptr, ptr, sz);
+			
+			if (!retvar) fprintf(stderr, "failure to write to %s\n", s.ptr);
+			
+			mmfree(s.ptr);
+			
+			return retvar;
+		}
+		
+		if ((fileis1(tmpentrypath.ptr) != FILEISNOTEXIST && !fileremoverecursive(tmpentrypath.ptr)) ||
+			!filemkdirparents(tmpentrypath.ptr)) {
+			fprintf(stderr, "failed to create %s\n", tmpentrypath.ptr);
+			goto labelfortmpentryfailure;
+		}
+		
+		// I generate the file "src".
+		if (!entryfilewrite("src", compileresult.srcfilepaths.ptr,
+			stringmmsz(compileresult.srcfilepaths))) {
+			goto labelfortmpentryfailure;
+		}
+		
 		#ifdef LYRICALUSEINOTIFY
 		execsrc = stringduplicate1(compileresult.srcfilepaths);
 		#endif
 		
 		// I generate the executable binary.
 		#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
-		lyricalbackendx86result* binresult = lyricalbackendx86(compileresult, LYRICALBACKENDX86PAGEALIGNED);
+		lyricalbackendx86result* binresult = lyricalbackendx86(compileresult, backendflag);
 		#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
-		lyricalbackendx64result* binresult = lyricalbackendx64(compileresult, LYRICALBACKENDX64PAGEALIGNED);
+		lyricalbackendx64result* binresult = lyricalbackendx64(compileresult, backendflag);
 		#endif
 		
-		if (!binresult->execbin.ptr) {
+		// The backend return null when
+		// it failed to lower an instruction.
+		if (!binresult || !binresult->execbin.ptr) {
 			fprintf(stderr, "failure to generate binary\n");
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
+			goto labelfortmpentryfailure;
 		}
 		
-		if (binresult->importinfo.ptr) {
-			fprintf(stderr, "import support not yet implemented\n");
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
+		// I store the list of the folders
+		// of the modules imported to "lib",
+		// the import information to "imp",
+		// and the export information to "exp";
+		// they are used to link the libraries
+		// when loading the executable binary.
+		
+		if (libpaths.ptr && !entryfilewrite("lib", libpaths.ptr, stringmmsz(libpaths))) {
+			goto labelfortmpentryfailure;
 		}
 		
-		if (binresult->exportinfo.ptr) {
-			fprintf(stderr, "export support not yet implemented\n");
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
+		if (binresult->importinfo.ptr &&
+			!entryfilewrite("imp", binresult->importinfo.ptr, arrayu8sz(binresult->importinfo))) {
+			goto labelfortmpentryfailure;
+		}
+		
+		if (binresult->exportinfo.ptr &&
+			!entryfilewrite("exp", binresult->exportinfo.ptr, arrayu8sz(binresult->exportinfo))) {
+			goto labelfortmpentryfailure;
 		}
 		
 		// I store the executable binary to "bin".
-		if (!filewritetruncate1(cachepathbin.ptr, binresult->execbin.ptr, arrayu8sz(binresult->execbin))) {
-			fprintf(stderr, "failure to write to %s\n", cachepathbin.ptr);
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
+		if (!entryfilewrite("bin", binresult->execbin.ptr, arrayu8sz(binresult->execbin))) {
+			goto labelfortmpentryfailure;
 		}
 		
 		if (options.dbg) {
 			// I store the debug information to "dbg".
-			if (!filewritetruncate1(cachepathdbg.ptr, binresult->dbginfo.ptr, arrayu8sz(binresult->dbginfo))) {
-				fprintf(stderr, "failure to write to %s\n", cachepathdbg.ptr);
-				exitstatus = -1; // The shell use non-null for failing.
-				goto labelforinotifysetup;
+			if (!entryfilewrite("dbg", binresult->dbginfo.ptr, arrayu8sz(binresult->dbginfo))) {
+				goto labelfortmpentryfailure;
 			}
 		}
 		
@@ -683,10 +2516,8 @@ void main (uint argc, u8** arg, u8** env) {
 			string textresult = lyricalbackendtext(compileresult);
 			
 			// I store the compilation log to "log".
-			if (!filewritetruncate1(cachepathlog.ptr, textresult.ptr, stringmmsz(textresult))) {
-				fprintf(stderr, "failure to write to %s\n", cachepathlog.ptr);
-				exitstatus = -1; // The shell use non-null for failing.
-				goto labelforinotifysetup;
+			if (!entryfilewrite("log", textresult.ptr, stringmmsz(textresult))) {
+				goto labelfortmpentryfailure;
 			}
 			
 			mmfree(textresult.ptr);
@@ -696,27 +2527,113 @@ void main (uint argc, u8** arg, u8** env) {
 		execmap.constantstringssz = binresult->constantstringssz;
 		execmap.globalvarregionsz = binresult->globalvarregionsz;
 		
-		// I store the executable binary map to "map".
-		if (!filewritetruncate1(cachepathbinmap.ptr, &execmap, sizeof(binmap))) {
-			fprintf(stderr, "failure to write to %s\n", cachepathbinmap.ptr);
+		((mnfheader*)mnf.ptr)->execmap = execmap;
+		
+		// I store the manifest to "mnf".
+		if (!entryfilewrite("mnf", mnf.ptr, arrayu8sz(mnf))) {
+			goto labelfortmpentryfailure;
+		}
+		
+		mmfree(mnf.ptr);
+		
+		// I publish the cache entry by renaming
+		// tmpentrypath to entrypath; if a cache
+		// entry with the same key exist, it was
+		// published by another process since
+		// the key was computed, and it is used
+		// instead; but if it has no "mnf", it is
+		// a folder left incomplete by a previous
+		// version of the runner, and it is replaced.
+		uint ispublished = 0;
+		
+		for (uint i = 0; i < 2 && !ispublished; ++i) {
+			
+			if (!rename(tmpentrypath.ptr, entrypath.ptr)) {
+				ispublished = 1;
+				break;
+			}
+			
+			if (errno != EEXIST && errno != ENOTEMPTY) break;
+			
+			string s = stringfmt("%s/mnf", entrypath.ptr);
+			
+			if (fileis1(s.ptr) == FILEISREGULAR)
+				ispublished = fileremoverecursive(tmpentrypath.ptr);
+			else if (!fileremoverecursive(entrypath.ptr)) i = 2;
+			
+			mmfree(s.ptr);
+		}
+		
+		if (!ispublished) {
+			
+			fprintf(stderr, "failure to publish %s\n", entrypath.ptr);
+			
+			// Every failure once tmpentrypath
+			// was created end up here, so that
+			// the folder is not left in the store.
+			labelfortmpentryfailure:
+			
+			fileremoverecursive(tmpentrypath.ptr);
+			
+			mmfree(tmpentrypath.ptr);
+			mmfree(entrypath.ptr);
+			
+			exitstatus = -1; // The shell use non-null for failing.
+			goto labelforinotifysetup;
+		}
+		
+		mmfree(tmpentrypath.ptr);
+		
+		if (!cachepathlink(entrypath.ptr)) {
+			fprintf(stderr, "failure to link %s\n", cachepath.ptr);
 			exitstatus = -1; // The shell use non-null for failing.
 			goto labelforinotifysetup;
 		}
 		
+		// Processes waiting for the
+		// compilation can now use
+		// the cache entry generated.
+		cachepathunlock();
+		
+		storeevict(entrypath.ptr);
+		
+		mmfree(entrypath.ptr);
+		
+		// The process which made the request
+		// to the compile daemon use the cache
+		// entry published.
+		if (daemonconnfid != -1) {
+			daemonreply(DAEMONCOMPILED);
+			goto labelfordaemonrequest;
+		}
+		
+		// The process which forked to
+		// compile the library use the
+		// cache entry published.
+		if (options.lib) exit(0);
+		
+		// The stack page pool is made of 4 gpr
+		// at the end of the global variable region.
+		stackpagepooloffset = (execmap.globalvarregionsz - (4*sizeof(uint)));
+		
 		// Align execmap values to a pagesize.
 		execmap.executableinstrsz = ROUNDUPTOPOWEROFTWO(execmap.executableinstrsz, 0x1000);
 		execmap.constantstringssz = ROUNDUPTOPOWEROFTWO(execmap.constantstringssz, 0x1000);
 		execmap.globalvarregionsz = ROUNDUPTOPOWEROFTWO(execmap.globalvarregionsz, 0x1000);
 		
 		#if defined(__linux__)
+		uint execpagessz = execmap.executableinstrsz + execmap.constantstringssz + execmap.globalvarregionsz;
+		
+		void* execpagesat = execpagesaddr(execpagessz);
+		
 		// Allocate the pages
 		// to which a jump will be
 		// done to start execution.
 		execpages = mmap(
-			0,
-			execmap.executableinstrsz + execmap.constantstringssz + execmap.globalvarregionsz,
+			execpagesat,
+			execpagessz,
 			PROT_WRITE,
-			MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED,
+			MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED|(execpagesat ? MAP_FIXED : 0),
 			0, 0);
 		
 		if (execpages == (void*)-1) {
@@ -725,6 +2642,11 @@ void main (uint argc, u8** arg, u8** env) {
 			goto labelforinotifysetup;
 		}
 		
+		// Done before the pages get
+		// written, so that they can be
+		// allocated as huge pages.
+		execpagesadvise(execpages, execmap);
+		
 		// Copy executable instructions.
 		bytcpy(
 			execpages,
@@ -807,27 +2729,19 @@ void main (uint argc, u8** arg, u8** env) {
 		lyricalfree(compileresult);
 		
 	} else {
-		// If I get here, compilation is not needed.
-		
-		uint fid;
+		// If I get here, compilation is not needed,
+		// and execmap was set by iscompileneeded().
 		
-		if ((fid = open(cachepathbinmap.ptr, O_RDONLY)) == -1) {
-			fprintf(stderr, "failure to open %s\n", cachepathbinmap.ptr);
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
-		}
+		// The library was compiled by another
+		// process since the process which forked
+		// to compile it checked its cache entry.
+		if (options.lib) exit(0);
 		
-		if (read(fid, &execmap, sizeof(binmap)) != sizeof(binmap)) {
-			fprintf(stderr, "failure to read %s\n", cachepathbinmap.ptr);
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
-		}
+		uint fid;
 		
-		if (close(fid) == -1) {
-			fprintf(stderr, "failure to close %s\n", cachepathbinmap.ptr);
-			exitstatus = -1; // The shell use non-null for failing.
-			goto labelforinotifysetup;
-		}
+		// The stack page pool is made of 4 gpr
+		// at the end of the global variable region.
+		stackpagepooloffset = (execmap.globalvarregionsz - (4*sizeof(uint)));
 		
 		// Align execmap values to a pagesize.
 		execmap.executableinstrsz = ROUNDUPTOPOWEROFTWO(execmap.executableinstrsz, 0x1000);
@@ -851,16 +2765,20 @@ void main (uint argc, u8** arg, u8** env) {
 		// loaded in memory for another process.
 		
 		#if defined(__linux__)
+		// execmap.globalvarregionsz is included
+		// in the mapped region size so that
+		// the space for the global variable region
+		// get reserved, since it is not part
+		// of the opened file "bin".
+		uint execpagessz = execmap.executableinstrsz + execmap.constantstringssz + execmap.globalvarregionsz;
+		
+		void* execpagesat = execpagesaddr(execpagessz);
+		
 		execpages = mmap(
-			0,
-			// execmap.globalvarregionsz is included
-			// in the mapped region size so that
-			// the space for the global variable region
-			// get reserved, since it is not part
-			// of the opened file "bin".
-			execmap.executableinstrsz + execmap.constantstringssz + execmap.globalvarregionsz,
+			execpagesat,
+			execpagessz,
 			PROT_READ,
-			MAP_PRIVATE,
+			MAP_PRIVATE|execpagesmapflags(execpagesat),
 			fid, 0);
 		
 		if (execpages == (void*)-1) {
@@ -881,6 +2799,8 @@ void main (uint argc, u8** arg, u8** env) {
 			goto labelforinotifysetup;
 		}
 		
+		execpagesadvise(execpages, execmap);
+		
 		// Set page permissions.
 		
 		if (mprotect(
@@ -936,21 +2856,429 @@ void main (uint argc, u8** arg, u8** env) {
 		#endif
 	}
 	
-	mmfree(cachepathbinmap.ptr);
+	// Function which return the content
+	// of the file which name is given
+	// as argument, within the cache entry
+	// pointed by the symlink which path
+	// is given as argument, or arrayu8null
+	// if it do not exist; the content is
+	// followed by a null-terminating byte
+	// which is counted in the size of
+	// the array returned.
+	arrayu8 entryfileread (u8* linkpath, u8* name) {
+		
+		string s = stringfmt("%s/%s", linkpath, name);
+		
+		arrayu8 content = ((fileis2(s.ptr) == FILEISREGULAR) ? fileread1(s.ptr) : arrayu8null);
+		
+		mmfree(s.ptr);
+		
+		return content;
+	}
+	
+	// Function which map the executable
+	// binary "bin" which path is given as
+	// argument, the same way it is done for
+	// the file to run, using the binmap aligned
+	// to a pagesize given as argument; the string
+	// region is left readable, and the address
+	// where it was mapped is returned.
+	// Null is returned on failure.
+	void* entrybinmap (u8* binpath, binmap map) {
+		
+		int fid;
+		
+		if ((fid = open(binpath, O_RDONLY|O_CLOEXEC)) == -1) {
+			fprintf(stderr, "failure to open %s\n", binpath);
+			return 0;
+		}
+		
+		#if defined(__linux__)
+		uint pagessz = map.executableinstrsz + map.constantstringssz + map.globalvarregionsz;
+		
+		void* pagesat = execpagesaddr(pagessz);
+		
+		void* pages = mmap(
+			pagesat,
+			pagessz,
+			PROT_READ,
+			MAP_PRIVATE|execpagesmapflags(pagesat),
+			fid, 0);
+			
+		// The file is closed since
+		// its mapping remain valid.
+		close(fid);
+		
+		if (pages == (void*)-1) {
+			fprintf(stderr, "mmap() failed\n");
+			return 0;
+		}
+		
+		// Allocate pages for global variables.
+		if (map.globalvarregionsz && mmap(
+			(void*)(pages + map.executableinstrsz + map.constantstringssz),
+			map.globalvarregionsz,
+			PROT_READ|PROT_WRITE,
+			MAP_FIXED|MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED,
+			0, 0) == (void*)-1) {
+			fprintf(stderr, "failure to allocate pages for global variables\n");
+			return 0;
+		}
+		
+		execpagesadvise(pages, map);
+		
+		if (mprotect(pages, map.executableinstrsz, PROT_EXEC) != 0) {
+			fprintf(stderr, "failure to set --x memory protection\n");
+			return 0;
+		}
+		#else
+		void* pages = mmap(
+			0,
+			map.executableinstrsz + map.constantstringssz + map.globalvarregionsz,
+			PROT_READ|PROT_WRITE|PROT_EXEC,
+			MAP_PRIVATE|MAP_ANONYMOUS|MAP_UNINITIALIZED,
+			0, 0);
+			
+		if (pages == (void*)-1) {
+			close(fid);
+			fprintf(stderr, "mmap() failed\n");
+			return 0;
+		}
+		
+		uint sztoread = map.executableinstrsz + map.constantstringssz;
+		
+		if (read(fid, pages, sztoread) != sztoread) {
+			close(fid);
+			fprintf(stderr, "failure to read %s\n", binpath);
+			return 0;
+		}
+		
+		close(fid);
+		#endif
+		
+		return pages;
+	}
+	
+	// When compilation was not needed,
+	// the list of the folders of the modules
+	// imported is loaded from "lib".
+	if (!libpaths.ptr) libpaths.ptr = entryfileread(cachepath.ptr, "lib").ptr;
+	
+	// Import information of
+	// the executable binary.
+	arrayu8 importinfo = entryfileread(cachepath.ptr, "imp");
+	
+	// I link the executable binary with
+	// the libraries that it import, and
+	// the libraries that they import,
+	// compiling them if needed.
+	if (libpaths.ptr || importinfo.ptr) {
+		
+		// Structure used to describe
+		// a library being loaded.
+		typedef struct {
+			// Path of the folder of its module.
+			string path;
+			
+			// Path to the symlink pointing
+			// to its cache entry.
+			string cachepath;
+			
+			void* execpages;
+			
+			// Its binmap aligned to a pagesize.
+			binmap execmap;
+			
+			// Content of the files "lib",
+			// "exp" and "imp" of its cache entry.
+			arrayu8 libpaths;
+			arrayu8 exportinfo;
+			arrayu8 importinfo;
+			
+			// Set once added to libruns.
+			uint isordered;
+			
+		} libinfo;
+		
+		// Array of libinfo, for all the
+		// libraries listed in liblist.
+		arrayu8 libs = arrayu8null;
+		
+		// Newline separated list
+		// of the folders of the modules
+		// of all the libraries to load.
+		string liblist = (libpaths.ptr ? stringduplicate2(libpaths.ptr) : stringnull);
+		
+		// Offset within liblist of the path
+		// of the next library to load.
+		uint liblistoffset = 0;
+		
+		while (liblist.ptr && liblist.ptr[liblistoffset]) {
+			
+			u8* path = liblist.ptr + liblistoffset;
+			u8* pathend = path;
+			
+			while (*pathend && *pathend != '\n') ++pathend;
+			
+			liblistoffset = ((pathend - liblist.ptr) + (*pathend != 0));
+			
+			libinfo* l = (libinfo*)arrayu8append2(&libs, sizeof(libinfo));
+			
+			bytsetz(l, sizeof(libinfo));
+			
+			l->path = stringduplicate3(path, pathend - path);
+			
+			l->cachepath = stringfmt("%s%d%s/.lib", LYRICALCACHEDIR, getuid(), l->path.ptr);
+			
+			// A library is compiled anew if
+			// its sources were modified since
+			// the file to run was compiled.
+			if (!libcompile(l->path.ptr, &l->execmap, 0)) {
+				fprintf(stderr, "failure to compile library %s\n", l->path.ptr);
+				exitstatus = -1; // The shell use non-null for failing.
+				goto labelforinotifysetup;
+			}
+			
+			// Align execmap values to a pagesize.
+			l->execmap.executableinstrsz = ROUNDUPTOPOWEROFTWO(l->execmap.executableinstrsz, 0x1000);
+			l->execmap.constantstringssz = ROUNDUPTOPOWEROFTWO(l->execmap.constantstringssz, 0x1000);
+			l->execmap.globalvarregionsz = ROUNDUPTOPOWEROFTWO(l->execmap.globalvarregionsz, 0x1000);
+			
+			string s = stringfmt("%s/bin", l->cachepath.ptr);
+			
+			l->execpages = entrybinmap(s.ptr, l->execmap);
+			
+			mmfree(s.ptr);
+			
+			if (options.zygote) {
+				if (zygotelibs.ptr) stringappend1(&zygotelibs, l->cachepath);
+				else zygotelibs = stringduplicate1(l->cachepath);
+				stringappend4(&zygotelibs, '\n');
+			}
+			
+			if (!l->execpages) {
+				exitstatus = -1; // The shell use non-null for failing.
+				goto labelforinotifysetup;
+			}
+			
+			l->libpaths = entryfileread(l->cachepath.ptr, "lib");
+			l->exportinfo = entryfileread(l->cachepath.ptr, "exp");
+			l->importinfo = entryfileread(l->cachepath.ptr, "imp");
+			
+			// I add to liblist the libraries
+			// imported by the library which
+			// are not already in it.
+			
+			u8* ptr = l->libpaths.ptr;
+			
+			if (ptr) while (*ptr) {
+				
+				u8* ptrend = ptr;
+				
+				while (*ptrend && *ptrend != '\n') ++ptrend;
+				
+				u8 c = *ptrend;
+				
+				*ptrend = 0;
+				
+				if (!islisted(liblist.ptr, ptr)) {
+					stringappend2(&liblist, ptr);
+					stringappend4(&liblist, '\n');
+				}
+				
+				if ((*ptrend = c)) ++ptrend;
+				
+				ptr = ptrend;
+			}
+		}
+		
+		libinfo* libsptr = (libinfo*)libs.ptr;
+		libinfo* libslimit = (libinfo*)(libs.ptr + arrayu8sz(libs));
+		
+		// Function which return the address
+		// of the function which linking signature
+		// is given as argument, exported by
+		// any of the libraries, or null if
+		// it could not be found.
+		void* findexport (u8* linkingsignature) {
+			
+			for (libinfo* l = libsptr; l < libslimit; ++l) {
+				
+				u8* ptr = l->exportinfo.ptr;
+				u8* ptrlimit = ptr + (arrayu8sz(l->exportinfo) - 1);
+				
+				if (ptr) while ((ptr + stringsz(ptr) + 1 + sizeof(uint)) <= ptrlimit) {
+					
+					uint ptrsz = stringsz(ptr);
+					
+					uint isfound = stringiseq3(ptr, linkingsignature);
+					
+					ptr += (ptrsz + 1);
+					
+					if (isfound) {
+						
+						uint offset;
+						bytcpy(&offset, ptr, sizeof(uint));
+						
+						return (l->execpages + offset);
+					}
+					
+					ptr += sizeof(uint);
+				}
+			}
+			
+			return 0;
+		}
+		
+		// Function which link the imports of the
+		// executable binary mapped at the address
+		// given by the argument pages, using
+		// the import information given as argument;
+		// the offset to each function imported is
+		// written in the string region, from where
+		// it is retrieved.
+		// Null is returned on failure.
+		uint linkimports (void* pages, binmap map, arrayu8 importinfo) {
+			
+			if (!importinfo.ptr) return 1;
+			
+			void* stringregion = (pages + map.executableinstrsz);
+			
+			#if defined(__linux__)
+			if (mprotect(stringregion, map.constantstringssz, PROT_READ|PROT_WRITE) != 0) {
+				fprintf(stderr, "failure to set rw- memory protection\n");
+				return 0;
+			}
+			#endif
+			
+			u8* ptr = importinfo.ptr;
+			u8* ptrlimit = ptr + (arrayu8sz(importinfo) - 1);
+			
+			while ((ptr + stringsz(ptr) + 1 + sizeof(uint)) <= ptrlimit) {
+				
+				u8* linkingsignature = ptr;
+				
+				ptr += (stringsz(ptr) + 1);
+				
+				uint offset;
+				bytcpy(&offset, ptr, sizeof(uint));
+				
+				ptr += sizeof(uint);
+				
+				void* f = findexport(linkingsignature);
+				
+				if (!f || (offset + sizeof(uint)) > map.constantstringssz) {
+					fprintf(stderr, "unresolved import %s\n", linkingsignature);
+					return 0;
+				}
+				
+				// The offset to the function
+				// imported is from where
+				// it is written.
+				*(uint*)(stringregion + offset) = ((uint)f - (uint)(stringregion + offset));
+			}
+			
+			#if defined(__linux__)
+			if (mprotect(stringregion, map.constantstringssz, PROT_READ) != 0) {
+				fprintf(stderr, "failure to set r-- memory protection\n");
+				return 0;
+			}
+			#endif
+			
+			return 1;
+		}
+		
+		uint islinked = linkimports(execpages, execmap, importinfo);
+		
+		if (importinfo.ptr) mmfree(importinfo.ptr);
+		
+		for (libinfo* l = libsptr; islinked && l < libslimit; ++l)
+			islinked = linkimports(l->execpages, l->execmap, l->importinfo);
+			
+		if (!islinked) {
+			exitstatus = -1; // The shell use non-null for failing.
+			goto labelforinotifysetup;
+		}
+		
+		// Function which add to libruns the
+		// libraries which module folder paths
+		// are in the newline separated list
+		// given as argument, each after the
+		// libraries that it import.
+		void orderlibs (u8* list) {
+			
+			if (list) while (*list) {
+				
+				u8* listend = list;
+				
+				while (*listend && *listend != '\n') ++listend;
+				
+				libinfo* l = libsptr;
+				
+				while (l < libslimit && !stringiseq5(list, listend - list, l->path)) ++l;
+				
+				if (l < libslimit && !l->isordered) {
+					
+					l->isordered = 1;
+					
+					orderlibs(l->libpaths.ptr);
+					
+					librun* r = (librun*)arrayu8append2(&libruns, sizeof(librun));
+					
+					r->execpages = l->execpages;
+					r->globalvarregion = (void**)(l->execpages + l->execmap.executableinstrsz + l->execmap.constantstringssz);
+				}
+				
+				list = (*listend ? listend+1 : listend);
+			}
+		}
+		
+		orderlibs(libpaths.ptr);
+		
+		// libruns is used at runtime.
+		if (libruns.ptr) mmsessionextract(memsession, libruns.ptr);
+		if (zygotelibs.ptr) mmsessionextract(memsession, zygotelibs.ptr);
+		
+		for (libinfo* l = libsptr; l < libslimit; ++l) {
+			mmfree(l->path.ptr);
+			mmfree(l->cachepath.ptr);
+			if (l->libpaths.ptr) mmfree(l->libpaths.ptr);
+			if (l->exportinfo.ptr) mmfree(l->exportinfo.ptr);
+			if (l->importinfo.ptr) mmfree(l->importinfo.ptr);
+		}
+		
+		if (libs.ptr) mmfree(libs.ptr);
+		if (liblist.ptr) mmfree(liblist.ptr);
+		if (libpaths.ptr) mmfree(libpaths.ptr);
+	}
+	
+	mmfree(cachepathmnf.ptr);
+	mmfree(storepath.ptr);
+	mmfree(daemonpath.ptr);
 	mmfree(cachepathbin.ptr);
 	mmfree(cachepathsrc.ptr);
 	if (cachepathlog.ptr) mmfree(cachepathlog.ptr);
 	// Note that cachepathdbg is not freed because
 	// it is used at runtime by pagefaulthandler(). 
 	
-	#ifndef LYRICALUSEINOTIFY
-	labelforinotifysetup:;
-	#else
-	
+	#ifdef LYRICALUSEINOTIFY
 	mmsessionextract(memsession, execsrc.ptr);
+	#endif
 	
 	labelforinotifysetup:;
 	
+	if (daemonconnfid != -1) {
+		daemonreply(DAEMONFAILED);
+		goto labelfordaemonrequest;
+	}
+	
+	// The process which forked to
+	// compile the library check
+	// the exit status.
+	if (options.lib) exit(exitstatus);
+	
+	#ifdef LYRICALUSEINOTIFY
+	
 	void* inotifythreadstack;
 	
 	if ((inotifythreadstack = mmap(
@@ -1035,6 +3363,10 @@ void main (uint argc, u8** arg, u8** env) {
 	
 	#endif
 	
+	// The lock from cachepathlock() is
+	// still held if compilation failed.
+	cachepathunlock();
+	
 	if (exitstatus != 0) goto labelforskippingexec;
 	
 	#ifdef MMDEBUG
@@ -1105,6 +3437,41 @@ void main (uint argc, u8** arg, u8** env) {
 	
 	void** globalvarregion = (void**)(execpages + execmap.executableinstrsz + execmap.constantstringssz);
 	
+	// Set to 1 when the global variable region
+	// was restored from a snapshot; it is
+	// returned by the syscall LYRICALSYSCALLSNAPSHOTRESTORED.
+	uint snapshotrestored = 0;
+	
+	if (options.snapshot && execmap.globalvarregionsz) {
+		// The snapshot is mapped private
+		// over the global variable region,
+		// so that its pages are copied only
+		// when written; it is used only if
+		// its size match the size of the region,
+		// which is what was written by
+		// the syscall LYRICALSYSCALLSNAPSHOT.
+		
+		string s = stringfmt("%s/glb", cachepath.ptr);
+		
+		int fid = open(s.ptr, O_RDONLY);
+		
+		if (fid != -1) {
+			
+			struct stat st;
+			
+			if (!fstat(fid, &st) && st.st_size == execmap.globalvarregionsz && mmap(
+				globalvarregion,
+				execmap.globalvarregionsz,
+				PROT_READ|PROT_WRITE,
+				MAP_PRIVATE|MAP_FIXED,
+				fid, 0) != (void*)-1) snapshotrestored = 1;
+				
+			close(fid);
+		}
+		
+		mmfree(s.ptr);
+	}
+	
 	globalvarregion[0] = (void*)&arg;
 	globalvarregion[1] = (void*)&env;
 	// globalvarregion[2] get set within
@@ -1112,6 +3479,25 @@ void main (uint argc, u8** arg, u8** env) {
 	// globalvarregion[3] get set within
 	// the file implementing a server.
 	
+	if (options.stackpagestats) {
+		
+		uint* stackpagepool = (uint*)((void*)globalvarregion + stackpagepooloffset);
+		
+		void stackpagestats () {
+			fprintf(stderr,
+				#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
+				"stack pages: %d from pool, %d allocated, %d left in pool\n",
+				#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
+				"stack pages: %ld from pool, %ld allocated, %ld left in pool\n",
+				#endif
+				stackpagepool[2], stackpagepool[3], stackpagepool[1]);
+		}
+		
+		// The counts are written even when
+		// the binary terminate using exit().
+		atexit(stackpagestats);
+	}
+	
 	// Install the Lyrical syscalls.
 	#include "syscalls.lyrical.c"
 	
@@ -1123,24 +3509,81 @@ void main (uint argc, u8** arg, u8** env) {
 	#include "x64.pagefaulthandler.lyrical.c"
 	#endif
 	
-	void runexecpages() {
+	void runpages (void* pages) {
+		// Saving the registers which GCC expect
+		// to be preserved across a call, since
+		// the caller keep using them after
+		// the root function of a library was run;
+		// the stackframe pointer is also used
+		// by GCC to access a stackframe.
+		// The stack pointer is also adjusted
+		// so that the generated code is entered
+		// with the same alignment as when only
+		// the stackframe pointer was saved;
+		// otherwise, the stackframe of the rootfunc
+		// could start at the location where a stack
+		// page hold the link to the previous stack page.
 		#if defined(LYRICALX86) || defined(LYRICALX86LINUX) || defined(LYRICALX86CYGWIN)
-		// Saving EBP because GCC do not save it,
-		// and use it to access a stackframe.
-		asm volatile ("push %ebp");
-		((void(*)(void))execpages)();
-		asm volatile ("pop %ebp");
+		asm volatile ("push %ebp; push %ebx; push %esi; push %edi; sub $4, %esp");
+		((void(*)(void))pages)();
+		asm volatile ("add $4, %esp; pop %edi; pop %esi; pop %ebx; pop %ebp");
 		#elif defined(LYRICALX64) || defined(LYRICALX64LINUX) || defined(LYRICALX64CYGWIN)
-		// Saving RBP because GCC do not save it,
-		// and use it to access a stackframe.
-		asm volatile ("push %rbp");
-		((void(*)(void))execpages)();
-		asm volatile ("pop %rbp");
+		asm volatile ("push %rbp; push %rbx; push %r12; push %r13; push %r14; push %r15; sub $8, %rsp");
+		((void(*)(void))pages)();
+		asm volatile ("add $8, %rsp; pop %r15; pop %r14; pop %r13; pop %r12; pop %rbx; pop %rbp");
 		#endif
 	}
 	
+	void runexecpages() {
+		// The root function of each library
+		// is run first, with its global variable
+		// region set the same way as the one
+		// of the executable binary.
+		
+		librun* r = (librun*)libruns.ptr;
+		librun* rlimit = (librun*)(libruns.ptr + arrayu8sz(libruns));
+		
+		while (r < rlimit) {
+			
+			bytcpy(r->globalvarregion, globalvarregion, 4*sizeof(void*));
+			
+			runpages(r->execpages);
+			
+			++r;
+		}
+		
+		runpages(execpages);
+	}
+	
+	if (options.faultstats) {
+		
+		struct rusage startusage;
+		
+		getrusage(RUSAGE_SELF, &startusage);
+		
+		fprintf(stderr, "page faults before execution: %ld minor, %ld major\n",
+			startusage.ru_minflt, startusage.ru_majflt);
+			
+		void faultstats () {
+			
+			struct rusage usage;
+			
+			getrusage(RUSAGE_SELF, &usage);
+			
+			fprintf(stderr, "page faults during execution: %ld minor, %ld major\n",
+				usage.ru_minflt - startusage.ru_minflt,
+				usage.ru_majflt - startusage.ru_majflt);
+		}
+		
+		// The counts are written even when
+		// the binary terminate using exit().
+		atexit(faultstats);
+	}
+	
 	if (options.tcpipv4svr.en) {
 		#include "tcpipv4svr.lyrical.c"
+	} else if (options.zygote) {
+		#include "zygote.lyrical.c"
 	} else runexecpages();
 	
 	// I jump here in the event of an error.
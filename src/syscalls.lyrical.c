@@ -359,6 +359,65 @@ uint lyricalsyscalls (
 			
 			break;
 		}
+		
+		case LYRICALSYSCALLSNAPSHOT: {
+			
+			if (!options.snapshot || !execmap.globalvarregionsz) break;
+			
+			// The pointers set by the runner
+			// and the stack page pool are not
+			// saved in the snapshot, since
+			// they are valid only within
+			// the process saving it.
+			
+			void* saved[4];
+			uint savedpool[4];
+			
+			uint* stackpagepool = (uint*)((void*)globalvarregion + stackpagepooloffset);
+			
+			bytcpy(saved, globalvarregion, sizeof(saved));
+			bytcpy(savedpool, stackpagepool, sizeof(savedpool));
+			
+			bytsetz(globalvarregion, sizeof(saved));
+			bytsetz(stackpagepool, sizeof(savedpool));
+			
+			// The snapshot is written to a temporary
+			// file renamed to its final name, so that
+			// a concurrent run never map it partially
+			// written.
+			
+			string tmppath = stringfmt("%s/.glb%d", cachepath.ptr, getpid());
+			
+			string s = stringfmt("%s/glb", cachepath.ptr);
+			
+			uint retvar = 0;
+			
+			if (!filewritetruncate1(tmppath.ptr, (u8*)globalvarregion, execmap.globalvarregionsz) ||
+				rename(tmppath.ptr, s.ptr)) {
+				
+				unlink(tmppath.ptr);
+				
+				retvar = -1;
+			}
+			
+			mmfree(s.ptr);
+			
+			mmfree(tmppath.ptr);
+			
+			bytcpy(globalvarregion, saved, sizeof(saved));
+			bytcpy(stackpagepool, savedpool, sizeof(savedpool));
+			
+			return retvar;
+			
+			break;
+		}
+		
+		case LYRICALSYSCALLSNAPSHOTRESTORED: {
+			
+			return snapshotrestored;
+			
+			break;
+		}
 	}
 	
 	return -1;
@@ -22,6 +22,9 @@ compilearg.minunusedregcountforop[LYRICALOPSRL] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRLI2] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRA] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRAI2] = 1;
+compilearg.minunusedregcountforop[LYRICALOPROL] = 1;
+compilearg.minunusedregcountforop[LYRICALOPROR] = 1;
+compilearg.minunusedregcountforop[LYRICALOPPOPCNT] = 2;
 compilearg.minunusedregcountforop[LYRICALOPZXT] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSXT] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSEQ] = 2;
@@ -65,6 +68,26 @@ compilearg.minunusedregcountforop[LYRICALOPLDST32] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST32I] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST64] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST64I] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS8] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS64] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD8] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD64] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB8] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB64] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND8] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND16] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND32] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND64] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR8] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR16] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR32] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR64] = 2;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPY] = 3;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPYI] = 3;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPY2] = 3;
@@ -20,6 +20,9 @@ compilearg.minunusedregcountforop[LYRICALOPSRL] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRLI2] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRA] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSRAI2] = 1;
+compilearg.minunusedregcountforop[LYRICALOPROL] = 1;
+compilearg.minunusedregcountforop[LYRICALOPROR] = 1;
+compilearg.minunusedregcountforop[LYRICALOPPOPCNT] = 2;
 compilearg.minunusedregcountforop[LYRICALOPZXT] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSXT] = 1;
 compilearg.minunusedregcountforop[LYRICALOPSEQ] = 1;
@@ -46,6 +49,21 @@ compilearg.minunusedregcountforop[LYRICALOPST8I] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST8] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST8R] = 1;
 compilearg.minunusedregcountforop[LYRICALOPLDST8I] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS8] = 2;
+compilearg.minunusedregcountforop[LYRICALOPCAS16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPCAS32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD8] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHADD32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB8] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB16] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHSUB32] = 1;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND8] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND16] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHAND32] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR8] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR16] = 2;
+compilearg.minunusedregcountforop[LYRICALOPFETCHOR32] = 2;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPY] = 3;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPYI] = 3;
 compilearg.minunusedregcountforop[LYRICALOPMEM8CPY2] = 3;
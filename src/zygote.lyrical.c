@@ -0,0 +1,370 @@
+
+// ---------------------------------------------------------------------
+// Copyright (c) William Fonkou Tambe
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ---------------------------------------------------------------------
+
+
+// File which implement the zygote, which
+// keep the executable binary of the file
+// to run mapped, with the Lyrical syscalls
+// and the pagefault handler installed,
+// and fork a process to run it for each
+// request made by zygoterun().
+
+// Structure describing a cache entry
+// which executable binary was mapped.
+typedef struct {
+	// Path to its file "mnf".
+	string mnfpath;
+	
+	// flagshash with which
+	// it was generated.
+	u64 flagshash;
+	
+	// Device and inode of its file "mnf";
+	// a cache entry generated anew, to which
+	// its symlink get pointed, has a different
+	// file "mnf" than the one mapped.
+	dev_t dev;
+	ino_t ino;
+	
+} zygoteentry;
+
+// Array of zygoteentry for the file
+// to run and the libraries it link.
+arrayu8 zygoteentries = arrayu8null;
+
+// Function which add to zygoteentries
+// the cache entry pointed by the symlink
+// which path of size pathsz is given
+// as argument, and which was generated
+// using the flagshash given as argument.
+void zygoteentryadd (u8* path, uint pathsz, u64 hash) {
+	
+	zygoteentry* e = (zygoteentry*)arrayu8append2(&zygoteentries, sizeof(zygoteentry));
+	
+	e->mnfpath = stringduplicate3(path, pathsz);
+	stringappend2(&e->mnfpath, "/mnf");
+	
+	e->flagshash = hash;
+	
+	struct stat st;
+	
+	if (stat(e->mnfpath.ptr, &st) == -1) {
+		perror("lyrical: stat()");
+		exit(-1); // The shell use non-null for failing.
+	}
+	
+	e->dev = st.st_dev;
+	e->ino = st.st_ino;
+}
+
+zygoteentryadd(cachepath.ptr, stringmmsz(cachepath), flagshash);
+
+if (zygotelibs.ptr) {
+	
+	u8* ptr = zygotelibs.ptr;
+	
+	while (*ptr) {
+		
+		u8* ptrend = ptr;
+		
+		while (*ptrend && *ptrend != '\n') ++ptrend;
+		
+		zygoteentryadd(ptr, ptrend - ptr, libflagshash);
+		
+		ptr = (*ptrend ? ptrend+1 : ptrend);
+	}
+}
+
+// Function which return whether the
+// cache entries in zygoteentries are
+// still the ones that their symlink
+// point to, and are up to date.
+uint zygoteisuptodate () {
+	
+	zygoteentry* e = (zygoteentry*)zygoteentries.ptr;
+	zygoteentry* elimit = (zygoteentry*)(zygoteentries.ptr + arrayu8sz(zygoteentries));
+	
+	while (e < elimit) {
+		
+		binmap map;
+		
+		struct stat st;
+		
+		if (!mnfcheck(e->mnfpath.ptr, e->flagshash, &map, 0, 0) ||
+			stat(e->mnfpath.ptr, &st) == -1 ||
+			st.st_dev != e->dev || st.st_ino != e->ino)
+			return 0;
+			
+		++e;
+	}
+	
+	return 1;
+}
+
+string zygotepath = zygotepathfor();
+
+struct sockaddr_un zygoteaddr = {.sun_family = AF_UNIX};
+
+if ((stringmmsz(zygotepath)+1) > sizeof(zygoteaddr.sun_path)) {
+	fprintf(stderr, "lyrical: path too long %s\n", zygotepath.ptr);
+	exit(-1); // The shell use non-null for failing.
+}
+
+bytcpy(zygoteaddr.sun_path, zygotepath.ptr, stringmmsz(zygotepath)+1);
+
+string zygotedirpath = filedirname(zygotepath.ptr);
+
+if (!filemkdirparents(zygotedirpath.ptr)) {
+	fprintf(stderr, "lyrical: failure to create %s\n", zygotedirpath.ptr);
+	exit(-1); // The shell use non-null for failing.
+}
+
+mmfree(zygotedirpath.ptr);
+
+int zygotelistenfid = socket(AF_UNIX, SOCK_STREAM|SOCK_CLOEXEC, 0);
+
+if (zygotelistenfid == -1) {
+	perror("lyrical: socket()");
+	exit(-1); // The shell use non-null for failing.
+}
+
+if (connect(zygotelistenfid, (struct sockaddr*)&zygoteaddr, sizeof(zygoteaddr)) != -1) {
+	fprintf(stderr, "lyrical: zygote already running\n");
+	exit(-1); // The shell use non-null for failing.
+}
+
+// If I get here, no zygote is accepting
+// requests; the socket, if it exist, was
+// left by a zygote that got killed.
+unlink(zygotepath.ptr);
+
+if (bind(zygotelistenfid, (struct sockaddr*)&zygoteaddr, sizeof(zygoteaddr)) == -1) {
+	perror("lyrical: bind()");
+	exit(-1); // The shell use non-null for failing.
+}
+
+if (listen(zygotelistenfid, 64) == -1) {
+	perror("lyrical: listen()");
+	exit(-1); // The shell use non-null for failing.
+}
+
+// The options with which
+// requests are served.
+typeof(options) zygoteoptions = options;
+zygoteoptions.zygote = 0;
+
+// The forked processes get reaped
+// without being waited for, and replying
+// to a process which made a request and
+// terminated must not terminate the zygote.
+signal(SIGCHLD, SIG_IGN);
+signal(SIGPIPE, SIG_IGN);
+
+fprintf(stderr, "lyrical: ready to accept requests\n");
+
+while (1) {
+	
+	int connfid = accept4(zygotelistenfid, 0, 0, SOCK_CLOEXEC);
+	
+	if (connfid == -1) {
+		if (errno != EINTR) perror("lyrical: accept()");
+		continue;
+	}
+	
+	zygoterequest req;
+	
+	int fds[3] = {-1, -1, -1};
+	
+	union {
+		struct cmsghdr h;
+		u8 buf[CMSG_SPACE(sizeof(fds))];
+	} cmsg;
+	
+	struct iovec iov = {
+		.iov_base = &req,
+		.iov_len = sizeof(req)
+	};
+	
+	struct msghdr msg = {
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = cmsg.buf,
+		.msg_controllen = sizeof(cmsg.buf)
+	};
+	
+	sint n = recvmsg(connfid, &msg, MSG_CMSG_CLOEXEC);
+	
+	struct cmsghdr* c;
+	
+	if (n > 0 && (c = CMSG_FIRSTHDR(&msg)) &&
+		c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_RIGHTS &&
+		c->cmsg_len == CMSG_LEN(sizeof(fds)))
+		bytcpy(fds, CMSG_DATA(c), sizeof(fds));
+		
+	uint sz = ((n > 0) ? n : 0);
+	
+	// The request may not have been
+	// received in its entirety.
+	while (n > 0 && sz < sizeof(req)) {
+		if ((n = read(connfid, (u8*)&req + sz, sizeof(req) - sz)) > 0)
+			sz += n;
+	}
+	
+	u8* strs = 0;
+	
+	// The request is served only if it was
+	// made with the same options and flags;
+	// otherwise, or if the cache entries are
+	// out of date, the connection is closed
+	// without reply, and the process which
+	// made the request run the file itself.
+	if (fds[0] != -1 && sz == sizeof(req) && req.sz &&
+		!bytcmp(&req.options, &zygoteoptions, sizeof(zygoteoptions)) &&
+		req.flagshash == flagshash) {
+		
+		strs = mmalloc(req.sz);
+		
+		sz = 0;
+		
+		while (sz < req.sz && (n = read(connfid, strs + sz, req.sz - sz)) > 0)
+			sz += n;
+			
+		// The strings must be null
+		// terminated, and as many as
+		// described by the request.
+		
+		uint count = 0;
+		
+		if (sz == req.sz && !strs[sz-1]) {
+			
+			u8* ptr = strs;
+			u8* ptrlimit = strs + sz;
+			
+			while (ptr < ptrlimit) if (!*ptr++) ++count;
+		}
+		
+		if (count != (1 + req.argc + req.envc)) {
+			mmfree(strs);
+			strs = 0;
+		}
+	}
+	
+	if (strs && !zygoteisuptodate()) {
+		
+		// Requests are no longer served,
+		// since the file to run or the libraries
+		// it link must be compiled anew.
+		
+		close(zygotelistenfid);
+		
+		unlink(zygotepath.ptr);
+		
+		fprintf(stderr, "lyrical: cache entry out of date, zygote exiting\n");
+		
+		exit(0);
+	}
+	
+	pid_t pid = (strs ? fork() : -1);
+	
+	if (!pid) {
+		// Child process.
+		
+		close(zygotelistenfid);
+		
+		signal(SIGCHLD, SIG_DFL);
+		signal(SIGPIPE, SIG_DFL);
+		
+		// A new session is created so that
+		// the terminal of the process which made
+		// the request, which it forward signals to,
+		// can be used without job control.
+		setsid();
+		
+		uint i = 0;
+		
+		do if (fds[i] != i) {
+			dup2(fds[i], i);
+			close(fds[i]);
+		} while (++i < 3);
+		
+		pid = getpid();
+		
+		send(connfid, &pid, sizeof(pid), MSG_NOSIGNAL);
+		
+		// Function which reply with the exit
+		// status, even when the binary terminate
+		// using exit(); it is registered with
+		// on_exit() since atexit() do not provide it.
+		void zygotereply (int status, void* unused) {
+			u32 s = status;
+			send(connfid, &s, sizeof(s), MSG_NOSIGNAL);
+		}
+		
+		on_exit(zygotereply, 0);
+		
+		if (chdir((char*)strs) == -1) {
+			perror("lyrical: chdir()");
+			exit(-1); // The shell use non-null for failing.
+		}
+		
+		// The arguments and environment are
+		// set from the strings of the request,
+		// which follow the current working directory.
+		
+		u8** a = mmalloc((req.argc + 1 + req.envc + 1) * sizeof(u8*));
+		
+		arg = a;
+		
+		u8* ptr = strs;
+		
+		while (*ptr++);
+		
+		for (i = 0; i < req.argc; ++i) {
+			*a++ = ptr;
+			while (*ptr++);
+		}
+		
+		*a++ = 0;
+		
+		env = a;
+		
+		for (i = 0; i < req.envc; ++i) {
+			*a++ = ptr;
+			while (*ptr++);
+		}
+		
+		*a = 0;
+		
+		runexecpages();
+		
+		exit(exitstatus);
+	}
+	
+	// Parent process.
+	
+	if (pid == -1 && strs) perror("lyrical: fork()");
+	
+	uint i = 0;
+	
+	do if (fds[i] != -1) close(fds[i]);
+	while (++i < 3);
+	
+	close(connfid);
+	
+	if (strs) mmfree(strs);
+}